@@ -227,7 +227,7 @@ public:
         Meta *cmeta = reinterpret_cast<Meta*>(p);
         cmeta->next = NULL;
         cmeta->arena_id = -1;
-        cmeta->magic = 0xFEDCFEDC01230123;
+        cmeta->magic = MISS_MAGIC;
         ctx = PTR_META2OBJ(p);
         new (ctx) T();
       }
@@ -235,29 +235,37 @@ public:
     return ctx;
   }
 
+  /**
+   * The object is returned to the arena of the current thread rather than the
+   * one it is borrowed from, so that the objects borrowed on one core and
+   * returned on another do not contend on the lock of the origin arena, and
+   * the arena of the thread which keeps borrowing is refilled by the returns.
+   * The arena keeps at most 2 * cnt_per_arena_ objects, the objects beyond it
+   * go back to the origin arena, or are freed if they are allocated directly.
+   */
   void return_object(T* x) {
     if (NULL == x) {
       COMMON_LOG(ERROR, "allocate memory failed", K(typeid(T).name()), K(item_size_), K(get_itid()));
     } else {
       Meta *cmeta = PTR_OBJ2META(x);
-      int64_t aid = cmeta->arena_id;
-      if (aid >= 0) {
-        x->reset();
-        ObPoolArenaHead &arena = arena_[aid];
-        int64_t cur_ts = OB_TSC_TIMESTAMP.current_time();
-        { // Enter the critical area of the arena, the timestamp is obtained outside the lock, and minimize the length of the critical area
-          ObLatchWGuard lock_guard(arena.lock, ObLatchIds::SERVER_OBJECT_POOL_ARENA_LOCK);
-          cmeta->next = static_cast<Meta*>(arena.next);
-          arena.next = static_cast<void*>(cmeta);
-          arena.return_cnt++;
-          arena.free_num++;
-          arena.last_return_ts = cur_ts;
-        }
-      } else {
+      const bool is_miss = (MISS_MAGIC == cmeta->magic);
+      int64_t aid = get_itid() % arena_.size();
+      int64_t cur_ts = OB_TSC_TIMESTAMP.current_time();
+      bool is_returned = false;
+      x->reset();
+      if (ATOMIC_LOAD(&arena_[aid].free_num) < max_free_per_arena_) {
+        is_returned = push_(aid, cmeta, is_miss, cur_ts);
+      }
+      if (!is_returned && !is_miss) {
+        // the preallocated objects are never freed, arena_id keeps the arena
+        // they are preallocated for, which bounds the free objects of it
+        aid = cmeta->arena_id;
+        is_returned = push_(aid, cmeta, is_miss, cur_ts, true /*force*/);
+      }
+      if (!is_returned) {
         x->~T();
         ob_free(cmeta);
-        ObPoolArenaHead &arena = arena_[-aid];
-        int64_t cur_ts = OB_TSC_TIMESTAMP.current_time();
+        ObPoolArenaHead &arena = arena_[aid];
         { // Enter the critical area of the arena, the timestamp is obtained outside the lock, and minimize the length of the critical area
           ObLatchWGuard lock_guard(arena.lock, ObLatchIds::SERVER_OBJECT_POOL_ARENA_LOCK);
           arena.miss_return_cnt++;
@@ -280,6 +288,7 @@ private:
     buf_ = NULL;
     int ret = OB_SUCCESS;
     cnt_per_arena_ = lib::is_mini_mode() ? 16 : 128;
+    max_free_per_arena_ = 2 * cnt_per_arena_;
     int64_t s = (sizeof(T) + sizeof(Meta)); // Each cached object header has a Meta field to store necessary information and linked list pointers
     item_size_ = upper_align(s, CACHE_ALIGN_SIZE); // Align according to the cache line to ensure that there will be no false sharing between objects
     if (OB_FAIL(ObCacheLineSegregatedArrayBase::get_instance().alloc_array(arena_))) {
@@ -294,7 +303,7 @@ private:
           Meta *cmeta = reinterpret_cast<Meta*>(p);
           cmeta->next = pmeta;
           cmeta->arena_id = i;
-          cmeta->magic = 0xFEDCFEDC01240124;
+          cmeta->magic = POOL_MAGIC;
           pmeta = cmeta;
           new (p + sizeof(Meta)) T();
           p += item_size_;
@@ -319,6 +328,8 @@ private:
   }
 
 private:
+  static const int64_t POOL_MAGIC = static_cast<int64_t>(0xFEDCFEDC01240124);
+  static const int64_t MISS_MAGIC = static_cast<int64_t>(0xFEDCFEDC01230123);
   struct Meta
   {
     Meta * next;
@@ -326,8 +337,32 @@ private:
     int64_t magic;
     char padding__[8];
   };
+  bool push_(const int64_t aid, Meta *cmeta, const bool is_miss, const int64_t cur_ts, const bool force = false) {
+    bool is_returned = false;
+    ObPoolArenaHead &arena = arena_[aid];
+    { // Enter the critical area of the arena, the timestamp is obtained outside the lock, and minimize the length of the critical area
+      ObLatchWGuard lock_guard(arena.lock, ObLatchIds::SERVER_OBJECT_POOL_ARENA_LOCK);
+      if (force || arena.free_num < max_free_per_arena_) {
+        cmeta->next = static_cast<Meta*>(arena.next);
+        arena.next = static_cast<void*>(cmeta);
+        arena.free_num++;
+        if (is_miss) {
+          arena.miss_return_cnt++;
+          arena.last_miss_return_ts = cur_ts;
+        } else {
+          arena.return_cnt++;
+          arena.last_return_ts = cur_ts;
+        }
+        is_returned = true;
+      }
+    }
+    return is_returned;
+  }
+
+private:
   ObPoolArenaArray arena_;
   int64_t cnt_per_arena_;
+  int64_t max_free_per_arena_;
   int64_t item_size_;
   void *buf_;
 };
@@ -63,6 +63,7 @@ enum ObDedupTaskType
   T_CHECK_PG_RECOVERY_FINISHED = 31,
   T_UPDATE_FILE_RECOVERY_STATUS = 32,
   T_UPDATE_FILE_RECOVERY_STATUS_V2 = 33,
+  T_COMPACTION_COLUMN_STAT = 34,
 };
 
 class ObDedupQueue;
@@ -332,6 +332,11 @@ STAT_EVENT_ADD_DEF(INDEX_BLOCK_CACHE_HIT, "index micro block cache hit", ObStatC
 STAT_EVENT_ADD_DEF(BLOCKSCAN_BLOCK_CNT, "blockscaned data micro block count", ObStatClassIds::STORAGE, "blockscaned data micro block count", 60088, true, true)
 STAT_EVENT_ADD_DEF(BLOCKSCAN_ROW_CNT, "blockscaned row count", ObStatClassIds::STORAGE, "blockscaned row count", 60089, true, true)
 STAT_EVENT_ADD_DEF(PUSHDOWN_STORAGE_FILTER_ROW_CNT, "storage filtered row count", ObStatClassIds::STORAGE, "storage filter row count", 60090, true, true)
+STAT_EVENT_ADD_DEF(MEMSTORE_ROW_COMPACTION_TRIM_COUNT, "memstore row compaction trim count", ObStatClassIds::STORAGE, "memstore row compaction trim count", 60091, true, true)
+STAT_EVENT_ADD_DEF(TX_DATA_MEMTABLE_HIT_COUNT, "tx data memtable hit count", ObStatClassIds::STORAGE, "tx data memtable hit count", 60092, true, true)
+STAT_EVENT_ADD_DEF(TX_DATA_LOOKUP_CACHE_HIT_COUNT, "tx data lookup cache hit count", ObStatClassIds::STORAGE, "tx data lookup cache hit count", 60093, true, true)
+STAT_EVENT_ADD_DEF(TX_DATA_LOOKUP_CACHE_MISS_COUNT, "tx data lookup cache miss count", ObStatClassIds::STORAGE, "tx data lookup cache miss count", 60094, true, true)
+STAT_EVENT_ADD_DEF(TX_DATA_SSTABLE_READ_COUNT, "tx data sstable read count", ObStatClassIds::STORAGE, "tx data sstable read count", 60095, true, true)
 
 // backup & restore
 STAT_EVENT_ADD_DEF(BACKUP_IO_READ_COUNT, "backup io read count", ObStatClassIds::STORAGE, "backup io read count", 69000, true, true)
@@ -628,6 +628,7 @@ PCODE_DEF(OB_EXECUTE_IO_BENCHMARK, 0x73F)
 PCODE_DEF(OB_GET_LS_SYNC_SCN, 0x740)
 PCODE_DEF(OB_FLASHBACK_CLOG, 0x741)
 PCODE_DEF(OB_DUMP_SINGLE_TX_DATA, 0x742)
+PCODE_DEF(OB_DUMP_IO_LATENCY_HISTOGRAM, 0x743)
 
 // BatchRpc
 PCODE_DEF(OB_BATCH, 0x750)
@@ -0,0 +1,132 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#define private public
+#include "lib/objectpool/ob_server_object_pool.h"
+
+namespace oceanbase
+{
+namespace common
+{
+
+struct TestPoolObj
+{
+  TestPoolObj() : value_(0) {}
+  void reset() { value_ = 0; }
+  int64_t value_;
+};
+
+typedef ObServerObjectPool<TestPoolObj> TestPool;
+
+int64_t get_free_num(TestPool &pool)
+{
+  int64_t free_num = 0;
+  for (int64_t i = 0; i < pool.arena_.size(); i++) {
+    free_num += pool.arena_[i].free_num;
+  }
+  return free_num;
+}
+
+// The objects borrowed by one thread are returned by another one, the returned
+// objects stay in the arena of the returning thread and are reused by it, and
+// no arena keeps more objects than its limit.
+TEST(TestServerObjectPool, cross_thread_return)
+{
+  TestPool &pool = TestPool::get_instance();
+  const int64_t total_cnt = pool.arena_.size() * pool.cnt_per_arena_;
+  const int64_t borrow_cnt = 4 * pool.max_free_per_arena_;
+  ASSERT_EQ(total_cnt, get_free_num(pool));
+
+  std::vector<TestPoolObj *> objs;
+  std::thread borrower([&]() {
+    for (int64_t i = 0; i < borrow_cnt; i++) {
+      TestPoolObj *obj = sop_borrow(TestPoolObj);
+      ASSERT_TRUE(NULL != obj);
+      ASSERT_EQ(0, obj->value_);
+      obj->value_ = i + 1;
+      objs.push_back(obj);
+    }
+  });
+  borrower.join();
+  ASSERT_EQ(total_cnt - pool.cnt_per_arena_, get_free_num(pool));
+
+  std::thread returner([&]() {
+    const int64_t aid = get_itid() % pool.arena_.size();
+    const int64_t free_num = pool.arena_[aid].free_num;
+    for (int64_t i = 0; i < borrow_cnt; i++) {
+      sop_return(TestPoolObj, objs[i]);
+      ASSERT_GE(pool.max_free_per_arena_ + pool.cnt_per_arena_, pool.arena_[aid].free_num);
+    }
+    ASSERT_LE(free_num, pool.arena_[aid].free_num);
+    // the returned objects are borrowed from the local arena
+    const int64_t miss_cnt = pool.arena_[aid].miss_cnt;
+    for (int64_t i = 0; i < pool.cnt_per_arena_; i++) {
+      TestPoolObj *obj = sop_borrow(TestPoolObj);
+      ASSERT_EQ(0, obj->value_);
+      objs[i] = obj;
+    }
+    ASSERT_EQ(miss_cnt, pool.arena_[aid].miss_cnt);
+    for (int64_t i = 0; i < pool.cnt_per_arena_; i++) {
+      sop_return(TestPoolObj, objs[i]);
+    }
+  });
+  returner.join();
+
+  // all the preallocated objects are back, the extra ones are freed except
+  // the ones cached within the limit
+  ASSERT_LE(total_cnt, get_free_num(pool));
+  for (int64_t i = 0; i < pool.arena_.size(); i++) {
+    ASSERT_GE(pool.max_free_per_arena_ + pool.cnt_per_arena_, pool.arena_[i].free_num);
+  }
+}
+
+TEST(TestServerObjectPool, concurrent)
+{
+  TestPool &pool = TestPool::get_instance();
+  const int64_t thread_cnt = 8;
+  const int64_t loop_cnt = 100000;
+  std::vector<std::thread> threads;
+  for (int64_t i = 0; i < thread_cnt; i++) {
+    threads.push_back(std::thread([&]() {
+      TestPoolObj *objs[16];
+      for (int64_t j = 0; j < loop_cnt; j++) {
+        const int64_t cnt = j % 16 + 1;
+        for (int64_t k = 0; k < cnt; k++) {
+          objs[k] = sop_borrow(TestPoolObj);
+          EXPECT_EQ(0, objs[k]->value_);
+          objs[k]->value_ = j;
+        }
+        for (int64_t k = 0; k < cnt; k++) {
+          sop_return(TestPoolObj, objs[k]);
+        }
+      }
+    }));
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  for (int64_t i = 0; i < pool.arena_.size(); i++) {
+    ASSERT_GE(pool.max_free_per_arena_ + pool.cnt_per_arena_, pool.arena_[i].free_num);
+  }
+}
+
+}  // namespace common
+}  // namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
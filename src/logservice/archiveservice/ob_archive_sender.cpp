@@ -39,6 +39,7 @@
 #include "ob_archive_io.h"           // ObArchiveIO
 #include "share/backup/ob_backup_path.h"   // ObBackupPath
 #include "share/backup/ob_archive_path.h"   // ObArchivePathUtil
+#include "observer/omt/ob_tenant_config_mgr.h"  // ObTenantConfigGuard
 
 namespace oceanbase
 {
@@ -53,7 +54,9 @@ ObArchiveSender::ObArchiveSender() :
   persist_mgr_(NULL),
   round_mgr_(NULL),
   task_queue_(),
-  send_cond_()
+  send_cond_(),
+  active_thread_num_(1),
+  busy_thread_num_(0)
 {
 }
 
@@ -86,6 +89,8 @@ int ObArchiveSender::init(const uint64_t tenant_id,
     ARCHIVE_LOG(WARN, "task queue init failed", K(ret));
   } else {
     tenant_id_ = tenant_id;
+    active_thread_num_ = 1;
+    busy_thread_num_ = 0;
     inited_ = true;
   }
   return ret;
@@ -185,6 +190,34 @@ int64_t ObArchiveSender::get_send_task_status_count() const
   return task_queue_.size();
 }
 
+// 单个日志流的归档数据由一个线程串行发送, 因此发送并发度取决于等待发送以及正在发送的日志流个数
+// 线程数按需增加, 不再需要的线程空闲等待, 避免回收线程阻塞调用者
+void ObArchiveSender::adjust_thread_num()
+{
+  int ret = OB_SUCCESS;
+  int64_t max_thread_num = 1;
+  {
+    omt::ObTenantConfigGuard tenant_config(TENANT_CONF(tenant_id_));
+    if (tenant_config.is_valid()) {
+      max_thread_num = std::min(MAX_SENDER_THREAD_NUM,
+          std::max(1L, static_cast<int64_t>(tenant_config->_log_archive_sender_thread_num)));
+    }
+  }
+  const int64_t backlog = task_queue_.size() + ATOMIC_LOAD(&busy_thread_num_);
+  const int64_t target_thread_num = std::min(max_thread_num, std::max(1L, backlog));
+  const int64_t active_thread_num = ATOMIC_LOAD(&active_thread_num_);
+  if (OB_UNLIKELY(! inited_) || has_set_stop()) {
+  } else if (target_thread_num == active_thread_num) {
+  } else if (target_thread_num > get_thread_count()
+      && OB_FAIL(set_thread_count(target_thread_num))) {
+    ARCHIVE_LOG(WARN, "set sender thread count failed", K(ret), K(target_thread_num), K(backlog));
+  } else {
+    ATOMIC_STORE(&active_thread_num_, target_thread_num);
+    ARCHIVE_LOG(INFO, "adjust sender thread num", K_(tenant_id), K(active_thread_num),
+        K(target_thread_num), K(backlog), "thread_count", get_thread_count());
+  }
+}
+
 int ObArchiveSender::submit_send_task_(ObArchiveSendTask *task)
 {
   int ret = OB_SUCCESS;
@@ -212,7 +245,11 @@ void ObArchiveSender::run1()
     ARCHIVE_LOG(ERROR, "archive sender not init");
   } else {
     while (! has_set_stop()) {
-      do_thread_task_();
+      if (static_cast<int64_t>(get_thread_idx()) >= ATOMIC_LOAD(&active_thread_num_)) {
+        ob_usleep(IDLE_THREAD_WAIT_INTERVAL);
+      } else {
+        do_thread_task_();
+      }
     }
   }
 }
@@ -229,9 +266,11 @@ void ObArchiveSender::do_thread_task_()
     ret = OB_ERR_UNEXPECTED;
     ARCHIVE_LOG(ERROR, "data is NULL", K(ret), K(data));
   } else {
+    ATOMIC_INC(&busy_thread_num_);
     if (OB_FAIL(handle_task_list(data))) {
       ARCHIVE_LOG(WARN, "handle task list fail", K(ret));
     }
+    ATOMIC_DEC(&busy_thread_num_);
   }
 }
 
@@ -51,6 +51,8 @@ using oceanbase::share::ObLSID;
 class ObArchiveSender : public share::ObThreadPool, public ObArchiveWorker
 {
   static const int64_t MAX_SEND_NUM = 10;
+  static const int64_t MAX_SENDER_THREAD_NUM = 32;
+  static const int64_t IDLE_THREAD_WAIT_INTERVAL = 100 * 1000L;
 public:
   ObArchiveSender();
   virtual ~ObArchiveSender();
@@ -69,6 +71,8 @@ public:
   int submit_send_task(ObArchiveSendTask *task);
   int push_task_status(ObArchiveTaskStatus *task_status);
   int64_t get_send_task_status_count() const;
+  // 按照待发送日志流个数调整发送线程数, 线程只增不减, 超出部分空闲等待
+  void adjust_thread_num();
 
 private:
   enum DestSendOperator
@@ -178,6 +182,8 @@ private:
 
   common::ObLightyQueue task_queue_;            // 存放PG ObArchiveSendTaskStatus的queue
   common::ObCond        send_cond_;
+  int64_t               active_thread_num_;     // 可消费task status的线程数
+  int64_t               busy_thread_num_;       // 正在处理task status的线程数
 };
 
 } // namespace archive
@@ -214,6 +214,7 @@ void ObArchiveService::do_thread_task_()
   } else {
     do_check_switch_archive_();
     check_and_set_archive_stop_();
+    sender_.adjust_thread_num();
     print_archive_status_();
     persist_mgr_.persist_and_load();
   }
@@ -362,7 +362,12 @@ int ObLSArchiveTask::print_self()
 {
   int ret = OB_SUCCESS;
   RLockGuard guard(rwlock_);
-  ARCHIVE_LOG(INFO, "print ls archive task", K_(id), K_(tenant_id), K_(station), K_(round_start_ts), K_(dest));
+  // 归档延迟, 当前时间与已归档日志最大log ts的差值, 单位us
+  const int64_t archive_ts = dest_.max_archived_info_.get_log_ts();
+  const int64_t archive_lag_us = archive_ts > 0 ?
+    common::ObTimeUtility::current_time() - archive_ts / 1000L : -1;
+  ARCHIVE_LOG(INFO, "print ls archive task", K_(id), K_(tenant_id), K_(station), K_(round_start_ts),
+      K(archive_lag_us), K_(dest));
   return ret;
 }
 
@@ -120,7 +120,11 @@ void ObLogRestoreHandler::switch_role(const common::ObRole &role, const int64_t
   if (! is_strong_leader(role_)) {
     ObResSrcAlloctor::free(parent_);
     parent_ = NULL;
+    // the issued task may be still running, keep it issued until it retires as a stale task,
+    // so that a new task of the ls is not scheduled before the stale one is finished
+    const bool issued = context_.issued_;
     context_.reset();
+    context_.issued_ = issued;
   }
 }
 
@@ -267,7 +271,8 @@ int ObLogRestoreHandler::add_source(const common::ObAddr &addr, const int64_t en
   return ret;
 }
 
-int ObLogRestoreHandler::raw_write(const palf::LSN &lsn,
+int ObLogRestoreHandler::raw_write(const int64_t proposal_id,
+                                   const palf::LSN &lsn,
                                    const char *buf,
                                    const int64_t buf_size)
 {
@@ -286,6 +291,9 @@ int ObLogRestoreHandler::raw_write(const palf::LSN &lsn,
         ret = OB_IN_STOP_STATE;
       } else if (LEADER != role_) {
         ret = OB_NOT_MASTER;
+      } else if (proposal_id != proposal_id_) {
+        // the task is scheduled by the former leader, its logs should not be written
+        ret = OB_NOT_MASTER;
       } else if (OB_UNLIKELY(!lsn.is_valid() || NULL == buf || 0 >= buf_size)) {
         ret = OB_INVALID_ARGUMENT;
       } else {
@@ -362,6 +370,7 @@ int ObLogRestoreHandler::update_fetch_log_progress(const int64_t id,
     ret = OB_NOT_INIT;
   } else if (! is_strong_leader(role_)) {
     is_stale = true;
+    context_.issued_ = false;
     CLOG_LOG(INFO, "ls not leader, stale task, just skip it", K(id), K(role_));
   } else if (OB_UNLIKELY(id != id_ || proposal_id != proposal_id_)) {
     is_stale = true;
@@ -84,10 +84,12 @@ public:
   // @brief As restore handler maybe destroyed, log source should be copied out
   void deep_copy_source(ObRemoteSourceGuard &guard);
   // @brief raw write logs to the pointed offset of palf
+  // @param[in] const int64_t, the proposal_id of the fetch log task
   // @param[in] const palf::LSN, the pointed offset to be writen of the data buffer
   // @param[in] const char *, the data buffer
   // @param[in], const int64_t, the size of the data buffer
-  int raw_write(const palf::LSN &lsn, const char *buf, const int64_t buf_size);
+  // @retval OB_NOT_MASTER    not leader, or the task is scheduled with a stale proposal_id
+  int raw_write(const int64_t proposal_id, const palf::LSN &lsn, const char *buf, const int64_t buf_size);
   // @brief check if need update fetch log source,
   // ONLY return true if role of RestoreHandler is LEADER
   bool need_update_source() const;
@@ -147,6 +147,8 @@ void ObLogRestoreService::run1()
 
 void ObLogRestoreService::do_thread_task_()
 {
+  fetch_log_worker_.update_thread_num();
+
   update_upstream_();
 
   schedule_fetch_log_();
@@ -32,6 +32,7 @@
 #include "ob_remote_log_iterator.h"                     // ObRemoteLogIterator
 #include "ob_log_restore_handler.h"                     // ObLogRestoreHandler
 #include "storage/tx_storage/ob_ls_handle.h"            // ObLSHandle
+#include "observer/omt/ob_tenant_config_mgr.h"          // ObTenantConfigGuard
 
 namespace oceanbase
 {
@@ -62,6 +63,7 @@ ObRemoteFetchWorker::ObRemoteFetchWorker() :
   restore_service_(NULL),
   ls_svr_(NULL),
   task_queue_(),
+  active_thread_num_(1),
   cond_()
 {}
 
@@ -97,16 +99,21 @@ void ObRemoteFetchWorker::destroy()
   inited_ = false;
   stop();
   wait();
+  active_thread_num_ = 1;
   ls_svr_ = NULL;
 }
 
 int ObRemoteFetchWorker::start()
 {
   int ret = OB_SUCCESS;
+  const int64_t thread_num = get_config_thread_num_();
   ObThreadPool::set_run_wrapper(MTL_CTX());
   if (OB_UNLIKELY(! inited_)) {
     ret = OB_NOT_INIT;
     LOG_ERROR("ObRemoteFetchWorker not init", K(ret));
+  } else if (OB_FAIL(ObThreadPool::set_thread_count(thread_num))) {
+    LOG_WARN("ObRemoteFetchWorker set thread count failed", K(ret));
+  } else if (FALSE_IT(ATOMIC_STORE(&active_thread_num_, thread_num))) {
   } else if (OB_FAIL(ObThreadPool::start())) {
     LOG_WARN("ObRemoteFetchWorker start failed", K(ret));
   } else {
@@ -132,6 +139,36 @@ void ObRemoteFetchWorker::signal()
   cond_.signal();
 }
 
+// the thread count is not reduced, as it joins the stopped threads and blocks the caller
+// until their current tasks are finished, the threads no longer needed are idle instead
+void ObRemoteFetchWorker::update_thread_num()
+{
+  int ret = OB_SUCCESS;
+  const int64_t thread_num = get_config_thread_num_();
+  const int64_t active_thread_num = ATOMIC_LOAD(&active_thread_num_);
+  if (OB_UNLIKELY(! inited_) || has_set_stop()) {
+  } else if (thread_num == active_thread_num) {
+  } else if (thread_num > get_thread_count()
+      && OB_FAIL(ObThreadPool::set_thread_count(thread_num))) {
+    LOG_WARN("ObRemoteFetchWorker set thread count failed", K(ret), K(thread_num), K(active_thread_num));
+  } else {
+    ATOMIC_STORE(&active_thread_num_, thread_num);
+    LOG_INFO("ObRemoteFetchWorker update thread num succ", K_(tenant_id), K(thread_num),
+        K(active_thread_num), "thread_count", get_thread_count());
+  }
+}
+
+int64_t ObRemoteFetchWorker::get_config_thread_num_() const
+{
+  int64_t thread_num = 1;
+  omt::ObTenantConfigGuard tenant_config(TENANT_CONF(tenant_id_));
+  if (tenant_config.is_valid()) {
+    thread_num = std::min(MAX_FETCH_LOG_THREAD_NUM,
+        std::max(1L, static_cast<int64_t>(tenant_config->_log_restore_fetch_thread_num)));
+  }
+  return thread_num;
+}
+
 int ObRemoteFetchWorker::submit_fetch_log_task(ObFetchLogTask *task)
 {
   int ret = OB_SUCCESS;
@@ -160,21 +197,30 @@ void ObRemoteFetchWorker::run1()
     LOG_INFO("ObRemoteFetchWorker not init");
   } else {
     while (! has_set_stop()) {
-      int64_t begin_tstamp = ObTimeUtility::current_time();
-      do_thread_task_();
-      int64_t end_tstamp = ObTimeUtility::current_time();
-      int64_t wait_interval = THREAD_RUN_INTERVAL - (end_tstamp - begin_tstamp);
-      if (wait_interval > 0) {
-        cond_.timedwait(wait_interval);
+      if (static_cast<int64_t>(get_thread_idx()) >= ATOMIC_LOAD(&active_thread_num_)) {
+        ob_usleep(IDLE_THREAD_WAIT_INTERVAL);
+      } else {
+        bool has_progress = false;
+        int64_t begin_tstamp = ObTimeUtility::current_time();
+        do_thread_task_(has_progress);
+        int64_t end_tstamp = ObTimeUtility::current_time();
+        int64_t wait_interval = THREAD_RUN_INTERVAL - (end_tstamp - begin_tstamp);
+        // go on with the next task without waiting only if the log is fetched forward, so the
+        // fetching is not limited by the interval, while the task waiting for the source, the
+        // upper limit or the replay is not popped and pushed back in a busy loop
+        if (! has_progress && wait_interval > 0) {
+          cond_.timedwait(wait_interval);
+        }
       }
     }
   }
 }
 
-void ObRemoteFetchWorker::do_thread_task_()
+void ObRemoteFetchWorker::do_thread_task_(bool &has_progress)
 {
   int ret = OB_SUCCESS;
   void *data = NULL;
+  has_progress = false;
   if (OB_FAIL(task_queue_.pop(data))) {
     if (OB_ENTRY_NOT_EXIST == ret) {
       if (REACH_TIME_INTERVAL(10 * 1000 * 1000L)) {
@@ -190,9 +236,12 @@ void ObRemoteFetchWorker::do_thread_task_()
   } else {
     ObFetchLogTask *task = static_cast<ObFetchLogTask *>(data);
     ObLSID id = task->id_;
+    const LSN pre_lsn = task->cur_lsn_;
     if (OB_FAIL(handle(*task))) {
       LOG_WARN("handle task failed", K(ret), KPC(task));
     }
+    // the task may be freed or handled by other threads after it is retired
+    has_progress = task->cur_lsn_ > pre_lsn;
 
     // only fatal error report fail, retry with others
     if (is_fatal_error_(ret)) {
@@ -270,7 +319,7 @@ int ObRemoteFetchWorker::handle(ObFetchLogTask &task)
     LOG_WARN("ObRemoteLogIterator init failed", K(ret), K_(tenant_id), K(task));
   } else if (OB_FAIL(get_upper_limit_ts_(task.id_, upper_limit_ts))) {
     LOG_WARN("get upper_limit_ts failed", K(ret), K(task));
-  } else if (OB_FAIL(submit_entries_(task.id_, upper_limit_ts, iter, max_submit_log_ts))) {
+  } else if (OB_FAIL(submit_entries_(task.id_, task.proposal_id_, upper_limit_ts, iter, max_submit_log_ts))) {
     LOG_WARN("submit entries failed", K(ret), K(task), K(iter));
   } else if (OB_FAIL(iter.get_cur_lsn_ts(end_lsn, max_fetch_log_ts))) {
     // TODO iterator可能是没有数据的, 此处暂不处理, 后续不需要cut日志, 后续处理逻辑会放到restore_handler, 此处不处理该异常
@@ -319,6 +368,7 @@ int ObRemoteFetchWorker::get_upper_limit_ts_(const ObLSID &id, int64_t &ts)
 }
 
 int ObRemoteFetchWorker::submit_entries_(const ObLSID &id,
+    const int64_t proposal_id,
     const int64_t upper_limit_ts,
     ObRemoteLogIterator &iter,
     int64_t &max_submit_log_ts)
@@ -349,7 +399,7 @@ int ObRemoteFetchWorker::submit_entries_(const ObLSID &id,
       } else if (origin_entry_size != entry.get_data_len()
           && OB_FAIL(entry.get_header().serialize(buf, size, pos))) {
         LOG_WARN("serialize header failed", K(ret), K(entry));
-      } else if (OB_FAIL(submit_log_(id, lsn, buf, entry.get_serialize_size()))) {
+      } else if (OB_FAIL(submit_log_(id, proposal_id, lsn, buf, entry.get_serialize_size()))) {
         LOG_WARN("submit log failed", K(ret), K(iter), K(buf), K(entry), K(lsn));
       } else {
         max_submit_log_ts = entry.get_header().get_max_timestamp();
@@ -366,17 +416,18 @@ int ObRemoteFetchWorker::submit_entries_(const ObLSID &id,
 }
 
 int ObRemoteFetchWorker::submit_log_(const ObLSID &id,
+    const int64_t proposal_id,
     const LSN &lsn,
     char *buf,
     const int64_t buf_size)
 {
   int ret = OB_SUCCESS;
   GET_RESTORE_HANDLER_CTX(id) {
-    if (OB_FAIL(restore_handler->raw_write(lsn, buf, buf_size))) {
+    if (OB_FAIL(restore_handler->raw_write(proposal_id, lsn, buf, buf_size))) {
       if (OB_ERR_OUT_OF_LOWER_BOUND == ret) {
         ret = OB_SUCCESS;
       } else {
-        LOG_WARN("raw write failed", K(ret), K(id), K(lsn), K(buf), K(buf_size));
+        LOG_WARN("raw write failed", K(ret), K(id), K(proposal_id), K(lsn), K(buf), K(buf_size));
       }
     }
   }
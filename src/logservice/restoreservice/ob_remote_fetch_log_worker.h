@@ -43,6 +43,8 @@ using oceanbase::palf::LSN;
 // Remote fetch log worker
 class ObRemoteFetchWorker : public share::ObThreadPool
 {
+  static const int64_t MAX_FETCH_LOG_THREAD_NUM = 32;
+  static const int64_t IDLE_THREAD_WAIT_INTERVAL = 100 * 1000L;
 public:
   ObRemoteFetchWorker();
   ~ObRemoteFetchWorker();
@@ -53,6 +55,10 @@ public:
   void stop();
   void wait();
   void signal();
+  // the fetch log tasks of different log streams are handled in parallel,
+  // the active thread count follows the tenant config _log_restore_fetch_thread_num,
+  // threads are only added, the ones no longer needed are idle
+  void update_thread_num();
 public:
   // submit fetch log task
   //
@@ -62,13 +68,16 @@ public:
 
 private:
   void run1();
-  void do_thread_task_();
+  // has_progress is true if the log of the task is fetched forward
+  void do_thread_task_(bool &has_progress);
+  int64_t get_config_thread_num_() const;
   int handle(ObFetchLogTask &task);
   int get_upper_limit_ts_(const ObLSID &id, int64_t &ts);
-  int submit_entries_(const ObLSID &id, const int64_t upper_limit_ts, ObRemoteLogIterator &iter, int64_t &max_submit_log_ts);
+  int submit_entries_(const ObLSID &id, const int64_t proposal_id, const int64_t upper_limit_ts,
+      ObRemoteLogIterator &iter, int64_t &max_submit_log_ts);
   int cut_group_log_(const ObLSID &id, const LSN &lsn, const int64_t cut_ts, palf::LogGroupEntry &entry);
   int get_pre_accum_checksum_(const ObLSID &id, const LSN &lsn, int64_t &pre_accum_checksum);
-  int submit_log_(const ObLSID &id, const LSN &lsn, char *buf, const int64_t buf_size);
+  int submit_log_(const ObLSID &id, const int64_t proposal_id, const LSN &lsn, char *buf, const int64_t buf_size);
   void mark_if_to_end_(ObFetchLogTask &task, const int64_t upper_limit_ts, const int64_t timestamp);
   int try_retire_(ObFetchLogTask *&task);
   void try_update_location_info_(const ObFetchLogTask &task, ObRemoteLogIterator &iter);
@@ -82,6 +91,7 @@ private:
   ObLogRestoreService *restore_service_;
   storage::ObLSService *ls_svr_;
   common::ObLightyQueue task_queue_;
+  int64_t active_thread_num_;     // the threads with smaller index handle the tasks
 
   common::ObCond cond_;
 private:
@@ -2089,6 +2089,9 @@ typedef enum ObItemType
   T_ALL_COLUMN_GROUP,
   T_SINGLE_COLUMN_GROUP,
   T_NORMAL_COLUMN_GROUP,
+
+  // direct load hint
+  T_APPEND,
   
   T_MAX //Attention: add a new type before T_MAX
 } ObItemType;
@@ -20,6 +20,8 @@
 #include "observer/mysql/ob_mysql_result_set.h"
 #include "observer/ob_server_struct.h"
 #include "observer/mysql/obmp_query.h"
+#include "observer/omt/ob_tenant_config_mgr.h"
+#include "storage/memtable/ob_lock_wait_mgr.h"
 
 namespace oceanbase
 {
@@ -431,6 +433,48 @@ public:
 };
 
 
+// The row conflicted on is a hotspot: it has accumulated too many versions in
+// the memtable, which means the writers are serialized on its row lock and each
+// of them holds the lock until its commit log is persisted. Let the autocommit
+// statements of the session release the row locks early for a while, so that
+// they unlock the row once the commit log is submitted and the queued writers'
+// commit logs get persisted by palf in the same group.
+// The decision is kept in the session and decays by itself, the shared plan is
+// never touched.
+// NB: the early lock release is still guarded by tenant's enable_early_lock_release.
+class ObHotspotRowElrRetryPolicy : public ObRetryPolicy
+{
+public:
+  ObHotspotRowElrRetryPolicy() = default;
+  ~ObHotspotRowElrRetryPolicy() = default;
+  virtual void test(ObRetryParam &v) const override
+  {
+    rpc::ObLockWaitNode *node = memtable::ObLockWaitMgr::get_thread_node();
+    if (RETRY_TYPE_NONE == v.retry_type_
+        || OB_ISNULL(node)
+        || !node->need_wait()) {
+      // do nothing
+    } else {
+      const bool is_autocommit_stmt = !v.session_.has_explicit_start_trans()
+                                      && v.session_.get_local_autocommit();
+      int64_t threshold = 0;
+      omt::ObTenantConfigGuard tenant_config(TENANT_CONF(v.session_.get_effective_tenant_id()));
+      if (tenant_config.is_valid()) {
+        threshold = tenant_config->_hotspot_row_elr_threshold;
+      }
+      if (ObQueryRetryCtrl::is_hotspot_row_conflict(is_autocommit_stmt,
+                                                    node->total_update_cnt_,
+                                                    threshold)) {
+        v.session_.set_hotspot_row_elr_expire_ts(ObTimeUtility::current_time()
+                                                 + ObQueryRetryCtrl::HOTSPOT_ROW_ELR_DURATION);
+        LOG_DEBUG("release row locks early for hotspot row", K(threshold),
+                  "total_update_cnt", node->total_update_cnt_,
+                  "tablet_id", node->tablet_id_, K(v));
+      }
+    }
+  }
+};
+
 class ObTrxSetViolationRetryPolicy : public ObRetryPolicy
 {
 public:
@@ -626,7 +670,8 @@ void ObQueryRetryCtrl::try_lock_row_conflict_proc(ObRetryParam &v)
 {
   ObRetryObject retry_obj(v);
   ObLockRowConflictRetryPolicy lock_conflict;
-  retry_obj.test(lock_conflict);
+  ObHotspotRowElrRetryPolicy hotspot_elr;
+  retry_obj.test(lock_conflict).test(hotspot_elr);
 }
 
 
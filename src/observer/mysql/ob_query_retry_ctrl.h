@@ -168,6 +168,18 @@ public:
   // must ensure calling destroy after all threads exit
   static void destroy();
 
+  // how long the autocommit statements of a session keep releasing row locks
+  // early after the last hotspot row conflict
+  static const int64_t HOTSPOT_ROW_ELR_DURATION = 10L * 1000L * 1000L; // 10s
+  // an autocommit statement blocked by a row with at least threshold versions
+  // in memtable is a writer of hotspot row, 0 threshold disables it
+  static bool is_hotspot_row_conflict(const bool is_autocommit_stmt,
+                                      const int64_t total_update_cnt,
+                                      const int64_t threshold)
+  {
+    return is_autocommit_stmt && threshold > 0 && total_update_cnt >= threshold;
+  }
+
   //本接口目前在ObMPQuery和SPI使用，SPI使用的时候必须本地重试直至超时，所以需要传入force_local_retry为true
   //force_local_retry为true时，不做try_packet_retry
   void test_and_save_retry_state(const ObGlobalContext &gctx,
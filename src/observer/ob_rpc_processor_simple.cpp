@@ -906,6 +906,33 @@ int ObDumpSingleTxDataP::process()
   return ret;
 }
 
+int ObDumpIOLatencyHistogramP::process()
+{
+  int ret = OB_SUCCESS;
+  ObArray<uint64_t> tenant_ids;
+  if (OB_INVALID_TENANT_ID != arg_.tenant_id_) {
+    if (OB_FAIL(tenant_ids.push_back(arg_.tenant_id_))) {
+      LOG_WARN("push back tenant id failed", K(ret), K(arg_));
+    }
+  } else if (OB_FAIL(OB_IO_MANAGER.get_tenant_ids(tenant_ids))) {
+    LOG_WARN("get tenant ids failed", K(ret));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < tenant_ids.count(); ++i) {
+    const uint64_t tenant_id = tenant_ids.at(i);
+    ObRefHolder<ObTenantIOManager> tenant_holder;
+    if (OB_FAIL(OB_IO_MANAGER.get_tenant_io_manager(tenant_id, tenant_holder))) {
+      LOG_WARN("get tenant io manager failed", K(ret), K(tenant_id));
+    } else {
+      tenant_holder.get_ptr()->get_io_latency_stat().print_histograms(tenant_id);
+      if (arg_.need_reset_) {
+        tenant_holder.get_ptr()->reset_io_latency_stat();
+      }
+    }
+  }
+  LOG_INFO("finish dump io latency histogram", K(ret), K(arg_));
+  return ret;
+}
+
 int ObHaltPrewarmP::process()
 {
   int ret = OB_NOT_SUPPORTED;
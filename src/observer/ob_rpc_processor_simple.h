@@ -135,6 +135,7 @@ OB_DEFINE_PROCESSOR_S(Srv, OB_CLEAR_AUTOINC_CACHE, ObRpcClearAutoincCacheP);
 OB_DEFINE_PROCESSOR_OBADMIN(Srv, OB_DUMP_MEMTABLE, ObDumpMemtableP);
 OB_DEFINE_PROCESSOR_OBADMIN(Srv, OB_DUMP_TX_DATA_MEMTABLE, ObDumpTxDataMemtableP);
 OB_DEFINE_PROCESSOR_OBADMIN(Srv, OB_DUMP_SINGLE_TX_DATA, ObDumpSingleTxDataP);
+OB_DEFINE_PROCESSOR_OBADMIN(Srv, OB_DUMP_IO_LATENCY_HISTOGRAM, ObDumpIOLatencyHistogramP);
 OB_DEFINE_PROCESSOR_OBADMIN(Srv, OB_FORCE_PURGE_MEMTABLE, ObHaltPrewarmP);
 OB_DEFINE_PROCESSOR_S(Srv, OB_FORCE_PURGE_MEMTABLE_ASYNC, ObHaltPrewarmAsyncP);
 OB_DEFINE_PROCESSOR_OBADMIN(Srv, OB_FORCE_SWITCH_ILOG_FILE, ObForceSwitchILogFileP);
@@ -78,6 +78,7 @@ void oceanbase::observer::init_srv_xlator_for_partition(ObSrvRpcXlator *xlator)
   RPC_PROCESSOR(ObDumpMemtableP, gctx_);
   RPC_PROCESSOR(ObDumpTxDataMemtableP, gctx_);
   RPC_PROCESSOR(ObDumpSingleTxDataP, gctx_);
+  RPC_PROCESSOR(ObDumpIOLatencyHistogramP, gctx_);
   RPC_PROCESSOR(ObForceSwitchILogFileP, gctx_);
   RPC_PROCESSOR(ObForceSetAllAsSingleReplicaP, gctx_);
   // RPC_PROCESSOR(ObSplitDestPartitionRequestP, gctx_.par_ser_);
@@ -46,6 +46,11 @@ int ObHColumnDescriptor::from_string(const common::ObString &str)
               if (NULL != ttl_val && ttl_val->get_type() == json::JT_NUMBER) {
                 time_to_live_ = static_cast<int32_t>(ttl_val->get_number());
               }
+            } else if (elem->name_.case_compare("MaxVersions") == 0) {
+              json::Value *versions_val = elem->value_;
+              if (NULL != versions_val && versions_val->get_type() == json::JT_NUMBER) {
+                max_versions_ = static_cast<int32_t>(versions_val->get_number());
+              }
             }
           }  // end foreach
         }
@@ -85,6 +90,14 @@ void ObHTableColumnTracker::set_ttl(int32_t ttl_value)
   }
 }
 
+void ObHTableColumnTracker::set_max_versions(int32_t max_versions)
+{
+  // the versions asked by the query are capped by the column family
+  if (max_versions > 0 && max_versions < max_versions_) {
+    max_versions_ = max_versions;
+  }
+}
+
 bool ObHTableColumnTracker::is_done(int64_t timestamp) const
 {
   return min_versions_ <= 0 && is_expired(timestamp);
@@ -623,6 +636,7 @@ ObHTableRowIterator::ObHTableRowIterator(const ObTableQuery &query)
      max_result_size_(query.get_max_result_size()),
      batch_size_(query.get_batch()),
      time_to_live_(0),
+     max_versions_(0),
      curr_cell_(),
      allocator_(ObModIds::TABLE_PROC),
      column_tracker_(NULL),
@@ -682,6 +696,9 @@ int ObHTableRowIterator::add_same_kq_to_res(ObIArray<ObNewRow> &same_kq_cells, O
   int ret = OB_SUCCESS;
   int N = same_kq_cells.count();
   int M = htable_filter_.get_max_versions();
+  if (max_versions_ > 0 && max_versions_ < M) {
+    M = max_versions_;
+  }
   int end_idx = (N - M) > 0 ? (N - M) : 0;
   for (int i = N - 1; OB_SUCC(ret) && i >= end_idx; i--) {
     ObNewRow &tmp = same_kq_cells.at(i);
@@ -748,8 +765,13 @@ int ObHTableRowIterator::get_next_result(ObTableQueryResult *&out_result)
     }
     if (OB_FAIL(column_tracker_->init(htable_filter_, scan_order_))) {
       LOG_WARN("failed to init column tracker", K(ret));
-    } else if (time_to_live_ > 0) {
-      column_tracker_->set_ttl(time_to_live_);
+    } else {
+      if (time_to_live_ > 0) {
+        column_tracker_->set_ttl(time_to_live_);
+      }
+      if (max_versions_ > 0) {
+        column_tracker_->set_max_versions(max_versions_);
+      }
     }
   }
   if (OB_SUCC(ret) && NULL == matcher_) {
@@ -30,14 +30,18 @@ class ObHColumnDescriptor final
 {
 public:
   ObHColumnDescriptor()
-      :time_to_live_(0)
+      :time_to_live_(0),
+       max_versions_(0)
   {}
   int from_string(const common::ObString &str);
 
   void set_time_to_live(int32_t v) { time_to_live_ = v; }
   int32_t get_time_to_live() const { return time_to_live_; }
+  void set_max_versions(int32_t v) { max_versions_ = v; }
+  int32_t get_max_versions() const { return max_versions_; }
 private:
   int32_t time_to_live_; // Time-to-live of cell contents, in seconds.
+  int32_t max_versions_; // Max versions of cell contents kept, also applied in major merge.
 };
 
 enum class ObHTableMatchCode
@@ -81,6 +85,7 @@ public:
   // Give the tracker a chance to declare it's done based on only the timestamp.
   bool is_done(int64_t timestamp) const;
   void set_ttl(int32_t ttl_value);
+  void set_max_versions(int32_t max_versions);
 protected:
   int32_t max_versions_;  // default: 1
   int32_t min_versions_;  // default: 0
@@ -189,6 +194,7 @@ public:
   bool has_more_result() const { return has_more_cells_; }
   void set_hfilter(table::hfilter::Filter *hfilter);
   void set_ttl(int32_t ttl_value);
+  void set_max_versions(int32_t max_versions) { max_versions_ = max_versions; }
   int add_same_kq_to_res(ObIArray<common::ObNewRow> &same_kq_cells, ObTableQueryResult *&out_result);
   ObIArray<common::ObNewRow> &get_same_kq_cells() { return same_kq_cells_; }
 private:
@@ -207,6 +213,7 @@ private:
   int64_t max_result_size_;
   int32_t batch_size_;
   int32_t time_to_live_; // Time-to-live of cell contents, in seconds.
+  int32_t max_versions_; // Max versions of the column family, 0 for unlimited.
 
   table::ObTableQueryResult one_hbase_row_;
   ObHTableCellEntity curr_cell_;
@@ -234,6 +241,7 @@ public:
   virtual bool has_more_result() const override { return row_iterator_.has_more_result(); }
   void set_scan_result(common::ObNewRowIterator *scan_result) { row_iterator_.set_scan_result(scan_result); }
   void set_ttl(int32_t ttl_value) { row_iterator_.set_ttl(ttl_value); }
+  void set_max_versions(int32_t max_versions) { row_iterator_.set_max_versions(max_versions); }
   // parse the filter string
   int parse_filter_string(common::ObArenaAllocator* allocator);
 private:
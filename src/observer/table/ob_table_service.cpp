@@ -2281,6 +2281,9 @@ int ObTableService::execute_query(ObTableServiceQueryCtx &ctx, const ObTableQuer
       if (p_hcolumn_desc->get_time_to_live() > 0) {
         ctx.htable_result_iterator_->set_ttl(p_hcolumn_desc->get_time_to_live());
       }
+      if (p_hcolumn_desc->get_max_versions() > 0) {
+        ctx.htable_result_iterator_->set_max_versions(p_hcolumn_desc->get_max_versions());
+      }
     } else {
       ctx.normal_result_iterator_->set_scan_result(ctx.scan_result_);
     }
@@ -466,6 +466,188 @@ int ObAllVirtualIOQuota::inner_get_next_row(common::ObNewRow *&row)
   return ret;
 }
 
+ObAllVirtualIOLatencyHistogram::HistogramInfo::HistogramInfo()
+  : tenant_id_(OB_INVALID_TENANT_ID),
+    module_(ObIOModule::MAX_MODULE),
+    mode_(ObIOMode::MAX_MODE),
+    phase_(ObIOLatencyStat::MAX_PHASE),
+    count_(0),
+    avg_us_(0),
+    p50_us_(0),
+    p90_us_(0),
+    p99_us_(0),
+    p999_us_(0),
+    max_us_(0)
+{
+
+}
+
+ObAllVirtualIOLatencyHistogram::HistogramInfo::~HistogramInfo()
+{
+
+}
+
+ObAllVirtualIOLatencyHistogram::ObAllVirtualIOLatencyHistogram()
+  : histogram_infos_(), histogram_pos_(0)
+{
+
+}
+
+ObAllVirtualIOLatencyHistogram::~ObAllVirtualIOLatencyHistogram()
+{
+
+}
+
+int ObAllVirtualIOLatencyHistogram::init(const common::ObAddr &addr)
+{
+  int ret = OB_SUCCESS;
+  ObArray<uint64_t> tenant_ids;
+  if (OB_FAIL(init_addr(addr))) {
+    LOG_WARN("init failed", K(ret), K(addr));
+  } else if (OB_FAIL(OB_IO_MANAGER.get_tenant_ids(tenant_ids))) {
+    LOG_WARN("get tenant id failed", K(ret));
+  } else {
+    for (int64_t i = 0; OB_SUCC(ret) && i < tenant_ids.count(); ++i) {
+      const uint64_t cur_tenant_id = tenant_ids.at(i);
+      ObRefHolder<ObTenantIOManager> tenant_holder;
+      if (OB_FAIL(OB_IO_MANAGER.get_tenant_io_manager(cur_tenant_id, tenant_holder))) {
+        if (OB_HASH_NOT_EXIST != ret) {
+          LOG_WARN("get tenant io manager failed", K(ret), K(cur_tenant_id));
+        } else {
+          ret = OB_TENANT_NOT_EXIST;
+          LOG_WARN("tenant not exist", K(ret), K(cur_tenant_id));
+        }
+      } else {
+        const ObIOLatencyStat &latency_stat = tenant_holder.get_ptr()->get_io_latency_stat();
+        for (int64_t m = 0; OB_SUCC(ret) && m < static_cast<int>(ObIOModule::MAX_MODULE); ++m) {
+          for (int64_t j = 0; OB_SUCC(ret) && j < static_cast<int>(ObIOMode::MAX_MODE); ++j) {
+            for (int64_t k = 0; OB_SUCC(ret) && k < ObIOLatencyStat::MAX_PHASE; ++k) {
+              const ObIOLatencyHistogram &histogram = latency_stat.get_histogram(
+                  static_cast<ObIOModule>(m), static_cast<ObIOMode>(j), static_cast<ObIOLatencyStat::Phase>(k));
+              const int64_t count = histogram.get_count();
+              if (count > 0) {
+                HistogramInfo item;
+                item.tenant_id_ = cur_tenant_id;
+                item.module_ = static_cast<ObIOModule>(m);
+                item.mode_ = static_cast<ObIOMode>(j);
+                item.phase_ = static_cast<ObIOLatencyStat::Phase>(k);
+                item.count_ = count;
+                item.avg_us_ = histogram.get_sum() / count;
+                item.p50_us_ = histogram.get_percentile(50);
+                item.p90_us_ = histogram.get_percentile(90);
+                item.p99_us_ = histogram.get_percentile(99);
+                item.p999_us_ = histogram.get_percentile(99.9);
+                item.max_us_ = histogram.get_max();
+                if (OB_FAIL(histogram_infos_.push_back(item))) {
+                  LOG_WARN("push back io latency histogram item failed", K(ret), K(item));
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+    if (OB_SUCC(ret)) {
+      is_inited_ = true;
+    }
+  }
+  return ret;
+}
+
+void ObAllVirtualIOLatencyHistogram::reset()
+{
+  ObAllVirtualIOStatusIterator::reset();
+  histogram_infos_.reset();
+  histogram_pos_ = 0;
+}
+
+int ObAllVirtualIOLatencyHistogram::inner_get_next_row(common::ObNewRow *&row)
+{
+  int ret = OB_SUCCESS;
+  row = nullptr;
+  ObObj *cells = cur_row_.cells_;
+  if (OB_UNLIKELY(!is_inited_ || nullptr == cells)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret), KP(cur_row_.cells_), K(is_inited_));
+  } else if (histogram_pos_ >= histogram_infos_.count()) {
+    row = nullptr;
+    ret = OB_ITER_END;
+  } else {
+    HistogramInfo &item = histogram_infos_.at(histogram_pos_);
+    for (int64_t i = 0; OB_SUCC(ret) && i < output_column_ids_.count(); ++i) {
+      const uint64_t column_id = output_column_ids_.at(i);
+      switch (column_id) {
+        case SVR_IP: {
+          cells[i].set_varchar(ip_buf_);
+          cells[i].set_collation_type(ObCharset::get_default_collation(ObCharset::get_default_charset()));
+          break;
+        }
+        case SVR_PORT: {
+          cells[i].set_int(addr_.get_port());
+          break;
+        }
+        case TENANT_ID: {
+          cells[i].set_int(item.tenant_id_);
+          break;
+        }
+        case MODULE: {
+          cells[i].set_varchar(get_io_module_name(item.module_));
+          cells[i].set_collation_type(ObCharset::get_default_collation(ObCharset::get_default_charset()));
+          break;
+        }
+        case MODE: {
+          cells[i].set_varchar(get_io_mode_string(item.mode_));
+          cells[i].set_collation_type(ObCharset::get_default_collation(ObCharset::get_default_charset()));
+          break;
+        }
+        case PHASE: {
+          cells[i].set_varchar(ObIOLatencyStat::get_phase_name(item.phase_));
+          cells[i].set_collation_type(ObCharset::get_default_collation(ObCharset::get_default_charset()));
+          break;
+        }
+        case COUNT: {
+          cells[i].set_int(item.count_);
+          break;
+        }
+        case AVG_US: {
+          cells[i].set_int(item.avg_us_);
+          break;
+        }
+        case P50_US: {
+          cells[i].set_int(item.p50_us_);
+          break;
+        }
+        case P90_US: {
+          cells[i].set_int(item.p90_us_);
+          break;
+        }
+        case P99_US: {
+          cells[i].set_int(item.p99_us_);
+          break;
+        }
+        case P999_US: {
+          cells[i].set_int(item.p999_us_);
+          break;
+        }
+        case MAX_US: {
+          cells[i].set_int(item.max_us_);
+          break;
+        }
+        default: {
+          ret = OB_ERR_UNEXPECTED;
+          LOG_WARN("invalid column id", K(ret), K(column_id), K(i), K(output_column_ids_));
+          break;
+        }
+      } // end switch
+    } // end for-loop
+    if (OB_SUCC(ret)) {
+      row = &cur_row_;
+    }
+    ++histogram_pos_;
+  }
+  return ret;
+}
+
 }// namespace observer
 }// namespace oceanbase
 
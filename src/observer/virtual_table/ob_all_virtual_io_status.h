@@ -17,6 +17,7 @@
 #include "share/ob_scanner.h"
 #include "common/row/ob_row.h"
 #include "share/io/ob_io_calibration.h"
+#include "share/io/ob_io_struct.h"
 
 namespace oceanbase
 {
@@ -135,6 +136,59 @@ private:
   int64_t quota_pos_;
 };
 
+// The histograms are cumulative since the observer starts, "ob_admin reset_io_latency_histogram"
+// resets them to get the percentiles of an interval.
+class ObAllVirtualIOLatencyHistogram : public ObAllVirtualIOStatusIterator
+{
+public:
+  ObAllVirtualIOLatencyHistogram();
+  virtual ~ObAllVirtualIOLatencyHistogram();
+  int init(const common::ObAddr &addr);
+  virtual void reset() override;
+  virtual int inner_get_next_row(common::ObNewRow *&row) override;
+private:
+  enum COLUMN
+  {
+    SVR_IP = common::OB_APP_MIN_COLUMN_ID,
+    SVR_PORT,
+    TENANT_ID,
+    MODULE,
+    MODE,
+    PHASE,
+    COUNT,
+    AVG_US,
+    P50_US,
+    P90_US,
+    P99_US,
+    P999_US,
+    MAX_US,
+  };
+  struct HistogramInfo
+  {
+  public:
+    HistogramInfo();
+    ~HistogramInfo();
+    TO_STRING_KV(K(tenant_id_), K(module_), K(mode_), K(phase_), K(count_), K(avg_us_),
+        K(p50_us_), K(p90_us_), K(p99_us_), K(p999_us_), K(max_us_));
+  public:
+    uint64_t tenant_id_;
+    common::ObIOModule module_;
+    common::ObIOMode mode_;
+    common::ObIOLatencyStat::Phase phase_;
+    int64_t count_;
+    int64_t avg_us_;
+    int64_t p50_us_;
+    int64_t p90_us_;
+    int64_t p99_us_;
+    int64_t p999_us_;
+    int64_t max_us_;
+  };
+  DISALLOW_COPY_AND_ASSIGN(ObAllVirtualIOLatencyHistogram);
+private:
+  ObArray<HistogramInfo> histogram_infos_;
+  int64_t histogram_pos_;
+};
+
 }// namespace observer
 }// namespace oceanbase
 
@@ -2137,6 +2137,17 @@ int ObVTIterCreator::create_vt_iter(ObVTableScanParam &params,
             }
             break;
           }
+          case OB_ALL_VIRTUAL_IO_LATENCY_HISTOGRAM_TID: {
+            ObAllVirtualIOLatencyHistogram *io_latency_histogram = nullptr;
+            if (OB_SUCC(NEW_VIRTUAL_TABLE(ObAllVirtualIOLatencyHistogram, io_latency_histogram))) {
+              if (OB_FAIL(io_latency_histogram->init(addr_))) {
+                SERVER_LOG(WARN, "fail to init ObAllVirtualIOLatencyHistogram, ", K(ret));
+              } else {
+                vt_iter = static_cast<ObVirtualTableIterator *>(io_latency_histogram);
+              }
+            }
+            break;
+          }
           case OB_ALL_VIRTUAL_TABLET_ENCRYPT_INFO_TID: {
             ObAllVirtualTabletEncryptInfo *partition_encrypt_info = NULL;
             if (OB_SUCC(NEW_VIRTUAL_TABLE(ObAllVirtualTabletEncryptInfo, partition_encrypt_info))) {
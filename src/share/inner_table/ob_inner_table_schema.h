@@ -581,6 +581,7 @@ public:
   static int all_virtual_io_benchmark_schema(share::schema::ObTableSchema &table_schema);
   static int all_virtual_io_quota_schema(share::schema::ObTableSchema &table_schema);
   static int all_virtual_server_compaction_event_history_schema(share::schema::ObTableSchema &table_schema);
+  static int all_virtual_io_latency_histogram_schema(share::schema::ObTableSchema &table_schema);
   static int session_variables_schema(share::schema::ObTableSchema &table_schema);
   static int table_privileges_schema(share::schema::ObTableSchema &table_schema);
   static int user_privileges_schema(share::schema::ObTableSchema &table_schema);
@@ -2483,6 +2484,7 @@ const schema_create_func virtual_table_schema_creators [] = {
   ObInnerTableSchema::all_virtual_io_benchmark_schema,
   ObInnerTableSchema::all_virtual_io_quota_schema,
   ObInnerTableSchema::all_virtual_server_compaction_event_history_schema,
+  ObInnerTableSchema::all_virtual_io_latency_histogram_schema,
   ObInnerTableSchema::session_variables_schema,
   ObInnerTableSchema::table_privileges_schema,
   ObInnerTableSchema::user_privileges_schema,
@@ -7031,6 +7033,7 @@ const uint64_t cluster_distributed_vtables [] = {
   OB_ALL_VIRTUAL_IO_CALIBRATION_STATUS_TID,
   OB_ALL_VIRTUAL_IO_BENCHMARK_TID,
   OB_ALL_VIRTUAL_IO_QUOTA_TID,
+  OB_ALL_VIRTUAL_IO_LATENCY_HISTOGRAM_TID,
   OB_ALL_VIRTUAL_LOCK_WAIT_STAT_TID,
   OB_ALL_VIRTUAL_TENANT_MEMSTORE_ALLOCATOR_INFO_TID,
   OB_ALL_VIRTUAL_BAD_BLOCK_TABLE_TID,
@@ -9155,11 +9158,11 @@ static inline int get_sys_table_lob_aux_schema(const uint64_t tid,
 
 const int64_t OB_CORE_TABLE_COUNT = 4;
 const int64_t OB_SYS_TABLE_COUNT = 212;
-const int64_t OB_VIRTUAL_TABLE_COUNT = 551;
+const int64_t OB_VIRTUAL_TABLE_COUNT = 552;
 const int64_t OB_SYS_VIEW_COUNT = 601;
-const int64_t OB_SYS_TENANT_TABLE_COUNT = 1369;
+const int64_t OB_SYS_TENANT_TABLE_COUNT = 1370;
 const int64_t OB_CORE_SCHEMA_VERSION = 1;
-const int64_t OB_BOOTSTRAP_SCHEMA_VERSION = 1372;
+const int64_t OB_BOOTSTRAP_SCHEMA_VERSION = 1373;
 
 } // end namespace share
 } // end namespace oceanbase
@@ -329,6 +329,7 @@ const uint64_t OB_ALL_VIRTUAL_IO_CALIBRATION_STATUS_TID = 11113; // "__all_virtu
 const uint64_t OB_ALL_VIRTUAL_IO_BENCHMARK_TID = 11114; // "__all_virtual_io_benchmark"
 const uint64_t OB_ALL_VIRTUAL_IO_QUOTA_TID = 11115; // "__all_virtual_io_quota"
 const uint64_t OB_ALL_VIRTUAL_SERVER_COMPACTION_EVENT_HISTORY_TID = 11116; // "__all_virtual_server_compaction_event_history"
+const uint64_t OB_ALL_VIRTUAL_IO_LATENCY_HISTOGRAM_TID = 11117; // "__all_virtual_io_latency_histogram"
 const uint64_t OB_SESSION_VARIABLES_TID = 12001; // "SESSION_VARIABLES"
 const uint64_t OB_TABLE_PRIVILEGES_TID = 12002; // "TABLE_PRIVILEGES"
 const uint64_t OB_USER_PRIVILEGES_TID = 12003; // "USER_PRIVILEGES"
@@ -2215,6 +2216,7 @@ const char *const OB_ALL_VIRTUAL_IO_CALIBRATION_STATUS_TNAME = "__all_virtual_io
 const char *const OB_ALL_VIRTUAL_IO_BENCHMARK_TNAME = "__all_virtual_io_benchmark";
 const char *const OB_ALL_VIRTUAL_IO_QUOTA_TNAME = "__all_virtual_io_quota";
 const char *const OB_ALL_VIRTUAL_SERVER_COMPACTION_EVENT_HISTORY_TNAME = "__all_virtual_server_compaction_event_history";
+const char *const OB_ALL_VIRTUAL_IO_LATENCY_HISTOGRAM_TNAME = "__all_virtual_io_latency_histogram";
 const char *const OB_SESSION_VARIABLES_TNAME = "SESSION_VARIABLES";
 const char *const OB_TABLE_PRIVILEGES_TNAME = "TABLE_PRIVILEGES";
 const char *const OB_USER_PRIVILEGES_TNAME = "USER_PRIVILEGES";
@@ -7641,6 +7641,32 @@ def_table_schema(
   vtable_route_policy = 'distributed',
 )
 
+def_table_schema(
+    owner             = 'chaser.ch',
+    table_name        = '__all_virtual_io_latency_histogram',
+    table_id          = '11117',
+    table_type        = 'VIRTUAL_TABLE',
+    gm_columns        = [],
+    rowkey_columns    = [],
+    normal_columns    = [
+      ('svr_ip',        'varchar:MAX_IP_ADDR_LENGTH'),
+      ('svr_port',      'int'),
+      ('tenant_id',     'int'),
+      ('module',        'varchar:256'),
+      ('mode',          'varchar:256'),
+      ('phase',         'varchar:256'),
+      ('count',         'int'),
+      ('avg_us',        'int'),
+      ('p50_us',        'int'),
+      ('p90_us',        'int'),
+      ('p99_us',        'int'),
+      ('p999_us',       'int'),
+      ('max_us',        'int'),
+    ],
+    partition_columns = ['svr_ip', 'svr_port'],
+    vtable_route_policy = 'distributed',
+)
+
 ################################################################
 ################################################################
 # INFORMATION SCHEMA
@@ -205,6 +205,7 @@ int ObTenantIOClock::init(const ObTenantIOConfig &io_config, const ObIOUsage *io
     if (OB_SUCC(ret)) {
       unit_clock_.iops_ = unit_config.max_iops_;
       unit_clock_.last_ns_ = 0;
+      update_limit_clocks(io_config);
       io_usage_ = io_usage;
       is_inited_ = true;
     }
@@ -256,6 +257,7 @@ int ObTenantIOClock::calc_phyqueue_clock(ObPhyQueue *phy_queue, const ObIOReques
       } else {
         // ensure not exceed max iops of the tenant
         unit_clock_.atom_update(current_ts, iops_scale, phy_queue->tenant_limitation_ts_);
+        calc_limit_clock(current_ts, cate_index, req, phy_queue);
       }
     }
   }
@@ -383,6 +385,7 @@ int ObTenantIOClock::update_io_config(const ObTenantIOConfig &io_config)
     }
     if (OB_SUCC(ret)) {
       unit_clock_.iops_ = unit_config.max_iops_;
+      update_limit_clocks(io_config);
       is_inited_ = true;
     }
   }
@@ -405,27 +408,42 @@ int64_t ObTenantIOClock::get_min_proportion_ts()
 
 ObMClock &ObTenantIOClock::get_mclock(const int category_index)
 {
-  const bool use_category_clock = category_clocks_[category_index].is_valid();
-  ObMClock &io_clock = use_category_clock ? category_clocks_[category_index] : other_clock_;
+  const int mclock_index = get_mclock_index(category_index);
+  ObMClock &io_clock = static_cast<int>(ObIOCategory::MAX_CATEGORY) == mclock_index
+      ? other_clock_ : category_clocks_[mclock_index];
   return io_clock;
 }
 
+int ObTenantIOClock::get_mclock_index(const int category_index)
+{
+  int mclock_index = static_cast<int>(ObIOCategory::MAX_CATEGORY);
+  const int sys_index = static_cast<int>(ObIOCategory::SYS_IO);
+  if (category_clocks_[category_index].is_valid()) {
+    mclock_index = category_index;
+  } else if (is_sys_sub_category(static_cast<ObIOCategory>(category_index))
+      && category_clocks_[sys_index].is_valid()) {
+    mclock_index = sys_index;
+  }
+  return mclock_index;
+}
+
 double ObTenantIOClock::get_weight_scale(const int category_index)
 {
   double weight_scale = 1;
   if (OB_ISNULL(io_usage_)) {
     // do nothing
   } else {
-    const bool is_other_category = !category_clocks_[category_index].is_valid();
     int64_t sum_weight_percent = 0;
-    bool need_add_other_weight = true;
+    bool is_weight_added[static_cast<int>(ObIOCategory::MAX_CATEGORY) + 1] = { false };
     for (int64_t i = 0; i < static_cast<int>(ObIOCategory::MAX_CATEGORY); ++i) {
       if (io_usage_->is_request_doing(static_cast<ObIOCategory>(i))) {
-        if (category_clocks_[i].is_valid()) {
-          sum_weight_percent += io_config_.category_configs_[i].weight_percent_;
-        } else if (need_add_other_weight) {
-          sum_weight_percent += io_config_.other_config_.weight_percent_;
-          need_add_other_weight = false;
+        // the categories sharing one clock only add the weight once
+        const int mclock_index = get_mclock_index(i);
+        if (!is_weight_added[mclock_index]) {
+          sum_weight_percent += static_cast<int>(ObIOCategory::MAX_CATEGORY) == mclock_index
+              ? io_config_.other_config_.weight_percent_
+              : io_config_.category_configs_[mclock_index].weight_percent_;
+          is_weight_added[mclock_index] = true;
         }
       }
     }
@@ -436,6 +454,47 @@ double ObTenantIOClock::get_weight_scale(const int category_index)
   return weight_scale;
 }
 
+void ObTenantIOClock::update_limit_clocks(const ObTenantIOConfig &io_config)
+{
+  for (int64_t i = 0; i < static_cast<int>(ObIOCategory::MAX_CATEGORY); ++i) {
+    const ObTenantIOConfig::CategoryLimit &limit = io_config.category_limits_[i];
+    for (int64_t j = 0; j < static_cast<int>(ObIOMode::MAX_MODE); ++j) {
+      iops_limit_clocks_[i][j].iops_ = limit.max_iops_[j];
+      bandwidth_limit_clocks_[i][j].iops_ = limit.max_bandwidth_[j];
+    }
+  }
+}
+
+void ObTenantIOClock::calc_limit_clock(
+    const int64_t current_ts,
+    const int cate_index,
+    const ObIORequest &req,
+    ObPhyQueue *phy_queue)
+{
+  const int mode_index = static_cast<int>(req.get_mode());
+  if (mode_index >= 0 && mode_index < static_cast<int>(ObIOMode::MAX_MODE)) {
+    ObAtomIOClock &iops_clock = iops_limit_clocks_[cate_index][mode_index];
+    ObAtomIOClock &bandwidth_clock = bandwidth_limit_clocks_[cate_index][mode_index];
+    int64_t limit_ts = 0;
+    int64_t deadline_ts = 0;
+    if (ATOMIC_LOAD(&iops_clock.iops_) > 0) {
+      iops_clock.atom_update(current_ts, 1.0, deadline_ts);
+      limit_ts = max(limit_ts, deadline_ts);
+    }
+    if (ATOMIC_LOAD(&bandwidth_clock.iops_) > 0) {
+      // the bandwidth clock counts bytes, each request takes size bytes
+      const int64_t io_size = max(1L, max(req.io_info_.size_, req.io_size_));
+      bandwidth_clock.atom_update(current_ts, 1.0 / io_size, deadline_ts);
+      limit_ts = max(limit_ts, deadline_ts);
+    }
+    if (limit_ts > 0) {
+      // the limits are hard, the reservation can not exceed them either
+      phy_queue->reservation_ts_ = max(phy_queue->reservation_ts_, limit_ts);
+      phy_queue->category_limitation_ts_ = max(phy_queue->category_limitation_ts_, limit_ts);
+    }
+  }
+}
+
 int64_t ObTenantIOClock::calc_iops(const int64_t iops, const int64_t percentage)
 {
   return max(1, static_cast<int64_t>(static_cast<double>(iops) * percentage / 100));
@@ -65,14 +65,21 @@ public:
       K_(other_clock), K_(unit_clock), K(io_config_), K(io_usage_));
 private:
   ObMClock &get_mclock(const int category_index);
+  // the index of the mclock used by the category, MAX_CATEGORY for the other clock
+  int get_mclock_index(const int category_index);
   double get_weight_scale(const int category_index);
   int64_t calc_iops(const int64_t iops, const int64_t percentage);
   int64_t calc_weight(const int64_t weight, const int64_t percentage);
+  void update_limit_clocks(const ObTenantIOConfig &io_config);
+  // delay the request until the iops and bandwidth limits of its category and mode are met
+  void calc_limit_clock(const int64_t current_ts, const int cate_index, const ObIORequest &req, ObPhyQueue *phy_queue);
 private:
   bool is_inited_;
   ObMClock category_clocks_[static_cast<int>(ObIOCategory::MAX_CATEGORY)];
   ObMClock other_clock_;
   ObAtomIOClock unit_clock_;
+  ObAtomIOClock iops_limit_clocks_[static_cast<int>(ObIOCategory::MAX_CATEGORY)][static_cast<int>(ObIOMode::MAX_MODE)];
+  ObAtomIOClock bandwidth_limit_clocks_[static_cast<int>(ObIOCategory::MAX_CATEGORY)][static_cast<int>(ObIOMode::MAX_MODE)];
   ObTenantIOConfig io_config_;
   const ObIOUsage *io_usage_;
 };
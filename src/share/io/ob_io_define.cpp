@@ -62,6 +62,9 @@ static const char *user_category_name = "USER";
 static const char *sys_category_name = "SYS";
 static const char *prewarm_category_name = "PREWARM";
 static const char *large_query_category_name = "LARGE";
+static const char *compaction_category_name = "COMPACTION";
+static const char *migration_category_name = "MIGRATION";
+static const char *backup_category_name = "BACKUP";
 const char *oceanbase::common::get_io_category_name(ObIOCategory category)
 {
   const char *ret_name = "UNKNOWN";
@@ -81,6 +84,15 @@ const char *oceanbase::common::get_io_category_name(ObIOCategory category)
     case ObIOCategory::LARGE_QUERY_IO:
       ret_name = large_query_category_name;
       break;
+    case ObIOCategory::COMPACTION_IO:
+      ret_name = compaction_category_name;
+      break;
+    case ObIOCategory::MIGRATION_IO:
+      ret_name = migration_category_name;
+      break;
+    case ObIOCategory::BACKUP_IO:
+      ret_name = backup_category_name;
+      break;
     default:
       break;
   }
@@ -100,10 +112,69 @@ ObIOCategory oceanbase::common::get_io_category_enum(const char *category_name)
     io_category = ObIOCategory::PREWARM_IO;
   } else if (0 == strncasecmp(category_name, large_query_category_name, strlen(large_query_category_name))) {
     io_category = ObIOCategory::LARGE_QUERY_IO;
+  } else if (0 == strncasecmp(category_name, compaction_category_name, strlen(compaction_category_name))) {
+    io_category = ObIOCategory::COMPACTION_IO;
+  } else if (0 == strncasecmp(category_name, migration_category_name, strlen(migration_category_name))) {
+    io_category = ObIOCategory::MIGRATION_IO;
+  } else if (0 == strncasecmp(category_name, backup_category_name, strlen(backup_category_name))) {
+    io_category = ObIOCategory::BACKUP_IO;
   }
   return io_category;
 }
 
+bool oceanbase::common::is_sys_sub_category(const ObIOCategory category)
+{
+  return ObIOCategory::COMPACTION_IO == category
+      || ObIOCategory::MIGRATION_IO == category
+      || ObIOCategory::BACKUP_IO == category;
+}
+
+static thread_local ObIOCategory thread_sys_io_category = ObIOCategory::MAX_CATEGORY;
+
+void oceanbase::common::set_thread_sys_io_category(const ObIOCategory category)
+{
+  thread_sys_io_category = category;
+}
+
+ObIOCategory oceanbase::common::get_thread_sys_io_category()
+{
+  return thread_sys_io_category;
+}
+
+const char *oceanbase::common::get_io_module_name(const ObIOModule module)
+{
+  const char *ret_name = "UNKNOWN";
+  switch (module) {
+    case ObIOModule::DATA:
+      ret_name = "DATA";
+      break;
+    case ObIOModule::COMPACTION:
+      ret_name = "COMPACTION";
+      break;
+    case ObIOModule::INDEX_BUILD:
+      ret_name = "INDEX_BUILD";
+      break;
+    case ObIOModule::MIGRATION:
+      ret_name = "MIGRATION";
+      break;
+    case ObIOModule::BACKUP:
+      ret_name = "BACKUP";
+      break;
+    case ObIOModule::TMP_FILE:
+      ret_name = "TMP_FILE";
+      break;
+    case ObIOModule::LOG:
+      ret_name = "LOG";
+      break;
+    case ObIOModule::OTHER:
+      ret_name = "OTHER";
+      break;
+    default:
+      break;
+  }
+  return ret_name;
+}
+
 /******************             IOFlag              **********************/
 ObIOFlag::ObIOFlag()
   : flag_(0)
@@ -148,6 +219,51 @@ ObIOCategory ObIOFlag::get_category() const
   return static_cast<ObIOCategory>(category_);
 }
 
+ObIOModule ObIOFlag::get_module() const
+{
+  ObIOModule module = ObIOModule::OTHER;
+  const ObIOCategory category = get_category();
+  if (ObIOCategory::LOG_IO == category) {
+    module = ObIOModule::LOG;
+  } else if (ObIOCategory::BACKUP_IO == category) {
+    module = ObIOModule::BACKUP;
+  } else {
+    switch (wait_event_id_) {
+      case ObWaitEventIds::DB_FILE_DATA_READ:
+      case ObWaitEventIds::DB_FILE_DATA_INDEX_READ:
+        module = ObIOModule::DATA;
+        break;
+      case ObWaitEventIds::DB_FILE_COMPACT_READ:
+      case ObWaitEventIds::DB_FILE_COMPACT_WRITE:
+      case ObWaitEventIds::BLOOM_FILTER_BUILD_READ:
+        module = ObIOModule::COMPACTION;
+        break;
+      case ObWaitEventIds::DB_FILE_INDEX_BUILD_READ:
+      case ObWaitEventIds::DB_FILE_INDEX_BUILD_WRITE:
+        module = ObIOModule::INDEX_BUILD;
+        break;
+      case ObWaitEventIds::DB_FILE_MIGRATE_READ:
+      case ObWaitEventIds::DB_FILE_MIGRATE_WRITE:
+        module = ObIOModule::MIGRATION;
+        break;
+      case ObWaitEventIds::INTERM_RESULT_DISK_READ:
+      case ObWaitEventIds::INTERM_RESULT_DISK_WRITE:
+      case ObWaitEventIds::ROW_STORE_DISK_READ:
+      case ObWaitEventIds::ROW_STORE_DISK_WRITE:
+        module = ObIOModule::TMP_FILE;
+        break;
+      default:
+        if (ObIOCategory::COMPACTION_IO == category) {
+          module = ObIOModule::COMPACTION;
+        } else if (ObIOCategory::MIGRATION_IO == category) {
+          module = ObIOModule::MIGRATION;
+        }
+        break;
+    }
+  }
+  return module;
+}
+
 void ObIOFlag::set_wait_event(int64_t wait_event_id)
 {
   wait_event_id_ = wait_event_id;
@@ -640,6 +756,7 @@ void ObIORequest::finish(const ObIORetCode &ret_code)
       if (OB_NOT_NULL(tenant_io_mgr_.get_ptr())) {
         tenant_io_mgr_.get_ptr()->io_usage_.accumulate(*this);
         tenant_io_mgr_.get_ptr()->io_usage_.record_request_finish(*this);
+        tenant_io_mgr_.get_ptr()->io_latency_stat_.record(*this);
       }
       if (OB_UNLIKELY(OB_SUCCESS != ret_code_.io_ret_)) {
         OB_IO_MANAGER.get_device_health_detector().record_failure(*this);
@@ -833,6 +950,11 @@ bool ObIOHandle::is_valid() const
   return nullptr != req_;
 }
 
+bool ObIOHandle::is_finished() const
+{
+  return nullptr != req_ && ATOMIC_LOAD(&req_->is_finished_);
+}
+
 int ObIOHandle::wait(const int64_t timeout_ms)
 {
   int ret = OB_SUCCESS;
@@ -1009,6 +1131,27 @@ bool ObTenantIOConfig::CategoryConfig::is_valid() const
   return min_percent_ > 0 && max_percent_ >= min_percent_ && max_percent_ <= 100 && weight_percent_ >= 0 && weight_percent_ <= 100;
 }
 
+ObTenantIOConfig::CategoryLimit::CategoryLimit()
+{
+  MEMSET(max_iops_, 0, sizeof(max_iops_));
+  MEMSET(max_bandwidth_, 0, sizeof(max_bandwidth_));
+}
+
+bool ObTenantIOConfig::CategoryLimit::is_valid() const
+{
+  bool bret = false;
+  for (int64_t i = 0; !bret && i < static_cast<int>(ObIOMode::MAX_MODE); ++i) {
+    bret = max_iops_[i] > 0 || max_bandwidth_[i] > 0;
+  }
+  return bret;
+}
+
+bool ObTenantIOConfig::CategoryLimit::operator ==(const CategoryLimit &other) const
+{
+  return 0 == MEMCMP(max_iops_, other.max_iops_, sizeof(max_iops_))
+      && 0 == MEMCMP(max_bandwidth_, other.max_bandwidth_, sizeof(max_bandwidth_));
+}
+
 ObTenantIOConfig::ObTenantIOConfig()
   : memory_limit_(0), callback_thread_count_(0), enable_io_tracer_(false)
 {
@@ -1075,6 +1218,12 @@ bool ObTenantIOConfig::operator ==(const ObTenantIOConfig &other) const
         LOG_INFO("category config not equal", K(category_config), K(other_category_config), K(i), K(max_category_count));
       }
     }
+    for (int64_t i = 0; bret && i < max_category_count; ++i) {
+      if (!(category_limits_[i] == other.category_limits_[i])) {
+        bret = false;
+        LOG_INFO("category limit not equal", K(category_limits_[i]), K(other.category_limits_[i]), K(i));
+      }
+    }
   }
   return bret;
 }
@@ -1144,6 +1293,62 @@ int ObTenantIOConfig::parse_category_config(const char *config_str)
   return ret;
 }
 
+int ObTenantIOConfig::parse_category_limit_config(const char *config_str)
+{
+  int ret = OB_SUCCESS;
+  const int64_t max_config_length = 512;
+  char copied_str[max_config_length] = { 0 };
+  if (OB_ISNULL(config_str) || strlen(config_str) > max_config_length) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KCSTRING(config_str));
+  } else if (0 > snprintf(copied_str, max_config_length, "%s", config_str)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("copy config string failed", K(ret), KCSTRING(config_str));
+  } else {
+    str_trim(copied_str);
+    int pos = 0;
+    int len = strlen(copied_str);
+    for (int64_t i = 0; OB_SUCC(ret) && i < len; ++i) {
+      if (';' == copied_str[i]) {
+        copied_str[i] = '\0';
+      } else if (':' == copied_str[i]) {
+        copied_str[i] = ' ';
+      }
+    }
+    while (OB_SUCC(ret) && pos < len) {
+      const char *tmp_config_str = copied_str + pos;
+      char category_name[max_config_length] = { 0 };
+      CategoryLimit tmp_limit;
+      int64_t read_mb = 0;
+      int64_t write_mb = 0;
+      // category: max read iops, max write iops, max read MB/s, max write MB/s
+      int scan_count = sscanf(tmp_config_str, "%s %ld,%ld,%ld,%ld",
+                              category_name,
+                              &tmp_limit.max_iops_[static_cast<int>(ObIOMode::READ)],
+                              &tmp_limit.max_iops_[static_cast<int>(ObIOMode::WRITE)],
+                              &read_mb,
+                              &write_mb);
+      const ObIOCategory io_category = get_io_category_enum(category_name);
+      if (5 != scan_count) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("scan current category limit failed", K(ret), K(scan_count), KCSTRING(tmp_config_str));
+      } else if (ObIOCategory::MAX_CATEGORY == io_category
+          || tmp_limit.max_iops_[static_cast<int>(ObIOMode::READ)] < 0
+          || tmp_limit.max_iops_[static_cast<int>(ObIOMode::WRITE)] < 0
+          || read_mb < 0 || write_mb < 0) {
+        ret = OB_INVALID_ARGUMENT;
+        LOG_WARN("invalid category limit", K(ret), KCSTRING(tmp_config_str), K(tmp_limit), K(read_mb), K(write_mb));
+      } else {
+        tmp_limit.max_bandwidth_[static_cast<int>(ObIOMode::READ)] = read_mb * 1024L * 1024L;
+        tmp_limit.max_bandwidth_[static_cast<int>(ObIOMode::WRITE)] = write_mb * 1024L * 1024L;
+        category_limits_[static_cast<int>(io_category)] = tmp_limit;
+        pos += strlen(tmp_config_str) + 1;
+      }
+    }
+  }
+  return ret;
+}
+
 int ObTenantIOConfig::get_category_config(const ObIOCategory category, int64_t &min_iops, int64_t &max_iops, int64_t &iops_weight) const
 {
   int ret = OB_SUCCESS;
@@ -1188,6 +1393,18 @@ int64_t ObTenantIOConfig::to_string(char* buf, const int64_t buf_len) const
     J_KV("other", other_config_);
   }
   BUF_PRINTF("]");
+  BUF_PRINTF(", category_limits:[");
+  need_comma = false;
+  for (int64_t i = 0; i < static_cast<int>(ObIOCategory::MAX_CATEGORY); ++i) {
+    if (category_limits_[i].is_valid()) {
+      if (need_comma) {
+        J_COMMA();
+      }
+      J_KV(get_io_category_name(static_cast<ObIOCategory>(i)), category_limits_[i]);
+      need_comma = true;
+    }
+  }
+  BUF_PRINTF("]");
   J_OBJ_END();
   return pos;
 }
@@ -46,11 +46,37 @@ enum class ObIOCategory : uint8_t
   SYS_IO = 2,
   PREWARM_IO = 3,
   LARGE_QUERY_IO = 4,
+  COMPACTION_IO = 5,
+  MIGRATION_IO = 6,
+  BACKUP_IO = 7,
   MAX_CATEGORY
 };
 
 const char *get_io_category_name(ObIOCategory category);
 ObIOCategory get_io_category_enum(const char *category_name);
+// compaction, migration and backup are split from sys io, which use the clock of sys io
+// unless they are configured
+bool is_sys_sub_category(const ObIOCategory category);
+// the sys io issued by current thread is accounted to this category, e.g. the dag worker
+// sets it to the category of the running dag, MAX_CATEGORY for none
+void set_thread_sys_io_category(const ObIOCategory category);
+ObIOCategory get_thread_sys_io_category();
+
+// the caller module of the io request, which the latency is attributed to
+enum class ObIOModule : uint8_t
+{
+  DATA = 0, // data and index block reads, e.g. the block cache miss of the queries
+  COMPACTION = 1,
+  INDEX_BUILD = 2,
+  MIGRATION = 3,
+  BACKUP = 4,
+  TMP_FILE = 5,
+  LOG = 6,
+  OTHER = 7,
+  MAX_MODULE
+};
+
+const char *get_io_module_name(const ObIOModule module);
 
 struct ObIOFlag final
 {
@@ -63,6 +89,8 @@ public:
   ObIOMode get_mode() const;
   void set_category(ObIOCategory category);
   ObIOCategory get_category() const;
+  // derived from the wait event and the category
+  ObIOModule get_module() const;
   void set_wait_event(int64_t wait_event_id);
   int64_t get_wait_event() const;
   void set_read();
@@ -299,6 +327,8 @@ public:
   int set_request(ObIORequest &req);
   bool is_empty() const;
   bool is_valid() const;
+  // check whether the io is done without waiting
+  bool is_finished() const;
 
   int wait(const int64_t timeout_ms);
   const char *get_buffer();
@@ -338,12 +368,26 @@ public:
     int64_t max_percent_;
     int64_t weight_percent_;
   };
+  // the absolute limits of the category for each io mode, 0 means unlimited
+  struct CategoryLimit
+  {
+    CategoryLimit();
+    bool is_valid() const;
+    bool operator ==(const CategoryLimit &other) const;
+    TO_STRING_KV("max_read_iops", max_iops_[static_cast<int>(ObIOMode::READ)],
+                 "max_write_iops", max_iops_[static_cast<int>(ObIOMode::WRITE)],
+                 "max_read_bandwidth", max_bandwidth_[static_cast<int>(ObIOMode::READ)],
+                 "max_write_bandwidth", max_bandwidth_[static_cast<int>(ObIOMode::WRITE)]);
+    int64_t max_iops_[static_cast<int>(ObIOMode::MAX_MODE)];
+    int64_t max_bandwidth_[static_cast<int>(ObIOMode::MAX_MODE)]; // bytes per second
+  };
 public:
   ObTenantIOConfig();
   static const ObTenantIOConfig &default_instance();
   bool is_valid() const;
   bool operator ==(const ObTenantIOConfig &other) const;
   int parse_category_config(const char *config_str);
+  int parse_category_limit_config(const char *config_str);
   int get_category_config(const ObIOCategory category, int64_t &min_iops, int64_t &max_iops, int64_t &iops_weight) const;
   int64_t to_string(char* buf, const int64_t buf_len) const;
 public:
@@ -352,6 +396,7 @@ public:
   UnitConfig unit_config_;
   CategoryConfig category_configs_[static_cast<int>(ObIOCategory::MAX_CATEGORY)];
   CategoryConfig other_config_;
+  CategoryLimit category_limits_[static_cast<int>(ObIOCategory::MAX_CATEGORY)];
   bool enable_io_tracer_;
 };
 
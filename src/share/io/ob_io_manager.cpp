@@ -699,6 +699,12 @@ int ObTenantIOManager::inner_aio(const ObIOInfo &info, ObIOHandle &handle)
     LOG_WARN("fail to set master to handle", K(ret), KP(req));
   } else if (OB_FAIL(req->init(info))) {
     LOG_WARN("init request failed", K(ret), K(info), KPC(req));
+  } else if (ObIOCategory::SYS_IO == req->get_category()
+      && ObIOCategory::MAX_CATEGORY != get_thread_sys_io_category()) {
+    // the sys io issued by compaction, migration or backup dags is accounted to their own category
+    req->io_info_.flag_.set_category(get_thread_sys_io_category());
+  }
+  if (OB_FAIL(ret)) {
   } else if (OB_FAIL(io_scheduler_->schedule_request(*io_clock_, *req))) {
     LOG_WARN("schedule request failed", K(ret), KPC(req));
   }
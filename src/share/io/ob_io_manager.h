@@ -113,6 +113,8 @@ public:
   int enqueue_callback(ObIORequest &req);
   ObIOClock *get_io_clock() { return io_clock_; }
   const ObIOUsage &get_io_usage() { return io_usage_; }
+  const ObIOLatencyStat &get_io_latency_stat() const { return io_latency_stat_; }
+  void reset_io_latency_stat() { io_latency_stat_.reset(); }
   int update_io_config(const ObTenantIOConfig &io_config);
   int alloc_io_request(ObIAllocator &allocator,const int64_t callback_size,  ObIORequest *&req);
   int alloc_io_clock(ObIAllocator &allocator, ObIOClock *&io_clock);
@@ -135,6 +137,7 @@ private:
   ObIOScheduler *io_scheduler_;
   ObIOCallbackManager callback_mgr_;
   ObIOUsage io_usage_;
+  ObIOLatencyStat io_latency_stat_;
   ObIOTracer io_tracer_;
 };
 
@@ -475,6 +475,166 @@ bool ObIOUsage::is_request_doing(const ObIOCategory category) const
   return ATOMIC_LOAD(&doing_request_count_[static_cast<int>(category)]) > 0;
 }
 
+/******************             IOLatencyHistogram              **********************/
+
+ObIOLatencyHistogram::ObIOLatencyHistogram()
+  : count_(0), sum_(0), max_(0)
+{
+  MEMSET(buckets_, 0, sizeof(buckets_));
+}
+
+void ObIOLatencyHistogram::record(const int64_t latency_us)
+{
+  const int64_t value = max(latency_us, 0L);
+  ATOMIC_INC(&buckets_[get_bucket_idx(value)]);
+  ATOMIC_INC(&count_);
+  ATOMIC_AAF(&sum_, value);
+  int64_t cur_max = ATOMIC_LOAD(&max_);
+  while (value > cur_max && cur_max != ATOMIC_VCAS(&max_, cur_max, value)) {
+    cur_max = ATOMIC_LOAD(&max_);
+  }
+}
+
+void ObIOLatencyHistogram::reset()
+{
+  // may race with record, the requests recorded meanwhile are partially lost
+  ATOMIC_STORE(&count_, 0);
+  ATOMIC_STORE(&sum_, 0);
+  ATOMIC_STORE(&max_, 0);
+  for (int64_t i = 0; i < BUCKET_CNT; ++i) {
+    ATOMIC_STORE(&buckets_[i], 0);
+  }
+}
+
+int64_t ObIOLatencyHistogram::get_percentile(const double percentage) const
+{
+  int64_t latency_us = 0;
+  const int64_t count = get_count();
+  if (count > 0) {
+    const int64_t target_count = max(1L, static_cast<int64_t>(ceil(count * percentage / 100.0)));
+    int64_t sum_count = 0;
+    int64_t idx = 0;
+    for (; idx < BUCKET_CNT && sum_count < target_count; ++idx) {
+      sum_count += get_bucket_count(idx);
+    }
+    // the concurrent recording may leave the buckets behind the count
+    latency_us = sum_count < target_count ? get_max() : min(get_bucket_upper_bound(idx - 1), get_max());
+  }
+  return latency_us;
+}
+
+int64_t ObIOLatencyHistogram::get_bucket_idx(const int64_t latency_us)
+{
+  int64_t idx = 0;
+  const int64_t value = min(latency_us, (1L << MAX_LATENCY_BITS) - 1);
+  if (value < SUB_BUCKET_CNT) {
+    idx = value;
+  } else {
+    const int64_t highest_bit = 63 - __builtin_clzl(static_cast<uint64_t>(value));
+    const int64_t shift = highest_bit - SUB_BUCKET_BITS;
+    idx = (shift + 1) * SUB_BUCKET_CNT + ((value >> shift) - SUB_BUCKET_CNT);
+  }
+  return idx;
+}
+
+int64_t ObIOLatencyHistogram::get_bucket_upper_bound(const int64_t idx)
+{
+  int64_t upper_bound = 0;
+  if (idx < SUB_BUCKET_CNT) {
+    upper_bound = idx;
+  } else {
+    const int64_t shift = idx / SUB_BUCKET_CNT - 1;
+    const int64_t sub_idx = idx % SUB_BUCKET_CNT;
+    upper_bound = ((SUB_BUCKET_CNT + sub_idx + 1) << shift) - 1;
+  }
+  return upper_bound;
+}
+
+/******************             IOLatencyStat              **********************/
+
+void ObIOLatencyStat::record(const ObIORequest &req)
+{
+  const int module_idx = static_cast<int>(req.get_flag().get_module());
+  const int mode_idx = static_cast<int>(req.get_mode());
+  const ObIOTimeLog &time_log = req.time_log_;
+  if (module_idx < static_cast<int>(ObIOModule::MAX_MODULE) && mode_idx < static_cast<int>(ObIOMode::MAX_MODE)) {
+    ObIOLatencyHistogram *histograms = histograms_[module_idx][mode_idx];
+    if (time_log.submit_ts_ > 0) {
+      histograms[QUEUE].record(get_io_interval(time_log.submit_ts_, time_log.begin_ts_));
+    }
+    if (time_log.return_ts_ > 0) {
+      histograms[DEVICE].record(get_io_interval(time_log.return_ts_, time_log.submit_ts_));
+    }
+    if (time_log.callback_finish_ts_ > 0) {
+      histograms[CALLBACK].record(get_io_interval(time_log.callback_finish_ts_, time_log.callback_enqueue_ts_));
+    }
+  }
+}
+
+void ObIOLatencyStat::reset()
+{
+  for (int64_t i = 0; i < static_cast<int>(ObIOModule::MAX_MODULE); ++i) {
+    for (int64_t j = 0; j < static_cast<int>(ObIOMode::MAX_MODE); ++j) {
+      for (int64_t k = 0; k < MAX_PHASE; ++k) {
+        histograms_[i][j][k].reset();
+      }
+    }
+  }
+}
+
+void ObIOLatencyStat::print_histograms(const uint64_t tenant_id) const
+{
+  for (int64_t i = 0; i < static_cast<int>(ObIOModule::MAX_MODULE); ++i) {
+    for (int64_t j = 0; j < static_cast<int>(ObIOMode::MAX_MODE); ++j) {
+      for (int64_t k = 0; k < MAX_PHASE; ++k) {
+        const ObIOLatencyHistogram &histogram = histograms_[i][j][k];
+        if (histogram.get_count() > 0) {
+          char buckets_str[4096] = { 0 };
+          int64_t pos = 0;
+          for (int64_t idx = 0; idx < ObIOLatencyHistogram::BUCKET_CNT; ++idx) {
+            const int64_t bucket_count = histogram.get_bucket_count(idx);
+            if (bucket_count > 0 && OB_SUCCESS != databuff_printf(buckets_str, sizeof(buckets_str), pos,
+                "%ld:%ld ", ObIOLatencyHistogram::get_bucket_upper_bound(idx), bucket_count)) {
+              break; // the buckets are truncated
+            }
+          }
+          LOG_INFO("[IO LATENCY HISTOGRAM]", K(tenant_id),
+              "module", get_io_module_name(static_cast<ObIOModule>(i)),
+              "mode", get_io_mode_string(static_cast<ObIOMode>(j)),
+              "phase", get_phase_name(static_cast<Phase>(k)),
+              "count", histogram.get_count(),
+              "avg_us", histogram.get_sum() / histogram.get_count(),
+              "p50_us", histogram.get_percentile(50),
+              "p90_us", histogram.get_percentile(90),
+              "p99_us", histogram.get_percentile(99),
+              "p999_us", histogram.get_percentile(99.9),
+              "max_us", histogram.get_max(),
+              "buckets(upper_bound_us:count)", buckets_str);
+        }
+      }
+    }
+  }
+}
+
+const char *ObIOLatencyStat::get_phase_name(const Phase phase)
+{
+  const char *ret_name = "UNKNOWN";
+  switch (phase) {
+    case QUEUE:
+      ret_name = "QUEUE";
+      break;
+    case DEVICE:
+      ret_name = "DEVICE";
+      break;
+    case CALLBACK:
+      ret_name = "CALLBACK";
+      break;
+    default:
+      break;
+  }
+  return ret_name;
+}
+
 int64_t ObIOUsage::to_string(char* buf, const int64_t buf_len) const
 {
   int64_t pos = 0;
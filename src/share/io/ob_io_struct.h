@@ -157,6 +157,67 @@ private:
   int64_t doing_request_count_[static_cast<int>(ObIOCategory::MAX_CATEGORY)];
 };
 
+// HDR-style log-linear histogram of the latency in microseconds. The latency
+// below SUB_BUCKET_CNT is counted exactly and each power of two above is split
+// into SUB_BUCKET_CNT buckets, so the relative error of the percentiles is
+// bounded by 1 / SUB_BUCKET_CNT.
+class ObIOLatencyHistogram final
+{
+public:
+  static const int64_t SUB_BUCKET_BITS = 3;
+  static const int64_t SUB_BUCKET_CNT = 1L << SUB_BUCKET_BITS;
+  static const int64_t MAX_LATENCY_BITS = 30; // about 1000s, larger than the max io interval
+  static const int64_t BUCKET_CNT = (MAX_LATENCY_BITS - SUB_BUCKET_BITS + 1) * SUB_BUCKET_CNT;
+  ObIOLatencyHistogram();
+  ~ObIOLatencyHistogram() = default;
+  void record(const int64_t latency_us);
+  void reset();
+  int64_t get_count() const { return ATOMIC_LOAD(&count_); }
+  int64_t get_sum() const { return ATOMIC_LOAD(&sum_); }
+  int64_t get_max() const { return ATOMIC_LOAD(&max_); }
+  int64_t get_bucket_count(const int64_t idx) const { return ATOMIC_LOAD(&buckets_[idx]); }
+  // the upper bound of the bucket holding the percentile, 0 for empty histogram
+  int64_t get_percentile(const double percentage) const;
+  static int64_t get_bucket_idx(const int64_t latency_us);
+  static int64_t get_bucket_upper_bound(const int64_t idx);
+  TO_STRING_KV(K_(count), K_(sum), K_(max));
+private:
+  int64_t count_;
+  int64_t sum_;
+  int64_t max_;
+  int64_t buckets_[BUCKET_CNT];
+  DISALLOW_COPY_AND_ASSIGN(ObIOLatencyHistogram);
+};
+
+// The latency histograms of a tenant for each caller module, io mode and
+// phase of the request: waiting in the queues before submitted, on the
+// device, and waiting for and running the callback.
+class ObIOLatencyStat final
+{
+public:
+  enum Phase
+  {
+    QUEUE = 0,
+    DEVICE,
+    CALLBACK,
+    MAX_PHASE
+  };
+  ObIOLatencyStat() = default;
+  ~ObIOLatencyStat() = default;
+  void record(const ObIORequest &req);
+  void reset();
+  const ObIOLatencyHistogram &get_histogram(const ObIOModule module, const ObIOMode mode, const Phase phase) const
+  {
+    return histograms_[static_cast<int>(module)][static_cast<int>(mode)][phase];
+  }
+  // print the percentiles and the non empty buckets into log
+  void print_histograms(const uint64_t tenant_id) const;
+  static const char *get_phase_name(const Phase phase);
+private:
+  ObIOLatencyHistogram histograms_[static_cast<int>(ObIOModule::MAX_MODULE)][static_cast<int>(ObIOMode::MAX_MODE)][MAX_PHASE];
+  DISALLOW_COPY_AND_ASSIGN(ObIOLatencyStat);
+};
+
 class ObCpuUsage final
 {
 public:
@@ -4018,6 +4018,8 @@ OB_SERIALIZE_MEMBER(ObDumpTxDataMemtableArg, tenant_id_, ls_id_);
 
 OB_SERIALIZE_MEMBER(ObDumpSingleTxDataArg, tenant_id_, ls_id_, tx_id_);
 
+OB_SERIALIZE_MEMBER(ObDumpIOLatencyHistogramArg, tenant_id_, need_reset_);
+
 int ObRootMajorFreezeArg::assign(const ObRootMajorFreezeArg &other)
 {
   int ret = OB_SUCCESS;
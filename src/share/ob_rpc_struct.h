@@ -4724,6 +4724,20 @@ public:
   int64_t tx_id_;
 };
 
+struct ObDumpIOLatencyHistogramArg
+{
+  OB_UNIS_VERSION(1);
+public:
+  ObDumpIOLatencyHistogramArg() : tenant_id_(OB_INVALID_TENANT_ID), need_reset_(false) {}
+  // OB_INVALID_TENANT_ID for all tenants
+  bool is_valid() const { return true; }
+
+  TO_STRING_KV(K_(tenant_id), K_(need_reset));
+
+  uint64_t tenant_id_;
+  bool need_reset_; // reset the histograms after dumped, to start a new interval
+};
+
 struct ObUpdateIndexStatusArg : public ObDDLArg
 {
   OB_UNIS_VERSION(1);
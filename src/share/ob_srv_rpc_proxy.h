@@ -94,6 +94,7 @@ public:
   RPC_S(PR5 dump_memtable, OB_DUMP_MEMTABLE, (ObDumpMemtableArg));
   RPC_S(PR5 dump_tx_data_memtable, OB_DUMP_TX_DATA_MEMTABLE, (ObDumpTxDataMemtableArg));
   RPC_S(PR5 dump_single_tx_data, OB_DUMP_SINGLE_TX_DATA, (ObDumpSingleTxDataArg));
+  RPC_S(PR5 dump_io_latency_histogram, OB_DUMP_IO_LATENCY_HISTOGRAM, (ObDumpIOLatencyHistogramArg));
   RPC_S(PR5 halt_all_prewarming, OB_FORCE_PURGE_MEMTABLE);
   RPC_AP(PR5 halt_all_prewarming_async, OB_FORCE_PURGE_MEMTABLE_ASYNC, (obrpc::UInt64));
   RPC_S(PR5 set_debug_sync_action, OB_SET_DS_ACTION, (obrpc::ObDebugSyncActionArg));
@@ -405,10 +405,19 @@ DEF_INT(_temporary_file_io_area_size, OB_TENANT_PARAMETER, "1", "[0, 50)",
          "memory buffer size of temporary file, as a percentage of total tenant memory. "
          "Range: [0, 50), percentage",
          ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_temporary_file_compression, OB_TENANT_PARAMETER, "False",
+         "specifies whether the temporary file blocks are compressed by lz4 when they are flushed to disk. "
+         "Value: True: compress the blocks; False: write the blocks as they are",
+         ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_INT(_storage_meta_memory_limit_percentage, OB_TENANT_PARAMETER, "20", "[0, 50)",
          "maximum memory for storage meta, as a percentage of total tenant memory. "
          "Range: [0, 50), percentage, 0 means no limit to storage meta memory",
          ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_lazy_tablet_load, OB_TENANT_PARAMETER, "False",
+         "specifies whether the user tablets are released from memory after they are replayed on restart, "
+         "and loaded from disk on first access, the background scans of the tablets keep them released. "
+         "Value: True: load the tablets on first access; False: keep all the tablets in memory after restart",
+         ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 ////  rootservice config
 DEF_TIME(lease_time, OB_CLUSTER_PARAMETER, "10s", "[1s, 5m]",
          "Lease for current heartbeat. If the root server does not received any heartbeat "
@@ -532,6 +541,18 @@ DEF_INT(log_disk_percentage, OB_CLUSTER_PARAMETER, "0", "[0,99]",
 //        "Range: [0, ] in integer",
 //        ObParameterAttr(Section::LOGSERVICE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 
+DEF_INT(_log_restore_fetch_thread_num, OB_TENANT_PARAMETER, "4", "[1,32]",
+        "the number of threads which fetch the archive logs of the log streams in restore and write "
+        "them to the local log in parallel, the logs of one log stream are fetched by one thread at a time. "
+        "Range: [1, 32] in integer",
+        ObParameterAttr(Section::LOGSERVICE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+
+DEF_INT(_log_archive_sender_thread_num, OB_TENANT_PARAMETER, "4", "[1,32]",
+        "the max number of threads which send the archive logs of the log streams to the archive dest "
+        "in parallel, the threads in use follow the number of log streams waiting to be sent. "
+        "Range: [1, 32] in integer",
+        ObParameterAttr(Section::LOGSERVICE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+
 DEF_INT(log_disk_utilization_limit_threshold, OB_TENANT_PARAMETER, "95",
         "[80, 100]",
         "maximum of log disk usage percentage before stop submitting or receiving logs, "
@@ -637,6 +658,11 @@ DEF_INT(row_compaction_update_limit, OB_CLUSTER_PARAMETER, "6", "[1, 6400]",
         "maximum update count before trigger row compaction. "
         "Range: [1, 64]",
         ObParameterAttr(Section::TRANS, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_row_compaction_trim, OB_CLUSTER_PARAMETER, "False",
+         "specifies whether row compaction detaches the trans nodes older than the compact node "
+         "which is not larger than the min reserved snapshot of the tablet. "
+         "Value: True: enabled; False: disabled",
+         ObParameterAttr(Section::TRANS, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_BOOL(ignore_replay_checksum_error, OB_CLUSTER_PARAMETER, "False",
          "specifies whether error raised from the memtable replay checksum validation can be ignored. "
          "Value: True:ignored; False: not ignored",
@@ -654,10 +680,28 @@ DEF_TIME(_ob_trans_rpc_timeout, OB_CLUSTER_PARAMETER, "3s", "[0s, 3600s]",
 DEF_BOOL(enable_early_lock_release, OB_TENANT_PARAMETER, "False",
          "enable early lock release",
          ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_INT(_hotspot_row_elr_threshold, OB_TENANT_PARAMETER, "0", "[0,)",
+        "the number of row versions in memtable above which the autocommit statements conflicting on the row "
+        "release their row locks early, it takes effect only if enable_early_lock_release is on. "
+        "0 means disabled. Range: [0, +∞)",
+        ObParameterAttr(Section::TRANS, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 
 DEF_TIME(_ob_get_gts_ahead_interval, OB_CLUSTER_PARAMETER, "0s", "[0s, 1s]",
          "get gts ahead interval. Range: [0s, 1s]",
          ObParameterAttr(Section::TRANS, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_TIME(_gts_lease_duration, OB_CLUSTER_PARAMETER, "0s", "[0s, 10s]",
+         "the duration within which the read snapshot can be issued locally after the gts is fetched "
+         "from the remote gts leader, and the new gts leader issues no gts for such a duration after "
+         "taking over. 0 means disabled. Range: [0s, 10s]",
+         ObParameterAttr(Section::TRANS, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_TIME(_gts_lease_max_clock_skew, OB_CLUSTER_PARAMETER, "1ms", "[0s, 1s]",
+         "the max clock skew among the servers which may be the gts leader, "
+         "it is added to the timestamps issued by gts lease. Range: [0s, 1s]",
+         ObParameterAttr(Section::TRANS, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_TIME(_trx_msg_batch_window, OB_CLUSTER_PARAMETER, "0ms", "[0ms, 10ms]",
+         "the max time a two-phase commit message waits to be batched with the messages of other "
+         "transactions to the same server, 0 means the message is sent immediately. Range: [0ms, 10ms]",
+         ObParameterAttr(Section::TRANS, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 
 //// rpc config
 DEF_TIME(rpc_timeout, OB_CLUSTER_PARAMETER, "2s",
@@ -736,6 +780,9 @@ DEF_INT(_io_callback_thread_count, OB_TENANT_PARAMETER, "8", "[1,64]",
 DEF_STR(io_category_config, OB_TENANT_PARAMETER, "other: 100,100,100",
         "configs for different category of io request. specify with category name, minimal percentage, maximal percentage, weight percentage. devide the category with semicolon",
         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_STR(io_category_limit_config, OB_TENANT_PARAMETER, "",
+        "absolute limits for different category of io request. specify with category name, max read iops, max write iops, max read bandwidth and max write bandwidth in MB/s, 0 means unlimited. devide the category with semicolon, e.g. backup: 0,0,200,200",
+        ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_INT(_large_query_io_percentage, OB_CLUSTER_PARAMETER, "0", "[0,100]",
         "the max percentage of io resource for big query. Range: [0,100] in integer. Especially, 0 means unlimited. The default value is 0.",
         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
@@ -744,6 +791,13 @@ DEF_BOOL(_enable_parallel_minor_merge, OB_TENANT_PARAMETER, "True",
          "specifies whether enable parallel minor merge. "
          "Value: True:turned on;  False: turned off",
          ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_major_merge_column_stat, OB_TENANT_PARAMETER, "False",
+         "specifies whether collect the optimizer statistics of the columns during major merge, "
+         "the stats are reported only if all the rows of the partition are rewritten. "
+         "Only the histogram of the leading rowkey column is rebuilt, the other columns keep "
+         "their existing histograms. "
+         "Value: True:turned on;  False: turned off",
+         ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_INT(compaction_low_thread_score, OB_TENANT_PARAMETER, "0", "[0,100]",
         "the current work thread score of low priority compaction. Range: [0,100] in integer. Especially, 0 means default value",
         ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
@@ -753,6 +807,11 @@ DEF_INT(compaction_mid_thread_score, OB_TENANT_PARAMETER, "0", "[0,100]",
 DEF_INT(compaction_high_thread_score, OB_TENANT_PARAMETER, "0", "[0,100]",
         "the current work thread score of high priority compaction. Range: [0,100] in integer. Especially, 0 means default value",
         ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_TIME(_compaction_fg_io_rt_threshold, OB_TENANT_PARAMETER, "0ms", "[0ms, 10s]",
+         "the foreground io latency above which the concurrency of compaction is throttled, "
+         "and below half of which it is boosted up to twice of the thread score. "
+         "Range: [0ms, 10s]. Especially, 0 means the concurrency of compaction is not adjusted",
+         ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_INT(ha_high_thread_score, OB_TENANT_PARAMETER, "0", "[0,100]",
         "the current work thread score of high availability high thread. Range: [0,100] in integer. Especially, 0 means default value",
         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
@@ -790,6 +849,10 @@ DEF_TIME(_minor_compaction_interval, OB_TENANT_PARAMETER, "0s", "[0s,30m]",
          "the time interval to start next minor compaction, Range: [0s,30m]"
          "Range: [0s, 30m)",
          ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_uncommitted_row_backfill, OB_TENANT_PARAMETER, "False",
+         "specifies whether to schedule minor compaction for the minor sstable whose uncommitted rows "
+         "have all been decided, to fill in their commit versions. Value: True, False",
+         ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_INT(major_compact_trigger, OB_TENANT_PARAMETER, "0", "[0,65535]",
         "specifies how many minor freeze should be triggered between two major freeze, Range: [0,65535] in integer",
         ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
@@ -841,6 +904,10 @@ DEF_INT(_migrate_block_verify_level, OB_CLUSTER_PARAMETER, "1", "[0,2]",
         "1 : physical verification"
         "2 : logical verification",
         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_INT(_ha_copy_macro_block_window, OB_CLUSTER_PARAMETER, "4", "[1,8]",
+        "the number of macro blocks which are read ahead by the source and written in flight by the "
+        "destination when copying the sstables of a tablet in migration, rebuild and restore. Range: [1, 8]",
+        ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 
 DEF_TIME(_cache_wash_interval, OB_CLUSTER_PARAMETER, "200ms", "[1ms, 1m]",
         "specify interval of cache background wash",
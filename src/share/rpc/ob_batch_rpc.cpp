@@ -147,7 +147,11 @@ int ObBatchRpcBase::post(const uint64_t tenant_id, const ObAddr &dest, const int
       }
     }
   } else {
+    ATOMIC_INC(&batched_req_cnt_);
     if (delay_us_ <= 0) {
+      if (buffer->need_flush()) {
+        flush_cond_.signal();
+      }
       cond_.signal();
     }
   }
@@ -255,7 +259,11 @@ int ObBatchRpcBase::post(const uint64_t tenant_id, const ObAddr &dest, const int
       }
     }
   } else {
+    ATOMIC_INC(&batched_req_cnt_);
     if (delay_us_ <= 0) {
+      if (buffer->need_flush()) {
+        flush_cond_.signal();
+      }
       cond_.signal();
     }
   }
@@ -287,6 +295,10 @@ ObRpcBuffer* ObBatchRpcBase::fetch(const uint64_t tenant_id, const ObAddr &serve
 void ObBatchRpcBase::do_work()
 {
   if (is_inited_) {
+    const int64_t batch_window_us = get_batch_window_us_();
+    if (batch_window_us > 0) {
+      wait_batch_window_(batch_window_us);
+    }
     const int64_t start_ts = common::ObTimeUtility::current_time();
     static const int64_t CLEAN_SVR_INTERVAL = 15 * 24 * 3600 * 1000 * 1000l;  // clean server when idle time reachs 15d
     bool need_gc = false;
@@ -299,6 +311,7 @@ void ObBatchRpcBase::do_work()
       while (iter->send(*rpc_, iter->get_tenant_id(), self_, 0 == cnt) > 0) {
         cnt++;
       }
+      sent_pkt_cnt_ += cnt;
       if (start_ts - iter->get_last_use_ts() > CLEAN_SVR_INTERVAL
           && iter->is_empty()) {
         need_gc = true;
@@ -334,6 +347,7 @@ void ObBatchRpcBase::do_work()
         }
       }
     }
+    statistics_(start_ts);
     const int64_t cost_time = common::ObTimeUtility::current_time() - start_ts;
     int64_t sleep_ts = delay_us_ > 0 ? delay_us_ : (10 * 1000);
     sleep_ts -= cost_time;
@@ -361,6 +375,47 @@ void ObBatchRpcBase::destroy_buffer(RpcBuffer* p)
   ob_free(p);
 }
 
+int64_t ObBatchRpcBase::get_batch_window_us_() const
+{
+  int64_t window_us = 0;
+  if (TRX_BATCH_REQ_NODELAY == batch_type_ && delay_us_ <= 0) {
+    window_us = GCONF._trx_msg_batch_window;
+  }
+  return window_us;
+}
+
+// Wait for the requests of concurrent transactions to the same server to be
+// coalesced into one packet, the window ends early once any buffer is full.
+void ObBatchRpcBase::wait_batch_window_(const int64_t window_us)
+{
+  const int64_t start_ts = common::ObTimeUtility::current_time();
+  int64_t remain_us = window_us;
+  bool need_flush = false;
+  while (!need_flush && remain_us > 0) {
+    (void)flush_cond_.wait(remain_us);
+    RpcBuffer* iter = NULL;
+    while (!need_flush && NULL != (iter = buffer_map_->quick_next(iter))) {
+      need_flush = iter->need_flush();
+    }
+    remain_us = window_us - (common::ObTimeUtility::current_time() - start_ts);
+  }
+}
+
+void ObBatchRpcBase::statistics_(const int64_t cur_ts)
+{
+  if (cur_ts - last_stat_ts_ > STAT_INTERVAL) {
+    const int64_t batched_req_cnt = ATOMIC_LOAD(&batched_req_cnt_);
+    if (batched_req_cnt > 0) {
+      RPC_LOG(INFO, "batch rpc statistics", K_(batch_type), K(batched_req_cnt), K_(sent_pkt_cnt),
+              "req_cnt_per_pkt", batched_req_cnt / (sent_pkt_cnt_ + 1),
+              "batch_window_us", get_batch_window_us_());
+    }
+    ATOMIC_FAA(&batched_req_cnt_, -batched_req_cnt);
+    sent_pkt_cnt_ = 0;
+    last_stat_ts_ = cur_ts;
+  }
+}
+
 int ObBatchRpcBase::get_dst_svr_list(common::ObIArray<share::ObCascadMember> &dst_list)
 {
   int ret = OB_SUCCESS;
@@ -201,6 +201,8 @@ public:
       freeze(cur_read_seq);
     }
   }
+  // some buffer is full and waiting to be sent
+  bool has_frozen() const { return get_read_seq() < get_fill_seq(); }
   bool is_empty() const {
     bool bool_ret = false;
     const int64_t cur_read_seq = get_read_seq();
@@ -267,6 +269,9 @@ public:
   bool is_empty() const {
     return buffer_.is_empty();
   }
+  bool need_flush() const {
+    return buffer_.has_frozen();
+  }
   int64_t calc_hash(const uint64_t tenant_id, const common::ObAddr &addr, const int64_t dst_cluster_id) const
   {
     // server和cluster_id计算hash值与ObCascadMember::hash()一样
@@ -358,7 +363,9 @@ public:
   typedef common::FixedHash2<RpcBuffer> BufferMap;
   typedef SingleWaitCond SendCond;
   static const int64_t SVR_IDLE_TIME_THRESHOLD = 10 * 60 * 1000 * 1000L;  // 10 minutes
-  ObBatchRpcBase(): is_inited_(false), batch_type_(-1), self_(), delay_us_(0), rpc_(nullptr), buffer_map_(nullptr)
+  static const int64_t STAT_INTERVAL = 10 * 1000 * 1000;
+  ObBatchRpcBase(): is_inited_(false), batch_type_(-1), self_(), delay_us_(0), rpc_(nullptr), buffer_map_(nullptr),
+                    batched_req_cnt_(0), sent_pkt_cnt_(0), last_stat_ts_(0)
   {}
   ~ObBatchRpcBase()
   {
@@ -434,6 +441,11 @@ protected:
 private:
   RpcBuffer* create_buffer(const uint64_t tenant_id, const common::ObAddr& addr, const int64_t dst_cluster_id);
   void destroy_buffer(RpcBuffer* p);
+  // the time a request of no-delay batch type may wait to be coalesced with
+  // the following requests to the same server, 0 means sent immediately
+  int64_t get_batch_window_us_() const;
+  void wait_batch_window_(const int64_t window_us);
+  void statistics_(const int64_t cur_ts);
 private:
   bool is_inited_;
   int batch_type_;
@@ -441,7 +453,12 @@ private:
   int64_t delay_us_;
   Rpc* rpc_;
   SendCond cond_;
+  // signaled when a buffer is full during the batch window
+  SendCond flush_cond_;
   BufferMap *buffer_map_;
+  int64_t batched_req_cnt_;
+  int64_t sent_pkt_cnt_;
+  int64_t last_stat_ts_;
 };
 
 class ObBatchRpc: public lib::TGRunnable
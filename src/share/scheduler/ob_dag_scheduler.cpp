@@ -28,6 +28,8 @@
 #include "storage/compaction/ob_tenant_compaction_progress.h"
 #include "storage/compaction/ob_tablet_merge_ctx.h"
 #include "storage/compaction/ob_compaction_diagnose.h"
+#include "storage/tx_storage/ob_tenant_freezer.h"
+#include "share/io/ob_io_manager.h"
 #include <sys/sysinfo.h>
 #include <algorithm>
 
@@ -1168,6 +1170,37 @@ const char *ObIDag::get_dag_module_str(const enum ObDagType::ObDagTypeEnum type)
   return str;
 }
 
+ObIOCategory ObIDag::get_io_category(const ObDagType::ObDagTypeEnum type)
+{
+  ObIOCategory category = ObIOCategory::MAX_CATEGORY;
+  switch (type) {
+    case ObDagType::DAG_TYPE_MINI_MERGE:
+    case ObDagType::DAG_TYPE_MINOR_MERGE:
+    case ObDagType::DAG_TYPE_MAJOR_MERGE:
+    case ObDagType::DAG_TYPE_TX_TABLE_MERGE:
+    case ObDagType::DAG_TYPE_WRITE_CKPT:
+    case ObDagType::DAG_TYPE_DDL_KV_MERGE:
+      category = ObIOCategory::COMPACTION_IO;
+      break;
+    case ObDagType::DAG_TYPE_MIGRATE:
+    case ObDagType::DAG_TYPE_FAST_MIGRATE:
+    case ObDagType::DAG_TYPE_VALIDATE:
+    case ObDagType::DAG_TYPE_BACKFILL_TX:
+    case ObDagType::DAG_TYPE_RESTORE:
+      category = ObIOCategory::MIGRATION_IO;
+      break;
+    case ObDagType::DAG_TYPE_BACKUP:
+    case ObDagType::DAG_TYPE_BACKUP_BACKUPSET:
+    case ObDagType::DAG_TYPE_BACKUP_ARCHIVELOG:
+    case ObDagType::DAG_TYPE_BACKUP_CLEAN:
+      category = ObIOCategory::BACKUP_IO;
+      break;
+    default:
+      break;
+  }
+  return category;
+}
+
 const char *ObIDag::get_dag_prio_str(const ObDagPrio::ObDagPrioEnum prio)
 {
   const char *str = "";
@@ -1390,11 +1423,13 @@ void ObTenantDagWorker::run1()
           COMMON_LOG(WARN, "invalid compat mode", K(ret), K(*dag));
         } else {
           THIS_WORKER.set_compatibility_mode(compat_mode);
+          set_thread_sys_io_category(ObIDag::get_io_category(dag->get_type()));
           if (OB_FAIL(task_->do_work())) {
             if (!dag->ignore_warning()) {
               COMMON_LOG(WARN, "failed to do work", K(ret), K(*task_), K(compat_mode));
             }
           }
+          set_thread_sys_io_category(ObIOCategory::MAX_CATEGORY);
         }
       }
 
@@ -1455,6 +1490,52 @@ void ObTenantDagWorker::yield()
   }
 }
 
+/***************************************ObCompactionConcurrencyController impl********************************************/
+
+void ObCompactionConcurrencyController::update(
+    const int64_t rt_threshold_us,
+    const int64_t fg_rt_us,
+    const bool memstore_pressure)
+{
+  if (rt_threshold_us <= 0) {
+    reset();
+  } else {
+    major_factor_pct_ = next_factor_(major_factor_pct_, rt_threshold_us, fg_rt_us);
+    if (memstore_pressure) {
+      // writes will be throttled if the frozen memstores can't be dumped in time,
+      // which hurts the foreground more than the io of mini and minor merge
+      dump_factor_pct_ = MIN(MAX(dump_factor_pct_, DEFAULT_FACTOR_PCT) + INCREASE_STEP_PCT, MAX_FACTOR_PCT);
+    } else {
+      dump_factor_pct_ = next_factor_(dump_factor_pct_, rt_threshold_us, fg_rt_us);
+    }
+  }
+}
+
+int64_t ObCompactionConcurrencyController::next_factor_(
+    const int64_t factor_pct,
+    const int64_t rt_threshold_us,
+    const int64_t fg_rt_us)
+{
+  int64_t next_factor_pct = factor_pct;
+  if (fg_rt_us > rt_threshold_us) {
+    next_factor_pct = MAX(factor_pct / 2, MIN_FACTOR_PCT);
+  } else if (fg_rt_us * 2 < rt_threshold_us) {
+    next_factor_pct = MIN(factor_pct + INCREASE_STEP_PCT, MAX_FACTOR_PCT);
+  }
+  return next_factor_pct;
+}
+
+int32_t ObCompactionConcurrencyController::get_limit(const int64_t priority, const int32_t score) const
+{
+  int64_t factor_pct = DEFAULT_FACTOR_PCT;
+  if (ObDagPrio::DAG_PRIO_COMPACTION_HIGH == priority || ObDagPrio::DAG_PRIO_COMPACTION_MID == priority) {
+    factor_pct = dump_factor_pct_;
+  } else if (ObDagPrio::DAG_PRIO_COMPACTION_LOW == priority) {
+    factor_pct = major_factor_pct_;
+  }
+  return static_cast<int32_t>(MAX(score * factor_pct / 100, 1));
+}
+
 /***************************************ObTenantDagScheduler impl********************************************/
 
 int ObTenantDagScheduler::mtl_init(ObTenantDagScheduler* &scheduler)
@@ -1478,6 +1559,7 @@ ObTenantDagScheduler::ObTenantDagScheduler()
     work_thread_num_(0),
     default_work_thread_num_(0),
     total_running_task_cnt_(0),
+    last_adjust_ts_(0),
     tg_id_(-1)
 {
 }
@@ -1630,6 +1712,8 @@ void ObTenantDagScheduler::destroy()
     work_thread_num_ = 0;
     total_running_task_cnt_ = 0;
     MEMSET(running_task_cnts_, 0, sizeof(running_task_cnts_));
+    concurrency_controller_.reset();
+    last_adjust_ts_ = 0;
     MEMSET(dag_cnts_, 0, sizeof(dag_cnts_));
     MEMSET(dag_net_cnts_, 0, sizeof(dag_net_cnts_));
     waiting_workers_.reset();
@@ -1685,6 +1769,7 @@ void ObTenantDagScheduler::get_default_config()
   for (int64_t i = 0; i < ObDagPrio::DAG_PRIO_MAX; ++i) { // calc sum of default_low_limit
     low_limits_[i] = OB_DAG_PRIOS[i].score_; // temp solution
     up_limits_[i] = OB_DAG_PRIOS[i].score_;
+    thread_scores_[i] = OB_DAG_PRIOS[i].score_;
     threads_sum += up_limits_[i];
   }
   work_thread_num_ = threads_sum;
@@ -2136,6 +2221,7 @@ void ObTenantDagScheduler::run1()
   lib::set_thread_name("DagScheduler");
   while (!has_set_stop()) {
     dump_dag_status();
+    adjust_compaction_concurrency();
     loop_dag_net();
     {
       ObThreadCondGuard guard(scheduler_sync_);
@@ -2968,7 +3054,8 @@ int ObTenantDagScheduler::set_thread_score(const int64_t priority, const int32_t
   } else {
     ObThreadCondGuard guard(scheduler_sync_);
     const int32_t old_val = up_limits_[priority];
-    up_limits_[priority] = 0 == score ? OB_DAG_PRIOS[priority].score_ : score;
+    thread_scores_[priority] = 0 == score ? OB_DAG_PRIOS[priority].score_ : score;
+    up_limits_[priority] = concurrency_controller_.get_limit(priority, thread_scores_[priority]);
     low_limits_[priority] = up_limits_[priority];
     if (old_val != up_limits_[priority]) {
       update_work_thread_num();
@@ -2981,6 +3068,73 @@ int ObTenantDagScheduler::set_thread_score(const int64_t priority, const int32_t
   return ret;
 }
 
+void ObTenantDagScheduler::adjust_compaction_concurrency()
+{
+  int ret = OB_SUCCESS;
+  const int64_t cur_ts = ObTimeUtility::fast_current_time();
+  int64_t rt_threshold_us = 0;
+  if (cur_ts - last_adjust_ts_ >= ObCompactionConcurrencyController::ADJUST_INTERVAL) {
+    last_adjust_ts_ = cur_ts;
+    {
+      omt::ObTenantConfigGuard tenant_config(TENANT_CONF(MTL_ID()));
+      if (tenant_config.is_valid()) {
+        rt_threshold_us = tenant_config->_compaction_fg_io_rt_threshold;
+      }
+    }
+    if (rt_threshold_us <= 0 && concurrency_controller_.is_default()) {
+      // disabled and nothing to restore
+    } else {
+      int64_t fg_rt_us = 0;
+      bool memstore_pressure = false;
+      common::ObTenantIOManager *io_manager = MTL(common::ObTenantIOManager*);
+      storage::ObTenantFreezer *freezer = MTL(storage::ObTenantFreezer*);
+      if (OB_NOT_NULL(io_manager)) {
+        // the io usage is refreshed by io tuner every second
+        common::ObIOUsage::AvgItems avg_iops, avg_bytes, avg_rt_us;
+        io_manager->get_io_usage().get_io_usage(avg_iops, avg_bytes, avg_rt_us);
+        fg_rt_us = static_cast<int64_t>(avg_rt_us[static_cast<int>(common::ObIOCategory::USER_IO)]
+                                                 [static_cast<int>(common::ObIOMode::READ)]);
+      }
+      if (OB_NOT_NULL(freezer)) {
+        int64_t active_memstore_used = 0;
+        int64_t total_memstore_used = 0;
+        int64_t memstore_freeze_trigger = 0;
+        int64_t memstore_limit = 0;
+        int64_t freeze_cnt = 0;
+        if (OB_FAIL(freezer->get_tenant_memstore_cond(active_memstore_used, total_memstore_used,
+            memstore_freeze_trigger, memstore_limit, freeze_cnt, false/*force_refresh*/))) {
+          COMMON_LOG(WARN, "failed to get tenant memstore cond", K(ret));
+        } else {
+          // the frozen memstores are waiting for dump
+          memstore_pressure = memstore_freeze_trigger > 0 && total_memstore_used > memstore_freeze_trigger;
+        }
+      }
+      concurrency_controller_.update(rt_threshold_us, fg_rt_us, memstore_pressure);
+
+      ObThreadCondGuard guard(scheduler_sync_);
+      bool changed = false;
+      for (int64_t i = 0; i < ObIDag::MergeDagPrioCnt; ++i) {
+        const int64_t priority = ObIDag::MergeDagPrio[i];
+        const int32_t up_limit = concurrency_controller_.get_limit(priority, thread_scores_[priority]);
+        if (up_limit != up_limits_[priority]) {
+          up_limits_[priority] = up_limit;
+          low_limits_[priority] = up_limit;
+          changed = true;
+        }
+      }
+      if (changed) {
+        update_work_thread_num();
+        scheduler_sync_.signal();
+        COMMON_LOG(INFO, "adjust compaction concurrency", K(rt_threshold_us), K(fg_rt_us),
+            K(memstore_pressure), K_(concurrency_controller), K_(work_thread_num),
+            "high", up_limits_[ObDagPrio::DAG_PRIO_COMPACTION_HIGH],
+            "mid", up_limits_[ObDagPrio::DAG_PRIO_COMPACTION_MID],
+            "low", up_limits_[ObDagPrio::DAG_PRIO_COMPACTION_LOW]);
+      }
+    }
+  }
+}
+
 int32_t ObTenantDagScheduler::get_running_task_cnt(const ObDagPrio::ObDagPrioEnum priority)
 {
   int32_t count = -1;
@@ -22,6 +22,7 @@
 #include "lib/lock/ob_mutex.h"
 #include "lib/profile/ob_trace_id.h"
 #include "share/rc/ob_tenant_base.h"
+#include "share/io/ob_io_define.h"
 #include "share/scheduler/ob_dag_scheduler_config.h"
 
 namespace oceanbase
@@ -257,6 +258,8 @@ public:
   static const char *get_dag_type_str(const ObDagType::ObDagTypeEnum type);
   static const char *get_dag_prio_str(const ObDagPrio::ObDagPrioEnum prio);
   static const char *get_dag_module_str(const enum ObDagType::ObDagTypeEnum type);
+  // the io category of the sys io issued by the dag, MAX_CATEGORY for keeping SYS_IO
+  static common::ObIOCategory get_io_category(const ObDagType::ObDagTypeEnum type);
   static bool is_finish_status(ObDagStatus dag_status)
   {
     return DAG_STATUS_FINISH == dag_status || DAG_STATUS_ABORT == dag_status;
@@ -729,6 +732,45 @@ public:
   int64_t total_mem_limit;
 };
 
+// ObCompactionConcurrencyController scales the thread limits of compaction
+// priorities by the feedback of foreground io latency and memstore pressure.
+//
+// The limits are cut by half once the foreground io latency exceeds the
+// threshold, and grow by step while the latency stays below half of it, up to
+// twice of the configured thread score when the tenant is idle. Mini and minor
+// merges release memstore, they are never throttled below the configured score
+// when the memstore is under pressure, and are boosted instead.
+class ObCompactionConcurrencyController
+{
+public:
+  static const int64_t MIN_FACTOR_PCT = 25;
+  static const int64_t MAX_FACTOR_PCT = 200;
+  static const int64_t DEFAULT_FACTOR_PCT = 100;
+  static const int64_t INCREASE_STEP_PCT = 10;
+  static const int64_t ADJUST_INTERVAL = 1000L * 1000L; // 1s
+
+  ObCompactionConcurrencyController() { reset(); }
+  ~ObCompactionConcurrencyController() = default;
+  void reset()
+  {
+    dump_factor_pct_ = DEFAULT_FACTOR_PCT;
+    major_factor_pct_ = DEFAULT_FACTOR_PCT;
+  }
+  bool is_default() const
+  {
+    return DEFAULT_FACTOR_PCT == dump_factor_pct_ && DEFAULT_FACTOR_PCT == major_factor_pct_;
+  }
+  // rt_threshold_us <= 0 means the controller is disabled
+  void update(const int64_t rt_threshold_us, const int64_t fg_rt_us, const bool memstore_pressure);
+  int32_t get_limit(const int64_t priority, const int32_t score) const;
+  TO_STRING_KV(K_(dump_factor_pct), K_(major_factor_pct));
+private:
+  static int64_t next_factor_(const int64_t factor_pct, const int64_t rt_threshold_us, const int64_t fg_rt_us);
+private:
+  int64_t dump_factor_pct_; // mini and minor merge
+  int64_t major_factor_pct_;
+};
+
 class ObTenantDagScheduler : public lib::TGRunnable
 {
   friend class ObTenantDagWorker;
@@ -872,6 +914,7 @@ private:
   void pause_worker(ObTenantDagWorker &worker, const int64_t priority);
   void dump_dag_status();
   int check_need_load_shedding(const int64_t priority, const bool for_schedule, bool &need_shedding);
+  void adjust_compaction_concurrency();
   void update_work_thread_num();
   int move_dag_to_list_(
       ObIDag *dag,
@@ -917,6 +960,7 @@ private:
   int32_t running_task_cnts_[ObDagPrio::DAG_PRIO_MAX];
   int32_t low_limits_[ObDagPrio::DAG_PRIO_MAX]; // wait to delete
   int32_t up_limits_[ObDagPrio::DAG_PRIO_MAX]; // wait to delete
+  int32_t thread_scores_[ObDagPrio::DAG_PRIO_MAX]; // configured limits before adjusted
   int64_t dag_cnts_[ObDagType::DAG_TYPE_MAX];
   int64_t dag_net_cnts_[ObDagNetType::DAG_NET_TYPE_MAX];
   common::ObConcurrentFIFOAllocator allocator_;
@@ -924,6 +968,8 @@ private:
   PriorityWorkerList running_workers_; // running workers
   WorkerList free_workers_; // free workers who have not been assigned to any task
   DagNetIdMap dag_net_id_map_; // for HA to search dag_net of specified dag_id
+  ObCompactionConcurrencyController concurrency_controller_;
+  int64_t last_adjust_ts_;
   int tg_id_;
 };
 
@@ -0,0 +1,1144 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_ENG
+
+#include "sql/engine/cmd/ob_load_data_direct_impl.h"
+
+#include <algorithm>
+#include "lib/oblog/ob_log_module.h"
+#include "lib/string/ob_sql_string.h"
+#include "lib/mysqlclient/ob_mysql_proxy.h"
+#include "share/object/ob_obj_cast.h"
+#include "share/schema/ob_table_schema.h"
+#include "share/location_cache/ob_location_struct.h"
+#include "share/ob_ddl_common.h"
+#include "share/ob_max_id_fetcher.h"
+#include "observer/ob_server_struct.h"
+#include "storage/tx/ob_ts_mgr.h"
+#include "observer/ob_inner_sql_connection_pool.h"
+#include "sql/ob_sql_utils.h"
+#include "sql/ob_sql_trans_control.h"
+#include "sql/das/ob_das_location_router.h"
+#include "sql/engine/ob_exec_context.h"
+
+using namespace oceanbase::common;
+using namespace oceanbase::share;
+using namespace oceanbase::share::schema;
+using namespace oceanbase::storage;
+using namespace oceanbase::blocksstable;
+using namespace oceanbase::transaction::tablelock;
+
+namespace oceanbase
+{
+namespace sql
+{
+
+int64_t ObLoadDataDirectRow::get_deep_copy_size() const
+{
+  int64_t size = sizeof(ObObj) * cell_cnt_;
+  for (int64_t i = 0; NULL != cells_ && i < cell_cnt_; ++i) {
+    size += cells_[i].get_deep_copy_size();
+  }
+  return size;
+}
+
+int ObLoadDataDirectRow::deep_copy(const ObLoadDataDirectRow &src, char *buf, const int64_t len, int64_t &pos)
+{
+  int ret = OB_SUCCESS;
+  const int64_t copy_size = src.get_deep_copy_size();
+  if (OB_UNLIKELY(!src.is_valid() || NULL == buf || len - pos < copy_size)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(src), KP(buf), K(len), K(pos), K(copy_size));
+  } else {
+    tablet_id_ = src.tablet_id_;
+    seq_ = src.seq_;
+    cell_cnt_ = src.cell_cnt_;
+    cells_ = reinterpret_cast<ObObj *>(buf + pos);
+    pos += sizeof(ObObj) * cell_cnt_;
+    for (int64_t i = 0; OB_SUCC(ret) && i < cell_cnt_; ++i) {
+      new (cells_ + i) ObObj();
+      if (OB_FAIL(cells_[i].deep_copy(src.cells_[i], buf, len, pos))) {
+        LOG_WARN("fail to deep copy cell", K(ret), K(i));
+      }
+    }
+  }
+  return ret;
+}
+
+DEFINE_SERIALIZE(ObLoadDataDirectRow)
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(tablet_id_.serialize(buf, buf_len, pos))) {
+    LOG_WARN("fail to serialize tablet id", K(ret));
+  } else if (OB_FAIL(serialization::encode_vi64(buf, buf_len, pos, seq_))) {
+    LOG_WARN("fail to encode seq", K(ret));
+  } else if (OB_FAIL(serialization::encode_vi64(buf, buf_len, pos, cell_cnt_))) {
+    LOG_WARN("fail to encode cell count", K(ret));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < cell_cnt_; ++i) {
+    if (OB_FAIL(cells_[i].serialize(buf, buf_len, pos))) {
+      LOG_WARN("fail to serialize cell", K(ret), K(i));
+    }
+  }
+  return ret;
+}
+
+// the cells are reused, they are allocated by the deep copy of the sample row
+DEFINE_DESERIALIZE(ObLoadDataDirectRow)
+{
+  int ret = OB_SUCCESS;
+  int64_t cell_cnt = 0;
+  if (OB_FAIL(tablet_id_.deserialize(buf, data_len, pos))) {
+    LOG_WARN("fail to deserialize tablet id", K(ret));
+  } else if (OB_FAIL(serialization::decode_vi64(buf, data_len, pos, &seq_))) {
+    LOG_WARN("fail to decode seq", K(ret));
+  } else if (OB_FAIL(serialization::decode_vi64(buf, data_len, pos, &cell_cnt))) {
+    LOG_WARN("fail to decode cell count", K(ret));
+  } else if (OB_UNLIKELY(NULL == cells_ || cell_cnt != cell_cnt_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("cells are not prepared", K(ret), KP(cells_), K(cell_cnt), K(cell_cnt_));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < cell_cnt_; ++i) {
+    if (OB_FAIL(cells_[i].deserialize(buf, data_len, pos))) {
+      LOG_WARN("fail to deserialize cell", K(ret), K(i));
+    }
+  }
+  return ret;
+}
+
+DEFINE_GET_SERIALIZE_SIZE(ObLoadDataDirectRow)
+{
+  int64_t size = 0;
+  size += tablet_id_.get_serialize_size();
+  size += serialization::encoded_length_vi64(seq_);
+  size += serialization::encoded_length_vi64(cell_cnt_);
+  for (int64_t i = 0; i < cell_cnt_; ++i) {
+    size += cells_[i].get_serialize_size();
+  }
+  return size;
+}
+
+bool ObLoadDataDirectRowCompare::operator()(const ObLoadDataDirectRow *left,
+                                            const ObLoadDataDirectRow *right)
+{
+  bool bret = false;
+  int ret = OB_SUCCESS;
+  int cmp = 0;
+  if (OB_UNLIKELY(OB_SUCCESS != result_code_)) {
+    //do nothing
+  } else if (OB_ISNULL(left) || OB_ISNULL(right)) {
+    result_code_ = OB_INVALID_ARGUMENT;
+    LOG_WARN("row should not be null", K_(result_code), KP(left), KP(right));
+  } else if (left->tablet_id_ != right->tablet_id_) {
+    bret = left->tablet_id_ < right->tablet_id_;
+  } else if (OB_FAIL(compare_rowkey(*left, *right, rowkey_cnt_, cmp))) {
+    result_code_ = ret;
+    LOG_WARN("fail to compare rowkey", K_(result_code));
+  } else if (0 != cmp) {
+    bret = cmp < 0;
+  } else {
+    bret = left->seq_ < right->seq_;
+  }
+  return bret;
+}
+
+int ObLoadDataDirectRowCompare::compare_rowkey(const ObLoadDataDirectRow &left,
+                                               const ObLoadDataDirectRow &right,
+                                               const int64_t rowkey_cnt,
+                                               int &cmp)
+{
+  int ret = OB_SUCCESS;
+  cmp = 0;
+  if (OB_UNLIKELY(left.cell_cnt_ < rowkey_cnt || right.cell_cnt_ < rowkey_cnt)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(left), K(right), K(rowkey_cnt));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && 0 == cmp && i < rowkey_cnt; ++i) {
+    if (OB_FAIL(left.cells_[i].compare(right.cells_[i], cmp))) {
+      LOG_WARN("fail to compare cell", K(ret), K(i), K(left.cells_[i]), K(right.cells_[i]));
+    }
+  }
+  return ret;
+}
+
+ObLoadDataDirectTaskCtx::ObLoadDataDirectTaskCtx(const ObLoadDataDirectParam &param)
+  : is_inited_(false),
+    param_(param),
+    allocator_("LoadDirectTask"),
+    cast_allocator_("LoadDirectCast"),
+    sort_ret_(OB_SUCCESS),
+    compare_(sort_ret_, param.rowkey_cnt_),
+    sorter_(),
+    row_(),
+    row_cnt_(0)
+{
+}
+
+ObLoadDataDirectTaskCtx::~ObLoadDataDirectTaskCtx()
+{
+  sorter_.clean_up();
+}
+
+int ObLoadDataDirectTaskCtx::init()
+{
+  int ret = OB_SUCCESS;
+  const int64_t cell_cnt = param_.columns_.count();
+  ObObj *cells = NULL;
+  if (OB_UNLIKELY(is_inited_)) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("init twice", K(ret));
+  } else if (OB_UNLIKELY(cell_cnt <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K_(param));
+  } else if (OB_ISNULL(cells = static_cast<ObObj *>(allocator_.alloc(sizeof(ObObj) * cell_cnt)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to allocate memory", K(ret), K(cell_cnt));
+  } else if (OB_FAIL(sorter_.init(SORT_MEMORY_LIMIT,
+                                  ObLoadDataDirectImpl::FILE_BUFFER_SIZE,
+                                  param_.expire_ts_,
+                                  param_.tenant_id_,
+                                  &compare_))) {
+    LOG_WARN("fail to init sorter", K(ret));
+  } else {
+    for (int64_t i = 0; i < cell_cnt; ++i) {
+      new (cells + i) ObObj();
+    }
+    row_.cells_ = cells;
+    row_.cell_cnt_ = cell_cnt;
+    is_inited_ = true;
+  }
+  return ret;
+}
+
+int ObLoadDataDirectTaskCtx::add_line(const int64_t seq,
+                                      const ObTabletID &tablet_id,
+                                      const ObIArray<ObCSVGeneralParser::FieldValue> &fields,
+                                      const ObDataTypeCastParams &dtc_params,
+                                      const ObCastMode cast_mode)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else {
+    cast_allocator_.reuse();
+    row_.tablet_id_ = tablet_id;
+    row_.seq_ = seq;
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < param_.columns_.count(); ++i) {
+    const ObLoadDataDirectColumn &column = param_.columns_.at(i);
+    const ObCollationType cs_type = column.meta_.get_collation_type();
+    ObObj &cell = row_.cells_[i];
+    ObObj field_obj;
+    if (column.field_idx_ >= fields.count()) {
+      //the line has less fields than the field list, the missing ones are null
+      field_obj.set_null();
+    } else {
+      ObLoadDataBase::field_to_obj(field_obj, fields.at(column.field_idx_),
+                                   param_.file_cs_type_, column.is_string_column_);
+    }
+    if (field_obj.is_null()) {
+      if (OB_UNLIKELY(!column.is_nullable_)) {
+        ret = OB_BAD_NULL_ERROR;
+        LOG_WARN("null value for not null column", K(ret), K(column));
+      } else {
+        cell.set_null();
+      }
+    } else {
+      ObCastCtx cast_ctx(&cast_allocator_, &dtc_params, cast_mode, cs_type);
+      ObObj cast_obj;
+      ObObj buf_obj;
+      const ObObj *res_obj = NULL;
+      if (OB_FAIL(ObObjCaster::to_type(column.meta_.get_type(), cs_type, cast_ctx,
+                                       field_obj, cast_obj))) {
+        LOG_WARN("fail to cast field", K(ret), K(column), K(field_obj));
+      } else if (OB_FAIL(obj_accuracy_check(cast_ctx, column.accuracy_, cs_type,
+                                            cast_obj, buf_obj, res_obj))) {
+        LOG_WARN("fail to check accuracy", K(ret), K(column), K(cast_obj));
+      } else if (OB_ISNULL(res_obj)) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("result obj is null", K(ret));
+      } else {
+        cell = *res_obj;
+      }
+    }
+  }
+  if (OB_SUCC(ret)) {
+    if (OB_FAIL(sorter_.add_item(row_))) {
+      LOG_WARN("fail to add row to sorter", K(ret), K_(row));
+    } else if (OB_FAIL(sort_ret_)) {
+      LOG_WARN("fail to compare rows", K(ret));
+    } else {
+      ++row_cnt_;
+    }
+  }
+  return ret;
+}
+
+int ObLoadDataDirectTaskCtx::transfer_sorted_rows(ObLoadDataDirectSorter &merge_sorter)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_FAIL(sorter_.do_sort(false /*final_merge*/))) {
+    LOG_WARN("fail to sort rows", K(ret));
+  } else if (OB_FAIL(sort_ret_)) {
+    LOG_WARN("fail to compare rows", K(ret));
+  } else if (OB_FAIL(sorter_.transfer_final_sorted_fragment_iter(merge_sorter))) {
+    LOG_WARN("fail to transfer sorted fragment", K(ret));
+  }
+  return ret;
+}
+
+int ObLoadDataDirectRowIterator::RowHolder::copy(const ObLoadDataDirectRow &src)
+{
+  int ret = OB_SUCCESS;
+  const int64_t size = src.get_deep_copy_size();
+  char *buf = NULL;
+  int64_t pos = 0;
+  allocator_.reuse();
+  if (OB_ISNULL(buf = static_cast<char *>(allocator_.alloc(size)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to allocate memory", K(ret), K(size));
+  } else if (OB_FAIL(row_.deep_copy(src, buf, size, pos))) {
+    LOG_WARN("fail to deep copy row", K(ret), K(src));
+  }
+  return ret;
+}
+
+ObLoadDataDirectRowIterator::ObLoadDataDirectRowIterator()
+  : is_inited_(false),
+    allocator_("LoadDirectIter"),
+    sorter_(NULL),
+    param_(NULL),
+    tablet_id_(),
+    pending_idx_(-1),
+    is_end_(false),
+    new_row_(),
+    duplicated_row_cnt_(0)
+{
+}
+
+ObLoadDataDirectRowIterator::~ObLoadDataDirectRowIterator()
+{
+  reset();
+}
+
+int ObLoadDataDirectRowIterator::init(ObLoadDataDirectSorter &sorter,
+                                      const ObLoadDataDirectParam &param)
+{
+  int ret = OB_SUCCESS;
+  const int64_t cell_cnt = param.columns_.count()
+                           + storage::ObMultiVersionRowkeyHelpper::get_extra_rowkey_col_cnt();
+  ObObj *cells = NULL;
+  if (OB_UNLIKELY(is_inited_)) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("init twice", K(ret));
+  } else if (OB_UNLIKELY(param.columns_.count() < param.rowkey_cnt_ || param.rowkey_cnt_ <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(param));
+  } else if (OB_ISNULL(cells = static_cast<ObObj *>(allocator_.alloc(sizeof(ObObj) * cell_cnt)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to allocate memory", K(ret), K(cell_cnt));
+  } else {
+    for (int64_t i = 0; i < cell_cnt; ++i) {
+      new (cells + i) ObObj();
+    }
+    new_row_.assign(cells, cell_cnt);
+    sorter_ = &sorter;
+    param_ = &param;
+    pending_idx_ = -1;
+    is_end_ = false;
+    duplicated_row_cnt_ = 0;
+    is_inited_ = true;
+  }
+  return ret;
+}
+
+void ObLoadDataDirectRowIterator::reset()
+{
+  is_inited_ = false;
+  sorter_ = NULL;
+  param_ = NULL;
+  tablet_id_.reset();
+  pending_idx_ = -1;
+  is_end_ = false;
+  new_row_.reset();
+  duplicated_row_cnt_ = 0;
+  allocator_.reset();
+}
+
+int ObLoadDataDirectRowIterator::get_next_row(ObNewRow *&row)
+{
+  UNUSEDx(row);
+  return OB_NOT_SUPPORTED;
+}
+
+int ObLoadDataDirectRowIterator::fetch_row(RowHolder &holder, bool &is_end)
+{
+  int ret = OB_SUCCESS;
+  const ObLoadDataDirectRow *item = NULL;
+  is_end = false;
+  if (OB_FAIL(sorter_->get_next_item(item))) {
+    if (OB_ITER_END == ret) {
+      is_end = true;
+      ret = OB_SUCCESS;
+    } else {
+      LOG_WARN("fail to get next item", K(ret));
+    }
+  } else if (OB_ISNULL(item)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("item is null", K(ret));
+  } else if (OB_FAIL(holder.copy(*item))) {
+    LOG_WARN("fail to copy row", K(ret));
+  }
+  return ret;
+}
+
+int ObLoadDataDirectRowIterator::peek_tablet_id(ObTabletID &tablet_id)
+{
+  int ret = OB_SUCCESS;
+  bool is_end = false;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (pending_idx_ < 0 && !is_end_) {
+    if (OB_FAIL(fetch_row(holders_[0], is_end))) {
+      LOG_WARN("fail to fetch row", K(ret));
+    } else if (is_end) {
+      is_end_ = true;
+    } else {
+      pending_idx_ = 0;
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (pending_idx_ < 0) {
+    ret = OB_ITER_END;
+  } else {
+    tablet_id = holders_[pending_idx_].row_.tablet_id_;
+  }
+  return ret;
+}
+
+int ObLoadDataDirectRowIterator::get_next_row_with_tablet_id(
+    const uint64_t table_id,
+    const int64_t rowkey_count,
+    const int64_t snapshot_version,
+    ObNewRow *&row,
+    ObTabletID &tablet_id)
+{
+  UNUSED(table_id);
+  int ret = OB_SUCCESS;
+  ObTabletID next_tablet_id;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_UNLIKELY(rowkey_count != param_->rowkey_cnt_ || snapshot_version <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(rowkey_count), K(snapshot_version), KPC_(param));
+  } else if (OB_FAIL(peek_tablet_id(next_tablet_id))) {
+    if (OB_ITER_END != ret) {
+      LOG_WARN("fail to peek tablet id", K(ret));
+    }
+  } else if (next_tablet_id != tablet_id_) {
+    // the rows of the current tablet are all returned, the row is kept for the next slice
+    row = &new_row_;
+    tablet_id = next_tablet_id;
+  } else {
+    int64_t out_idx = pending_idx_;
+    bool is_duplicated = true;
+    pending_idx_ = -1;
+    while (OB_SUCC(ret) && is_duplicated && !is_end_) {
+      const int64_t next_idx = 1 - out_idx;
+      const ObLoadDataDirectRow &out_row = holders_[out_idx].row_;
+      const ObLoadDataDirectRow &next_row = holders_[next_idx].row_;
+      bool is_end = false;
+      int cmp = 0;
+      if (OB_FAIL(fetch_row(holders_[next_idx], is_end))) {
+        LOG_WARN("fail to fetch row", K(ret));
+      } else if (is_end) {
+        is_end_ = true;
+      } else if (next_row.tablet_id_ != out_row.tablet_id_) {
+        is_duplicated = false;
+      } else if (OB_FAIL(ObLoadDataDirectRowCompare::compare_rowkey(
+                           out_row, next_row, param_->rowkey_cnt_, cmp))) {
+        LOG_WARN("fail to compare rowkey", K(ret));
+      } else if (0 != cmp) {
+        is_duplicated = false;
+      } else {
+        ++duplicated_row_cnt_;
+        switch (param_->dupl_action_) {
+          case ObLoadDupActionType::LOAD_REPLACE:
+            // the rows of the same rowkey are sorted by the position in the file, the last one wins
+            out_idx = next_idx;
+            break;
+          case ObLoadDupActionType::LOAD_IGNORE:
+            break;
+          default:
+            ret = OB_ERR_PRIMARY_KEY_DUPLICATE;
+            LOG_WARN("duplicated rowkey", K(ret), K(out_row), K(next_row));
+            break;
+        }
+      }
+      if (OB_SUCC(ret) && !is_duplicated) {
+        pending_idx_ = next_idx;
+      }
+    }
+    if (OB_FAIL(ret)) {
+    } else if (OB_FAIL(fill_row(holders_[out_idx].row_, snapshot_version))) {
+      LOG_WARN("fail to fill row", K(ret));
+    } else {
+      row = &new_row_;
+      tablet_id = tablet_id_;
+    }
+  }
+  return ret;
+}
+
+int ObLoadDataDirectRowIterator::fill_row(const ObLoadDataDirectRow &src, const int64_t snapshot_version)
+{
+  int ret = OB_SUCCESS;
+  const int64_t rowkey_cnt = param_->rowkey_cnt_;
+  const int64_t extra_rowkey_cnt = storage::ObMultiVersionRowkeyHelpper::get_extra_rowkey_col_cnt();
+  if (OB_UNLIKELY(src.cell_cnt_ + extra_rowkey_cnt != new_row_.count_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("unexpected cell count", K(ret), K(src), K_(new_row));
+  } else {
+    for (int64_t i = 0; i < rowkey_cnt; ++i) {
+      new_row_.cells_[i] = src.cells_[i];
+    }
+    new_row_.cells_[rowkey_cnt].set_int(-snapshot_version);
+    new_row_.cells_[rowkey_cnt + 1].set_int(0);
+    for (int64_t i = rowkey_cnt; i < src.cell_cnt_; ++i) {
+      new_row_.cells_[i + extra_rowkey_cnt] = src.cells_[i];
+    }
+  }
+  return ret;
+}
+
+ObLoadDataDirectImpl::ObLoadDataDirectImpl()
+  : is_direct_(false), is_locked_(false), param_(), task_ctxs_()
+{
+}
+
+ObLoadDataDirectImpl::~ObLoadDataDirectImpl()
+{
+  destroy_task_ctxs();
+}
+
+void ObLoadDataDirectImpl::destroy_task_ctxs()
+{
+  for (int64_t i = 0; i < task_ctxs_.count(); ++i) {
+    if (OB_NOT_NULL(task_ctxs_.at(i))) {
+      task_ctxs_.at(i)->~ObLoadDataDirectTaskCtx();
+    }
+  }
+  task_ctxs_.reset();
+}
+
+int ObLoadDataDirectImpl::execute(ObExecContext &ctx, ObLoadDataStmt &load_stmt)
+{
+  int ret = OB_SUCCESS;
+  bool is_supported = false;
+  if (OB_FAIL(init_param(ctx, load_stmt, is_supported))) {
+    LOG_WARN("fail to init direct load param", K(ret));
+  } else {
+    is_direct_ = is_supported;
+    if (!is_direct_) {
+      LOG_INFO("LOAD DATA direct path is not supported, use the normal path",
+               "table_name", load_stmt.get_load_arguments().combined_name_);
+    }
+    if (OB_FAIL(ObLoadDataSPImpl::execute(ctx, load_stmt))) {
+      LOG_WARN("fail to execute load data", K(ret), K_(is_direct));
+    }
+  }
+  //the shuffle handles referring to the task ctxs are released
+  destroy_task_ctxs();
+  if (is_locked_) {
+    int tmp_ret = OB_SUCCESS;
+    if (OB_TMP_FAIL(unlock_table(ctx, OB_SUCCESS != ret))) {
+      LOG_WARN("fail to unlock table", K(tmp_ret), K_(param));
+      ret = COVER_SUCC(tmp_ret);
+    }
+  }
+  return ret;
+}
+
+int ObLoadDataDirectImpl::insert_task_gen_and_dispatch(ObExecContext &ctx, ToolBox &box)
+{
+  int ret = OB_SUCCESS;
+  if (!is_direct_) {
+    ret = ObLoadDataSPImpl::insert_task_gen_and_dispatch(ctx, box);
+  } else {
+    //the rows are kept by the sorters of the shuffle tasks, nothing to insert
+  }
+  return ret;
+}
+
+int ObLoadDataDirectImpl::init_param(ObExecContext &ctx, ObLoadDataStmt &load_stmt, bool &is_supported)
+{
+  int ret = OB_SUCCESS;
+  const ObLoadArgument &load_args = load_stmt.get_load_arguments();
+  ObSchemaGetterGuard *schema_guard = NULL;
+  const ObTableSchema *table_schema = NULL;
+  uint64_t task_id = OB_INVALID_ID;
+  bool is_empty = false;
+  is_supported = false;
+  if (OB_ISNULL(ctx.get_sql_ctx())
+      || OB_ISNULL(schema_guard = ctx.get_sql_ctx()->schema_guard_)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("sql ctx is null", K(ret), KP(ctx.get_sql_ctx()));
+  } else if (OB_FAIL(schema_guard->get_table_schema(load_args.tenant_id_,
+                                                    load_args.table_id_,
+                                                    table_schema))) {
+    LOG_WARN("fail to get table schema", K(ret), K(load_args.table_id_));
+  } else if (OB_ISNULL(table_schema)) {
+    ret = OB_TABLE_NOT_EXIST;
+    LOG_WARN("table not exist", K(ret), K(load_args.table_id_));
+  } else {
+    param_.tenant_id_ = load_args.tenant_id_;
+    param_.table_id_ = load_args.table_id_;
+    param_.table_name_ = load_args.combined_name_;
+    param_.schema_version_ = table_schema->get_schema_version();
+    param_.rowkey_cnt_ = table_schema->get_rowkey_column_num();
+    param_.file_cs_type_ = load_args.file_cs_type_;
+    param_.dupl_action_ = load_args.dupl_action_;
+    param_.expire_ts_ = THIS_WORKER.get_timeout_ts();
+    if (OB_FAIL(check_table_supported(*table_schema, is_supported))) {
+      LOG_WARN("fail to check table", K(ret));
+    } else if (!is_supported) {
+    } else if (OB_FAIL(init_columns(load_stmt, *table_schema, is_supported))) {
+      LOG_WARN("fail to init columns", K(ret));
+    } else if (!is_supported) {
+    } else if (OB_FAIL(init_ls_tablet_ids(*table_schema, is_supported))) {
+      LOG_WARN("fail to init ls tablet ids", K(ret));
+    } else if (!is_supported) {
+    } else if (OB_ISNULL(GCTX.sql_proxy_)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("sql proxy is null", K(ret));
+    } else if (OB_FAIL(ObMaxIdFetcher(*GCTX.sql_proxy_).fetch_new_max_id(
+                OB_SYS_TENANT_ID, OB_MAX_USED_DDL_TASK_ID_TYPE, task_id, 1L/*ddl start id*/))) {
+      LOG_WARN("fail to fetch new task id", K(ret));
+    } else if (FALSE_IT(param_.task_id_ = task_id)) {
+    } else if (OB_FAIL(lock_table(ctx, is_supported))) {
+      LOG_WARN("fail to lock table", K(ret));
+    } else if (!is_supported) {
+      LOG_INFO("LOAD DATA direct path cannot lock the table", K(load_args.table_id_));
+    } else if (OB_FAIL(check_table_empty(load_stmt, is_empty))) {
+      LOG_WARN("fail to check table empty", K(ret));
+    } else if (!is_empty) {
+      is_supported = false;
+      LOG_INFO("LOAD DATA direct path only supports empty table", K(load_args.table_id_));
+    } else {
+      LOG_INFO("LOAD DATA direct path", K_(param));
+    }
+    if ((OB_FAIL(ret) || !is_supported) && is_locked_) {
+      int tmp_ret = OB_SUCCESS;
+      if (OB_TMP_FAIL(unlock_table(ctx, true /*is_rollback*/))) {
+        LOG_WARN("fail to unlock table", K(tmp_ret), K_(param));
+      }
+    }
+  }
+  return ret;
+}
+
+int ObLoadDataDirectImpl::lock_table(ObExecContext &ctx, bool &is_locked)
+{
+  int ret = OB_SUCCESS;
+  ObSQLSessionInfo *session = ctx.get_my_session();
+  bool ac = false;
+  is_locked = false;
+  if (OB_ISNULL(session)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("session is null", K(ret));
+  } else if (OB_FAIL(session->get_autocommit(ac))) {
+    LOG_WARN("fail to get autocommit", K(ret));
+  } else if (!ac || session->has_explicit_start_trans() || session->is_in_transaction()) {
+    //the installed sstables cannot be rolled back with the transaction of the user
+    LOG_INFO("LOAD DATA direct path is not supported in transaction, use the normal path", K_(param));
+  } else {
+    //the table must stay empty and must not be written by others until the sstables are installed,
+    //the lock is held by the transaction of the statement, so it is released by the end of the
+    //transaction or by the transaction cleanup after a crash
+    int tmp_ret = OB_SUCCESS;
+    if (OB_FAIL(ObSqlTransControl::lock_table(ctx, param_.table_id_, EXCLUSIVE))) {
+      if (ObDDLUtil::is_table_lock_retry_ret_code(ret)) {
+        LOG_INFO("cannot lock table, use the normal path", K(ret), K_(param));
+        ret = OB_SUCCESS;
+      } else {
+        LOG_WARN("fail to lock table", K(ret), K_(param));
+      }
+      if (OB_TMP_FAIL(ObSqlTransControl::end_trans(ctx, true /*is_rollback*/, false /*is_explicit*/))) {
+        LOG_WARN("fail to rollback trans", K(tmp_ret), K_(param));
+        ret = COVER_SUCC(tmp_ret);
+      }
+    } else {
+      is_locked = true;
+      is_locked_ = true;
+    }
+  }
+  return ret;
+}
+
+int ObLoadDataDirectImpl::unlock_table(ObExecContext &ctx, const bool is_rollback)
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(ObSqlTransControl::end_trans(ctx, is_rollback, false /*is_explicit*/))) {
+    LOG_WARN("fail to end trans", K(ret), K(is_rollback), K_(param));
+  } else {
+    is_locked_ = false;
+  }
+  return ret;
+}
+
+int ObLoadDataDirectImpl::delete_loaded_rows(ObExecContext &ctx)
+{
+  int ret = OB_SUCCESS;
+  ObSQLSessionInfo *session = ctx.get_my_session();
+  observer::ObInnerSQLConnectionPool *pool = NULL;
+  sqlclient::ObISQLConnection *conn = NULL;
+  ObSqlString sql;
+  int64_t affected_rows = 0;
+  if (OB_ISNULL(session) || OB_ISNULL(GCTX.sql_proxy_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("session or sql proxy is null", K(ret), KP(session), KP(GCTX.sql_proxy_));
+  } else if (OB_ISNULL(pool = static_cast<observer::ObInnerSQLConnectionPool *>(
+                           GCTX.sql_proxy_->get_pool()))) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("connection pool is null", K(ret));
+  } else if (OB_FAIL(sql.assign_fmt("DELETE FROM %.*s",
+                                    param_.table_name_.length(), param_.table_name_.ptr()))) {
+    LOG_WARN("fail to assign sql", K(ret));
+  } else if (OB_FAIL(pool->acquire(session, conn))) {
+    LOG_WARN("fail to acquire inner connection", K(ret));
+  } else if (OB_ISNULL(conn)) {
+    ret = OB_INNER_STAT_ERROR;
+    LOG_WARN("connection is null", K(ret));
+  } else if (OB_FAIL(conn->execute_write(param_.tenant_id_, sql.ptr(), affected_rows, true))) {
+    //the rows are deleted in the transaction holding the table lock
+    LOG_WARN("fail to execute sql", K(ret), K(sql));
+  } else {
+    LOG_INFO("LOAD DATA direct path delete the rows of the installed tablets", K(affected_rows), K_(param));
+  }
+  if (OB_NOT_NULL(conn)) {
+    GCTX.sql_proxy_->close(conn, OB_SUCC(ret));
+  }
+  return ret;
+}
+
+int ObLoadDataDirectImpl::check_table_supported(const ObTableSchema &table_schema, bool &is_supported)
+{
+  int ret = OB_SUCCESS;
+  const char *reason = NULL;
+  bool has_lob = false;
+  if (OB_FAIL(table_schema.has_lob_column(has_lob))) {
+    LOG_WARN("fail to check lob column", K(ret));
+  } else if (has_lob) {
+    reason = "lob column";
+  } else if (table_schema.is_heap_table()) {
+    reason = "table without primary key";
+  } else if (table_schema.get_index_tid_count() > 0) {
+    reason = "index";
+  } else if (!table_schema.get_foreign_key_infos().empty()) {
+    reason = "foreign key";
+  } else if (0 != table_schema.get_autoinc_column_id()) {
+    reason = "auto increment column";
+  }
+  for (ObTableSchema::const_constraint_iterator iter = table_schema.constraint_begin();
+       OB_SUCC(ret) && NULL == reason && iter != table_schema.constraint_end();
+       ++iter) {
+    if (OB_ISNULL(*iter)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("constraint is null", K(ret));
+    } else if (CONSTRAINT_TYPE_CHECK == (*iter)->get_constraint_type()) {
+      reason = "check constraint";
+    }
+  }
+  if (OB_SUCC(ret)) {
+    is_supported = (NULL == reason);
+    if (!is_supported) {
+      LOG_INFO("LOAD DATA direct path does not support the table", K(reason),
+               "table_id", table_schema.get_table_id());
+    }
+  }
+  return ret;
+}
+
+int ObLoadDataDirectImpl::init_columns(ObLoadDataStmt &load_stmt,
+                                       const ObTableSchema &table_schema,
+                                       bool &is_supported)
+{
+  int ret = OB_SUCCESS;
+  const ObIArray<ObLoadDataStmt::FieldOrVarStruct> &field_list = load_stmt.get_field_or_var_list();
+  ObSEArray<ObColDesc, 16> column_descs;
+  is_supported = true;
+  param_.columns_.reset();
+  if (!load_stmt.get_table_assignment().empty()) {
+    is_supported = false;
+    LOG_INFO("LOAD DATA direct path does not support SET clause");
+  } else if (OB_FAIL(table_schema.get_rowkey_column_ids(column_descs))) {
+    LOG_WARN("fail to get rowkey column descs", K(ret));
+  } else if (OB_FAIL(table_schema.get_column_ids_without_rowkey(column_descs, true /*no_virtual*/))) {
+    LOG_WARN("fail to get column descs", K(ret));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && is_supported && i < column_descs.count(); ++i) {
+    const uint64_t column_id = column_descs.at(i).col_id_;
+    const ObColumnSchemaV2 *column_schema = NULL;
+    ObLoadDataDirectColumn column;
+    if (OB_ISNULL(column_schema = table_schema.get_column_schema(column_id))) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("column schema is null", K(ret), K(column_id));
+    } else if (column_schema->is_generated_column()
+               || ob_is_enumset_tc(column_schema->get_data_type())) {
+      is_supported = false;
+    } else {
+      for (int64_t j = 0; j < field_list.count(); ++j) {
+        if (field_list.at(j).is_table_column_ && field_list.at(j).column_id_ == column_id) {
+          column.field_idx_ = j;
+        }
+      }
+      if (OB_INVALID_INDEX_INT64 == column.field_idx_) {
+        //the column is filled by the default value
+        is_supported = false;
+      } else {
+        column.column_id_ = column_id;
+        column.meta_ = column_schema->get_meta_type();
+        column.accuracy_ = column_schema->get_accuracy();
+        column.is_nullable_ = !column_schema->is_not_null_for_write();
+        column.is_string_column_ = ob_is_string_tc(column_schema->get_data_type());
+        if (OB_FAIL(param_.columns_.push_back(column))) {
+          LOG_WARN("fail to push back", K(ret));
+        }
+      }
+    }
+    if (OB_SUCC(ret) && !is_supported) {
+      LOG_INFO("LOAD DATA direct path requires every column is given by the file directly",
+               K(column_id));
+    }
+  }
+  return ret;
+}
+
+int ObLoadDataDirectImpl::init_ls_tablet_ids(const ObTableSchema &table_schema, bool &is_supported)
+{
+  int ret = OB_SUCCESS;
+  const int64_t expire_renew_time = 2 * 1000000; // 2s
+  ObSEArray<ObTabletID, 4> tablet_ids;
+  ObSEArray<ObObjectID, 4> part_ids;
+  is_supported = true;
+  param_.ls_tablet_ids_.reset();
+  if (OB_FAIL(table_schema.get_all_tablet_and_object_ids(tablet_ids, part_ids))) {
+    LOG_WARN("fail to get tablet ids", K(ret));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && is_supported && i < tablet_ids.count(); ++i) {
+    ObDASTabletLoc tablet_loc;
+    if (OB_FAIL(ObDASLocationRouter::get_leader(param_.tenant_id_, tablet_ids.at(i),
+                                                tablet_loc, expire_renew_time))) {
+      LOG_WARN("fail to get leader", K(ret), K(tablet_ids.at(i)));
+    } else if (tablet_loc.server_ != GCTX.self_addr()) {
+      //the sstables are built by the local ddl redo writer
+      is_supported = false;
+      LOG_INFO("LOAD DATA direct path requires all the leaders are local", K(tablet_loc));
+    } else if (OB_FAIL(param_.ls_tablet_ids_.push_back(
+                         std::make_pair(tablet_loc.ls_id_, tablet_loc.tablet_id_)))) {
+      LOG_WARN("fail to push back", K(ret));
+    }
+  }
+  if (OB_SUCC(ret) && is_supported) {
+    std::sort(param_.ls_tablet_ids_.begin(), param_.ls_tablet_ids_.end(),
+              [](const LSTabletIDPair &left, const LSTabletIDPair &right) {
+                return left.second < right.second;
+              });
+  }
+  return ret;
+}
+
+int ObLoadDataDirectImpl::check_table_empty(ObLoadDataStmt &load_stmt, bool &is_empty)
+{
+  int ret = OB_SUCCESS;
+  const ObLoadArgument &load_args = load_stmt.get_load_arguments();
+  is_empty = false;
+  SMART_VAR(ObMySQLProxy::MySQLResult, res) {
+    sqlclient::ObMySQLResult *result = NULL;
+    ObSqlString sql;
+    if (OB_ISNULL(GCTX.sql_proxy_)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("sql proxy is null", K(ret));
+    } else if (OB_FAIL(sql.assign_fmt(lib::is_oracle_mode()
+                                      ? "SELECT 1 FROM %.*s WHERE ROWNUM = 1"
+                                      : "SELECT 1 FROM %.*s LIMIT 1",
+                                      load_args.combined_name_.length(),
+                                      load_args.combined_name_.ptr()))) {
+      LOG_WARN("fail to assign sql", K(ret));
+    } else if (OB_FAIL(GCTX.sql_proxy_->read(res, load_args.tenant_id_, sql.ptr()))) {
+      LOG_WARN("fail to execute sql", K(ret), K(sql));
+    } else if (OB_ISNULL(result = res.get_result())) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("fail to get sql result", K(ret));
+    } else if (OB_FAIL(result->next())) {
+      if (OB_ITER_END == ret) {
+        is_empty = true;
+        ret = OB_SUCCESS;
+      } else {
+        LOG_WARN("fail to get next row", K(ret));
+      }
+    }
+  }
+  return ret;
+}
+
+int ObLoadDataDirectImpl::prepare_load(ObExecContext &ctx, ObLoadDataStmt &load_stmt, ToolBox &box)
+{
+  UNUSED(load_stmt);
+  int ret = OB_SUCCESS;
+  for (int64_t i = 0; OB_SUCC(ret) && is_direct_ && i < box.shuffle_resource.count(); ++i) {
+    ObShuffleTaskHandle *handle = box.shuffle_resource.at(i);
+    ObLoadDataDirectTaskCtx *task_ctx = NULL;
+    if (OB_ISNULL(handle)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("shuffle task handle is null", K(ret));
+    } else if (OB_ISNULL(task_ctx = OB_NEWx(ObLoadDataDirectTaskCtx, (&ctx.get_allocator()), param_))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("fail to alloc", K(ret));
+    } else if (OB_FAIL(task_ctxs_.push_back(task_ctx))) {
+      task_ctx->~ObLoadDataDirectTaskCtx();
+      LOG_WARN("fail to push back", K(ret));
+    } else if (OB_FAIL(task_ctx->init())) {
+      LOG_WARN("fail to init task ctx", K(ret));
+    } else {
+      handle->direct_task_ctx = task_ctx;
+    }
+  }
+  return ret;
+}
+
+int ObLoadDataDirectImpl::exec_direct_shuffle(int64_t task_id, ObShuffleTaskHandle *handle)
+{
+  int ret = OB_SUCCESS;
+  int64_t parsed_line_num = 0;
+  ObSQLSessionInfo *session = NULL;
+  ObCastMode cast_mode = CM_NONE;
+  if (OB_ISNULL(handle)
+      || OB_ISNULL(handle->data_buffer)
+      || OB_ISNULL(handle->direct_task_ctx)
+      || OB_ISNULL(session = handle->exec_ctx.get_my_session())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(handle));
+  } else if (OB_FAIL(ObSQLUtils::get_default_cast_mode(stmt::T_LOAD_DATA, session, cast_mode))) {
+    LOG_WARN("fail to get cast mode", K(ret));
+  } else {
+    const ObDataTypeCastParams dtc_params = ObBasicSessionInfo::create_dtc_params(session);
+    ObSEArray<ObCSVGeneralParser::LineErrRec, 1> err_records;
+    int64_t nrows = 1;
+    const char *ptr = handle->data_buffer->begin_ptr();
+    const char *end = handle->data_buffer->begin_ptr() + handle->data_buffer->get_data_len();
+    auto handle_one_line = [](ObIArray<ObCSVGeneralParser::FieldValue> &fields_per_line) -> int {
+      UNUSED(fields_per_line);
+      return common::OB_SUCCESS;
+    };
+    handle->err_records.reuse();
+
+    while (OB_SUCC(ret) && ptr < end) {
+      err_records.reuse();
+      ret = handle->parser.scan<decltype(handle_one_line), true>(ptr, end, nrows,
+                                                                 handle->escape_buffer->begin_ptr(),
+                                                                 handle->escape_buffer->begin_ptr() + handle->escape_buffer->get_buffer_size(),
+                                                                 handle_one_line, err_records, true);
+      if (OB_FAIL(ret)) {
+        LOG_WARN("fail to scan", K(ret));
+      } else if (err_records.count() > 0) {
+        ObParserErrRec rec;
+        rec.row_offset_in_task = parsed_line_num;
+        rec.ret = err_records[0].err_code;
+        if (OB_FAIL(handle->err_records.push_back(rec))) {
+          LOG_WARN("fail to push back", K(ret));
+        }
+      }
+      if (OB_SUCC(ret) && nrows > 0) {
+        const int64_t cur_line_num = parsed_line_num++;
+        // the task ids follow the order of the file buffers
+        const int64_t seq = (task_id << 32) + cur_line_num;
+        ObTabletID tablet_id;
+        if (OB_FAIL(calc_tablet_id(*handle, tablet_id))) {
+          LOG_WARN("fail to calc tablet id", K(ret));
+        } else if (OB_FAIL(handle->direct_task_ctx->add_line(seq,
+                                                             tablet_id,
+                                                             handle->parser.get_fields_per_line(),
+                                                             dtc_params,
+                                                             cast_mode))) {
+          LOG_WARN("fail to add line", K(ret), K(task_id), K(cur_line_num),
+                   "line", handle->parser.get_fields_per_line());
+        }
+      }
+    }
+  }
+  if (OB_NOT_NULL(handle)) {
+    handle->result.row_cnt_ = parsed_line_num;
+  }
+  return ret;
+}
+
+int ObLoadDataDirectImpl::finish_load(ObExecContext &ctx, ToolBox &box)
+{
+  int ret = OB_SUCCESS;
+  if (is_direct_) {
+    int sort_ret = OB_SUCCESS;
+    int64_t row_cnt = 0;
+    int64_t affected_rows = 0;
+    ObLoadDataDirectRowCompare compare(sort_ret, param_.rowkey_cnt_);
+    HEAP_VAR(ObLoadDataDirectSorter, merge_sorter) {
+      if (OB_FAIL(merge_sorter.init(MERGE_MEMORY_LIMIT, FILE_BUFFER_SIZE, param_.expire_ts_,
+                                    param_.tenant_id_, &compare))) {
+        LOG_WARN("fail to init merge sorter", K(ret));
+      }
+      for (int64_t i = 0; OB_SUCC(ret) && i < task_ctxs_.count(); ++i) {
+        ObLoadDataDirectTaskCtx *task_ctx = task_ctxs_.at(i);
+        if (OB_ISNULL(task_ctx)) {
+          ret = OB_ERR_UNEXPECTED;
+          LOG_WARN("task ctx is null", K(ret), K(i));
+        } else if (OB_FAIL(task_ctx->transfer_sorted_rows(merge_sorter))) {
+          LOG_WARN("fail to transfer sorted rows", K(ret), K(i));
+        } else {
+          row_cnt += task_ctx->get_row_cnt();
+        }
+      }
+      if (OB_FAIL(ret)) {
+      } else if (OB_FAIL(merge_sorter.do_sort(true /*final_merge*/))) {
+        LOG_WARN("fail to merge sorted rows", K(ret));
+      } else if (OB_FAIL(sort_ret)) {
+        LOG_WARN("fail to compare rows", K(ret));
+      } else if (OB_FAIL(write_sstables(ctx, merge_sorter, affected_rows))) {
+        LOG_WARN("fail to write sstables", K(ret));
+      } else {
+        box.affected_rows = affected_rows;
+      }
+      merge_sorter.clean_up();
+    }
+    LOG_INFO("LOAD DATA direct path finish", K(ret), K(row_cnt), K(affected_rows),
+             "table_id", param_.table_id_);
+  }
+  return ret;
+}
+
+int ObLoadDataDirectImpl::write_sstables(ObExecContext &ctx,
+                                         ObLoadDataDirectSorter &merge_sorter,
+                                         int64_t &affected_rows)
+{
+  int ret = OB_SUCCESS;
+  int tmp_ret = OB_SUCCESS;
+  ObSSTableInsertManager &sstable_insert_mgr = ObSSTableInsertManager::get_instance();
+  ObSSTableInsertTableParam table_param;
+  ObSSTableInsertTabletParam tablet_param;
+  ObMacroDataSeq block_start_seq;
+  ObLoadDataDirectRowIterator row_iter;
+  int64_t context_id = -1;
+  int64_t snapshot_version = 0;
+  bool is_external_consistent = false;
+  affected_rows = 0;
+  if (OB_FAIL(OB_TS_MGR.get_ts_sync(param_.tenant_id_, GTS_TIMEOUT_US,
+                                    snapshot_version, is_external_consistent))) {
+    LOG_WARN("fail to get gts", K(ret), K(param_.tenant_id_));
+  } else if (OB_FAIL(table_param.ls_tablet_ids_.assign(param_.ls_tablet_ids_))) {
+    LOG_WARN("fail to assign ls tablet ids", K(ret));
+  } else {
+    table_param.exec_ctx_ = &ctx;
+    table_param.dest_table_id_ = param_.table_id_;
+    table_param.write_major_ = true;
+    table_param.schema_version_ = param_.schema_version_;
+    table_param.snapshot_version_ = snapshot_version;
+    table_param.task_cnt_ = 1;
+    //there is no ddl task for load data, the unique task id of this load identifies its redo
+    table_param.execution_id_ = param_.task_id_;
+    table_param.ddl_task_id_ = param_.task_id_;
+    if (OB_FAIL(sstable_insert_mgr.create_table_context(table_param, context_id))) {
+      LOG_WARN("fail to create table context", K(ret), K(table_param));
+    } else if (OB_FAIL(sstable_insert_mgr.update_table_context(context_id, snapshot_version))) {
+      LOG_WARN("fail to update table context", K(ret), K(context_id), K(snapshot_version));
+    } else if (OB_FAIL(row_iter.init(merge_sorter, param_))) {
+      LOG_WARN("fail to init row iterator", K(ret));
+    } else if (OB_FAIL(block_start_seq.set_parallel_degree(0))) {
+      LOG_WARN("fail to set parallel degree", K(ret));
+    } else {
+      tablet_param.context_id_ = context_id;
+      tablet_param.table_id_ = param_.table_id_;
+      tablet_param.write_major_ = true;
+      tablet_param.task_cnt_ = table_param.task_cnt_;
+      tablet_param.schema_version_ = param_.schema_version_;
+      tablet_param.snapshot_version_ = snapshot_version;
+      tablet_param.execution_id_ = table_param.execution_id_;
+      tablet_param.ddl_task_id_ = table_param.ddl_task_id_;
+      FLOG_INFO("LOAD DATA direct path start write sstables", K(context_id), K(table_param));
+    }
+  }
+
+  int64_t ls_idx = 0;
+  while (OB_SUCC(ret)) {
+    ObTabletID tablet_id;
+    int64_t tablet_affected_rows = 0;
+    if (OB_FAIL(row_iter.peek_tablet_id(tablet_id))) {
+      if (OB_ITER_END == ret) {
+        ret = OB_SUCCESS;
+        break;
+      } else {
+        LOG_WARN("fail to peek tablet id", K(ret));
+      }
+    } else {
+      //the rows are sorted by tablet id as the ls tablet ids
+      while (ls_idx < param_.ls_tablet_ids_.count()
+             && param_.ls_tablet_ids_.at(ls_idx).second != tablet_id) {
+        ++ls_idx;
+      }
+      if (OB_UNLIKELY(ls_idx >= param_.ls_tablet_ids_.count())) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("tablet is not found", K(ret), K(tablet_id));
+      } else {
+        tablet_param.ls_id_ = param_.ls_tablet_ids_.at(ls_idx).first;
+        tablet_param.tablet_id_ = tablet_id;
+        row_iter.set_tablet_id(tablet_id);
+        if (OB_FAIL(sstable_insert_mgr.add_sstable_slice(tablet_param, block_start_seq,
+                                                         row_iter, tablet_affected_rows))) {
+          LOG_WARN("fail to add sstable slice", K(ret), K(tablet_param));
+        } else {
+          affected_rows += tablet_affected_rows;
+        }
+      }
+    }
+  }
+
+  if (context_id > 0) {
+    //the sstables of all the tablets are created with the commit log, the empty ones included
+    const bool need_commit = OB_SUCC(ret);
+    if (OB_SUCCESS != (tmp_ret = sstable_insert_mgr.finish_table_context(context_id, need_commit))) {
+      LOG_WARN("fail to finish table context", K(tmp_ret), K(context_id), K(need_commit));
+      ret = OB_SUCC(ret) ? tmp_ret : ret;
+      //each tablet commits its own sstable, some tablets may have been installed, their rows
+      //are deleted and committed with the lock, so the failed load leaves the table empty
+      if (need_commit && is_locked_) {
+        if (OB_SUCCESS != (tmp_ret = delete_loaded_rows(ctx))) {
+          LOG_ERROR("fail to delete the rows of the installed tablets", K(tmp_ret), K_(param));
+        } else if (OB_SUCCESS != (tmp_ret = unlock_table(ctx, false /*is_rollback*/))) {
+          LOG_ERROR("fail to commit the deleted rows", K(tmp_ret), K_(param));
+        }
+      }
+    }
+  }
+  if (row_iter.get_duplicated_row_cnt() > 0) {
+    LOG_INFO("LOAD DATA direct path merge duplicated rows",
+             "duplicated_row_cnt", row_iter.get_duplicated_row_cnt());
+  }
+  return ret;
+}
+
+} // end namespace sql
+} // end namespace oceanbase
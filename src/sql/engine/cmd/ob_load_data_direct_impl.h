@@ -0,0 +1,251 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_SQL_LOAD_DATA_DIRECT_IMPL_H_
+#define OCEANBASE_SQL_LOAD_DATA_DIRECT_IMPL_H_
+
+#include "lib/allocator/page_arena.h"
+#include "common/row/ob_row.h"
+#include "share/ob_ls_id.h"
+#include "storage/ob_parallel_external_sort.h"
+#include "storage/ddl/ob_direct_insert_sstable_ctx.h"
+#include "sql/engine/cmd/ob_load_data_impl.h"
+
+namespace oceanbase
+{
+namespace share
+{
+namespace schema
+{
+class ObTableSchema;
+}
+}
+namespace sql
+{
+
+/**
+ * @brief one line of the file converted to the store columns of the table,
+ *        the rowkey columns come first, the extra multi-version columns are not included
+ */
+struct ObLoadDataDirectRow
+{
+public:
+  ObLoadDataDirectRow() : tablet_id_(), seq_(0), cell_cnt_(0), cells_(NULL) {}
+  ~ObLoadDataDirectRow() {}
+  bool is_valid() const { return tablet_id_.is_valid() && cell_cnt_ > 0 && NULL != cells_; }
+  int64_t get_deep_copy_size() const;
+  int deep_copy(const ObLoadDataDirectRow &src, char *buf, const int64_t len, int64_t &pos);
+  NEED_SERIALIZE_AND_DESERIALIZE;
+  TO_STRING_KV(K_(tablet_id), K_(seq), "cells", common::ObArrayWrap<common::ObObj>(cells_, cell_cnt_));
+public:
+  common::ObTabletID tablet_id_;
+  int64_t seq_; //the position of the line in the file, keeps the order of the duplicated rowkeys
+  int64_t cell_cnt_;
+  common::ObObj *cells_;
+};
+
+class ObLoadDataDirectRowCompare
+{
+public:
+  ObLoadDataDirectRowCompare(int &sort_ret, const int64_t rowkey_cnt)
+    : result_code_(sort_ret), rowkey_cnt_(rowkey_cnt) {}
+  bool operator()(const ObLoadDataDirectRow *left, const ObLoadDataDirectRow *right);
+  static int compare_rowkey(const ObLoadDataDirectRow &left,
+                            const ObLoadDataDirectRow &right,
+                            const int64_t rowkey_cnt,
+                            int &cmp);
+  int &result_code_;
+private:
+  int64_t rowkey_cnt_;
+};
+
+typedef storage::ObExternalSort<ObLoadDataDirectRow, ObLoadDataDirectRowCompare> ObLoadDataDirectSorter;
+
+/**
+ * @brief a store column of the table and the field of the file it comes from
+ */
+struct ObLoadDataDirectColumn
+{
+  ObLoadDataDirectColumn()
+    : column_id_(common::OB_INVALID_ID), field_idx_(common::OB_INVALID_INDEX_INT64),
+      meta_(), accuracy_(), is_nullable_(true), is_string_column_(false) {}
+  TO_STRING_KV(K_(column_id), K_(field_idx), K_(meta), K_(accuracy), K_(is_nullable),
+               K_(is_string_column));
+  uint64_t column_id_;
+  int64_t field_idx_;
+  common::ObObjMeta meta_;
+  common::ObAccuracy accuracy_;
+  bool is_nullable_;
+  bool is_string_column_;
+};
+
+/**
+ * @brief the parameters shared by all the shuffle tasks, read only after the load begins
+ */
+struct ObLoadDataDirectParam
+{
+  ObLoadDataDirectParam()
+    : tenant_id_(common::OB_INVALID_TENANT_ID), table_id_(common::OB_INVALID_ID),
+      schema_version_(0), rowkey_cnt_(0), file_cs_type_(common::CS_TYPE_INVALID),
+      dupl_action_(ObLoadDupActionType::LOAD_STOP_ON_DUP), expire_ts_(0), task_id_(0) {}
+  TO_STRING_KV(K_(tenant_id), K_(table_id), K_(schema_version), K_(rowkey_cnt), K_(file_cs_type),
+               K_(expire_ts), K_(task_id), K_(table_name), K_(columns), K_(ls_tablet_ids));
+  uint64_t tenant_id_;
+  uint64_t table_id_;
+  int64_t schema_version_;
+  int64_t rowkey_cnt_;
+  common::ObCollationType file_cs_type_;
+  ObLoadDupActionType dupl_action_;
+  int64_t expire_ts_;
+  int64_t task_id_; //unique id of this load, the execution id and the ddl task id of the redo
+  common::ObString table_name_; //the combined name of the table, owned by the statement
+  common::ObSEArray<ObLoadDataDirectColumn, 16> columns_; //in the order of the store columns
+  common::ObArray<storage::LSTabletIDPair> ls_tablet_ids_; //sorted by tablet id
+};
+
+/**
+ * @brief the lines parsed by one shuffle task handle are converted and sorted here,
+ *        a handle is used by one task at a time, so nothing is shared between threads
+ */
+class ObLoadDataDirectTaskCtx
+{
+public:
+  static const int64_t SORT_MEMORY_LIMIT = 64LL * 1024LL * 1024LL; // 64M
+  ObLoadDataDirectTaskCtx(const ObLoadDataDirectParam &param);
+  ~ObLoadDataDirectTaskCtx();
+  int init();
+  int add_line(const int64_t seq,
+               const common::ObTabletID &tablet_id,
+               const common::ObIArray<ObCSVGeneralParser::FieldValue> &fields,
+               const common::ObDataTypeCastParams &dtc_params,
+               const common::ObCastMode cast_mode);
+  // sort the rows of this task and hand them over to the merge sorter,
+  // the task ctx should not be destroyed before the merge is done
+  int transfer_sorted_rows(ObLoadDataDirectSorter &merge_sorter);
+  ObLoadDataDirectSorter &get_sorter() { return sorter_; }
+  int64_t get_row_cnt() const { return row_cnt_; }
+  TO_STRING_KV(K_(is_inited), K_(sort_ret), K_(row_cnt));
+private:
+  bool is_inited_;
+  const ObLoadDataDirectParam &param_;
+  common::ObArenaAllocator allocator_; //for the cells of row_
+  common::ObArenaAllocator cast_allocator_; //for the conversion of one line
+  int sort_ret_;
+  ObLoadDataDirectRowCompare compare_;
+  ObLoadDataDirectSorter sorter_;
+  ObLoadDataDirectRow row_;
+  int64_t row_cnt_;
+  DISALLOW_COPY_AND_ASSIGN(ObLoadDataDirectTaskCtx);
+};
+
+/**
+ * @brief return the sorted rows of one tablet to the sstable writer, the rows with the same
+ *        rowkey are merged according to the dup action, REPLACE keeps the last line of the file
+ *        and IGNORE keeps the first one
+ */
+class ObLoadDataDirectRowIterator : public storage::ObISSTableInsertRowIterator
+{
+public:
+  ObLoadDataDirectRowIterator();
+  virtual ~ObLoadDataDirectRowIterator();
+  int init(ObLoadDataDirectSorter &sorter, const ObLoadDataDirectParam &param);
+  // the tablet of the next row, OB_ITER_END if all the rows are returned
+  int peek_tablet_id(common::ObTabletID &tablet_id);
+  void set_tablet_id(const common::ObTabletID &tablet_id) { tablet_id_ = tablet_id; }
+  virtual void reset() override;
+  virtual int get_next_row(common::ObNewRow *&row) override;
+  virtual int get_next_row_with_tablet_id(
+      const uint64_t table_id,
+      const int64_t rowkey_count,
+      const int64_t snapshot_version,
+      common::ObNewRow *&row,
+      common::ObTabletID &tablet_id) override;
+  int64_t get_duplicated_row_cnt() const { return duplicated_row_cnt_; }
+private:
+  struct RowHolder
+  {
+    RowHolder() : allocator_("LoadDirectRow"), row_() {}
+    int copy(const ObLoadDataDirectRow &src);
+    common::ObArenaAllocator allocator_;
+    ObLoadDataDirectRow row_;
+  };
+  int fetch_row(RowHolder &holder, bool &is_end);
+  int fill_row(const ObLoadDataDirectRow &src, const int64_t snapshot_version);
+private:
+  bool is_inited_;
+  common::ObArenaAllocator allocator_; //for the cells of new_row_
+  ObLoadDataDirectSorter *sorter_;
+  const ObLoadDataDirectParam *param_;
+  common::ObTabletID tablet_id_;
+  RowHolder holders_[2];
+  int64_t pending_idx_; //the fetched but not returned row, -1 if none
+  bool is_end_;
+  common::ObNewRow new_row_;
+  int64_t duplicated_row_cnt_;
+  DISALLOW_COPY_AND_ASSIGN(ObLoadDataDirectRowIterator);
+};
+
+/**
+ * @brief load data direct path implementation
+ *        the lines are parsed and converted by the shuffle tasks in parallel and sorted by
+ *        tablet and rowkey through external sort, then the major sstables are built by the
+ *        ddl insert path, so the rows never go through memtables and the redo is logged by
+ *        macro blocks. It falls back to the normal path if the table is not supported.
+ *        The empty table is locked exclusively by the transaction of the statement until
+ *        the load ends, so the direct path is only used out of the transactions of the user.
+ *        The sstables are installed tablet by tablet, if some of them fail, the rows of the
+ *        installed ones are deleted before the lock is released and the statement fails.
+ */
+class ObLoadDataDirectImpl : public ObLoadDataSPImpl
+{
+public:
+  static const int64_t MERGE_MEMORY_LIMIT = 128LL * 1024LL * 1024LL; // 128M
+  static const int64_t FILE_BUFFER_SIZE = storage::ObExternalSortConstant::DEFAULT_FILE_READ_WRITE_BUFFER;
+  static const int64_t GTS_TIMEOUT_US = 10 * 1000 * 1000L; // 10s
+  ObLoadDataDirectImpl();
+  virtual ~ObLoadDataDirectImpl();
+  virtual int execute(ObExecContext &ctx, ObLoadDataStmt &load_stmt) override;
+  virtual int insert_task_gen_and_dispatch(ObExecContext &ctx, ToolBox &box) override;
+
+  // parse and sort the lines of a file buffer instead of generating the insert values
+  static int exec_direct_shuffle(int64_t task_id, ObShuffleTaskHandle *handle);
+
+protected:
+  virtual int prepare_load(ObExecContext &ctx, ObLoadDataStmt &load_stmt, ToolBox &box) override;
+  virtual int finish_load(ObExecContext &ctx, ToolBox &box) override;
+
+private:
+  int init_param(ObExecContext &ctx, ObLoadDataStmt &load_stmt, bool &is_supported);
+  int check_table_supported(const share::schema::ObTableSchema &table_schema, bool &is_supported);
+  int init_columns(ObLoadDataStmt &load_stmt,
+                   const share::schema::ObTableSchema &table_schema,
+                   bool &is_supported);
+  int init_ls_tablet_ids(const share::schema::ObTableSchema &table_schema, bool &is_supported);
+  int check_table_empty(ObLoadDataStmt &load_stmt, bool &is_empty);
+  int lock_table(ObExecContext &ctx, bool &is_locked);
+  int unlock_table(ObExecContext &ctx, const bool is_rollback);
+  int delete_loaded_rows(ObExecContext &ctx);
+  int write_sstables(ObExecContext &ctx, ObLoadDataDirectSorter &merge_sorter, int64_t &affected_rows);
+  void destroy_task_ctxs();
+
+private:
+  bool is_direct_; //false if the table is not supported and the normal path is used
+  bool is_locked_; //the table is locked exclusively by the transaction of the statement
+  ObLoadDataDirectParam param_;
+  common::ObSEArray<ObLoadDataDirectTaskCtx *, 64> task_ctxs_;
+  DISALLOW_COPY_AND_ASSIGN(ObLoadDataDirectImpl);
+};
+
+} // end namespace sql
+} // end namespace oceanbase
+
+#endif /* OCEANBASE_SQL_LOAD_DATA_DIRECT_IMPL_H_ */
@@ -16,6 +16,7 @@
 
 #include "lib/oblog/ob_log_module.h"
 #include "sql/engine/cmd/ob_load_data_impl.h"
+#include "sql/engine/cmd/ob_load_data_direct_impl.h"
 #include "sql/engine/ob_exec_context.h"
 
 namespace oceanbase
@@ -26,10 +27,19 @@ int ObLoadDataExecutor::execute(ObExecContext &ctx, ObLoadDataStmt &stmt)
 {
   int ret = OB_SUCCESS;
   ObLoadDataBase *load_impl = NULL;
+  int64_t direct_load = 0;
   if (!stmt.get_load_arguments().is_csv_format_) {
     ret = OB_NOT_SUPPORTED;
     LOG_WARN("invalid resolver results", K(ret));
-  } else if (OB_ISNULL(load_impl = OB_NEWx(ObLoadDataSPImpl, (&ctx.get_allocator())))) {
+  } else if (OB_FAIL(stmt.get_hints().get_value(ObLoadDataHint::DIRECT_LOAD, direct_load))) {
+    LOG_WARN("fail to get direct load hint", K(ret));
+  } else if (0 != direct_load) {
+    load_impl = OB_NEWx(ObLoadDataDirectImpl, (&ctx.get_allocator()));
+  } else {
+    load_impl = OB_NEWx(ObLoadDataSPImpl, (&ctx.get_allocator()));
+  }
+  if (OB_FAIL(ret)) {
+  } else if (OB_ISNULL(load_impl)) {
     ret = OB_ALLOCATE_MEMORY_FAILED;
     LOG_WARN("allocate memory failed", K(ret));
   } else {
@@ -440,15 +440,22 @@ int ObLoadDataBase::pre_parse_lines(ObLoadFileBuffer &buffer,
     LOG_WARN("invalid buffer", K(ret));
   } else if (parser.get_opt_params().is_simple_format_) {
     const ObCSVGeneralFormat &format = parser.get_format();
+    const char *end = buffer.current_ptr();
     char *cur_pos = buffer.begin_ptr();
     int64_t cur_lines = 0;
-    for (char *p = buffer.begin_ptr(); p < buffer.current_ptr(); ++p) {
+    //only the escaped char and the line terminator matter when looking for the line ends
+    ObCSVStructuralIndex struct_index;
+    OZ (struct_index.add_char(format.field_escaped_char_));
+    OZ (struct_index.add_char(parser.get_opt_params().line_term_c_));
+    for (const char *p = struct_index.next(buffer.begin_ptr(), end);
+         OB_SUCC(ret) && p < end;
+         p = struct_index.next(p + 1, end)) {
       char cur_char = *p;
-      if (format.field_escaped_char_ == cur_char && p + 1 < buffer.current_ptr()) {
+      if (format.field_escaped_char_ == cur_char && p + 1 < end) {
         p++;
       } else if (parser.get_opt_params().line_term_c_ == cur_char) {
         cur_lines++;
-        cur_pos = p + 1;
+        cur_pos = buffer.begin_ptr() + (p + 1 - buffer.begin_ptr());
         if (cur_lines >= line_count) {
           break;
         }
@@ -917,7 +924,8 @@ ObShuffleTaskHandle::ObShuffleTaskHandle(ObDataFragMgr &main_datafrag_mgr,
     escape_buffer(NULL),
     calc_tablet_id_expr(NULL),
     datafrag_mgr(main_datafrag_mgr),
-    string_values(main_string_values)
+    string_values(main_string_values),
+    direct_task_ctx(NULL)
 {
   const int64_t FILE_BUFFER_SIZE = ObLoadFileBuffer::MAX_BUFFER_SIZE;
   void *buf = NULL;
@@ -1045,7 +1053,6 @@ int ObLoadDataSPImpl::exec_shuffle(int64_t task_id, ObShuffleTaskHandle *handle)
       if (OB_SUCC(ret) && nrows > 0) {
         int64_t cur_line_num = parsed_line_num++;
         //计算partition id
-        ObObj result;
         ObTabletID tablet_id;
         //insert_values.reuse();
         str_buf.reuse();
@@ -1054,22 +1061,8 @@ int ObLoadDataSPImpl::exec_shuffle(int64_t task_id, ObShuffleTaskHandle *handle)
           LOG_WARN("fail to fill field expr", K(ret));
         } else if (OB_FAIL(handle->generator.gen_insert_values(insert_values, str_buf))) {
           LOG_WARN("fail to generate insert values", K(ret));
-        } else if (nullptr == handle->calc_tablet_id_expr) {
-          tablet_id = handle->datafrag_mgr.get_tablet_ids().at(0);
-        } else {
-          for (int i = 0; i < handle->parser.get_fields_per_line().count(); ++i) {
-            ObCSVGeneralParser::FieldValue &str_v = handle->parser.get_fields_per_line().at(i);
-            handle->row_in_file.get_cell(i).set_varchar_value(str_v.ptr_, str_v.len_);
-          }
-          if (OB_FAIL(handle->calc_tablet_id_expr->eval(handle->exec_ctx, handle->row_in_file, result))) {
-            LOG_WARN("fail to calc tablet id", K(ret));
-          } else {
-            tablet_id = ObTabletID(result.get_uint64());
-            if (OB_UNLIKELY(!tablet_id.is_valid())) {
-              ret = OB_NO_PARTITION_FOR_GIVEN_VALUE;
-              LOG_WARN("invalid partition for given value", K(ret));
-            }
-          }
+        } else if (OB_FAIL(calc_tablet_id(*handle, tablet_id))) {
+          LOG_WARN("fail to calc tablet id", K(ret));
         }
 
         LOG_DEBUG("LOAD DATA", "TheadId", get_tid_cache(), K(cur_line_num), K(tablet_id),
@@ -1153,6 +1146,30 @@ int ObLoadDataSPImpl::exec_shuffle(int64_t task_id, ObShuffleTaskHandle *handle)
   return ret;
 }
 
+int ObLoadDataSPImpl::calc_tablet_id(ObShuffleTaskHandle &handle, ObTabletID &tablet_id)
+{
+  int ret = OB_SUCCESS;
+  ObObj result;
+  if (nullptr == handle.calc_tablet_id_expr) {
+    tablet_id = handle.datafrag_mgr.get_tablet_ids().at(0);
+  } else {
+    for (int i = 0; i < handle.parser.get_fields_per_line().count(); ++i) {
+      ObCSVGeneralParser::FieldValue &str_v = handle.parser.get_fields_per_line().at(i);
+      handle.row_in_file.get_cell(i).set_varchar_value(str_v.ptr_, str_v.len_);
+    }
+    if (OB_FAIL(handle.calc_tablet_id_expr->eval(handle.exec_ctx, handle.row_in_file, result))) {
+      LOG_WARN("fail to calc tablet id", K(ret));
+    } else {
+      tablet_id = ObTabletID(result.get_uint64());
+      if (OB_UNLIKELY(!tablet_id.is_valid())) {
+        ret = OB_NO_PARTITION_FOR_GIVEN_VALUE;
+        LOG_WARN("invalid partition for given value", K(ret));
+      }
+    }
+  }
+  return ret;
+}
+
 int ObLoadDataSPImpl::exec_insert(ObInsertTask &task, ObInsertResult& result)
 {
   UNUSED(result);
@@ -1900,6 +1917,7 @@ int ObLoadDataSPImpl::execute(ObExecContext &ctx, ObLoadDataStmt &load_stmt)
   HEAP_VAR(ToolBox, box) {
     //init toolbox
     OZ (box.init(ctx, load_stmt));
+    OZ (prepare_load(ctx, load_stmt, box));
 
     LOG_INFO("LOAD DATA start report"
              , "file_path", load_stmt.get_load_arguments().file_name_
@@ -1941,6 +1959,8 @@ int ObLoadDataSPImpl::execute(ObExecContext &ctx, ObLoadDataStmt &load_stmt)
       OZ (ObLoadDataUtils::check_session_status(*ctx.get_my_session()));
     }
 
+    OZ (finish_load(ctx, box));
+
     //release
     OW (box.release_resources());
 
@@ -50,6 +50,7 @@ class ObLoadFileBuffer;
 class ObCSVParser;
 class ObLoadEscapeSM;
 class ObCSVGeneralParser;
+class ObLoadDataDirectTaskCtx;
 
 typedef common::hash::ObHashMap<common::ObString, int64_t> FileFieldIdxHashMap;
 typedef common::hash::ObHashMap<common::ObAddr, int64_t> ServerTimestampHashMap;
@@ -503,6 +504,7 @@ struct ObShuffleTaskHandle {
   common::ObBitSet<> &string_values;
   ObShuffleResult result;
   ObSEArray<ObParserErrRec, 16> err_records;
+  ObLoadDataDirectTaskCtx *direct_task_ctx; //not null if the rows are written to sstables directly
   TO_STRING_KV("task_id", result.task_id_);
 };
 
@@ -755,7 +757,7 @@ public:
   };
 public:
   ObLoadDataSPImpl() {}
-  ~ObLoadDataSPImpl() {}
+  virtual ~ObLoadDataSPImpl() {}
   int execute(ObExecContext &ctx, ObLoadDataStmt &load_stmt);
 
   int shuffle_task_gen_and_dispatch(ObExecContext &ctx, ToolBox &box);
@@ -763,7 +765,7 @@ public:
   int handle_returned_shuffle_task(ToolBox &box, ObShuffleTaskHandle &handle);
   int wait_shuffle_task_return(ToolBox &box);
 
-  int insert_task_gen_and_dispatch(ObExecContext &ctx, ToolBox &box);
+  virtual int insert_task_gen_and_dispatch(ObExecContext &ctx, ToolBox &box);
   int insert_task_send(ObInsertTask *insert_task, ToolBox &box);
   int handle_returned_insert_task(ObExecContext &ctx,
                                   ToolBox &box,
@@ -782,6 +784,20 @@ public:
 
   static int exec_shuffle(int64_t task_id, ObShuffleTaskHandle *handle);
   static int exec_insert(ObInsertTask &task, ObInsertResult &result);
+  static int calc_tablet_id(ObShuffleTaskHandle &handle, ObTabletID &tablet_id);
+
+protected:
+  //called after the toolbox is inited and after all the file data are shuffled
+  virtual int prepare_load(ObExecContext &ctx, ObLoadDataStmt &load_stmt, ToolBox &box)
+  {
+    UNUSEDx(ctx, load_stmt, box);
+    return common::OB_SUCCESS;
+  }
+  virtual int finish_load(ObExecContext &ctx, ToolBox &box)
+  {
+    UNUSEDx(ctx, box);
+    return common::OB_SUCCESS;
+  }
 
 private:
   static int gen_load_table_column_desc(ObExecContext &ctx,
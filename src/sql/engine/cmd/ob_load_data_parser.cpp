@@ -15,6 +15,7 @@
 #include "sql/engine/cmd/ob_load_data_parser.h"
 #include "sql/resolver/cmd/ob_load_data_stmt.h"
 #include "lib/oblog/ob_log_module.h"
+#include "storage/blocksstable/encoding/ob_encoding_query_util.h"
 
 using namespace oceanbase::sql;
 using namespace oceanbase::common;
@@ -24,6 +25,69 @@ namespace oceanbase
 namespace sql
 {
 
+uint64_t csv_structural_mask_normal(const char *block,
+                                    const int64_t len,
+                                    const char *chars,
+                                    const int64_t char_cnt)
+{
+  uint64_t mask = 0;
+  for (int64_t i = 0; i < len; ++i) {
+    for (int64_t j = 0; j < char_cnt; ++j) {
+      if (block[i] == chars[j]) {
+        mask |= (1ULL << i);
+        break;
+      }
+    }
+  }
+  return mask;
+}
+
+extern uint64_t csv_structural_mask_simd(const char *block,
+                                         const int64_t len,
+                                         const char *chars,
+                                         const int64_t char_cnt);
+
+ObCSVStructuralMaskFunc get_csv_structural_mask_func()
+{
+  return blocksstable::is_avx512_valid()
+      ? csv_structural_mask_simd
+      : csv_structural_mask_normal;
+}
+
+ObCSVStructuralMaskFunc csv_structural_mask_func = get_csv_structural_mask_func();
+
+int ObCSVStructuralIndex::add_char(const int64_t c)
+{
+  int ret = OB_SUCCESS;
+  bool is_exist = false;
+  if (INT64_MAX != c) {
+    const char ch = static_cast<char>(c);
+    for (int64_t i = 0; !is_exist && i < char_cnt_; ++i) {
+      is_exist = (ch == chars_[i]);
+    }
+    if (is_exist) {
+    } else if (OB_UNLIKELY(char_cnt_ >= MAX_CHAR_CNT)) {
+      ret = OB_SIZE_OVERFLOW;
+      LOG_WARN("too many structural chars", K(ret), K(c), KPC(this));
+    } else {
+      chars_[char_cnt_++] = ch;
+    }
+  }
+  return ret;
+}
+
+void ObCSVStructuralIndex::build_block(const char *str, const char *end)
+{
+  block_begin_ = str;
+  if (end - str >= BLOCK_SIZE) {
+    block_end_ = str + BLOCK_SIZE;
+    block_mask_ = csv_structural_mask_func(str, BLOCK_SIZE, chars_, char_cnt_);
+  } else {
+    block_end_ = end;
+    block_mask_ = csv_structural_mask_normal(str, end - str, chars_, char_cnt_);
+  }
+}
+
 int ObCSVGeneralParser::init(const ObDataInFileStruct &format,
                              int64_t file_column_nums,
                              ObCollationType file_cs_type)
@@ -63,6 +127,16 @@ int ObCSVGeneralParser::init(const ObDataInFileStruct &format,
         && !opt_param_.is_same_escape_enclosed_
         && format_.field_enclosed_char_ == INT64_MAX;
 
+    //every char the scanner stops at, the escaped char is a plain char if it is the enclosed char
+    struct_index_.reset();
+    OZ (struct_index_.add_char(opt_param_.field_term_c_));
+    OZ (struct_index_.add_char(opt_param_.line_term_c_));
+    OZ (struct_index_.add_char(format_.field_enclosed_char_));
+    if (!opt_param_.is_same_escape_enclosed_) {
+      OZ (struct_index_.add_char(format_.field_escaped_char_));
+    }
+    //the mask built char by char is slower than the byte by byte scan, only use it with avx512
+    OX (opt_param_.use_structural_index_ = blocksstable::is_avx512_valid() && struct_index_.is_valid());
   }
 
   if (OB_SUCC(ret) && OB_FAIL(fields_per_line_.prepare_allocate(file_column_nums))) {
@@ -40,6 +40,58 @@ struct ObCSVGeneralFormat {
   int64_t file_column_nums_;
 };
 
+typedef uint64_t (*ObCSVStructuralMaskFunc)(const char *block,
+                                            const int64_t len,
+                                            const char *chars,
+                                            const int64_t char_cnt);
+
+/**
+ * @brief bitmap of the structural chars of a buffer, which are the first chars of the
+ *        terminators, the enclosed char and the escaped char. The bitmap is built 64 bytes
+ *        at a time by simd if the cpu supports it, so that the scanner jumps from one
+ *        structural char to the next one instead of checking the plain chars one by one.
+ *        The content of the buffer should not change before reuse() is called.
+ */
+class ObCSVStructuralIndex
+{
+public:
+  static const int64_t BLOCK_SIZE = 64;
+  static const int64_t MAX_CHAR_CNT = 4;
+  ObCSVStructuralIndex() : char_cnt_(0), block_begin_(nullptr), block_end_(nullptr), block_mask_(0) {}
+  void reset() { char_cnt_ = 0; reuse(); }
+  void reuse() { block_begin_ = nullptr; block_end_ = nullptr; block_mask_ = 0; }
+  // INT64_MAX means no such char and is ignored
+  int add_char(const int64_t c);
+  bool is_valid() const { return char_cnt_ > 0; }
+
+  // the first structural char in [str, end), end if there is none
+  inline const char *next(const char *str, const char *end)
+  {
+    const char *found = end;
+    while (str < end && found == end) {
+      if (str < block_begin_ || str >= block_end_) {
+        build_block(str, end);
+      }
+      const uint64_t mask = block_mask_ & (~0ULL << (str - block_begin_));
+      if (0 != mask) {
+        found = block_begin_ + __builtin_ctzll(mask);
+      } else {
+        str = block_end_;
+      }
+    }
+    return found;
+  }
+  TO_STRING_KV("chars", common::ObString(char_cnt_, chars_), KP(block_begin_), KP(block_end_));
+private:
+  void build_block(const char *str, const char *end);
+private:
+  char chars_[MAX_CHAR_CNT];
+  int64_t char_cnt_;
+  const char *block_begin_;
+  const char *block_end_;
+  uint64_t block_mask_;
+};
+
 /**
  * @brief Fast csv general parser is mysql compatible csv parser
  *        It support single-byte or multi-byte seperators
@@ -73,7 +125,8 @@ public:
       is_filling_zero_to_empty_field_(false),
       is_line_term_by_counting_field_(false),
       is_same_escape_enclosed_(false),
-      is_simple_format_(false)
+      is_simple_format_(false),
+      use_structural_index_(false)
     {}
     char line_term_c_;
     char field_term_c_;
@@ -81,7 +134,9 @@ public:
     bool is_line_term_by_counting_field_;
     bool is_same_escape_enclosed_;
     bool is_simple_format_;
+    bool use_structural_index_;
   };
+  static const int64_t MAX_MB_CHAR_LEN = 4;
 public:
   ObCSVGeneralParser() {}
   int init(const ObDataInFileStruct &format,
@@ -89,6 +144,12 @@ public:
            common::ObCollationType file_cs_type);
   const ObCSVGeneralFormat &get_format() { return format_; }
   const OptParams &get_opt_params() { return opt_param_; }
+  // the byte by byte scan is used if disabled, for comparison.
+  // init() only enables the index if avx512 is available
+  void set_use_structural_index(bool use_index)
+  {
+    opt_param_.use_structural_index_ = use_index && struct_index_.is_valid();
+  }
 
   template<common::ObCharsetType cs_type, typename handle_func, bool DO_ESCAPE = false>
   int scan_proto(const char *&str, const char *end, int64_t &nrows,
@@ -134,6 +195,25 @@ private:
     return 1;
   }
 
+  // skip the plain chars before the next structural char, which is not skipped if it is
+  // covered by a multi-byte char, the result is the same as checking the chars one by one
+  template<common::ObCharsetType cs_type>
+  inline const char *skip_plain_chars(const char *str, const char *end)
+  {
+    const char *next = struct_index_.next(str, end);
+    for (int64_t k = 1; k < MAX_MB_CHAR_LEN && next - k >= str; ++k) {
+      if (mbcharlen<cs_type>(next - k, end) > k) {
+        const char *pos = str;
+        while (pos < next) {
+          pos += mbcharlen<cs_type>(pos, end);
+        }
+        next = pos;
+        break;
+      }
+    }
+    return next;
+  }
+
   int handle_irregular_line(int field_idx,
                             int line_no,
                             common::ObIArray<LineErrRec> &errors);
@@ -183,6 +263,7 @@ protected:
   ObCSVGeneralFormat format_;
   common::ObSEArray<FieldValue, 1> fields_per_line_;
   OptParams opt_param_;
+  ObCSVStructuralIndex struct_index_;
 };
 
 
@@ -243,6 +324,8 @@ int ObCSVGeneralParser::scan_proto(const char *&str,
 
   int line_no = 0;
   const char *line_begin = str;
+  //the buffer may be refilled between two scans
+  struct_index_.reuse();
 
   if (DO_ESCAPE) {
     if (escape_buf_end - escape_buf < end - str) {
@@ -288,6 +371,18 @@ int ObCSVGeneralParser::scan_proto(const char *&str,
         str++;
       }
       while (str < end && !is_term) {
+        if (opt_param_.use_structural_index_) {
+          const char *structural_str = skip_plain_chars<cs_type>(str, end);
+          if (structural_str != str) {
+            //the term flags are reset by the skipped plain chars
+            is_field_term = false;
+            is_line_term = false;
+            str = structural_str;
+          }
+          if (str >= end) {
+            break;
+          }
+        }
         const char *next = str + 1;
         if (next < end && ((format_.field_escaped_char_ == *str && !opt_param_.is_same_escape_enclosed_)
                            || (is_enclosed && format_.field_enclosed_char_ == *str && format_.field_enclosed_char_ == *next))) {
@@ -0,0 +1,51 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_ENG
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+#include <stdint.h>
+#include <stdlib.h>
+
+namespace oceanbase
+{
+namespace sql
+{
+// the block is always 64 bytes, the tail of the buffer is handled by the normal function
+uint64_t csv_structural_mask_simd(const char *block,
+                                  const int64_t len,
+                                  const char *chars,
+                                  const int64_t char_cnt)
+{
+#if defined(__x86_64__)
+  (void)len;
+  __m512i data = _mm512_loadu_si512(reinterpret_cast<const void *>(block));
+  __mmask64 mask = 0;
+  for (int64_t i = 0; i < char_cnt; ++i) {
+    mask |= _mm512_cmpeq_epi8_mask(data, _mm512_set1_epi8(chars[i]));
+  }
+  return static_cast<uint64_t>(mask);
+#else
+  (void)block;
+  (void)len;
+  (void)chars;
+  (void)char_cnt;
+  abort();
+  return 0;
+#endif
+}
+
+}  // namespace sql
+}  // namespace oceanbase
@@ -28,6 +28,7 @@
 #include "sql/code_generator/ob_code_generator.h"
 #include "sql/engine/ob_exec_context.h"
 #include "sql/engine/cmd/ob_load_data_impl.h"
+#include "sql/engine/cmd/ob_load_data_direct_impl.h"
 #include "lib/string/ob_string.h"
 #include "storage/tx_storage/ob_tenant_freezer.h"
 
@@ -147,6 +148,10 @@ int ObRpcLoadDataShuffleTaskExecuteP::process()
       if (OB_UNLIKELY(THIS_WORKER.is_timeout())) {
         ret = OB_TIMEOUT;
         LOG_WARN("LOAD DATA shuffle task timeout", K(ret), K(task));
+      } else if (NULL != handle->direct_task_ctx) {
+        if (OB_FAIL(ObLoadDataDirectImpl::exec_direct_shuffle(task.task_id_, handle))) {
+          LOG_WARN("fail to exec direct shuffle task", K(ret));
+        }
       } else if (OB_FAIL(ObLoadDataSPImpl::exec_shuffle(task.task_id_, handle))) {
         LOG_WARN("fail to exec shuffle task", K(ret));
       }
@@ -465,7 +465,8 @@ int ObSqlTransControl::start_stmt(ObExecContext &exec_ctx)
   if (OB_SUCC(ret)
       && txs->get_tx_elr_util().check_and_update_tx_elr_info(
                                          *session->get_tx_desc(),
-                                         session->get_early_lock_release())) {
+                                         session->get_early_lock_release()
+                                         || session->need_hotspot_row_elr())) {
     LOG_WARN("check and update tx elr info", K(ret), KPC(session->get_tx_desc()));
   }
   uint32_t session_id = 0;
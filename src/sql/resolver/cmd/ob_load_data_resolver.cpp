@@ -472,6 +472,12 @@ int ObLoadDataResolver::resolve_hints(const ParseNode &node)
         }
         break;
       }
+      case T_APPEND: {
+        if (OB_FAIL(stmt_hints.set_value(ObLoadDataHint::DIRECT_LOAD, 1))) {
+          LOG_WARN("fail to set direct load value", K(ret));
+        }
+        break;
+      }
       default:
         ret = OB_ERR_HINT_UNKNOWN;
         LOG_WARN("Unknown hint", "hint_name", get_type_name(hint_node->type_));
@@ -164,6 +164,7 @@ public:
     PARALLEL_THREADS = 0,  //parallel threads on the host server, for parsing and calc partition
     BATCH_SIZE,
     QUERY_TIMEOUT,
+    DIRECT_LOAD,  //write sstables directly without going through memtables
     TOTAL_INT_ITEM
   };
   enum StringHintItem {
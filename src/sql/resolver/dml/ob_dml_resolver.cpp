@@ -9267,6 +9267,10 @@ int ObDMLResolver::resolve_global_hint(const ParseNode &hint_node,
       global_hint.disable_cost_based_transform_ = true;
       break;
     }
+    case T_APPEND: {
+      // direct load is only done by LOAD DATA, the dml statements ignore the hint
+      break;
+    }
     default: {
       resolved_hint = false;
       break;
@@ -122,6 +122,7 @@ ObSQLSessionInfo::ObSQLSessionInfo() :
       has_temp_table_flag_(false),
       has_accessed_session_level_temp_table_(false),
       enable_early_lock_release_(false),
+      hotspot_row_elr_expire_ts_(0),
       is_for_trigger_package_(false),
       trans_type_(transaction::ObTxClass::USER),
       version_provider_(NULL),
@@ -282,6 +283,7 @@ void ObSQLSessionInfo::reset(bool skip_sys_var)
     inner_flag_ = false;
     is_max_availability_mode_ = false;
     enable_early_lock_release_ = false;
+    hotspot_row_elr_expire_ts_ = 0;
     ps_session_info_map_.reuse();
     ps_name_id_map_.reuse();
     next_client_ps_stmt_id_ = 0;
@@ -724,6 +724,16 @@ public:
   inline bool is_user_session() const { return USER_SESSION == session_type_; }
   void set_early_lock_release(bool enable);
   bool get_early_lock_release() const { return enable_early_lock_release_; }
+  // After an autocommit statement of the session is blocked by a hotspot row,
+  // the following autocommit statements release their row locks early until
+  // the expire ts, which is pushed back by every new hotspot row conflict.
+  void set_hotspot_row_elr_expire_ts(const int64_t expire_ts) { hotspot_row_elr_expire_ts_ = expire_ts; }
+  bool need_hotspot_row_elr() const
+  {
+    return !has_explicit_start_trans()
+        && get_local_autocommit()
+        && common::ObTimeUtility::current_time() < hotspot_row_elr_expire_ts_;
+  }
 
   bool is_inner() const
   {
@@ -970,6 +980,7 @@ private:
   bool has_temp_table_flag_;  //会话是否创建过临时表
   bool has_accessed_session_level_temp_table_;  //是否访问过Session临时表
   bool enable_early_lock_release_;
+  int64_t hotspot_row_elr_expire_ts_;
   // trigger.
   bool is_for_trigger_package_;
   transaction::ObTxClass trans_type_;
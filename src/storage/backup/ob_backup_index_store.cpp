@@ -562,7 +562,8 @@ int ObBackupMetaIndexStore::decode_meta_index_index_from_buffer_(const int64_t e
 
 /* ObBackupMacroBlockIndexStore */
 
-ObBackupMacroBlockIndexStore::ObBackupMacroBlockIndexStore() : ObIBackupIndexStore(), backup_set_desc_list_()
+ObBackupMacroBlockIndexStore::ObBackupMacroBlockIndexStore()
+  : ObIBackupIndexStore(), backup_set_desc_list_(), cached_range_index_(), cached_index_list_()
 {}
 
 ObBackupMacroBlockIndexStore::~ObBackupMacroBlockIndexStore()
@@ -657,9 +658,13 @@ int ObBackupMacroBlockIndexStore::get_macro_block_index(
     ret = OB_INVALID_ARGUMENT;
     LOG_WARN("get invalid args", K(ret), K(macro_id));
   } else if (OB_FAIL(inner_get_macro_block_range_index_(macro_id, range_index))) {
-    LOG_WARN("failed to inner get macro block range index", K(ret), K(macro_id));
+    if (OB_ENTRY_NOT_EXIST != ret) {
+      LOG_WARN("failed to inner get macro block range index", K(ret), K(macro_id));
+    }
   } else if (OB_FAIL(get_macro_block_index_(macro_id, range_index, macro_index))) {
-    LOG_WARN("failed to get macro block index", K(ret), K(macro_id), K(range_index));
+    if (OB_ENTRY_NOT_EXIST != ret) {
+      LOG_WARN("failed to get macro block index", K(ret), K(macro_id), K(range_index));
+    }
   }
   return ret;
 }
@@ -684,6 +689,8 @@ int ObBackupMacroBlockIndexStore::get_macro_range_index(
 void ObBackupMacroBlockIndexStore::reset()
 {
   turn_id_ = -1;
+  cached_range_index_.reset();
+  cached_index_list_.reset();
   is_inited_ = false;
 }
 
@@ -764,7 +771,9 @@ int ObBackupMacroBlockIndexStore::inner_get_macro_block_range_index_(
           if (OB_FAIL(decode_range_index_from_block_(end_pos, buffer_reader, index_list))) {
             LOG_WARN("failed to decode range index index from block", K(ret), K(end_pos), K(common_header));
           } else if (OB_FAIL(find_index_lower_bound_(logic_id, index_list, range_index))) {
-            LOG_WARN("failed to find index lower bound", K(ret), K(logic_id), K(index_list));
+            if (OB_ENTRY_NOT_EXIST != ret) {
+              LOG_WARN("failed to find index lower bound", K(ret), K(logic_id), K(index_list));
+            }
           } else {
             output = range_index;
             break;
@@ -773,7 +782,9 @@ int ObBackupMacroBlockIndexStore::inner_get_macro_block_range_index_(
           if (OB_FAIL(decode_range_index_index_from_block_(end_pos, buffer_reader, index_index_list))) {
             LOG_WARN("failed to decode index index from block", K(ret), K(end_pos), K(common_header));
           } else if (OB_FAIL(find_index_index_lower_bound_(logic_id, index_index_list, index_index))) {
-            LOG_WARN("failed to find lower bound", K(ret), K(logic_id), K(index_index_list));
+            if (OB_ENTRY_NOT_EXIST != ret) {
+              LOG_WARN("failed to find lower bound", K(ret), K(logic_id), K(index_index_list));
+            }
           } else {
             offset = index_index.offset_;
             length = index_index.length_;
@@ -813,7 +824,7 @@ int ObBackupMacroBlockIndexStore::find_index_lower_bound_(const common::ObLogicM
       index = *iter;
     } else {
       ret = OB_ENTRY_NOT_EXIST;
-      LOG_WARN("do not find such index", K(ret), K(logic_id), K(index_list));
+      LOG_DEBUG("do not find such index", K(ret), K(logic_id));
     }
   }
   return ret;
@@ -834,7 +845,7 @@ int ObBackupMacroBlockIndexStore::find_index_index_lower_bound_(const common::Ob
       index_index = *iter;
     } else {
       ret = OB_ENTRY_NOT_EXIST;
-      LOG_WARN("do not find such index", K(ret), K(logic_id), K(index_index_list));
+      LOG_DEBUG("do not find such index", K(ret), K(logic_id));
     }
   }
   return ret;
@@ -904,12 +915,15 @@ int ObBackupMacroBlockIndexStore::get_macro_block_index_(const common::ObLogicMa
   share::ObBackupPath backup_path;
   ObBufferReader buffer_reader;
   ObArenaAllocator allocator;
-  ObArray<ObBackupMacroBlockIndex> index_list;
   ObArray<ObBackupIndexBlockDesc> block_desc_list;
 
   if (OB_UNLIKELY(!macro_id.is_valid() || !range_index.is_valid())) {
     ret = OB_INVALID_ARGUMENT;
     LOG_WARN("get invalid args", K(ret), K(macro_id), K(range_index));
+  } else if (cached_range_index_.is_valid() && cached_range_index_ == range_index) {
+    // the index block is read already
+  } else if (FALSE_IT(cached_range_index_.reset())) {
+  } else if (FALSE_IT(cached_index_list_.reset())) {
   } else if (OB_FAIL(get_macro_block_backup_path_(range_index, backup_path))) {
     LOG_WARN("failed to get macro block backup path", K(ret), K(range_index));
   } else if (OB_FAIL(ObIBackupIndexIterator::read_backup_index_block_(backup_path,
@@ -920,23 +934,38 @@ int ObBackupMacroBlockIndexStore::get_macro_block_index_(const common::ObLogicMa
                  buffer_reader))) {
     LOG_WARN("failed to read index block", K(ret), K(backup_path), K(range_index));
   } else if (OB_FAIL(ObIBackupIndexIterator::parse_from_index_blocks_impl_(
-                 range_index.offset_, buffer_reader, index_list, block_desc_list))) {
+                 range_index.offset_, buffer_reader, cached_index_list_, block_desc_list))) {
     LOG_WARN("failed to parse from block", K(ret), K(backup_path), K(range_index), K(buffer_reader));
+    cached_index_list_.reset();
   } else {
-    bool found = false;
-    for (int64_t i = 0; OB_SUCC(ret) && i < index_list.count(); ++i) {
-      if (index_list.at(i).logic_id_ == macro_id) {
-        macro_index = index_list.at(i);
-        found = true;
-        break;
-      }
-    }
-    if (OB_SUCC(ret) && found) {
-      LOG_INFO("found macro block index success", K(macro_id), K(range_index), K(macro_id));
+    cached_range_index_ = range_index;
+  }
+
+  if (FAILEDx(find_macro_block_index_(macro_id, macro_index))) {
+    if (OB_ENTRY_NOT_EXIST == ret) {
+      LOG_DEBUG("no macro block index exist", K(ret), K(macro_id), K(range_index));
     } else {
-      ret = OB_ENTRY_NOT_EXIST;
-      LOG_WARN("no macro block index exist", K(ret), K(macro_id), K(range_index), K(index_list));
+      LOG_WARN("failed to find macro block index", K(ret), K(macro_id), K(range_index));
     }
+  } else {
+    LOG_DEBUG("found macro block index success", K(macro_id), K(range_index), K(macro_index));
+  }
+  return ret;
+}
+
+int ObBackupMacroBlockIndexStore::find_macro_block_index_(
+    const common::ObLogicMacroBlockId &macro_id, ObBackupMacroBlockIndex &macro_index)
+{
+  int ret = OB_SUCCESS;
+  bool found = false;
+  for (int64_t i = 0; !found && i < cached_index_list_.count(); ++i) {
+    if (cached_index_list_.at(i).logic_id_ == macro_id) {
+      macro_index = cached_index_list_.at(i);
+      found = true;
+    }
+  }
+  if (!found) {
+    ret = OB_ENTRY_NOT_EXIST;
   }
   return ret;
 }
@@ -163,10 +163,16 @@ private:
   int get_backup_set_desc_(const ObBackupMacroRangeIndex &range_index, share::ObBackupSetDesc &backup_set_desc);
   int get_macro_block_index_(const common::ObLogicMacroBlockId &macro_id, const ObBackupMacroRangeIndex &range_index,
       ObBackupMacroBlockIndex &macro_index);
+  int find_macro_block_index_(const common::ObLogicMacroBlockId &macro_id, ObBackupMacroBlockIndex &macro_index);
   virtual int fill_backup_set_descs_(const uint64_t tenant_id, const int64_t backup_set_id, common::ObMySQLProxy &sql_proxy);
 
 private:
   common::ObArray<share::ObBackupSetDesc> backup_set_desc_list_;
+  // the macro blocks of a backup batch are sorted by logic id, so the neighbouring lookups
+  // mostly hit the same index block. Keep the last one read to avoid reading it again from
+  // the backup dest. Not thread safe, the store is owned by one task.
+  ObBackupMacroRangeIndex cached_range_index_;
+  common::ObArray<ObBackupMacroBlockIndex> cached_index_list_;
   DISALLOW_COPY_AND_ASSIGN(ObBackupMacroBlockIndexStore);
 };
 
@@ -266,7 +266,7 @@ int ObMacroBlockBackupReader::get_macro_read_info_(
     read_info.macro_block_id_ = macro_block_id_;
     read_info.offset_ = 0;
     read_info.size_ = OB_SERVER_BLOCK_MGR.get_macro_block_size();
-    read_info.io_desc_.set_category(ObIOCategory::SYS_IO);
+    read_info.io_desc_.set_category(ObIOCategory::BACKUP_IO);
     read_info.io_desc_.set_wait_event(ObWaitEventIds::DB_FILE_MIGRATE_READ);
   }
   return ret;
@@ -2110,8 +2110,8 @@ int ObPrefetchBackupInfoTask::inner_process_()
             K(no_need_copy_item_list),
             K(no_need_copy_macro_index_list));
       } else {
-        LOG_INFO(
-            "receive backup items", K(task_id), K_(backup_data_type), "count", need_copy_item_list.count(), K_(param));
+        LOG_INFO("receive backup items", K(task_id), K_(backup_data_type), "count", need_copy_item_list.count(),
+            "reused_count", no_need_copy_item_list.count(), K_(param));
       }
     }
     if (OB_SUCC(ret)) {
@@ -510,6 +510,8 @@ int ObMacroBlockWriter::append_macro_block(const ObMacroBlockDesc &macro_desc)
         data_store_desc_->merge_info_->total_row_count_ += macro_desc.row_count_;
         data_store_desc_->merge_info_->occupy_size_
             += static_cast<const ObDataMacroBlockMeta *>(data_block_meta)->val_.occupy_size_;
+        data_store_desc_->merge_info_->multiplexed_macro_block_size_
+            += static_cast<const ObDataMacroBlockMeta *>(data_block_meta)->val_.occupy_size_;
       }
     }
   }
@@ -544,6 +546,7 @@ int ObMacroBlockWriter::append_micro_block(const ObMicroBlock &micro_block)
         STORAGE_LOG(WARN, "Failed to write micro block, ", K(ret), K(micro_block_desc));
       } else if (NULL != data_store_desc_->merge_info_) {
         data_store_desc_->merge_info_->multiplexed_micro_count_in_new_macro_++;
+        data_store_desc_->merge_info_->multiplexed_micro_size_in_new_macro_ += micro_block_desc.buf_size_;
       }
     }
   } else {
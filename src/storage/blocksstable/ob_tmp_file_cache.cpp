@@ -13,6 +13,7 @@
 #include "observer/omt/ob_tenant_config_mgr.h"
 #include "lib/stat/ob_diagnose_info.h"
 #include "common/ob_smart_var.h"
+#include "lib/compress/ob_compressor_pool.h"
 #include "storage/ob_file_system_router.h"
 #include "share/ob_task_define.h"
 #include "ob_tmp_file_cache.h"
@@ -643,6 +644,8 @@ ObTmpTenantMemBlockManager::ObTmpTenantMemBlockManager()
     block_write_ctx_(),
     last_access_tenant_config_ts_(0),
     last_tenant_mem_block_num_(1),
+    last_enable_compress_(false),
+    wash_block_ids_(),
     is_inited_(false)
 {
 }
@@ -710,6 +713,7 @@ void ObTmpTenantMemBlockManager::destroy()
   if (NULL != block_cache_) {
     block_cache_ = NULL;
   }
+  wash_block_ids_.reset();
   allocator_ = NULL;
   block_write_ctx_.reset();
   is_inited_ = false;
@@ -844,7 +848,8 @@ int ObTmpTenantMemBlockManager::get_macro_block(const int64_t dir_id,
     bool is_found = false;
     TmpMacroBlockMap::iterator iter;
     for (iter = t_mblk_map_.begin(); !is_found && iter != t_mblk_map_.end(); ++iter) {
-      if (tenant_id != iter->second->get_tenant_id() || dir_id != iter->second->get_dir_id()) {
+      if (tenant_id != iter->second->get_tenant_id() || dir_id != iter->second->get_dir_id()
+          || iter->second->is_washing()) {
         continue;
       } else {
         if (iter->second->get_max_cont_page_nums() < page_nums) {
@@ -883,8 +888,8 @@ int ObTmpTenantMemBlockManager::wash(const uint64_t tenant_id, int64_t block_num
   if (OB_UNLIKELY(!is_inited_)) {
     ret = OB_NOT_INIT;
     STORAGE_LOG(WARN, "ObTmpBlockCache has not been inited", K(ret));
-  } else if (OB_FAIL(wait_write_io_finish())) {
-    STORAGE_LOG(WARN, "fail to wait previous write io", K(ret));
+  } else if (OB_FAIL(reap_write_io())) {
+    STORAGE_LOG(WARN, "fail to reap previous write io", K(ret));
   } else {
     while (OB_SUCC(ret) && block_nums--) {
       int64_t count = t_mblk_map_.size();
@@ -978,8 +983,8 @@ int ObTmpTenantMemBlockManager::wash(const uint64_t tenant_id, ObTmpMacroBlock *
   if (OB_UNLIKELY(!is_inited_)) {
     ret = OB_NOT_INIT;
     STORAGE_LOG(WARN, "ObTmpBlockCache has not been inited", K(ret));
-  } else if (OB_FAIL(wait_write_io_finish())) {
-    STORAGE_LOG(WARN, "fail to wait previous write io", K(ret));
+  } else if (OB_FAIL(reap_write_io())) {
+    STORAGE_LOG(WARN, "fail to reap previous write io", K(ret));
   } else if (wash_block->is_disked()) {
     // nothing to do
   } else if (OB_FAIL(wash_with_no_wait(tenant_id, wash_block, is_empty))) {
@@ -1000,6 +1005,7 @@ int ObTmpTenantMemBlockManager::wash_with_no_wait(const uint64_t tenant_id,
     STORAGE_LOG(WARN, "The washing block is null", K(ret));
   } else {
     bool is_all_close = false;
+    bool is_queued = false;
     if (OB_FAIL(wash_block->close(is_all_close))) {
       STORAGE_LOG(WARN, "fail to close the wash block", K(ret));
     } else if (is_all_close) {
@@ -1011,27 +1017,16 @@ int ObTmpTenantMemBlockManager::wash_with_no_wait(const uint64_t tenant_id,
           is_empty = true;
         }
       } else if (wash_block->is_inited() && !wash_block->is_disked()) {
-        ObTmpBlockIOInfo info;
-        ObMacroBlockHandle &mb_handle = wash_block->get_macro_block_handle();
-        if (OB_FAIL(wash_block->get_wash_io_info(info))) {
-          STORAGE_LOG(WARN, "fail to get wash io info", K(ret), K(tenant_id));
-        } else if (OB_FAIL(write_io(info, wash_block->get_tmp_block_header(), mb_handle))) {
-          STORAGE_LOG(WARN, "fail to write tmp block", K(ret), K(tenant_id));
-        } else if (OB_FAIL(write_handles_.push_back(&mb_handle))) {
-          STORAGE_LOG(WARN, "fail to push back into write_handles", K(ret));
-        } else if (wash_block->is_disked()) {
-          // nothing to do
-        } else if (OB_FAIL(wash_block->give_back_buf_into_cache(true/*is_wash*/))) {
-          STORAGE_LOG(WARN, "fail to put tmp block cache", K(ret), K(tenant_id));
-        } else {
-          OB_TMP_FILE_STORE.dec_block_cache_num(tenant_id, 1);
-          free_page_nums_ -= wash_block->get_free_page_nums();
-          if (OB_FAIL(t_mblk_map_.erase_refactored(wash_block->get_block_id(), &wash_block))) {
-            STORAGE_LOG(WARN, "fail to erase t_mblk_map", K(ret));
+        if (is_compress_enabled()) {
+          // compressing a block takes long, it is done after the lock of the tenant file store is
+          // released. The block keeps washing, so no extent is allocated in it before it is written.
+          if (OB_FAIL(wash_block_ids_.push_back(wash_block->get_block_id()))) {
+            STORAGE_LOG(WARN, "fail to push back wash block id", K(ret), K(*wash_block));
           } else {
-            ObTaskController::get().allow_next_syslog();
-            STORAGE_LOG(INFO, "succeed to wash a block", K(*wash_block));
+            is_queued = true;
           }
+        } else if (OB_FAIL(write_wash_block(tenant_id, *wash_block, NULL, 0))) {
+          STORAGE_LOG(WARN, "fail to write wash block", K(ret), K(tenant_id));
         }
       } else {
         STORAGE_LOG(WARN, "this block has been destoryed", K(*wash_block));
@@ -1039,8 +1034,100 @@ int ObTmpTenantMemBlockManager::wash_with_no_wait(const uint64_t tenant_id,
     } else {
       STORAGE_LOG(INFO, "this block has some the unclosed extent", K(*wash_block));
     }
+    if (!is_queued) {
+      wash_block->set_washing_status(false);
+    }
+  }
+  return ret;
+}
+
+int ObTmpTenantMemBlockManager::write_wash_block(const uint64_t tenant_id,
+    ObTmpMacroBlock &wash_block, const char *compressed_buf, const int64_t compressed_size)
+{
+  int ret = OB_SUCCESS;
+  ObTmpBlockIOInfo info;
+  ObTmpMacroBlock *block = &wash_block;
+  ObMacroBlockHandle &mb_handle = wash_block.get_macro_block_handle();
+  if (OB_FAIL(wash_block.get_wash_io_info(info))) {
+    STORAGE_LOG(WARN, "fail to get wash io info", K(ret), K(tenant_id));
+  } else if (OB_FAIL(write_io(info, wash_block.get_tmp_block_header(), compressed_buf,
+      compressed_size, mb_handle))) {
+    STORAGE_LOG(WARN, "fail to write tmp block", K(ret), K(tenant_id));
+  } else if (FALSE_IT(wash_block.set_compressed_size(NULL == compressed_buf ? 0 : compressed_size))) {
+  } else if (OB_FAIL(write_handles_.push_back(&mb_handle))) {
+    STORAGE_LOG(WARN, "fail to push back into write_handles", K(ret));
+  } else if (wash_block.is_disked()) {
+    // nothing to do
+  } else if (OB_FAIL(wash_block.give_back_buf_into_cache(true/*is_wash*/))) {
+    STORAGE_LOG(WARN, "fail to put tmp block cache", K(ret), K(tenant_id));
+  } else {
+    OB_TMP_FILE_STORE.dec_block_cache_num(tenant_id, 1);
+    free_page_nums_ -= wash_block.get_free_page_nums();
+    if (OB_FAIL(t_mblk_map_.erase_refactored(wash_block.get_block_id(), &block))) {
+      STORAGE_LOG(WARN, "fail to erase t_mblk_map", K(ret));
+    } else {
+      ObTaskController::get().allow_next_syslog();
+      STORAGE_LOG(INFO, "succeed to wash a block", K(wash_block));
+    }
+  }
+  return ret;
+}
+
+int ObTmpTenantMemBlockManager::pop_wash_block(int64_t &block_id, ObTmpBlockIOInfo &io_info,
+    ObTmpBlockValueHandle &handle)
+{
+  int ret = OB_SUCCESS;
+  ObTmpMacroBlock *block = NULL;
+  block_id = -1;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    STORAGE_LOG(WARN, "ObTmpBlockCache has not been inited", K(ret));
+  }
+  while (OB_SUCC(ret) && NULL == block) {
+    if (wash_block_ids_.empty()) {
+      ret = OB_ITER_END;
+    } else if (OB_FAIL(wash_block_ids_.pop_back(block_id))) {
+      STORAGE_LOG(WARN, "fail to pop wash block id", K(ret));
+    } else if (OB_FAIL(t_mblk_map_.get_refactored(block_id, block))) {
+      if (OB_HASH_NOT_EXIST == ret) {
+        // the block has been freed after the wash, nothing to write.
+        block = NULL;
+        ret = OB_SUCCESS;
+      } else {
+        STORAGE_LOG(WARN, "fail to get wash block", K(ret), K(block_id));
+      }
+    } else if (OB_FAIL(block->get_wash_io_info(io_info))) {
+      STORAGE_LOG(WARN, "fail to get wash io info", K(ret), K(*block));
+    } else {
+      handle = block->get_handle();
+    }
+  }
+  return ret;
+}
+
+int ObTmpTenantMemBlockManager::write_wash_block(const uint64_t tenant_id, const int64_t block_id,
+    const char *compressed_buf, const int64_t compressed_size)
+{
+  int ret = OB_SUCCESS;
+  ObTmpMacroBlock *block = NULL;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    STORAGE_LOG(WARN, "ObTmpBlockCache has not been inited", K(ret));
+  } else if (OB_FAIL(t_mblk_map_.get_refactored(block_id, block))) {
+    if (OB_HASH_NOT_EXIST == ret) {
+      // the block has been freed during the compression.
+      ret = OB_SUCCESS;
+    } else {
+      STORAGE_LOG(WARN, "fail to get wash block", K(ret), K(block_id));
+    }
+  } else if (OB_FAIL(reap_write_io())) {
+    STORAGE_LOG(WARN, "fail to reap previous write io", K(ret));
+  } else if (OB_FAIL(write_wash_block(tenant_id, *block, compressed_buf, compressed_size))) {
+    STORAGE_LOG(WARN, "fail to write wash block", K(ret), K(tenant_id), K(*block));
+  }
+  if (NULL != block) {
+    block->set_washing_status(false);
   }
-  wash_block->set_washing_status(false);
   return ret;
 }
 
@@ -1066,9 +1153,121 @@ int ObTmpTenantMemBlockManager::wait_write_io_finish()
   return ret;
 }
 
+int ObTmpTenantMemBlockManager::wait_write_io_finish(ObTmpMacroBlock &block)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    STORAGE_LOG(WARN, "ObTmpFileStore has not been inited", K(ret));
+  } else {
+    const ObMacroBlockHandle *mb_handle = &block.get_macro_block_handle();
+    for (int64_t i = write_handles_.count() - 1; OB_SUCC(ret) && i >= 0; --i) {
+      if (mb_handle == write_handles_.at(i)) {
+        if (OB_FAIL(wait_write_io(i))) {
+          STORAGE_LOG(WARN, "fail to wait tmp write io", K(ret), K(block));
+        }
+        break;
+      }
+    }
+  }
+  return ret;
+}
+
+int ObTmpTenantMemBlockManager::reap_write_io()
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    STORAGE_LOG(WARN, "ObTmpFileStore has not been inited", K(ret));
+  } else {
+    for (int64_t i = write_handles_.count() - 1; OB_SUCC(ret) && i >= 0; --i) {
+      if (write_handles_.at(i)->get_io_handle().is_finished() && OB_FAIL(wait_write_io(i))) {
+        STORAGE_LOG(WARN, "fail to wait finished tmp write io", K(ret));
+      }
+    }
+    // the write handles are in the order of the wash, the oldest one is waited first.
+    while (OB_SUCC(ret) && write_handles_.count() >= MAX_PENDING_WRITE_IO_CNT) {
+      if (OB_FAIL(wait_write_io(0))) {
+        STORAGE_LOG(WARN, "fail to wait tmp write io", K(ret));
+      }
+    }
+  }
+  return ret;
+}
+
+int ObTmpTenantMemBlockManager::wait_write_io(const int64_t idx)
+{
+  int ret = OB_SUCCESS;
+  int tmp_ret = OB_SUCCESS;
+  const int64_t io_timeout_ms = GCONF._data_storage_io_timeout / 1000L;
+  ObMacroBlockHandle *mb_handle = NULL;
+  if (OB_UNLIKELY(idx < 0 || idx >= write_handles_.count())) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "invalid argument", K(ret), K(idx), K(write_handles_.count()));
+  } else if (OB_ISNULL(mb_handle = write_handles_.at(idx))) {
+    ret = OB_ERR_UNEXPECTED;
+    STORAGE_LOG(WARN, "the write handle is NULL", K(ret), K(idx));
+  } else {
+    if (OB_FAIL(mb_handle->wait(io_timeout_ms))) {
+      STORAGE_LOG(WARN, "fail to wait tmp write io", K(ret), K(*mb_handle));
+    }
+    mb_handle->get_io_handle().reset();
+    if (OB_SUCCESS != (tmp_ret = write_handles_.remove(idx))) {
+      STORAGE_LOG(WARN, "fail to remove write handle", K(tmp_ret), K(idx));
+      ret = OB_SUCC(ret) ? tmp_ret : ret;
+    } else if (0 == write_handles_.count()) {
+      block_write_ctx_.clear();
+    }
+  }
+  return ret;
+}
+
+int ObTmpTenantMemBlockManager::compress_block(const ObTmpBlockIOInfo &io_info,
+    char *&buf, int64_t &compressed_size)
+{
+  int ret = OB_SUCCESS;
+  common::ObCompressor *compressor = NULL;
+  int64_t max_overflow_size = 0;
+  int64_t buf_size = 0;
+  int64_t data_size = 0;
+  buf = NULL;
+  compressed_size = 0;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    STORAGE_LOG(WARN, "ObTmpBlockCache has not been inited", K(ret));
+  } else if (OB_FAIL(common::ObCompressorPool::get_instance().get_compressor(
+      common::LZ4_COMPRESSOR, compressor))) {
+    STORAGE_LOG(WARN, "fail to get lz4 compressor", K(ret));
+  } else if (OB_FAIL(compressor->get_max_overflow_size(io_info.size_, max_overflow_size))) {
+    STORAGE_LOG(WARN, "fail to get max overflow size", K(ret), K(io_info));
+  } else if (FALSE_IT(buf_size = io_info.size_ + max_overflow_size)) {
+  } else if (OB_ISNULL(buf = static_cast<char *>(allocator_->alloc(buf_size)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    STORAGE_LOG(WARN, "fail to alloc compress buf", K(ret), K(buf_size));
+  } else if (OB_FAIL(compressor->compress(io_info.buf_, io_info.size_, buf, buf_size, data_size))) {
+    STORAGE_LOG(WARN, "fail to compress tmp block", K(ret), K(io_info));
+  } else if (common::upper_align(data_size, DIO_READ_ALIGN_SIZE) <= io_info.size_ * MAX_COMPRESS_RATIO) {
+    compressed_size = data_size;
+  }
+  if (0 == compressed_size && NULL != buf) {
+    free_compress_buf(buf);
+    buf = NULL;
+  }
+  return ret;
+}
+
+void ObTmpTenantMemBlockManager::free_compress_buf(char *buf)
+{
+  if (NULL != buf && NULL != allocator_) {
+    allocator_->free(buf);
+  }
+}
+
 int ObTmpTenantMemBlockManager::write_io(
     const ObTmpBlockIOInfo &io_info,
     const ObTmpFileMacroBlockHeader &tmp_block_header,
+    const char *compressed_buf,
+    const int64_t compressed_size,
     ObMacroBlockHandle &handle)
 {
   int ret = OB_SUCCESS;
@@ -1086,6 +1285,11 @@ int ObTmpTenantMemBlockManager::write_io(
     write_info.buffer_ = io_info.buf_;
     write_info.offset_ = ObTmpMacroBlock::get_header_padding();
     write_info.size_ = io_info.size_;
+    if (NULL != compressed_buf && compressed_size > 0) {
+      // the data is copied by the io request, so the compress buf can be freed after the submit.
+      write_info.buffer_ = compressed_buf;
+      write_info.size_ = common::upper_align(compressed_size, DIO_READ_ALIGN_SIZE);
+    }
     if (OB_FAIL(ObBlockManager::async_write_block(write_info, handle))) {
       STORAGE_LOG(WARN, "Fail to async write block", K(ret), K(write_info), K(handle));
     } else if (OB_FAIL(block_write_ctx_.add_macro_block_id(handle.get_macro_id()))) {
@@ -1095,29 +1299,45 @@ int ObTmpTenantMemBlockManager::write_io(
   return ret;
 }
 
-int64_t ObTmpTenantMemBlockManager::get_tenant_mem_block_num()
+void ObTmpTenantMemBlockManager::refresh_tenant_config()
 {
-  int64_t tenant_mem_block_num = TENANT_MEM_BLOCK_NUM;
   int64_t last_access_ts = ATOMIC_LOAD(&last_access_tenant_config_ts_);
   if (last_access_ts > 0
       && common::ObClockGenerator::getClock() - last_access_ts < 10000000) {
-    tenant_mem_block_num = ATOMIC_LOAD(&last_tenant_mem_block_num_);
+    // use the cached config
   } else {
+    int64_t tenant_mem_block_num = TENANT_MEM_BLOCK_NUM;
+    bool enable_compress = false;
     omt::ObTenantConfigGuard tenant_config(TENANT_CONF(tenant_id_));
     if (!tenant_config.is_valid()) {
       COMMON_LOG(INFO, "failed to get tenant config", K_(tenant_id));
-    } else if (0 == tenant_config->_temporary_file_io_area_size) {
-      tenant_mem_block_num = 1L;
     } else {
-      const int64_t bytes = common::upper_align(
-        lib::get_tenant_memory_limit(tenant_id_) * tenant_config->_temporary_file_io_area_size / 100,
-        OB_TMP_FILE_STORE.get_block_size());
-      tenant_mem_block_num = bytes / OB_TMP_FILE_STORE.get_block_size();
+      enable_compress = tenant_config->_enable_temporary_file_compression;
+      if (0 == tenant_config->_temporary_file_io_area_size) {
+        tenant_mem_block_num = 1L;
+      } else {
+        const int64_t bytes = common::upper_align(
+          lib::get_tenant_memory_limit(tenant_id_) * tenant_config->_temporary_file_io_area_size / 100,
+          OB_TMP_FILE_STORE.get_block_size());
+        tenant_mem_block_num = bytes / OB_TMP_FILE_STORE.get_block_size();
+      }
     }
     ATOMIC_STORE(&last_tenant_mem_block_num_, tenant_mem_block_num);
+    ATOMIC_STORE(&last_enable_compress_, enable_compress);
     ATOMIC_STORE(&last_access_tenant_config_ts_, common::ObClockGenerator::getClock());
   }
-  return tenant_mem_block_num;
+}
+
+int64_t ObTmpTenantMemBlockManager::get_tenant_mem_block_num()
+{
+  refresh_tenant_config();
+  return ATOMIC_LOAD(&last_tenant_mem_block_num_);
+}
+
+bool ObTmpTenantMemBlockManager::is_compress_enabled()
+{
+  refresh_tenant_config();
+  return ATOMIC_LOAD(&last_enable_compress_);
 }
 
 }  // end namespace blocksstable
@@ -269,8 +269,18 @@ public:
   int try_wash(const uint64_t tenant_id, common::ObIArray<ObTmpMacroBlock *> &free_blocks);
   int add_macro_block(const uint64_t tenant_id, ObTmpMacroBlock *&t_mblk);
   int wait_write_io_finish();
-  OB_INLINE bool check_need_wait_write() { return write_handles_.count() > 0; }
+  // only wait for the write io of this block, nothing to do if it is not in flight.
+  int wait_write_io_finish(ObTmpMacroBlock &block);
   int free_extent(const int64_t free_page_nums, const ObTmpMacroBlock *t_mblk);
+  // the washed blocks to compress are queued by the wash, they are compressed without the lock of
+  // the tenant file store and written by write_wash_block(). The block is kept in memory and not
+  // allocated any more until it is written, the handle pins its buffer during the compression.
+  int pop_wash_block(int64_t &block_id, ObTmpBlockIOInfo &io_info, ObTmpBlockValueHandle &handle);
+  // the buf is allocated only if the block is worth compressing, free it by free_compress_buf().
+  int compress_block(const ObTmpBlockIOInfo &io_info, char *&buf, int64_t &compressed_size);
+  void free_compress_buf(char *buf);
+  int write_wash_block(const uint64_t tenant_id, const int64_t block_id,
+      const char *compressed_buf, const int64_t compressed_size);
 
 private:
   int get_macro_block(const int64_t dir_id, const uint64_t tenant_id, const int64_t page_nums,
@@ -279,12 +289,22 @@ private:
       common::ObIArray<ObTmpMacroBlock *> &free_blocks);
   int wash(const uint64_t tenant_id, ObTmpMacroBlock *wash_block, bool &is_empty);
   int wash_with_no_wait(const uint64_t tenant_id, ObTmpMacroBlock *wash_block, bool &is_empty);
+  int write_wash_block(const uint64_t tenant_id, ObTmpMacroBlock &wash_block,
+      const char *compressed_buf, const int64_t compressed_size);
   int write_io(
       const ObTmpBlockIOInfo &io_info,
       const ObTmpFileMacroBlockHeader &tmp_block_header,
+      const char *compressed_buf,
+      const int64_t compressed_size,
       ObMacroBlockHandle &handle);
+  // the washed blocks are flushed asynchronously, the finished write io are reaped here and
+  // the foreground only waits for the oldest one if too many write io are in flight.
+  int reap_write_io();
+  int wait_write_io(const int64_t idx);
   int refresh_dir_to_blk_map(const int64_t dir_id, const ObTmpMacroBlock *t_mblk);
+  void refresh_tenant_config();
   int64_t get_tenant_mem_block_num();
+  bool is_compress_enabled();
 
 private:
   // 1/256, only one free block each 256 block.
@@ -292,6 +312,9 @@ private:
   static const uint64_t DEFAULT_BUCKET_NUM = 1543L;
   static const uint64_t MBLK_HASH_BUCKET_NUM = 10243L;
   static const int64_t TENANT_MEM_BLOCK_NUM = 64L;
+  static const int64_t MAX_PENDING_WRITE_IO_CNT = 4L;
+  // the block is written as it is if lz4 can not save a quarter of the space.
+  static constexpr double MAX_COMPRESS_RATIO = 0.75;
   typedef common::hash::ObHashMap<int64_t, ObTmpMacroBlock*, common::hash::SpinReadWriteDefendMode>
       TmpMacroBlockMap;
   typedef common::hash::ObHashMap<int64_t, int64_t, common::hash::SpinReadWriteDefendMode> Map;
@@ -307,6 +330,8 @@ private:
   ObMacroBlocksWriteCtx block_write_ctx_;
   int64_t last_access_tenant_config_ts_;
   int64_t last_tenant_mem_block_num_;
+  bool last_enable_compress_;
+  common::ObSEArray<int64_t, 1> wash_block_ids_; // the washed blocks waiting for compression
   bool is_inited_;
   DISALLOW_COPY_AND_ASSIGN(ObTmpTenantMemBlockManager);
 };
@@ -12,7 +12,9 @@
 
 #include "ob_tmp_file_store.h"
 #include "ob_tmp_file.h"
+#include "ob_block_manager.h"
 #include "share/ob_task_define.h"
+#include "lib/compress/ob_compressor_pool.h"
 
 using namespace oceanbase::share;
 
@@ -419,6 +421,7 @@ ObTmpMacroBlock::ObTmpMacroBlock()
     macro_block_handle_(),
     tmp_file_header_(),
     io_desc_(),
+    compressed_size_(0),
     is_washing_(false),
     is_disked_(false),
     is_inited_(false)
@@ -444,6 +447,7 @@ int ObTmpMacroBlock::init(const int64_t block_id, const int64_t dir_id, const ui
     tmp_file_header_.dir_id_ = dir_id;
     tmp_file_header_.tenant_id_ = tenant_id;
     tmp_file_header_.free_page_nums_ = ObTmpFilePageBuddy::MAX_PAGE_NUMS;
+    compressed_size_ = 0;
     is_disked_ = false;
     is_washing_ = false;
     is_inited_ = true;
@@ -462,6 +466,7 @@ void ObTmpMacroBlock::destroy()
   tmp_file_header_.reset();
   buffer_ = NULL;
   handle_.reset();
+  compressed_size_ = 0;
   is_disked_ = false;
   is_washing_ = false;
   is_inited_ = false;
@@ -977,12 +982,58 @@ int ObTmpTenantFileStore::alloc(const int64_t dir_id, const uint64_t tenant_id,
       }
     }
   }
+  if (is_inited_) {
+    int tmp_ret = OB_SUCCESS;
+    if (OB_TMP_FAIL(flush_wash_blocks(tenant_id))) {
+      STORAGE_LOG(WARN, "fail to flush wash blocks", K(tmp_ret), K(tenant_id));
+    }
+  }
   if (OB_FAIL(ret) && OB_ALLOCATE_MEMORY_FAILED == ret) {
     STORAGE_LOG(WARN, "alloc memory failed", K(ret), K(ATOMIC_LOAD(&block_cache_num_)), K(ATOMIC_LOAD(&page_cache_num_)));
   }
   return ret;
 }
 
+int ObTmpTenantFileStore::flush_wash_blocks(const uint64_t tenant_id)
+{
+  int ret = OB_SUCCESS;
+  bool is_end = false;
+  while (OB_SUCC(ret) && !is_end) {
+    int64_t block_id = -1;
+    ObTmpBlockIOInfo io_info;
+    ObTmpBlockValueHandle handle;
+    char *compress_buf = NULL;
+    int64_t compressed_size = 0;
+    {
+      SpinWLockGuard guard(lock_);
+      if (OB_FAIL(tmp_mem_block_manager_.pop_wash_block(block_id, io_info, handle))) {
+        if (OB_ITER_END == ret) {
+          is_end = true;
+          ret = OB_SUCCESS;
+        } else {
+          STORAGE_LOG(WARN, "fail to pop wash block", K(ret));
+        }
+      }
+    }
+    if (OB_SUCC(ret) && !is_end) {
+      // the buffer of the block is pinned by the handle and no longer written, other io of the
+      // tenant is not blocked by the compression.
+      if (OB_FAIL(tmp_mem_block_manager_.compress_block(io_info, compress_buf, compressed_size))) {
+        STORAGE_LOG(WARN, "fail to compress tmp block, write it as it is", K(ret), K(io_info));
+        compressed_size = 0;
+        ret = OB_SUCCESS;
+      }
+      SpinWLockGuard guard(lock_);
+      if (OB_FAIL(tmp_mem_block_manager_.write_wash_block(tenant_id, block_id, compress_buf,
+          compressed_size))) {
+        STORAGE_LOG(WARN, "fail to write wash block", K(ret), K(block_id));
+      }
+    }
+    tmp_mem_block_manager_.free_compress_buf(compress_buf);
+  }
+  return ret;
+}
+
 int ObTmpTenantFileStore::free(ObTmpFileExtent *extent)
 {
   int ret = OB_SUCCESS;
@@ -1099,7 +1150,7 @@ int ObTmpTenantFileStore::free_macro_block(ObTmpMacroBlock *&t_mblk)
           t_mblk->set_disked();
         }
       } else if (!t_mblk->get_macro_block_handle().get_io_handle().is_empty() &&
-          OB_FAIL(tmp_mem_block_manager_.wait_write_io_finish())) { // in case of doing write io
+          OB_FAIL(tmp_mem_block_manager_.wait_write_io_finish(*t_mblk))) { // in case of doing write io
         STORAGE_LOG(WARN, "fail to wait write io finish", K(ret), K(t_mblk));
       }
       ObTaskController::get().allow_next_syslog();
@@ -1176,6 +1227,10 @@ int ObTmpTenantFileStore::read(ObTmpBlockIOInfo &io_info, ObTmpFileIOHandle &han
       if (OB_FAIL(handle.get_block_cache_handles().push_back(block_handle))) {
         STORAGE_LOG(WARN, "Fail to push back into block_handles", K(ret), K(block_handle));
       }
+    } else if (block->is_compressed()) {
+      if (OB_FAIL(read_compressed_block(block, io_info))) {
+        STORAGE_LOG(WARN, "fail to read compressed block", K(ret), K(io_info));
+      }
     } else if (OB_SUCC(read_page(block, io_info, handle))) {
       //nothing to do.
     } else {
@@ -1241,7 +1296,7 @@ int ObTmpTenantFileStore::read_page(ObTmpMacroBlock *block, ObTmpBlockIOInfo &io
 
     if (OB_SUCC(ret)) {
       // guarantee read io after the finished write.
-      if (OB_FAIL(wait_write_io_finish_if_need())) {
+      if (OB_FAIL(wait_write_io_finish_if_need(*block))) {
         STORAGE_LOG(WARN, "fail to wait previous write io", K(ret));
       } else {
         if (page_io_infos->count() > DEFAULT_PAGE_IO_MERGE_RATIO * page_nums) {
@@ -1295,19 +1350,60 @@ int ObTmpTenantFileStore::read_page(ObTmpMacroBlock *block, ObTmpBlockIOInfo &io
   return ret;
 }
 
-int ObTmpTenantFileStore::wait_write_io_finish_if_need()
+// the whole block is decompressed into the block cache, so that the following reads of
+// this block are served from memory.
+int ObTmpTenantFileStore::read_compressed_block(ObTmpMacroBlock *block, ObTmpBlockIOInfo &io_info)
 {
-  // guarantee read io after the finished write.
   int ret = OB_SUCCESS;
-  SpinWLockGuard guard(lock_);
-  if (tmp_mem_block_manager_.check_need_wait_write()) {
-    if (OB_FAIL(tmp_mem_block_manager_.wait_write_io_finish())) {
-      STORAGE_LOG(WARN, "fail to wait previous write io", K(ret));
+  const int64_t compressed_size = block->get_compressed_size();
+  ObTmpBlockCacheKey key(io_info.block_id_, io_info.tenant_id_);
+  ObTmpBlockValueHandle tb_handle;
+  ObMacroBlockHandle mb_handle;
+  ObMacroBlockReadInfo read_info;
+  common::ObCompressor *compressor = NULL;
+  int64_t data_size = 0;
+  read_info.io_desc_ = io_info.io_desc_;
+  read_info.macro_block_id_ = block->get_macro_block_id();
+  read_info.offset_ = ObTmpMacroBlock::get_header_padding();
+  read_info.size_ = common::upper_align(compressed_size, DIO_READ_ALIGN_SIZE);
+  if (OB_UNLIKELY(compressed_size <= 0 || io_info.offset_ + io_info.size_ > get_block_size())) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "invalid argument", K(ret), K(compressed_size), K(io_info));
+  } else if (OB_FAIL(wait_write_io_finish_if_need(*block))) {
+    STORAGE_LOG(WARN, "fail to wait previous write io", K(ret));
+  } else if (OB_FAIL(ObBlockManager::read_block(read_info, mb_handle))) {
+    STORAGE_LOG(WARN, "fail to read compressed tmp block", K(ret), K(read_info));
+  } else if (OB_FAIL(common::ObCompressorPool::get_instance().get_compressor(
+      common::LZ4_COMPRESSOR, compressor))) {
+    STORAGE_LOG(WARN, "fail to get lz4 compressor", K(ret));
+  } else if (OB_FAIL(tmp_mem_block_manager_.alloc_buf(key, tb_handle))) {
+    STORAGE_LOG(WARN, "fail to alloc block cache buf", K(ret), K(key));
+  } else if (OB_FAIL(compressor->decompress(mb_handle.get_buffer(), compressed_size,
+      tb_handle.value_->get_buffer(), get_block_size(), data_size))) {
+    STORAGE_LOG(WARN, "fail to decompress tmp block", K(ret), K(compressed_size), K(*block));
+  } else if (OB_UNLIKELY(get_block_size() != data_size)) {
+    ret = OB_ERR_UNEXPECTED;
+    STORAGE_LOG(WARN, "unexpected decompressed size", K(ret), K(data_size), K(*block));
+  } else {
+    MEMCPY(io_info.buf_, tb_handle.value_->get_buffer() + io_info.offset_, io_info.size_);
+    if (OB_FAIL(ObTmpBlockCache::get_instance().put_block(key, tb_handle))) {
+      STORAGE_LOG(WARN, "fail to put decompressed block into block cache", K(ret), K(key));
     }
   }
   return ret;
 }
 
+int ObTmpTenantFileStore::wait_write_io_finish_if_need(ObTmpMacroBlock &block)
+{
+  // guarantee read io after the finished write, the write io of the other blocks are not waited.
+  int ret = OB_SUCCESS;
+  SpinWLockGuard guard(lock_);
+  if (OB_FAIL(tmp_mem_block_manager_.wait_write_io_finish(block))) {
+    STORAGE_LOG(WARN, "fail to wait previous write io", K(ret), K(block));
+  }
+  return ret;
+}
+
 int ObTmpTenantFileStore::write(const ObTmpBlockIOInfo &io_info)
 {
   int ret = OB_SUCCESS;
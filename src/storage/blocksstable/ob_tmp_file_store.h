@@ -152,6 +152,10 @@ public:
   OB_INLINE bool is_inited() const { return is_inited_; }
   OB_INLINE bool is_disked() const { return ATOMIC_LOAD(&is_disked_); }
   OB_INLINE void set_disked() { ATOMIC_SET(&is_disked_, true); }
+  // the size of the lz4 compressed data on disk, 0 if the block is written as it is.
+  OB_INLINE int64_t get_compressed_size() const { return ATOMIC_LOAD(&compressed_size_); }
+  OB_INLINE void set_compressed_size(const int64_t size) { ATOMIC_SET(&compressed_size_, size); }
+  OB_INLINE bool is_compressed() const { return get_compressed_size() > 0; }
   static int64_t get_default_page_size() { return DEFAULT_PAGE_SIZE; }
   static int64_t calculate_offset(const int64_t page_start_id, const int64_t offset)
   {
@@ -174,7 +178,7 @@ public:
   int give_back_buf_into_cache(bool is_wash = false);
 
   TO_STRING_KV(KP_(buffer), K_(page_buddy), K_(handle), K_(macro_block_handle), K_(tmp_file_header),
-      K_(io_desc), K_(is_washing), K_(is_disked), K_(is_inited));
+      K_(io_desc), K_(compressed_size), K_(is_washing), K_(is_disked), K_(is_inited));
 private:
   static const int64_t DEFAULT_PAGE_SIZE;
   char *buffer_;
@@ -185,6 +189,7 @@ private:
   ObTmpFileMacroBlockHeader tmp_file_header_;
   common::ObIOFlag io_desc_;
   common::SpinRWLock lock_;
+  int64_t compressed_size_;
   bool is_washing_;
   bool is_disked_;
   bool is_inited_;
@@ -255,11 +260,14 @@ public:
 
 private:
   int read_page(ObTmpMacroBlock *block, ObTmpBlockIOInfo &io_info, ObTmpFileIOHandle &handle);
+  int read_compressed_block(ObTmpMacroBlock *block, ObTmpBlockIOInfo &io_info);
   int free_extent(ObTmpFileExtent *extent);
   int free_extent(const int64_t block_id, const int32_t start_page_id, const int32_t page_nums);
   int free_macro_block(ObTmpMacroBlock *&t_mblk);
   int alloc_macro_block(const int64_t dir_id, const uint64_t tenant_id, ObTmpMacroBlock *&t_mblk);
-  int wait_write_io_finish_if_need();
+  int wait_write_io_finish_if_need(ObTmpMacroBlock &block);
+  // compress the blocks queued by the wash without holding the lock and then write them.
+  int flush_wash_blocks(const uint64_t tenant_id);
 
 private:
   static const uint64_t IO_LIMIT = 4 * 1024L * 1024L * 1024L;
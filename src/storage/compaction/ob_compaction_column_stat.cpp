@@ -0,0 +1,897 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX STORAGE_COMPACTION
+#include "storage/compaction/ob_compaction_column_stat.h"
+#include "observer/ob_server_struct.h"
+#include "share/ob_common_rpc_proxy.h"
+#include "share/ob_rs_mgr.h"
+#include "share/schema/ob_multi_version_schema_service.h"
+#include "share/stat/ob_column_stat.h"
+#include "share/stat/ob_opt_column_stat.h"
+#include "share/stat/ob_opt_column_stat_cache.h"
+#include "share/stat/ob_opt_stat_manager.h"
+#include "share/stat/ob_opt_table_stat.h"
+#include "sql/engine/expr/ob_expr_estimate_ndv.h"
+#include "storage/compaction/ob_tablet_merge_ctx.h"
+#include "storage/compaction/ob_tenant_tablet_scheduler.h"
+#include "storage/ls/ob_ls.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace blocksstable;
+using namespace share::schema;
+namespace compaction
+{
+
+/*
+ *  ----------------------------------------------ObStatDatumHolder--------------------------------------------------
+ */
+
+int ObStatDatumHolder::copy(const ObStorageDatum &src, ObIAllocator &allocator)
+{
+  int ret = OB_SUCCESS;
+  int64_t pos = 0;
+  const int64_t copy_size = src.get_deep_copy_size();
+  if (copy_size > buf_size_) {
+    const int64_t new_size = MAX(copy_size, buf_size_ * 2);
+    char *new_buf = nullptr;
+    if (OB_ISNULL(new_buf = static_cast<char *>(allocator.alloc(new_size)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("failed to alloc stat datum buf", K(ret), K(new_size));
+    } else {
+      // the old buf belongs to the arena and is released with it
+      buf_ = new_buf;
+      buf_size_ = new_size;
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (OB_FAIL(datum_.deep_copy(src, buf_, buf_size_, pos))) {
+    LOG_WARN("failed to deep copy datum", K(ret), K(src));
+  }
+  return ret;
+}
+
+/*
+ *  ----------------------------------------------ObEquiDepthSampler--------------------------------------------------
+ */
+
+ObEquiDepthSampler::ObEquiDepthSampler()
+  : is_inited_(false),
+    allocator_(nullptr),
+    cmp_func_(nullptr),
+    run_value_(nullptr),
+    run_cnt_(0),
+    row_cnt_(0),
+    stride_(1),
+    next_sample_cnt_(0),
+    sample_cnt_(0),
+    samples_(nullptr)
+{
+}
+
+void ObEquiDepthSampler::reset()
+{
+  // the holders are allocated from the arena of the collector
+  is_inited_ = false;
+  allocator_ = nullptr;
+  cmp_func_ = nullptr;
+  run_value_ = nullptr;
+  run_cnt_ = 0;
+  row_cnt_ = 0;
+  stride_ = 1;
+  next_sample_cnt_ = 0;
+  sample_cnt_ = 0;
+  samples_ = nullptr;
+}
+
+int ObEquiDepthSampler::init(const ObDatumCmpFuncType cmp_func, ObIAllocator &allocator)
+{
+  int ret = OB_SUCCESS;
+  void *buf = nullptr;
+  if (IS_INIT) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("sampler init twice", K(ret));
+  } else if (OB_ISNULL(cmp_func)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid cmp func", K(ret));
+  } else if (OB_ISNULL(buf = allocator.alloc(sizeof(Sample) * MAX_SAMPLE_CNT))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("failed to alloc samples", K(ret));
+  } else if (FALSE_IT(samples_ = static_cast<Sample *>(buf))) {
+  } else if (OB_ISNULL(buf = allocator.alloc(sizeof(ObStatDatumHolder)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("failed to alloc run value holder", K(ret));
+  } else {
+    for (int64_t i = 0; i < MAX_SAMPLE_CNT; ++i) {
+      new (samples_ + i) Sample();
+    }
+    run_value_ = new (buf) ObStatDatumHolder();
+    allocator_ = &allocator;
+    cmp_func_ = cmp_func;
+    is_inited_ = true;
+  }
+  return ret;
+}
+
+int ObEquiDepthSampler::add(const ObStorageDatum &datum)
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("sampler not inited", K(ret));
+  } else if (run_cnt_ > 0 && 0 == cmp_func_(run_value_->get(), datum)) {
+    ++run_cnt_;
+    ++row_cnt_;
+  } else if (OB_FAIL(sample_run_(false/*force*/))) {
+    LOG_WARN("failed to sample run", K(ret));
+  } else if (OB_FAIL(run_value_->copy(datum, *allocator_))) {
+    LOG_WARN("failed to copy run value", K(ret), K(datum));
+  } else {
+    run_cnt_ = 1;
+    ++row_cnt_;
+  }
+  return ret;
+}
+
+int ObEquiDepthSampler::finish()
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("sampler not inited", K(ret));
+  } else if (OB_FAIL(sample_run_(true/*force*/))) {
+    LOG_WARN("failed to sample the last run", K(ret));
+  } else {
+    run_cnt_ = 0;
+  }
+  return ret;
+}
+
+int ObEquiDepthSampler::sample_run_(const bool force)
+{
+  int ret = OB_SUCCESS;
+  if (0 == run_cnt_ || (!force && row_cnt_ < next_sample_cnt_)) {
+    // no need to sample
+  } else {
+    if (MAX_SAMPLE_CNT == sample_cnt_) {
+      // keep the even ones, the holders of the dropped samples are swapped to
+      // the tail and reused
+      for (int64_t i = 1; i < MAX_SAMPLE_CNT / 2; ++i) {
+        std::swap(samples_[i], samples_[i * 2]);
+      }
+      sample_cnt_ = MAX_SAMPLE_CNT / 2;
+      stride_ *= 2;
+    }
+    Sample &sample = samples_[sample_cnt_];
+    void *buf = nullptr;
+    if (nullptr == sample.holder_) {
+      if (OB_ISNULL(buf = allocator_->alloc(sizeof(ObStatDatumHolder)))) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("failed to alloc sample holder", K(ret));
+      } else {
+        sample.holder_ = new (buf) ObStatDatumHolder();
+      }
+    }
+    if (OB_FAIL(ret)) {
+    } else if (OB_FAIL(sample.holder_->copy(run_value_->get(), *allocator_))) {
+      LOG_WARN("failed to copy sample value", K(ret));
+    } else {
+      sample.repeat_cnt_ = run_cnt_;
+      sample.endpoint_num_ = row_cnt_;
+      ++sample_cnt_;
+      next_sample_cnt_ = row_cnt_ + stride_;
+    }
+  }
+  return ret;
+}
+
+/*
+ *  ----------------------------------------------ObColumnStatCollector--------------------------------------------------
+ */
+
+ObColumnStatCollector::ColumnStat::ColumnStat()
+  : column_id_(OB_INVALID_ID),
+    col_idx_(-1),
+    meta_(),
+    cmp_func_(nullptr),
+    hash_func_(nullptr),
+    num_null_(0),
+    num_not_null_(0),
+    total_len_(0),
+    min_(),
+    max_(),
+    llc_bitmap_(nullptr),
+    sampler_(nullptr)
+{
+}
+
+ObColumnStatCollector::ObColumnStatCollector()
+  : is_inited_(false),
+    is_complete_(true),
+    allocator_("CompColStat"),
+    columns_(nullptr),
+    column_cnt_(0),
+    row_cnt_(0),
+    total_row_len_(0)
+{
+}
+
+void ObColumnStatCollector::reset()
+{
+  for (int64_t i = 0; i < column_cnt_; ++i) {
+    if (nullptr != columns_[i].sampler_) {
+      columns_[i].sampler_->~ObEquiDepthSampler();
+    }
+    columns_[i].~ColumnStat();
+  }
+  columns_ = nullptr;
+  column_cnt_ = 0;
+  row_cnt_ = 0;
+  total_row_len_ = 0;
+  is_complete_ = true;
+  is_inited_ = false;
+  allocator_.reset();
+}
+
+bool ObColumnStatCollector::need_collect_(const ObColDesc &col_desc)
+{
+  const ObObjType type = col_desc.col_type_.get_type();
+  return col_desc.col_id_ >= OB_APP_MIN_COLUMN_ID
+      && !is_shadow_column(col_desc.col_id_)
+      && !ob_is_text_tc(type)
+      && !ob_is_json(type)
+      && !ob_is_lob_locator(type);
+}
+
+int ObColumnStatCollector::init(const ObIArray<ObColDesc> &col_descs)
+{
+  int ret = OB_SUCCESS;
+  int64_t column_cnt = 0;
+  void *buf = nullptr;
+  if (IS_INIT) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("column stat collector init twice", K(ret));
+  } else if (OB_UNLIKELY(col_descs.empty())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid col descs", K(ret), K(col_descs));
+  } else {
+    for (int64_t i = 0; i < col_descs.count(); ++i) {
+      if (need_collect_(col_descs.at(i))) {
+        ++column_cnt;
+      }
+    }
+    if (0 == column_cnt) {
+    } else if (OB_ISNULL(buf = allocator_.alloc(sizeof(ColumnStat) * column_cnt))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("failed to alloc column stats", K(ret), K(column_cnt));
+    } else {
+      columns_ = static_cast<ColumnStat *>(buf);
+      for (int64_t i = 0; i < column_cnt; ++i) {
+        new (columns_ + i) ColumnStat();
+      }
+      column_cnt_ = column_cnt;
+    }
+  }
+  for (int64_t i = 0, pos = 0; OB_SUCC(ret) && i < col_descs.count(); ++i) {
+    const ObColDesc &col_desc = col_descs.at(i);
+    sql::ObExprBasicFuncs *basic_funcs = nullptr;
+    if (!need_collect_(col_desc)) {
+    } else if (OB_ISNULL(basic_funcs = ObDatumFuncs::get_basic_func(col_desc.col_type_.get_type(),
+                                                                    col_desc.col_type_.get_collation_type()))
+               || OB_ISNULL(basic_funcs->null_first_cmp_)
+               || OB_ISNULL(basic_funcs->default_hash_)) {
+      ret = OB_ERR_SYS;
+      LOG_WARN("unexpected null basic funcs", K(ret), K(col_desc));
+    } else if (OB_ISNULL(buf = allocator_.alloc(ObColumnStat::NUM_LLC_BUCKET))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("failed to alloc llc bitmap", K(ret));
+    } else {
+      ColumnStat &column = columns_[pos++];
+      column.column_id_ = col_desc.col_id_;
+      column.col_idx_ = i;
+      column.meta_ = col_desc.col_type_;
+      column.cmp_func_ = basic_funcs->null_first_cmp_;
+      // same as approx_count_distinct_synopsis, so the bitmaps could be merged
+      // with the ones gathered by dbms_stats
+      column.hash_func_ = basic_funcs->default_hash_;
+      column.llc_bitmap_ = static_cast<char *>(buf);
+      MEMSET(column.llc_bitmap_, 0, ObColumnStat::NUM_LLC_BUCKET);
+      if (0 != i) {
+        // only the leading rowkey column is in sorted order
+      } else if (OB_ISNULL(buf = allocator_.alloc(sizeof(ObEquiDepthSampler)))) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("failed to alloc sampler", K(ret));
+      } else if (FALSE_IT(column.sampler_ = new (buf) ObEquiDepthSampler())) {
+      } else if (OB_FAIL(column.sampler_->init(column.cmp_func_, allocator_))) {
+        LOG_WARN("failed to init sampler", K(ret));
+      }
+    }
+  }
+  if (OB_SUCC(ret)) {
+    is_inited_ = true;
+  } else {
+    reset();
+  }
+  return ret;
+}
+
+void ObColumnStatCollector::llc_add_value(const uint64_t hash_value, char *llc_bitmap)
+{
+  const uint64_t bucket_idx = hash_value >> (64 - ObColumnStat::BUCKET_BITS);
+  uint64_t pmax = 0;
+  if (0 != hash_value << ObColumnStat::BUCKET_BITS) {
+    pmax = sql::ObExprEstimateNdv::llc_leading_zeros(hash_value << ObColumnStat::BUCKET_BITS,
+                                                     64 - ObColumnStat::BUCKET_BITS) + 1;
+  }
+  if (pmax > static_cast<uint8_t>(llc_bitmap[bucket_idx])) {
+    llc_bitmap[bucket_idx] = static_cast<uint8_t>(pmax);
+  }
+}
+
+int ObColumnStatCollector::add_row(const ObDatumRow &row)
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("column stat collector not inited", K(ret));
+  } else if (!is_complete_) {
+    // the stats would be discarded
+  } else {
+    for (int64_t i = 0; OB_SUCC(ret) && i < column_cnt_; ++i) {
+      ColumnStat &column = columns_[i];
+      const ObStorageDatum &datum = row.storage_datums_[column.col_idx_];
+      if (datum.is_nop()) {
+      } else if (datum.is_null()) {
+        ++column.num_null_;
+      } else {
+        ++column.num_not_null_;
+        column.total_len_ += datum.len_;
+        total_row_len_ += datum.len_;
+        llc_add_value(column.hash_func_(datum, 0), column.llc_bitmap_);
+        if (column.min_.is_valid() && column.cmp_func_(datum, column.min_.get()) >= 0) {
+        } else if (OB_FAIL(column.min_.copy(datum, allocator_))) {
+          LOG_WARN("failed to copy min value", K(ret), K(datum));
+        }
+        if (OB_FAIL(ret)) {
+        } else if (column.max_.is_valid() && column.cmp_func_(datum, column.max_.get()) <= 0) {
+        } else if (OB_FAIL(column.max_.copy(datum, allocator_))) {
+          LOG_WARN("failed to copy max value", K(ret), K(datum));
+        }
+        if (OB_FAIL(ret) || nullptr == column.sampler_) {
+        } else if (OB_FAIL(column.sampler_->add(datum))) {
+          LOG_WARN("failed to add datum to sampler", K(ret), K(datum));
+        }
+      }
+    }
+    if (OB_SUCC(ret)) {
+      ++row_cnt_;
+    }
+  }
+  return ret;
+}
+
+int ObColumnStatCollector::finish()
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("column stat collector not inited", K(ret));
+  } else {
+    for (int64_t i = 0; OB_SUCC(ret) && i < column_cnt_; ++i) {
+      if (nullptr != columns_[i].sampler_ && OB_FAIL(columns_[i].sampler_->finish())) {
+        LOG_WARN("failed to finish sampler", K(ret), K(i));
+      }
+    }
+  }
+  return ret;
+}
+
+/*
+ *  ----------------------------------------------ObCompactionColumnStatReporter--------------------------------------------------
+ */
+
+int ObCompactionColumnStatReporter::check_need_report_(ObTabletMergeCtx &ctx, bool &need_report)
+{
+  int ret = OB_SUCCESS;
+  const ObIArray<ObColumnStatCollector *> &collectors = ctx.get_merge_info().get_column_stat_collectors();
+  const ObTableSchema *table_schema = ctx.schema_ctx_.table_schema_;
+  ObLS *ls = ctx.ls_handle_.get_ls();
+  ObRole role = INVALID_ROLE;
+  int64_t proposal_id = 0;
+  need_report = !collectors.empty();
+  for (int64_t i = 0; need_report && i < collectors.count(); ++i) {
+    // a task with no collector is not merged by rows
+    need_report = nullptr != collectors.at(i) && collectors.at(i)->is_complete();
+  }
+  if (!need_report) {
+  } else if (OB_ISNULL(table_schema) || !table_schema->is_user_table()) {
+    need_report = false;
+  } else if (OB_ISNULL(ls)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("ls is null", K(ret), K(ctx.param_));
+  } else if (OB_FAIL(ls->get_log_handler()->get_role(role, proposal_id))) {
+    LOG_WARN("failed to get role", K(ret), K(ctx.param_));
+  } else if (LEADER != role) {
+    // all the replicas merge the same data, only the leader writes the stats
+    need_report = false;
+  }
+  return ret;
+}
+
+int ObCompactionColumnStatReporter::get_partition_id_(
+    const ObTabletMergeCtx &ctx,
+    int64_t &partition_id,
+    int64_t &stat_level)
+{
+  int ret = OB_SUCCESS;
+  const ObTableSchema *table_schema = ctx.schema_ctx_.table_schema_;
+  int64_t part_id = OB_INVALID_INDEX;
+  int64_t subpart_id = OB_INVALID_INDEX;
+  if (OB_ISNULL(table_schema)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("table schema is null", K(ret));
+  } else if (PARTITION_LEVEL_ZERO == table_schema->get_part_level()) {
+    // the object id of the only tablet is the table id
+    partition_id = table_schema->get_table_id();
+    stat_level = TABLE_LEVEL;
+  } else if (OB_FAIL(table_schema->get_part_id_by_tablet(ctx.param_.tablet_id_, part_id, subpart_id))) {
+    LOG_WARN("failed to get part id by tablet", K(ret), K(ctx.param_));
+  } else if (PARTITION_LEVEL_TWO == table_schema->get_part_level()) {
+    partition_id = subpart_id;
+    stat_level = SUBPARTITION_LEVEL;
+  } else {
+    partition_id = part_id;
+    stat_level = PARTITION_LEVEL;
+  }
+  return ret;
+}
+
+int ObCompactionColumnStatReporter::build_histogram_(
+    const ObIArray<ObColumnStatCollector *> &collectors,
+    const int64_t col_pos,
+    const int64_t num_distinct,
+    ObOptColumnStat &col_stat)
+{
+  int ret = OB_SUCCESS;
+  ObHistogram &histogram = col_stat.get_histogram();
+  const int64_t total_cnt = col_stat.get_num_not_null();
+  const int64_t bucket_row_cnt = MAX(1, total_cnt / DEFAULT_BUCKET_CNT);
+  bool is_exact = true;
+  int64_t sample_cnt = 0;
+  int64_t pop_freq = 0;
+  int64_t pop_count = 0;
+  int64_t next_endpoint_num = 0;
+  int64_t offset = 0;
+  ObObj last_value;
+  for (int64_t i = 0; i < collectors.count(); ++i) {
+    const ObEquiDepthSampler *sampler = collectors.at(i)->get_column(col_pos).sampler_;
+    is_exact = is_exact && sampler->is_exact();
+    sample_cnt += sampler->get_sample_cnt();
+  }
+  is_exact = is_exact && sample_cnt <= DEFAULT_BUCKET_CNT;
+  // the ranges of the tasks are disjoint and in rowkey order, so the samples
+  // are concatenated with the row count of the previous tasks as offset
+  for (int64_t i = 0; OB_SUCC(ret) && i < collectors.count(); ++i) {
+    const ObEquiDepthSampler *sampler = collectors.at(i)->get_column(col_pos).sampler_;
+    for (int64_t j = 0; OB_SUCC(ret) && j < sampler->get_sample_cnt(); ++j) {
+      const ObEquiDepthSampler::Sample &sample = sampler->get_sample(j);
+      const int64_t endpoint_num = offset + sample.endpoint_num_;
+      const bool is_last = (i == collectors.count() - 1 && j == sampler->get_sample_cnt() - 1);
+      ObObj value;
+      if (OB_FAIL(sample.holder_->get().to_obj_enhance(value, collectors.at(i)->get_column(col_pos).meta_))) {
+        LOG_WARN("failed to transfer datum to obj", K(ret), K(sample));
+      } else if (histogram.get_bucket_size() > 0 && value == last_value) {
+        // the run of the same value is split by the ranges of the tasks
+        ObHistBucket &bucket = histogram.get(histogram.get_bucket_size() - 1);
+        bucket.endpoint_repeat_count_ += sample.repeat_cnt_;
+        bucket.endpoint_num_ = endpoint_num;
+      } else if (!is_exact && !is_last && endpoint_num < next_endpoint_num) {
+        // skip the samples to keep about DEFAULT_BUCKET_CNT buckets
+      } else if (OB_FAIL(col_stat.add_bucket(sample.repeat_cnt_, value, endpoint_num))) {
+        LOG_WARN("failed to add bucket", K(ret));
+      } else {
+        last_value = value;
+        next_endpoint_num = endpoint_num + bucket_row_cnt;
+      }
+    }
+    offset += sampler->get_row_cnt();
+  }
+  if (OB_SUCC(ret)) {
+    for (int64_t i = 0; i < histogram.get_bucket_size(); ++i) {
+      if (histogram.get(i).endpoint_repeat_count_ > bucket_row_cnt) {
+        pop_freq += histogram.get(i).endpoint_repeat_count_;
+        ++pop_count;
+      }
+    }
+    const ObHistType hist_type = is_exact ? ObHistType::FREQUENCY : ObHistType::HYBIRD;
+    histogram.set_type(hist_type);
+    histogram.set_sample_size(total_cnt);
+    histogram.set_bucket_cnt(histogram.get_bucket_size());
+    histogram.calc_density(hist_type, total_cnt, pop_freq, num_distinct, pop_count);
+  }
+  return ret;
+}
+
+int ObCompactionColumnStatReporter::build_column_stat_(
+    const ObIArray<ObColumnStatCollector *> &collectors,
+    const int64_t col_pos,
+    const int64_t row_cnt,
+    ObOptColumnStat &col_stat)
+{
+  int ret = OB_SUCCESS;
+  const ObColumnStatCollector::ColumnStat &first = collectors.at(0)->get_column(col_pos);
+  const ObStatDatumHolder *min = nullptr;
+  const ObStatDatumHolder *max = nullptr;
+  char *llc_bitmap = col_stat.get_llc_bitmap();
+  int64_t num_null = 0;
+  int64_t num_not_null = 0;
+  int64_t total_len = 0;
+  double num_distinct = 0;
+  if (OB_ISNULL(llc_bitmap) || ObColumnStat::NUM_LLC_BUCKET != col_stat.get_llc_bitmap_size()) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("llc bitmap of column stat is not allocated", K(ret));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < collectors.count(); ++i) {
+    const ObColumnStatCollector::ColumnStat &column = collectors.at(i)->get_column(col_pos);
+    num_null += column.num_null_;
+    num_not_null += column.num_not_null_;
+    total_len += column.total_len_;
+    for (int64_t j = 0; j < ObColumnStat::NUM_LLC_BUCKET; ++j) {
+      if (static_cast<uint8_t>(column.llc_bitmap_[j]) > static_cast<uint8_t>(llc_bitmap[j])) {
+        llc_bitmap[j] = column.llc_bitmap_[j];
+      }
+    }
+    if (!column.min_.is_valid()) {
+    } else if (nullptr == min || column.cmp_func_(column.min_.get(), min->get()) < 0) {
+      min = &column.min_;
+    }
+    if (!column.max_.is_valid()) {
+    } else if (nullptr == max || column.cmp_func_(column.max_.get(), max->get()) > 0) {
+      max = &column.max_;
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (OB_FAIL(sql::ObExprEstimateNdv::llc_estimate_ndv(
+      num_distinct, ObString(ObColumnStat::NUM_LLC_BUCKET, llc_bitmap)))) {
+    LOG_WARN("failed to estimate ndv", K(ret));
+  } else {
+    ObObj min_value;
+    ObObj max_value;
+    // the hll estimation may exceed the exact upper bound on small tables
+    const int64_t ndv = MIN(static_cast<int64_t>(num_distinct), num_not_null);
+    col_stat.set_column_id(first.column_id_);
+    col_stat.set_collation_type(first.meta_.get_collation_type());
+    col_stat.set_num_null(num_null);
+    col_stat.set_num_not_null(num_not_null);
+    col_stat.set_num_distinct(ndv);
+    col_stat.set_avg_len(0 == row_cnt ? 0 : total_len / row_cnt);
+    if (nullptr == min || nullptr == max) {
+      // all null, keep the null min and max value
+    } else if (OB_FAIL(min->get().to_obj_enhance(min_value, first.meta_))) {
+      LOG_WARN("failed to transfer min value", K(ret), KPC(min));
+    } else if (OB_FAIL(max->get().to_obj_enhance(max_value, first.meta_))) {
+      LOG_WARN("failed to transfer max value", K(ret), KPC(max));
+    } else {
+      col_stat.set_min_value(min_value);
+      col_stat.set_max_value(max_value);
+    }
+    if (OB_FAIL(ret) || nullptr == first.sampler_ || 0 == num_not_null) {
+    } else if (OB_FAIL(build_histogram_(collectors, col_pos, ndv, col_stat))) {
+      LOG_WARN("failed to build histogram", K(ret), K(col_pos));
+    }
+  }
+  return ret;
+}
+
+int ObCompactionColumnStatReporter::report(ObTabletMergeCtx &ctx)
+{
+  int ret = OB_SUCCESS;
+  const ObIArray<ObColumnStatCollector *> &collectors = ctx.get_merge_info().get_column_stat_collectors();
+  const uint64_t tenant_id = MTL_ID();
+  bool need_report = false;
+  int64_t partition_id = OB_INVALID_INDEX;
+  int64_t stat_level = INVALID_LEVEL;
+  if (OB_FAIL(check_need_report_(ctx, need_report))) {
+    LOG_WARN("failed to check need report column stat", K(ret), K(ctx.param_));
+  } else if (!need_report) {
+  } else if (OB_FAIL(get_partition_id_(ctx, partition_id, stat_level))) {
+    LOG_WARN("failed to get partition id", K(ret), K(ctx.param_));
+  } else {
+    const ObTableSchema &table_schema = *ctx.schema_ctx_.table_schema_;
+    const uint64_t table_id = table_schema.get_table_id();
+    const int64_t cur_time = ObTimeUtility::current_time();
+    ObArenaAllocator allocator("CompColStat");
+    ObOptTableStat table_stat;
+    ObSEArray<ObOptColumnStat *, 16> column_stats;
+    ObColumnStatReportTask task;
+    int64_t row_cnt = 0;
+    int64_t total_row_len = 0;
+    for (int64_t i = 0; i < collectors.count(); ++i) {
+      row_cnt += collectors.at(i)->get_row_cnt();
+      total_row_len += collectors.at(i)->get_total_row_len();
+    }
+    table_stat.set_table_id(table_id);
+    table_stat.set_partition_id(partition_id);
+    table_stat.set_object_type(stat_level);
+    table_stat.set_row_count(row_cnt);
+    table_stat.set_avg_row_size(0 == row_cnt ? 0 : total_row_len / row_cnt);
+    table_stat.set_macro_block_num(ctx.get_merge_info().get_sstable_merge_info().macro_block_count_);
+    table_stat.set_last_analyzed(cur_time);
+    for (int64_t i = 0; OB_SUCC(ret) && i < collectors.at(0)->get_column_cnt(); ++i) {
+      ObOptColumnStat *col_stat = nullptr;
+      void *buf = nullptr;
+      if (OB_ISNULL(buf = allocator.alloc(sizeof(ObOptColumnStat)))) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("failed to alloc column stat", K(ret));
+      } else if (FALSE_IT(col_stat = new (buf) ObOptColumnStat(allocator))) {
+      } else if (OB_FAIL(column_stats.push_back(col_stat))) {
+        col_stat->~ObOptColumnStat();
+        LOG_WARN("failed to push back column stat", K(ret));
+      } else if (FALSE_IT(col_stat->set_table_id(table_id))) {
+      } else if (FALSE_IT(col_stat->set_partition_id(partition_id))) {
+      } else if (FALSE_IT(col_stat->set_stat_level(stat_level))) {
+      } else if (FALSE_IT(col_stat->set_last_analyzed(cur_time))) {
+      } else if (OB_FAIL(build_column_stat_(collectors, i, row_cnt, *col_stat))) {
+        LOG_WARN("failed to build column stat", K(ret), K(i));
+      }
+    }
+    if (OB_FAIL(ret) || column_stats.empty()) {
+    } else if (OB_FAIL(task.init(tenant_id, table_stat, &column_stats.at(0), column_stats.count()))) {
+      LOG_WARN("failed to init column stat report task", K(ret), K(table_id), K(partition_id));
+    } else if (OB_FAIL(MTL(ObTenantTabletScheduler *)->schedule_report_column_stat(task))) {
+      LOG_WARN("failed to schedule column stat report task", K(ret), K(table_id), K(partition_id));
+    }
+    for (int64_t i = 0; i < column_stats.count(); ++i) {
+      column_stats.at(i)->~ObOptColumnStat();
+    }
+  }
+  return ret;
+}
+
+/*
+ *  ----------------------------------------------ObColumnStatReportTask--------------------------------------------------
+ */
+
+ObColumnStatReportTask::ObColumnStatReportTask()
+  : IObDedupTask(T_COMPACTION_COLUMN_STAT),
+    tenant_id_(OB_INVALID_TENANT_ID),
+    table_stat_(nullptr),
+    column_stats_(nullptr),
+    column_cnt_(0),
+    is_copy_(false)
+{
+}
+
+ObColumnStatReportTask::~ObColumnStatReportTask()
+{
+  if (is_copy_) {
+    for (int64_t i = 0; i < column_cnt_; ++i) {
+      column_stats_[i]->~ObOptColumnStat();
+    }
+    if (nullptr != table_stat_) {
+      table_stat_->~ObOptTableStat();
+    }
+  }
+  table_stat_ = nullptr;
+  column_stats_ = nullptr;
+  column_cnt_ = 0;
+}
+
+int ObColumnStatReportTask::init(
+    const uint64_t tenant_id,
+    ObOptTableStat &table_stat,
+    ObOptColumnStat **column_stats,
+    const int64_t column_cnt)
+{
+  int ret = OB_SUCCESS;
+  if (OB_NOT_NULL(table_stat_)) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("column stat report task init twice", K(ret));
+  } else if (OB_UNLIKELY(OB_INVALID_TENANT_ID == tenant_id || nullptr == column_stats || column_cnt <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(tenant_id), KP(column_stats), K(column_cnt));
+  } else {
+    tenant_id_ = tenant_id;
+    table_stat_ = &table_stat;
+    column_stats_ = column_stats;
+    column_cnt_ = column_cnt;
+  }
+  return ret;
+}
+
+int64_t ObColumnStatReportTask::hash() const
+{
+  uint64_t hash_val = 0;
+  const uint64_t table_id = table_stat_->get_table_id();
+  const int64_t partition_id = table_stat_->get_partition_id();
+  hash_val = murmurhash(&tenant_id_, sizeof(uint64_t), hash_val);
+  hash_val = murmurhash(&table_id, sizeof(uint64_t), hash_val);
+  hash_val = murmurhash(&partition_id, sizeof(int64_t), hash_val);
+  return hash_val;
+}
+
+bool ObColumnStatReportTask::operator ==(const IObDedupTask &other) const
+{
+  bool is_equal = false;
+  if (this == &other) {
+    is_equal = true;
+  } else if (get_type() == other.get_type()) {
+    // it's safe to do this transformation, we have checked the task's type
+    const ObColumnStatReportTask &o = static_cast<const ObColumnStatReportTask &>(other);
+    is_equal = o.tenant_id_ == tenant_id_
+               && o.table_stat_->get_table_id() == table_stat_->get_table_id()
+               && o.table_stat_->get_partition_id() == table_stat_->get_partition_id();
+  }
+  return is_equal;
+}
+
+int64_t ObColumnStatReportTask::get_deep_copy_size() const
+{
+  int64_t size = sizeof(*this) + upper_align(table_stat_->size(), sizeof(int64_t))
+                 + column_cnt_ * sizeof(ObOptColumnStat *);
+  for (int64_t i = 0; i < column_cnt_; ++i) {
+    size += upper_align(column_stats_[i]->size(), sizeof(int64_t));
+  }
+  return size;
+}
+
+IObDedupTask *ObColumnStatReportTask::deep_copy(char *buffer, const int64_t buf_size) const
+{
+  int ret = OB_SUCCESS;
+  ObColumnStatReportTask *task = nullptr;
+  if (OB_ISNULL(buffer) || OB_UNLIKELY(buf_size < get_deep_copy_size())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(buffer), K(buf_size));
+  } else {
+    ObIKVCacheValue *value = nullptr;
+    int64_t pos = sizeof(*this);
+    task = new (buffer) ObColumnStatReportTask();
+    task->tenant_id_ = tenant_id_;
+    task->is_copy_ = true;
+    if (OB_FAIL(table_stat_->deep_copy(buffer + pos, buf_size - pos, value))) {
+      LOG_WARN("failed to copy table stat", K(ret), KPC(table_stat_));
+    } else {
+      task->table_stat_ = static_cast<ObOptTableStat *>(value);
+      pos += upper_align(table_stat_->size(), sizeof(int64_t));
+      task->column_stats_ = reinterpret_cast<ObOptColumnStat **>(buffer + pos);
+      pos += column_cnt_ * sizeof(ObOptColumnStat *);
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && i < column_cnt_; ++i) {
+      if (OB_FAIL(column_stats_[i]->deep_copy(buffer + pos, buf_size - pos, value))) {
+        LOG_WARN("failed to copy column stat", K(ret), K(i));
+      } else {
+        task->column_stats_[task->column_cnt_++] = static_cast<ObOptColumnStat *>(value);
+        pos += upper_align(column_stats_[i]->size(), sizeof(int64_t));
+      }
+    }
+    if (OB_FAIL(ret)) {
+      task->~ObColumnStatReportTask();
+      task = nullptr;
+    }
+  }
+  return task;
+}
+
+int ObColumnStatReportTask::process()
+{
+  int ret = OB_SUCCESS;
+  ObSchemaGetterGuard schema_guard;
+  ObArenaAllocator allocator("CompColStat");
+  ObOptTableStat old_table_stat;
+  ObSEArray<ObOptTableStat *, 1> table_stats;
+  ObSEArray<ObOptColumnStat *, 16> column_stats;
+  const uint64_t table_id = nullptr == table_stat_ ? OB_INVALID_ID : table_stat_->get_table_id();
+  const int64_t partition_id = nullptr == table_stat_ ? OB_INVALID_INDEX : table_stat_->get_partition_id();
+  if (OB_UNLIKELY(!is_copy_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("only the task in queue could be processed", K(ret), KPC(this));
+  } else if (OB_FAIL(ObOptStatManager::get_instance().get_table_stat(
+      tenant_id_, ObOptTableStat::Key(tenant_id_, table_id, partition_id), old_table_stat))) {
+    LOG_WARN("failed to get table stat", K(ret), K(table_id), K(partition_id));
+  } else if (old_table_stat.get_stattype_locked() > 0) {
+    LOG_INFO("stats are locked, skip compaction column stat", K(table_id), K(partition_id));
+  } else if (OB_ISNULL(GCTX.schema_service_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("schema service is null", K(ret));
+  } else if (OB_FAIL(GCTX.schema_service_->get_tenant_schema_guard(tenant_id_, schema_guard))) {
+    LOG_WARN("failed to get tenant schema guard", K(ret), K_(tenant_id));
+  } else if (OB_FAIL(keep_histograms_(allocator))) {
+    LOG_WARN("failed to keep histograms", K(ret), K(table_id), K(partition_id));
+  } else if (OB_FAIL(table_stats.push_back(table_stat_))) {
+    LOG_WARN("failed to push back table stat", K(ret));
+  } else {
+    for (int64_t i = 0; OB_SUCC(ret) && i < column_cnt_; ++i) {
+      if (OB_FAIL(column_stats.push_back(column_stats_[i]))) {
+        LOG_WARN("failed to push back column stat", K(ret));
+      }
+    }
+    if (OB_FAIL(ret)) {
+    } else if (OB_FAIL(ObOptStatManager::get_instance().batch_write(&schema_guard,
+                                                                   tenant_id_,
+                                                                   table_stats,
+                                                                   column_stats,
+                                                                   table_stat_->get_last_analyzed(),
+                                                                   false/*is_index_stat*/,
+                                                                   false/*is_history_stat*/))) {
+      LOG_WARN("failed to write compaction column stat", K(ret), K(table_id), K(partition_id));
+    } else if (OB_FAIL(refresh_stat_cache_())) {
+      LOG_WARN("failed to refresh stat cache", K(ret), K(table_id), K(partition_id));
+    } else {
+      LOG_INFO("succeed to report compaction column stat", K(table_id), K(partition_id),
+               "row_cnt", table_stat_->get_row_count(), K_(column_cnt));
+    }
+  }
+  return ret;
+}
+
+int ObColumnStatReportTask::keep_histograms_(ObIAllocator &allocator)
+{
+  int ret = OB_SUCCESS;
+  for (int64_t i = 0; OB_SUCC(ret) && i < column_cnt_; ++i) {
+    ObOptColumnStat *col_stat = column_stats_[i];
+    ObOptColumnStatHandle handle;
+    const ObOptColumnStat::Key key(tenant_id_, col_stat->get_table_id(),
+                                   col_stat->get_partition_id(), col_stat->get_column_id());
+    if (col_stat->get_histogram().is_valid()) {
+      // rebuilt by the merge
+    } else if (OB_FAIL(ObOptStatManager::get_instance().get_column_stat(tenant_id_, key, handle))) {
+      LOG_WARN("failed to get column stat", K(ret), K(key));
+    } else if (nullptr == handle.stat_ || !handle.stat_->get_histogram().is_valid()) {
+      // no histogram to keep
+    } else {
+      const ObHistogram &old_histogram = handle.stat_->get_histogram();
+      const int64_t copy_size = old_histogram.deep_copy_size();
+      char *buf = nullptr;
+      int64_t pos = 0;
+      if (OB_ISNULL(buf = static_cast<char *>(allocator.alloc(copy_size)))) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("failed to alloc histogram", K(ret), K(copy_size));
+      } else if (OB_FAIL(col_stat->get_histogram().deep_copy(old_histogram, buf, copy_size, pos))) {
+        LOG_WARN("failed to copy histogram", K(ret), K(key));
+      }
+    }
+  }
+  return ret;
+}
+
+int ObColumnStatReportTask::refresh_stat_cache_()
+{
+  int ret = OB_SUCCESS;
+  // refresh the stat caches of all the servers as dbms_stats does
+  obrpc::ObUpdateStatCacheArg stat_arg;
+  ObAddr rs_addr;
+  stat_arg.tenant_id_ = tenant_id_;
+  stat_arg.table_id_ = table_stat_->get_table_id();
+  stat_arg.no_invalidate_ = true;
+  for (int64_t i = 0; OB_SUCC(ret) && i < column_cnt_; ++i) {
+    if (OB_FAIL(stat_arg.column_ids_.push_back(column_stats_[i]->get_column_id()))) {
+      LOG_WARN("failed to push back column id", K(ret));
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (OB_FAIL(stat_arg.partition_ids_.push_back(table_stat_->get_partition_id()))) {
+    LOG_WARN("failed to push back partition id", K(ret));
+  } else if (OB_ISNULL(GCTX.rs_rpc_proxy_) || OB_ISNULL(GCTX.rs_mgr_)) {
+    ret = OB_ERR_SYS;
+    LOG_WARN("rootserver rpc proxy or rs mgr is null", K(ret));
+  } else if (OB_FAIL(GCTX.rs_mgr_->get_master_root_server(rs_addr))) {
+    LOG_WARN("failed to get rootservice address", K(ret));
+  } else if (OB_FAIL(GCTX.rs_rpc_proxy_->to(rs_addr).update_stat_cache(stat_arg))) {
+    LOG_WARN("failed to update stat cache", K(ret), K(stat_arg));
+  }
+  return ret;
+}
+
+} // namespace compaction
+} // namespace oceanbase
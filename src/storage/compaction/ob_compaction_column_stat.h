@@ -0,0 +1,224 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_COMPACTION_OB_COMPACTION_COLUMN_STAT_H_
+#define OCEANBASE_COMPACTION_OB_COMPACTION_COLUMN_STAT_H_
+
+#include "lib/allocator/page_arena.h"
+#include "lib/queue/ob_dedup_queue.h"
+#include "share/datum/ob_datum_funcs.h"
+#include "share/schema/ob_table_param.h"
+#include "storage/blocksstable/ob_datum_row.h"
+
+namespace oceanbase
+{
+namespace common
+{
+class ObOptColumnStat;
+class ObOptTableStat;
+}
+namespace compaction
+{
+struct ObTabletMergeCtx;
+
+// keep a copy of the datum, the buffer is reused by the following copies and
+// only grows when the new datum does not fit
+class ObStatDatumHolder
+{
+public:
+  ObStatDatumHolder() : datum_(), buf_(nullptr), buf_size_(0) {}
+  ~ObStatDatumHolder() = default;
+  int copy(const blocksstable::ObStorageDatum &src, common::ObIAllocator &allocator);
+  const blocksstable::ObStorageDatum &get() const { return datum_; }
+  bool is_valid() const { return !datum_.is_nop(); }
+  TO_STRING_KV(K_(datum), K_(buf_size));
+private:
+  blocksstable::ObStorageDatum datum_;
+  char *buf_;
+  int64_t buf_size_;
+  DISALLOW_COPY_AND_ASSIGN(ObStatDatumHolder);
+};
+
+// Sample the endpoints of an equi-depth histogram from the values in sorted
+// order. The end of a run of equal values is sampled once the rows since the
+// last sample reach the stride, when the samples are full, every other one is
+// dropped and the stride is doubled, so the memory is bounded whatever the
+// number of rows is.
+class ObEquiDepthSampler
+{
+public:
+  static const int64_t MAX_SAMPLE_CNT = 512;
+  struct Sample
+  {
+    Sample() : holder_(nullptr), repeat_cnt_(0), endpoint_num_(0) {}
+    TO_STRING_KV(KPC_(holder), K_(repeat_cnt), K_(endpoint_num));
+    ObStatDatumHolder *holder_;
+    int64_t repeat_cnt_;
+    int64_t endpoint_num_; // cumulative row count up to this sample
+  };
+
+  ObEquiDepthSampler();
+  ~ObEquiDepthSampler() { reset(); }
+  void reset();
+  int init(const common::ObDatumCmpFuncType cmp_func, common::ObIAllocator &allocator);
+  // the values are expected in ascending order, null is not allowed
+  int add(const blocksstable::ObStorageDatum &datum);
+  int finish();
+  int64_t get_row_cnt() const { return row_cnt_; }
+  int64_t get_sample_cnt() const { return sample_cnt_; }
+  const Sample &get_sample(const int64_t idx) const { return samples_[idx]; }
+  // every distinct value is sampled
+  bool is_exact() const { return 1 == stride_; }
+  TO_STRING_KV(K_(is_inited), K_(run_cnt), K_(row_cnt), K_(stride), K_(next_sample_cnt), K_(sample_cnt));
+
+private:
+  int sample_run_(const bool force);
+
+private:
+  bool is_inited_;
+  common::ObIAllocator *allocator_;
+  common::ObDatumCmpFuncType cmp_func_;
+  ObStatDatumHolder *run_value_;
+  int64_t run_cnt_;
+  int64_t row_cnt_;
+  int64_t stride_;
+  int64_t next_sample_cnt_;
+  int64_t sample_cnt_;
+  Sample *samples_;
+  DISALLOW_COPY_AND_ASSIGN(ObEquiDepthSampler);
+};
+
+// Collect the column statistics of the rows written by one major merge task,
+// the hidden columns and the lob columns are skipped. The histogram is only
+// built on the leading rowkey column, which is the only one in sorted order,
+// the other columns only get the basic stats and the ndv.
+class ObColumnStatCollector
+{
+public:
+  struct ColumnStat
+  {
+    ColumnStat();
+    TO_STRING_KV(K_(column_id), K_(col_idx), K_(num_null), K_(num_not_null), K_(total_len),
+                 K_(min), K_(max), KPC_(sampler));
+    uint64_t column_id_;
+    int64_t col_idx_;
+    common::ObObjMeta meta_;
+    common::ObDatumCmpFuncType cmp_func_;
+    sql::ObExprHashFuncType hash_func_;
+    int64_t num_null_;
+    int64_t num_not_null_;
+    int64_t total_len_;
+    ObStatDatumHolder min_;
+    ObStatDatumHolder max_;
+    char *llc_bitmap_;
+    ObEquiDepthSampler *sampler_;
+  };
+
+  ObColumnStatCollector();
+  ~ObColumnStatCollector() { reset(); }
+  void reset();
+  int init(const common::ObIArray<share::schema::ObColDesc> &col_descs);
+  // the deleted rows should not be added
+  int add_row(const blocksstable::ObDatumRow &row);
+  int finish();
+  // some rows are not added, e.g. the macro blocks are reused
+  void set_incomplete() { is_complete_ = false; }
+  bool is_complete() const { return is_complete_; }
+  int64_t get_row_cnt() const { return row_cnt_; }
+  int64_t get_total_row_len() const { return total_row_len_; }
+  int64_t get_column_cnt() const { return column_cnt_; }
+  const ColumnStat &get_column(const int64_t idx) const { return columns_[idx]; }
+  static void llc_add_value(const uint64_t hash_value, char *llc_bitmap);
+  TO_STRING_KV(K_(is_inited), K_(is_complete), K_(column_cnt), K_(row_cnt), K_(total_row_len));
+
+private:
+  static bool need_collect_(const share::schema::ObColDesc &col_desc);
+
+private:
+  bool is_inited_;
+  bool is_complete_;
+  common::ObArenaAllocator allocator_;
+  ColumnStat *columns_;
+  int64_t column_cnt_;
+  int64_t row_cnt_;
+  int64_t total_row_len_;
+  DISALLOW_COPY_AND_ASSIGN(ObColumnStatCollector);
+};
+
+// Write the stats of a partition to the optimizer statistics tables and
+// refresh the stat caches. The task runs in the column stat queue of the
+// tenant tablet scheduler, so the inner sql and the rpc to rootservice never
+// block the merge threads. The columns without a rebuilt histogram keep the
+// histogram gathered by dbms_stats, since writing a column stat replaces all
+// of its histogram.
+class ObColumnStatReportTask : public common::IObDedupTask
+{
+public:
+  ObColumnStatReportTask();
+  virtual ~ObColumnStatReportTask();
+  // the stats are referenced until the task is added to the queue
+  int init(
+      const uint64_t tenant_id,
+      common::ObOptTableStat &table_stat,
+      common::ObOptColumnStat **column_stats,
+      const int64_t column_cnt);
+  virtual int64_t hash() const override;
+  virtual bool operator ==(const common::IObDedupTask &other) const override;
+  virtual int64_t get_deep_copy_size() const override;
+  virtual common::IObDedupTask *deep_copy(char *buffer, const int64_t buf_size) const override;
+  virtual int64_t get_abs_expired_time() const override { return 0; }
+  virtual int process() override;
+  TO_STRING_KV(K_(tenant_id), KPC_(table_stat), K_(column_cnt), K_(is_copy));
+
+private:
+  int keep_histograms_(common::ObIAllocator &allocator);
+  int refresh_stat_cache_();
+
+private:
+  uint64_t tenant_id_;
+  common::ObOptTableStat *table_stat_;
+  common::ObOptColumnStat **column_stats_;
+  int64_t column_cnt_;
+  bool is_copy_; // the stats are copied into the buffer of the task
+  DISALLOW_COPY_AND_ASSIGN(ObColumnStatReportTask);
+};
+
+// Merge the statistics collected by all the tasks of a major merge into the
+// stats of the partition and hand them to ObColumnStatReportTask.
+class ObCompactionColumnStatReporter
+{
+public:
+  static const int64_t DEFAULT_BUCKET_CNT = 254;
+  static int report(ObTabletMergeCtx &ctx);
+
+private:
+  static int check_need_report_(ObTabletMergeCtx &ctx, bool &need_report);
+  static int get_partition_id_(
+      const ObTabletMergeCtx &ctx,
+      int64_t &partition_id,
+      int64_t &stat_level);
+  static int build_column_stat_(
+      const common::ObIArray<ObColumnStatCollector *> &collectors,
+      const int64_t col_pos,
+      const int64_t row_cnt,
+      common::ObOptColumnStat &col_stat);
+  static int build_histogram_(
+      const common::ObIArray<ObColumnStatCollector *> &collectors,
+      const int64_t col_pos,
+      const int64_t num_distinct,
+      common::ObOptColumnStat &col_stat);
+};
+
+} // namespace compaction
+} // namespace oceanbase
+
+#endif // OCEANBASE_COMPACTION_OB_COMPACTION_COLUMN_STAT_H_
@@ -13,12 +13,17 @@
 #define USING_LOG_PREFIX STORAGE_COMPACTION
 
 #include "ob_i_compaction_filter.h"
+#include "lib/json/ob_json.h"
+#include "share/rc/ob_tenant_base.h"
+#include "share/schema/ob_table_schema.h"
+#include "share/table/ob_table.h"
 #include "storage/ob_i_store.h"
 
 namespace oceanbase
 {
 using namespace common;
 using namespace storage;
+using namespace share::schema;
 
 namespace compaction
 {
@@ -125,5 +130,332 @@ int ObTransStatusFilter::filter(
 }
 
 
+int ObTTLDescriptor::parse_from_comment(const ObString &comment, ObArenaAllocator &allocator)
+{
+  int ret = OB_SUCCESS;
+  json::Parser json_parser;
+  json::Value *ast = NULL;
+  is_htable_ = false;
+  time_to_live_ = 0;
+  max_versions_ = 0;
+  column_name_.reset();
+  if (comment.empty()) {
+    // skip
+  } else if (OB_FAIL(json_parser.init(&allocator))) {
+    LOG_WARN("failed to init json parser", K(ret));
+  } else if (OB_FAIL(json_parser.parse(comment.ptr(), comment.length(), ast))) {
+    // the comment is not a ttl descriptor
+    LOG_DEBUG("failed to parse comment", K(ret), K(comment));
+    ret = OB_SUCCESS;
+  } else if (NULL != ast
+             && ast->get_type() == json::JT_OBJECT
+             && ast->get_object().get_size() == 1) {
+    json::Pair *kv = ast->get_object().get_first();
+    if (NULL != kv && kv != ast->get_object().get_header()
+        && NULL != kv->value_ && kv->value_->get_type() == json::JT_OBJECT) {
+      const bool is_htable = (0 == kv->name_.case_compare("HColumnDescriptor"));
+      if (is_htable || 0 == kv->name_.case_compare("TTLDescriptor")) {
+        is_htable_ = is_htable;
+        DLIST_FOREACH(elem, kv->value_->get_object()) {
+          json::Value *val = elem->value_;
+          if (NULL == val) {
+          } else if (0 == elem->name_.case_compare("TimeToLive") && val->get_type() == json::JT_NUMBER) {
+            time_to_live_ = val->get_number();
+          } else if (0 == elem->name_.case_compare("MaxVersions") && val->get_type() == json::JT_NUMBER) {
+            max_versions_ = val->get_number();
+          } else if (0 == elem->name_.case_compare("Column") && val->get_type() == json::JT_STRING) {
+            column_name_ = val->get_string();
+          }
+        }  // end foreach
+      }
+    }
+  }
+  return ret;
+}
+
+bool ObTTLCompactionFilter::TaskState::is_same_cell(const ObString &key, const ObString &qualifier) const
+{
+  return key_len_ == key.length()
+      && qualifier_len_ == qualifier.length()
+      && 0 == MEMCMP(buf_, key.ptr(), key_len_)
+      && 0 == MEMCMP(buf_ + key_len_, qualifier.ptr(), qualifier_len_);
+}
+
+ObTTLCompactionFilter::TaskState::~TaskState()
+{
+  if (OB_NOT_NULL(buf_)) {
+    ob_free(buf_);
+    buf_ = nullptr;
+  }
+}
+
+int ObTTLCompactionFilter::TaskState::set_cell(const ObString &key, const ObString &qualifier)
+{
+  int ret = OB_SUCCESS;
+  const int64_t len = key.length() + qualifier.length();
+  if (len > buf_size_) {
+    const int64_t buf_size = MAX(len, buf_size_ * 2);
+    char *buf = nullptr;
+    if (OB_ISNULL(buf = static_cast<char *>(ob_malloc(buf_size, ObMemAttr(MTL_ID(), "TTLFilter"))))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("failed to alloc cell buf", K(ret), K(buf_size));
+    } else {
+      if (OB_NOT_NULL(buf_)) {
+        ob_free(buf_);
+      }
+      buf_ = buf;
+      buf_size_ = buf_size;
+    }
+  }
+  if (OB_SUCC(ret)) {
+    MEMCPY(buf_, key.ptr(), key.length());
+    MEMCPY(buf_ + key.length(), qualifier.ptr(), qualifier.length());
+    key_len_ = key.length();
+    qualifier_len_ = qualifier.length();
+    version_cnt_ = 0;
+  }
+  return ret;
+}
+
+ObTTLCompactionFilter::ObTTLCompactionFilter()
+  : ObICompactionFilter(true),
+    is_inited_(false),
+    is_htable_(false),
+    time_to_live_(0),
+    expire_col_idx_(-1),
+    expire_ts_(INT64_MIN),
+    max_versions_(0),
+    concurrent_cnt_(0),
+    task_states_(nullptr),
+    allocator_("TTLFilter")
+{
+}
+
+void ObTTLCompactionFilter::reset()
+{
+  if (OB_NOT_NULL(task_states_)) {
+    for (int64_t i = 0; i < concurrent_cnt_; ++i) {
+      task_states_[i].~TaskState();
+    }
+    task_states_ = nullptr;
+  }
+  ObICompactionFilter::reset();
+  is_full_merge_ = true;
+  is_htable_ = false;
+  time_to_live_ = 0;
+  expire_col_idx_ = -1;
+  expire_ts_ = INT64_MIN;
+  max_versions_ = 0;
+  concurrent_cnt_ = 0;
+  allocator_.reset();
+  is_inited_ = false;
+}
+
+int ObTTLCompactionFilter::init(
+    const ObTableSchema &table_schema,
+    const ObTTLDescriptor &ttl_desc,
+    const int64_t snapshot_version)
+{
+  int ret = OB_SUCCESS;
+  if (IS_INIT) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("is inited", K(ret), K(ttl_desc));
+  } else if (OB_UNLIKELY(!ttl_desc.is_valid() || snapshot_version <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(ttl_desc), K(snapshot_version));
+  } else if (FALSE_IT(time_to_live_ = ttl_desc.time_to_live_)) {
+  } else if (ttl_desc.is_htable_ && OB_FAIL(init_htable_(table_schema, snapshot_version))) {
+    LOG_WARN("failed to init htable ttl", K(ret), K(ttl_desc));
+  } else if (!ttl_desc.is_htable_
+      && OB_FAIL(init_timestamp_column_(table_schema, ttl_desc.column_name_, snapshot_version))) {
+    LOG_WARN("failed to init timestamp column ttl", K(ret), K(ttl_desc));
+  } else {
+    is_htable_ = ttl_desc.is_htable_;
+    max_versions_ = is_htable_ ? MAX(0, ttl_desc.max_versions_) : 0;
+    is_inited_ = true;
+  }
+  if (OB_FAIL(ret) && OB_INIT_TWICE != ret) {
+    reset();
+  }
+  return ret;
+}
+
+int ObTTLCompactionFilter::init_task_states(const int64_t concurrent_cnt)
+{
+  int ret = OB_SUCCESS;
+  void *buf = nullptr;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_NOT_NULL(task_states_)) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("task states are inited", K(ret), K_(concurrent_cnt));
+  } else if (OB_UNLIKELY(concurrent_cnt <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(concurrent_cnt));
+  } else if (OB_ISNULL(buf = allocator_.alloc(sizeof(TaskState) * concurrent_cnt))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("failed to alloc task states", K(ret), K(concurrent_cnt));
+  } else {
+    task_states_ = static_cast<TaskState *>(buf);
+    for (int64_t i = 0; i < concurrent_cnt; ++i) {
+      new (task_states_ + i) TaskState();
+    }
+    concurrent_cnt_ = concurrent_cnt;
+  }
+  return ret;
+}
+
+int ObTTLCompactionFilter::init_htable_(const ObTableSchema &table_schema, const int64_t snapshot_version)
+{
+  int ret = OB_SUCCESS;
+  const ObColumnSchemaV2 *key_col = table_schema.get_column_schema(table::ObHTableConstants::ROWKEY_CNAME);
+  const ObColumnSchemaV2 *qualifier_col = table_schema.get_column_schema(table::ObHTableConstants::CQ_CNAME);
+  const ObColumnSchemaV2 *version_col = table_schema.get_column_schema(table::ObHTableConstants::VERSION_CNAME);
+  // the rowkey of the htable is (K, Q, T), which are the first three columns of the row
+  if (OB_ISNULL(key_col) || OB_ISNULL(qualifier_col) || OB_ISNULL(version_col)
+      || table_schema.get_rowkey_column_num() != 3
+      || key_col->get_rowkey_position() != table::ObHTableConstants::COL_IDX_K + 1
+      || qualifier_col->get_rowkey_position() != table::ObHTableConstants::COL_IDX_Q + 1
+      || version_col->get_rowkey_position() != table::ObHTableConstants::COL_IDX_T + 1
+      || !version_col->get_meta_type().is_integer_type()) {
+    ret = OB_NOT_SUPPORTED;
+    LOG_WARN("table is not a htable", K(ret), KPC(key_col), KPC(qualifier_col), KPC(version_col));
+  } else {
+    // T is the negative timestamp in msec
+    expire_col_idx_ = table::ObHTableConstants::COL_IDX_T;
+    expire_ts_ = time_to_live_ > 0
+        ? snapshot_version / 1000L / 1000L - time_to_live_ * 1000L
+        : INT64_MIN;
+  }
+  return ret;
+}
+
+int ObTTLCompactionFilter::init_timestamp_column_(
+    const ObTableSchema &table_schema,
+    const ObString &column_name,
+    const int64_t snapshot_version)
+{
+  int ret = OB_SUCCESS;
+  ObSEArray<ObColDesc, OB_ROW_DEFAULT_COLUMNS_COUNT> col_descs;
+  const ObColumnSchemaV2 *col = table_schema.get_column_schema(column_name);
+  if (OB_ISNULL(col) || !col->get_meta_type().is_timestamp()) {
+    // datetime and the oracle timestamps are not in utc, which is unknown to storage
+    ret = OB_NOT_SUPPORTED;
+    LOG_WARN("ttl column should be a timestamp column", K(ret), K(column_name), KPC(col));
+  } else if (OB_FAIL(table_schema.get_multi_version_column_descs(col_descs))) {
+    LOG_WARN("failed to get multi version column descs", K(ret));
+  } else {
+    for (int64_t i = 0; i < col_descs.count(); ++i) {
+      if (col_descs.at(i).col_id_ == col->get_column_id()) {
+        expire_col_idx_ = i;
+        break;
+      }
+    }
+    if (expire_col_idx_ < 0) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("ttl column is not stored", K(ret), K(column_name), KPC(col));
+    } else {
+      expire_ts_ = snapshot_version / 1000L - time_to_live_ * 1000L * 1000L;
+    }
+  }
+  return ret;
+}
+
+int ObTTLCompactionFilter::prepare_task(
+    const int64_t task_idx,
+    ObIRowNewerVersionChecker *version_checker)
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_UNLIKELY(task_idx < 0 || task_idx >= concurrent_cnt_ || OB_ISNULL(version_checker))) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(task_idx), K_(concurrent_cnt), KP(version_checker));
+  } else {
+    task_states_[task_idx].reset_cell();
+    task_states_[task_idx].version_checker_ = version_checker;
+  }
+  return ret;
+}
+
+int ObTTLCompactionFilter::filter(
+    const blocksstable::ObDatumRow &row,
+    const int64_t task_idx,
+    ObFilterRet &filter_ret)
+{
+  int ret = OB_SUCCESS;
+  filter_ret = FILTER_RET_NOT_CHANGE;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_UNLIKELY(task_idx < 0 || task_idx >= concurrent_cnt_ || row.count_ <= expire_col_idx_)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(task_idx), K_(concurrent_cnt), K(row));
+  } else if (row.row_flag_.is_delete() || row.row_flag_.is_not_exist()) {
+    // dropped by the merger
+  } else {
+    const blocksstable::ObStorageDatum &datum = row.storage_datums_[expire_col_idx_];
+    bool exceeded = false;
+    if (datum.is_null() || datum.is_nop()) {
+    } else if (is_htable_ ? (-datum.get_int() < expire_ts_) : (datum.get_timestamp() < expire_ts_)) {
+      filter_ret = FILTER_RET_REMOVE;
+    }
+    if (FILTER_RET_REMOVE == filter_ret || max_versions_ <= 0) {
+    } else if (OB_FAIL(check_max_versions_(row, task_states_[task_idx], exceeded))) {
+      LOG_WARN("failed to check max versions", K(ret), K(row));
+    } else if (exceeded) {
+      filter_ret = FILTER_RET_REMOVE;
+    }
+    if (OB_SUCC(ret) && FILTER_RET_REMOVE == filter_ret) {
+      check_newer_version_(row, task_states_[task_idx], filter_ret);
+    }
+    if (OB_SUCC(ret) && FILTER_RET_REMOVE == filter_ret) {
+      LOG_DEBUG("filter expired row", K(row), K_(expire_ts), K_(max_versions));
+    }
+  }
+  return ret;
+}
+
+int ObTTLCompactionFilter::check_max_versions_(
+    const blocksstable::ObDatumRow &row,
+    TaskState &state,
+    bool &exceeded)
+{
+  int ret = OB_SUCCESS;
+  exceeded = false;
+  const ObString key = row.storage_datums_[table::ObHTableConstants::COL_IDX_K].get_string();
+  const ObString qualifier = row.storage_datums_[table::ObHTableConstants::COL_IDX_Q].get_string();
+  // the cells of one K and Q may be split into two tasks, which only keeps more versions
+  if (!state.is_same_cell(key, qualifier) && OB_FAIL(state.set_cell(key, qualifier))) {
+    LOG_WARN("failed to set cell", K(ret), K(key), K(qualifier));
+  } else {
+    exceeded = (++state.version_cnt_ > max_versions_);
+  }
+  return ret;
+}
+
+void ObTTLCompactionFilter::check_newer_version_(
+    const blocksstable::ObDatumRow &row,
+    TaskState &state,
+    ObFilterRet &filter_ret)
+{
+  int tmp_ret = OB_SUCCESS;
+  bool has_newer = false;
+  if (OB_ISNULL(state.version_checker_)) {
+    // the task is not prepared, keep the row
+    LOG_WARN("version checker of the task is null, keep the row", K(row));
+    filter_ret = FILTER_RET_NOT_CHANGE;
+  } else if (OB_TMP_FAIL(state.version_checker_->check(row, has_newer))) {
+    // keep the row when not sure, it is dropped by the next major merge
+    LOG_WARN("failed to check newer version, keep the row", K(tmp_ret), K(row));
+    filter_ret = FILTER_RET_NOT_CHANGE;
+  } else if (has_newer) {
+    LOG_DEBUG("expired row has newer version", K(row));
+    filter_ret = FILTER_RET_NOT_CHANGE;
+  }
+}
+
 } // namespace compaction
 } // namespace oceanbase
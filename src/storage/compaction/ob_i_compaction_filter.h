@@ -14,6 +14,7 @@
 #define OB_STORAGE_COMPACTION_I_COMPACTION_FILTER_H_
 
 #include "lib/utility/ob_print_utils.h"
+#include "lib/allocator/page_arena.h"
 #include "share/schema/ob_table_param.h"
 namespace oceanbase
 {
@@ -25,10 +26,28 @@ namespace storage
 {
 class ObStoreRow;
 }
+namespace share
+{
+namespace schema
+{
+class ObTableSchema;
+}
+}
 
 namespace compaction
 {
 
+// Tell whether the row just output by a merge task has the versions newer than the
+// base major sstable. Only the tables of the merge up to its snapshot are seen, which
+// are the same on all the replicas.
+class ObIRowNewerVersionChecker
+{
+public:
+  virtual ~ObIRowNewerVersionChecker() {}
+  // only called by the thread of the merge task
+  virtual int check(const blocksstable::ObDatumRow &row, bool &has_newer) = 0;
+};
+
 class ObICompactionFilter
 {
 public:
@@ -71,6 +90,23 @@ public:
       const blocksstable::ObDatumRow &row,
       ObFilterRet &filter_ret) = 0;
 
+  // the filters keeping state across the rows of one merge task override these two,
+  // the state of the task is reset when the task starts, so a retried task starts clean
+  virtual int prepare_task(const int64_t task_idx, ObIRowNewerVersionChecker *version_checker)
+  {
+    UNUSED(task_idx);
+    UNUSED(version_checker);
+    return common::OB_SUCCESS;
+  }
+  virtual int filter(
+      const blocksstable::ObDatumRow &row,
+      const int64_t task_idx,
+      ObFilterRet &filter_ret)
+  {
+    UNUSED(task_idx);
+    return filter(row, filter_ret);
+  }
+
   VIRTUAL_TO_STRING_KV(K_(is_full_merge));
 
   bool is_full_merge_; // be careful!!!! if full_merge=false, can't filter all keys
@@ -112,6 +148,107 @@ private:
   int64_t max_filtered_end_scn_;
 };
 
+// The TTL declared in the comment of the table, the same way as the TimeToLive of
+// the htables served by the table api:
+//   {"HColumnDescriptor": {"TimeToLive": 86400, "MaxVersions": 3}} for the htables
+//   {"TTLDescriptor": {"Column": "gmt_create", "TimeToLive": 86400}} for the tables
+//   with a TIMESTAMP column
+// TimeToLive is in seconds, the strings refer to the memory of the parse allocator.
+struct ObTTLDescriptor
+{
+  ObTTLDescriptor() : is_htable_(false), time_to_live_(0), max_versions_(0), column_name_() {}
+  ~ObTTLDescriptor() = default;
+  int parse_from_comment(const common::ObString &comment, common::ObArenaAllocator &allocator);
+  bool is_valid() const
+  {
+    return is_htable_ ? (time_to_live_ > 0 || max_versions_ > 0)
+                      : (time_to_live_ > 0 && !column_name_.empty());
+  }
+  TO_STRING_KV(K_(is_htable), K_(time_to_live), K_(max_versions), K_(column_name));
+
+  bool is_htable_;
+  int64_t time_to_live_;
+  int64_t max_versions_;
+  common::ObString column_name_;
+};
+
+// Drop the expired rows of the tables with a TTL descriptor in major merge.
+// The rows are expired against the snapshot of the merge instead of the current time,
+// so that all the replicas output the same rows. For the htables, the cells of one
+// K and Q are in the order of the newest first, only the first MaxVersions of them
+// are kept, which is tracked for each merge task.
+// Major sstable has no delete marker, so an expired row is only dropped when the merge
+// reads it from the base major sstable alone. The rows written after the last major
+// merge are kept until the next one. The versions written after the snapshot are not
+// checked, as they differ among the replicas.
+class ObTTLCompactionFilter : public ObICompactionFilter
+{
+public:
+  ObTTLCompactionFilter();
+  virtual ~ObTTLCompactionFilter() { reset(); }
+  int init(
+      const share::schema::ObTableSchema &table_schema,
+      const ObTTLDescriptor &ttl_desc,
+      const int64_t snapshot_version);
+  // the concurrent cnt is known after the parallel ranges are calculated
+  int init_task_states(const int64_t concurrent_cnt);
+  virtual void reset() override;
+
+  // only for the merge with one task
+  virtual int filter(const blocksstable::ObDatumRow &row, ObFilterRet &filter_ret) override
+  {
+    return filter(row, 0, filter_ret);
+  }
+  virtual int prepare_task(const int64_t task_idx, ObIRowNewerVersionChecker *version_checker) override;
+  virtual int filter(
+      const blocksstable::ObDatumRow &row,
+      const int64_t task_idx,
+      ObFilterRet &filter_ret) override;
+
+  INHERIT_TO_STRING_KV("ObICompactionFilter", ObICompactionFilter, "filter_name", "ObTTLCompactionFilter",
+      K_(is_inited), K_(is_htable), K_(expire_col_idx), K_(expire_ts), K_(max_versions), K_(concurrent_cnt));
+
+private:
+  // the K and Q of the last cell of the task
+  struct TaskState
+  {
+    TaskState()
+      : buf_(nullptr), buf_size_(0), key_len_(-1), qualifier_len_(-1), version_cnt_(0),
+        version_checker_(nullptr)
+    {}
+    ~TaskState();
+    void reset_cell() { key_len_ = -1; qualifier_len_ = -1; version_cnt_ = 0; }
+    bool is_same_cell(const common::ObString &key, const common::ObString &qualifier) const;
+    // the buf is only touched by the thread of the task
+    int set_cell(const common::ObString &key, const common::ObString &qualifier);
+    char *buf_;
+    int64_t buf_size_;
+    int64_t key_len_;
+    int64_t qualifier_len_;
+    int64_t version_cnt_;
+    ObIRowNewerVersionChecker *version_checker_;
+  };
+  int init_htable_(const share::schema::ObTableSchema &table_schema, const int64_t snapshot_version);
+  int init_timestamp_column_(
+      const share::schema::ObTableSchema &table_schema,
+      const common::ObString &column_name,
+      const int64_t snapshot_version);
+  int check_max_versions_(const blocksstable::ObDatumRow &row, TaskState &state, bool &exceeded);
+  void check_newer_version_(const blocksstable::ObDatumRow &row, TaskState &state, ObFilterRet &filter_ret);
+
+private:
+  bool is_inited_;
+  bool is_htable_;
+  int64_t time_to_live_;
+  int64_t expire_col_idx_;
+  int64_t expire_ts_; // usec for the timestamp column, msec for the htable
+  int64_t max_versions_;
+  int64_t concurrent_cnt_;
+  TaskState *task_states_;
+  common::ObArenaAllocator allocator_;
+  DISALLOW_COPY_AND_ASSIGN(ObTTLCompactionFilter);
+};
+
 } // namespace compaction
 } // namespace oceanbase
 
@@ -638,15 +638,18 @@ int ObPartitionMergePolicy::check_need_mini_minor_merge(
   const ObTabletTableStore &table_store = tablet.get_table_store();
   const ObTabletID &tablet_id = tablet.get_tablet_meta().tablet_id_;
   int64_t delay_merge_schedule_interval = 0;
+  bool enable_backfill = false;
   ObTablesHandleArray minor_tables;
   {
     omt::ObTenantConfigGuard tenant_config(TENANT_CONF(MTL_ID()));
     if (tenant_config.is_valid()) {
       mini_minor_threshold = tenant_config->minor_compact_trigger;
       delay_merge_schedule_interval = tenant_config->_minor_compaction_interval;
+      enable_backfill = tenant_config->_enable_uncommitted_row_backfill;
     }
   } // end of ObTenantConfigGuard
-  if (table_store.get_minor_sstables().count_ <= mini_minor_threshold) {
+  if (table_store.get_minor_sstables().count_ <= mini_minor_threshold
+      && (!enable_backfill || tablet.is_ls_tx_data_tablet())) {
     // total number of mini sstable is less than threshold + 1
   } else if (tablet.is_ls_tx_data_tablet()) {
     min_snapshot_version = 0;
@@ -661,6 +664,7 @@ int ObPartitionMergePolicy::check_need_mini_minor_merge(
   } else {
     int64_t minor_check_snapshot_version = 0;
     bool found_greater = false;
+    bool need_backfill = false;
 
     for (int64_t i = 0; OB_SUCC(ret) && i < minor_tables.get_count(); ++i) {
       ObSSTable *table = static_cast<ObSSTable *>(minor_tables.get_table(i));
@@ -674,6 +678,10 @@ int ObPartitionMergePolicy::check_need_mini_minor_merge(
       }
       found_greater = true;
       minor_sstable_count++;
+      if (enable_backfill && !need_backfill && need_backfill_uncommitted_rows(*table)) {
+        need_backfill = true;
+        LOG_INFO("minor sstable need backfill commit versions of uncommitted rows", KPC(table));
+      }
       if (table->is_mini_sstable()) {
         if (mini_minor_threshold == need_merge_mini_count++) {
           minor_check_snapshot_version = table->get_max_merged_trans_version();
@@ -690,7 +698,11 @@ int ObPartitionMergePolicy::check_need_mini_minor_merge(
       // GCONF.minor_compact_trigger means the maximum number of the current L0 sstable,
       // the compaction will be scheduled when it be exceeded
       // If minor_compact_trigger = 0, it means that all L0 sstables should be merged into L1 as soon as possible
-      if (minor_sstable_count <= 1) {
+      if (need_backfill) {
+        // rewrite the decided uncommitted rows with their commit versions, so that the readers need
+        // not to look up tx table for them
+        need_merge = true;
+      } else if (minor_sstable_count <= 1) {
         // only one minor sstable exist, no need to do mini minor merge
       } else if (table_store.get_table_count() >= MAX_SSTABLE_CNT_IN_STORAGE - RESERVED_STORE_CNT_IN_STORAGE) {
         need_merge = true;
@@ -1051,10 +1063,12 @@ int ObPartitionMergePolicy::refine_mini_minor_merge_result(ObGetMergeTablesResul
     int64_t mini_sstable_size = 1;
     int64_t minor_sstable_size = 1;
     int64_t minor_sstable_count = 0;
+    bool need_backfill = false;
     for (int64_t i = 0; OB_SUCC(ret) && i < result.handle_.get_count(); ++i) {
       if (OB_ISNULL(table = result.handle_.get_table(i)) || !table->is_minor_sstable()) {
         ret = OB_ERR_SYS;
         LOG_ERROR("get unexpected table", KP(table), K(ret));
+      } else if (FALSE_IT(need_backfill = need_backfill || need_backfill_uncommitted_rows(*table))) {
       } else if (FALSE_IT(sstable = reinterpret_cast<ObSSTable *>(table))) {
       } else if (table->is_mini_sstable()) { // L0 table
         mini_sstable_size += sstable->get_meta().get_basic_meta().row_count_;
@@ -1083,9 +1097,16 @@ int ObPartitionMergePolicy::refine_mini_minor_merge_result(ObGetMergeTablesResul
           if (tenant_config->_minor_compaction_amplification_factor != 0) {
             size_amplification_factor = tenant_config->_minor_compaction_amplification_factor;
           }
+          need_backfill = need_backfill && tenant_config->_enable_uncommitted_row_backfill;
+        } else {
+          need_backfill = false;
         }
       } // end of ObTenantConfigGuard
-      if (1 == result.handle_.get_count()) {
+      if (need_backfill && HISTORY_MINI_MINOR_MERGE != merge_type) {
+        // merge all the tables including the one needs backfill, even if it is the only one
+        merge_type = MINOR_MERGE;
+        LOG_INFO("minor refine, backfill commit versions of uncommitted rows", K(result));
+      } else if (1 == result.handle_.get_count()) {
         LOG_INFO("minor refine, only one sstable, no need to do mini minor merge", K(result));
         result.handle_.reset();
       } else if (HISTORY_MINI_MINOR_MERGE == merge_type) {
@@ -1125,6 +1146,18 @@ int ObPartitionMergePolicy::refine_mini_minor_merge_result(ObGetMergeTablesResul
   return ret;
 }
 
+bool ObPartitionMergePolicy::need_backfill_uncommitted_rows(const ObITable &table)
+{
+  bool bret = false;
+  if (table.is_minor_sstable() && !table.is_buf_minor_sstable()) {
+    const ObSSTable &sstable = static_cast<const ObSSTable &>(table);
+    // upper_trans_version is calculated only after all the transactions in the sstable are decided
+    bret = sstable.get_meta().contain_uncommitted_row()
+        && INT64_MAX != sstable.get_upper_trans_version();
+  }
+  return bret;
+}
+
 ObITable *ObPartitionMergePolicy::get_latest_sstable(const ObTabletTableStore &table_store)
 {
   ObITable *major_table = table_store.get_major_sstables().get_boundary_table(true/*last*/);
@@ -148,6 +148,9 @@ private:
       int64_t &max_snapshot_version);
 
   static bool check_table_count_safe(const storage::ObTabletTableStore &table_store);
+  // the minor sstable contains uncommitted rows whose transactions have all been decided, the
+  // minor merge fills in the commit versions of these rows
+  static bool need_backfill_uncommitted_rows(const storage::ObITable &table);
   // diagnose part
   static int diagnose_minor_dag(
       storage::ObMergeType merge_type,
@@ -18,6 +18,7 @@
 #include "ob_tablet_merge_task.h"
 #include "ob_tablet_merge_ctx.h"
 #include "ob_i_compaction_filter.h"
+#include "ob_compaction_column_stat.h"
 #include "storage/tx/ob_trans_service.h"
 
 namespace oceanbase
@@ -271,6 +272,7 @@ int ObPartitionMerger::try_filter_row(
   if (OB_NOT_NULL(merge_ctx_->compaction_filter_)) {
     if (OB_FAIL(merge_ctx_->compaction_filter_->filter(
         row,
+        task_idx_,
         filter_ret))) {
       STORAGE_LOG(WARN, "failed to filter row", K(ret), K(filter_ret));
     } else if (OB_UNLIKELY(filter_ret >= ObICompactionFilter::FILTER_RET_MAX
@@ -477,11 +479,19 @@ int ObPartitionMerger::compare_row_iters_range(ObPartitionMergeIter *base_iter,/
  *ObPartitionMajorMerger
  */
 ObPartitionMajorMerger::ObPartitionMajorMerger()
+  : column_stat_collector_(nullptr)
 {
 }
 
 ObPartitionMajorMerger::~ObPartitionMajorMerger()
 {
+  reset();
+}
+
+void ObPartitionMajorMerger::reset()
+{
+  column_stat_collector_ = nullptr;
+  ObPartitionMerger::reset();
 }
 
 int ObPartitionMajorMerger::open(ObTabletMergeCtx &ctx, const int64_t idx)
@@ -503,12 +513,76 @@ int ObPartitionMajorMerger::open(ObTabletMergeCtx &ctx, const int64_t idx)
     }
     task_idx_ = idx;
     data_store_desc_.sstable_index_builder_ = ctx.get_merge_info().get_index_builder();
-    is_inited_ = true;
+    int tmp_ret = OB_SUCCESS;
+    if (OB_NOT_NULL(ctx.compaction_filter_) && OB_FAIL(ctx.compaction_filter_->prepare_task(idx, this))) {
+      STORAGE_LOG(WARN, "Failed to prepare compaction filter for task", K(ret), K(idx));
+    } else {
+      if (OB_TMP_FAIL(ctx.get_merge_info().get_column_stat_collector(idx, data_store_desc_, column_stat_collector_))) {
+        // the stats of this merge are not reported without the collector of the task
+        STORAGE_LOG(WARN, "Failed to get column stat collector", K(tmp_ret), K(idx));
+        column_stat_collector_ = nullptr;
+      }
+      is_inited_ = true;
+    }
+  }
+
+  return ret;
+}
+
+int ObPartitionMajorMerger::check(const ObDatumRow &row, bool &has_newer)
+{
+  int ret = OB_SUCCESS;
+  has_newer = false;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    STORAGE_LOG(WARN, "ObPartitionMajorMerger is not inited", K(ret));
+  } else if (OB_UNLIKELY(minimum_iters_.empty())) {
+    ret = OB_ERR_UNEXPECTED;
+    STORAGE_LOG(WARN, "Unexpected empty minimum iters", K(ret), K(row));
+  } else {
+    // the minimum iters read the tables of the merge up to its snapshot
+    for (int64_t i = 0; OB_SUCC(ret) && !has_newer && i < minimum_iters_.count(); ++i) {
+      if (OB_ISNULL(minimum_iters_.at(i))) {
+        ret = OB_ERR_UNEXPECTED;
+        STORAGE_LOG(WARN, "Unexpected null merge iter", K(ret), K(i));
+      } else {
+        has_newer = !minimum_iters_.at(i)->is_base_sstable_iter();
+      }
+    }
   }
+  return ret;
+}
 
+int ObPartitionMajorMerger::close()
+{
+  int ret = OB_SUCCESS;
+  int tmp_ret = OB_SUCCESS;
+  if (OB_FAIL(ObPartitionMerger::close())) {
+    STORAGE_LOG(WARN, "Failed to close partition merger", K(ret));
+  } else if (nullptr != column_stat_collector_ && OB_TMP_FAIL(column_stat_collector_->finish())) {
+    STORAGE_LOG(WARN, "Failed to finish column stat collector", K(tmp_ret));
+    column_stat_collector_->set_incomplete();
+  }
   return ret;
 }
 
+int ObPartitionMajorMerger::process(const ObMicroBlock &micro_block)
+{
+  // the rows in the reused blocks are not seen
+  if (nullptr != column_stat_collector_) {
+    column_stat_collector_->set_incomplete();
+  }
+  return ObPartitionMerger::process(micro_block);
+}
+
+int ObPartitionMajorMerger::process(const ObMacroBlockDesc &macro_desc)
+{
+  if (nullptr != column_stat_collector_) {
+    column_stat_collector_->set_incomplete();
+  }
+  return ObPartitionMerger::process(macro_desc);
+}
+
 int ObPartitionMajorMerger::inner_process(const ObDatumRow &row)
 {
   int ret = OB_SUCCESS;
@@ -517,6 +591,13 @@ int ObPartitionMajorMerger::inner_process(const ObDatumRow &row)
       // drop del row
   } else if (OB_FAIL(macro_writer_.append_row(row))) {
     STORAGE_LOG(WARN, "Failed to append row to macro writer", K(ret));
+  } else if (nullptr != column_stat_collector_) {
+    // column stat is best effort and never fails the merge
+    int tmp_ret = OB_SUCCESS;
+    if (OB_TMP_FAIL(column_stat_collector_->add_row(row))) {
+      STORAGE_LOG(WARN, "Failed to add row to column stat collector", K(tmp_ret));
+      column_stat_collector_->set_incomplete();
+    }
   }
 
   if (OB_SUCC(ret)) {
@@ -695,6 +776,17 @@ int ObPartitionMajorMerger::merge_partition(ObTabletMergeCtx &ctx, const int64_t
                 }
 	            } else if (OB_FAIL(macro_writer_.check_data_macro_block_need_merge(*macro_desc, need_merge))) {
                 STORAGE_LOG(WARN, "Failed to check data macro block need merge", K(ret));
+              } else if (need_merge && MICRO_BLOCK_MERGE_LEVEL == merge_param.merge_level_) {
+                // the small macro block is merged into the new macro block by
+                // copying its micro blocks, rather than decoding all its rows
+                if (OB_FAIL(iter->open_curr_range(false /*for_rewrite*/))) {
+                  if (OB_ITER_END == ret) {
+                    ret = OB_SUCCESS;
+                  } else {
+                    STORAGE_LOG(WARN, "Failed to open the curr macro block", K(ret), KPC(iter));
+                  }
+                }
+                rewrite = true;
               } else if (need_merge) {
                 if(OB_FAIL(rewrite_macro_block(minimum_iters_))) {
                   STORAGE_LOG(WARN, "Failed to rewrite macro block", K(ret), KPC(merge_ctx_));
@@ -37,6 +37,7 @@ namespace compaction
 {
 struct ObTabletMergeCtx;
 struct ObMergeParameter;
+class ObColumnStatCollector;
 
 class ObPartitionMerger
 {
@@ -88,16 +89,24 @@ protected:
   bool is_inited_;
 };
 
-class ObPartitionMajorMerger : public ObPartitionMerger
+class ObPartitionMajorMerger : public ObPartitionMerger, public ObIRowNewerVersionChecker
 {
 public:
   ObPartitionMajorMerger();
   ~ObPartitionMajorMerger();
+  virtual void reset() override;
   virtual int merge_partition(ObTabletMergeCtx &ctx, const int64_t idx) override;
-  INHERIT_TO_STRING_KV("ObPartitionMajorMerger", ObPartitionMerger, KPC(merge_progress_));
+  // the row fused from the minimum iters has versions in the incremental tables of the merge
+  virtual int check(const blocksstable::ObDatumRow &row, bool &has_newer) override;
+  INHERIT_TO_STRING_KV("ObPartitionMajorMerger", ObPartitionMerger, KPC(merge_progress_),
+                       KPC_(column_stat_collector));
 protected:
   virtual int open(ObTabletMergeCtx &ctx, const int64_t idx) override;
+  virtual int close() override;
   virtual int inner_process(const blocksstable::ObDatumRow &row) override;
+  virtual int process(const blocksstable::ObMicroBlock &micro_block) override;
+  virtual int process(const blocksstable::ObMacroBlockDesc &macro_desc) override;
+  using ObPartitionMerger::process;
   virtual int init_merge_iters(ObIPartitionMergeFuser &fuser,
                                ObMergeParameter &merge_param,
                                MERGE_ITER_ARRAY &merge_iters) override;
@@ -116,6 +125,9 @@ private:
   int check_row_iters_purge(MERGE_ITER_ARRAY &minimum_iters,
                             ObPartitionMergeIter *base_major_iter,
                             bool &can_purged);
+private:
+  // owned by the merge info of the merge ctx, null if not collected
+  ObColumnStatCollector *column_stat_collector_;
 };
 
 class ObPartitionMinorMerger : public ObPartitionMerger
@@ -245,49 +245,47 @@ int ObParallelMergeCtx::init_parallel_mini_merge(compaction::ObTabletMergeCtx &m
   } else {
     const int64_t tablet_size = merge_ctx.get_merge_schema()->get_tablet_size();
     memtable::ObIMemtable *memtable = nullptr;
-    if (OB_FAIL(merge_ctx.tables_handle_.get_first_memtable(memtable))) {
-      STORAGE_LOG(WARN, "failed to get first memtable", K(ret),
+    int64_t total_bytes = 0;
+    int32_t mini_merge_thread = 0;
+    if (OB_FAIL(get_mini_merge_split_memtable(merge_ctx, memtable, total_bytes))) {
+      STORAGE_LOG(WARN, "failed to get memtable to split", K(ret),
                   "merge tables", merge_ctx.tables_handle_);
+    } else if (OB_FAIL(MTL(ObTenantDagScheduler *)->get_up_limit(ObDagPrio::DAG_PRIO_COMPACTION_HIGH, mini_merge_thread))) {
+      STORAGE_LOG(WARN, "failed to get uplimit", K(ret), K(mini_merge_thread));
     } else {
-      int64_t total_bytes = 0;
-      int64_t total_rows = 0;
-      int32_t mini_merge_thread = 0;
-      if (OB_FAIL(memtable->estimate_phy_size(nullptr, nullptr, total_bytes, total_rows))) {
-        STORAGE_LOG(WARN, "Failed to get estimate size from memtable", K(ret));
-      } else if (MTL(ObTenantDagScheduler *)->get_up_limit(ObDagPrio::DAG_PRIO_COMPACTION_HIGH, mini_merge_thread)) {
-        STORAGE_LOG(WARN, "failed to get uplimit", K(ret), K(mini_merge_thread));
+      ObArray<ObStoreRange> store_ranges;
+      mini_merge_thread = MAX(mini_merge_thread, PARALLEL_MERGE_TARGET_TASK_CNT);
+      concurrent_cnt_ = MIN((total_bytes + tablet_size - 1) / tablet_size, mini_merge_thread);
+      concurrent_cnt_ = MIN(concurrent_cnt_, MAX_MERGE_THREAD);
+      // the keys sampled from the btree may be less than the expected ranges
+      // when the rows are large, split into less ranges rather than dump serially
+      while (concurrent_cnt_ > 1
+             && OB_ENTRY_NOT_EXIST == (ret = memtable->get_split_ranges(nullptr, nullptr, concurrent_cnt_, store_ranges))) {
+        ret = OB_SUCCESS;
+        store_ranges.reuse();
+        concurrent_cnt_ = concurrent_cnt_ / 2;
+      }
+      if (OB_FAIL(ret)) {
+        STORAGE_LOG(WARN, "Failed to get split ranges from memtable", K(ret), K_(concurrent_cnt));
+      } else if (concurrent_cnt_ <= 1) {
+        if (OB_FAIL(init_serial_merge())) {
+          STORAGE_LOG(WARN, "Failed to init serialize merge", K(ret));
+        }
+      } else if (OB_UNLIKELY(store_ranges.count() != concurrent_cnt_)) {
+        ret = OB_ERR_UNEXPECTED;
+        STORAGE_LOG(WARN, "Unexpected range array and concurrent_cnt", K(ret), K_(concurrent_cnt),
+                    K(store_ranges));
       } else {
-        ObArray<ObStoreRange> store_ranges;
-        mini_merge_thread = MAX(mini_merge_thread, PARALLEL_MERGE_TARGET_TASK_CNT);
-        concurrent_cnt_ = MIN((total_bytes + tablet_size - 1) / tablet_size, mini_merge_thread);
-        if (concurrent_cnt_ <= 1) {
-          if (OB_FAIL(init_serial_merge())) {
-            STORAGE_LOG(WARN, "Failed to init serialize merge", K(ret));
-          }
-        } else if (OB_FAIL(memtable->get_split_ranges(nullptr, nullptr, concurrent_cnt_, store_ranges))) {
-          if (OB_ENTRY_NOT_EXIST == ret) {
-            if (OB_FAIL(init_serial_merge())) {
-              STORAGE_LOG(WARN, "Failed to init serialize merge", K(ret));
-            }
-          } else {
-            STORAGE_LOG(WARN, "Failed to get split ranges from memtable", K(ret));
+        for (int64_t i = 0; OB_SUCC(ret) && i < store_ranges.count(); i++) {
+          ObDatumRange datum_range;
+          if (OB_FAIL(datum_range.from_range(store_ranges.at(i), allocator_))) {
+            STORAGE_LOG(WARN, "Failed to transfer store range to datum range", K(ret), K(i), K(store_ranges.at(i)));
+          } else if (OB_FAIL(range_array_.push_back(datum_range))) {
+            STORAGE_LOG(WARN, "Failed to push back merge range to array", K(ret), K(datum_range));
           }
-        } else if (OB_UNLIKELY(store_ranges.count() != concurrent_cnt_)) {
-          ret = OB_ERR_UNEXPECTED;
-          STORAGE_LOG(WARN, "Unexpected range array and concurrent_cnt", K(ret), K_(concurrent_cnt),
-                      K(store_ranges));
-        } else {
-          for (int64_t i = 0; OB_SUCC(ret) && i < store_ranges.count(); i++) {
-            ObDatumRange datum_range;
-            if (OB_FAIL(datum_range.from_range(store_ranges.at(i), allocator_))) {
-              STORAGE_LOG(WARN, "Failed to transfer store range to datum range", K(ret), K(i), K(store_ranges.at(i)));
-            } else if (OB_FAIL(range_array_.push_back(datum_range))) {
-              STORAGE_LOG(WARN, "Failed to push back merge range to array", K(ret), K(datum_range));
-            }
-          }
-          parallel_type_ = PARALLEL_MINI;
-          STORAGE_LOG(INFO, "Succ to get parallel mini merge ranges", K_(concurrent_cnt), K_(range_array));
         }
+        parallel_type_ = PARALLEL_MINI;
+        STORAGE_LOG(INFO, "Succ to get parallel mini merge ranges", K(total_bytes), K_(concurrent_cnt), K_(range_array));
       }
     }
   }
@@ -295,6 +293,50 @@ int ObParallelMergeCtx::init_parallel_mini_merge(compaction::ObTabletMergeCtx &m
   return ret;
 }
 
+int ObParallelMergeCtx::get_mini_merge_split_memtable(
+    compaction::ObTabletMergeCtx &merge_ctx,
+    memtable::ObIMemtable *&split_memtable,
+    int64_t &total_bytes)
+{
+  int ret = OB_SUCCESS;
+  int64_t max_occupied_size = -1;
+  split_memtable = nullptr;
+  total_bytes = 0;
+  // The rows of all the memtables are dumped, the memtable occupied most is
+  // sampled to split the ranges. The estimated size of the btree assumes a
+  // fixed row size, which is far less than the real one for wide rows, so the
+  // occupied memory is also taken into account.
+  for (int64_t i = 0; OB_SUCC(ret) && i < merge_ctx.tables_handle_.get_count(); ++i) {
+    ObITable *table = merge_ctx.tables_handle_.get_table(i);
+    if (OB_ISNULL(table)) {
+      ret = OB_ERR_UNEXPECTED;
+      STORAGE_LOG(WARN, "unexpected null table", K(ret), K(i), K(merge_ctx.tables_handle_));
+    } else if (table->is_memtable()) {
+      memtable::ObIMemtable *memtable = static_cast<memtable::ObIMemtable *>(table);
+      const int64_t occupied_size = memtable->get_occupied_size();
+      total_bytes += occupied_size;
+      if (occupied_size > max_occupied_size) {
+        max_occupied_size = occupied_size;
+        split_memtable = memtable;
+      }
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (OB_ISNULL(split_memtable)) {
+    ret = OB_ENTRY_NOT_EXIST;
+    STORAGE_LOG(WARN, "no memtable to merge", K(ret), K(merge_ctx.tables_handle_));
+  } else {
+    int64_t estimate_bytes = 0;
+    int64_t estimate_rows = 0;
+    if (OB_FAIL(split_memtable->estimate_phy_size(nullptr, nullptr, estimate_bytes, estimate_rows))) {
+      STORAGE_LOG(WARN, "Failed to get estimate size from memtable", K(ret));
+    } else {
+      total_bytes = MAX(total_bytes, estimate_bytes);
+    }
+  }
+  return ret;
+}
+
 int ObParallelMergeCtx::init_parallel_mini_minor_merge(compaction::ObTabletMergeCtx &merge_ctx)
 {
   int ret = OB_SUCCESS;
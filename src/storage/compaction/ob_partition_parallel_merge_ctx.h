@@ -26,6 +26,10 @@ namespace compaction
 {
 struct ObTabletMergeCtx;
 }
+namespace memtable
+{
+class ObIMemtable;
+}
 namespace blocksstable
 {
 class ObSSTable;
@@ -60,6 +64,10 @@ private:
   //TODO @hanhui parallel in ai
   int init_serial_merge();
   int init_parallel_mini_merge(compaction::ObTabletMergeCtx &merge_ctx);
+  int get_mini_merge_split_memtable(
+      compaction::ObTabletMergeCtx &merge_ctx,
+      memtable::ObIMemtable *&split_memtable,
+      int64_t &total_bytes);
   int init_parallel_mini_minor_merge(compaction::ObTabletMergeCtx &merge_ctx);
   int init_parallel_major_merge(compaction::ObTabletMergeCtx &merge_ctx);
   int calc_mini_minor_parallel_degree(const int64_t tablet_size,
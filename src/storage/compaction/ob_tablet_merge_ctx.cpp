@@ -22,6 +22,8 @@
 #include "storage/compaction/ob_compaction_diagnose.h"
 #include "storage/compaction/ob_sstable_merge_info_mgr.h"
 #include "storage/compaction/ob_tenant_tablet_scheduler.h"
+#include "storage/compaction/ob_compaction_column_stat.h"
+#include "storage/compaction/ob_i_compaction_filter.h"
 #include "observer/omt/ob_multi_tenant.h"
 #include "share/scheduler/ob_dag_warning_history_mgr.h"
 
@@ -42,7 +44,8 @@ ObTabletMergeInfo::ObTabletMergeInfo()
      bloomfilter_block_id_(),
      sstable_merge_info_(),
      allocator_("MergeContext", OB_MALLOC_MIDDLE_BLOCK_SIZE),
-     index_builder_(nullptr)
+     index_builder_(nullptr),
+     column_stat_collectors_()
 {
 }
 
@@ -63,6 +66,13 @@ void ObTabletMergeInfo::destroy()
   }
   block_ctxs_.reset();
 
+  for (int64_t i = 0; i < column_stat_collectors_.count(); ++i) {
+    if (NULL != column_stat_collectors_.at(i)) {
+      column_stat_collectors_.at(i)->~ObColumnStatCollector();
+    }
+  }
+  column_stat_collectors_.reset();
+
   bloomfilter_block_id_.reset();
 
   if (OB_NOT_NULL(index_builder_)) {
@@ -89,6 +99,23 @@ int ObTabletMergeInfo::init(const ObTabletMergeCtx &ctx, bool need_check)
     for (int64_t i = 0; i < concurrent_cnt; ++i) {
       block_ctxs_[i] = NULL;
     }
+    bool enable_column_stat = false;
+    if (ctx.param_.is_major_merge()) {
+      omt::ObTenantConfigGuard tenant_config(TENANT_CONF(MTL_ID()));
+      if (tenant_config.is_valid()) {
+        enable_column_stat = tenant_config->_enable_major_merge_column_stat;
+      }
+    }
+    if (!enable_column_stat) {
+    } else if (OB_FAIL(column_stat_collectors_.prepare_allocate(concurrent_cnt))) {
+      LOG_WARN("failed to reserve column stat collectors", K(ret), K(concurrent_cnt));
+    } else {
+      for (int64_t i = 0; i < concurrent_cnt; ++i) {
+        column_stat_collectors_[i] = NULL;
+      }
+    }
+  }
+  if (OB_SUCC(ret)) {
     bloomfilter_block_id_.reset();
     sstable_merge_info_.tenant_id_ = MTL_ID();
     sstable_merge_info_.ls_id_ = ctx.param_.ls_id_;
@@ -133,6 +160,42 @@ int ObTabletMergeInfo::add_macro_blocks(
   return ret;
 }
 
+int ObTabletMergeInfo::get_column_stat_collector(
+    const int64_t idx,
+    const ObDataStoreDesc &desc,
+    ObColumnStatCollector *&collector)
+{
+  int ret = OB_SUCCESS;
+  void *buf = nullptr;
+  collector = nullptr;
+  ObSpinLockGuard guard(lock_);
+
+  if (!is_inited_) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not inited", K(ret));
+  } else if (column_stat_collectors_.empty()) {
+    // column stat is not collected
+  } else if (idx < 0 || idx >= column_stat_collectors_.count()) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid idx", K(ret), K(idx), "concurrent_cnt", column_stat_collectors_.count());
+  } else if (NULL != column_stat_collectors_[idx]) {
+    // the task is executed again, the rows may be added twice
+    collector = column_stat_collectors_[idx];
+    collector->set_incomplete();
+  } else if (OB_ISNULL(buf = allocator_.alloc(sizeof(ObColumnStatCollector)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("failed to alloc column stat collector", K(ret));
+  } else if (FALSE_IT(collector = new (buf) ObColumnStatCollector())) {
+  } else if (OB_FAIL(collector->init(desc.col_desc_array_))) {
+    LOG_WARN("failed to init column stat collector", K(ret), K(desc));
+    collector->~ObColumnStatCollector();
+    collector = nullptr;
+  } else {
+    column_stat_collectors_[idx] = collector;
+  }
+  return ret;
+}
+
 int ObTabletMergeInfo::add_bloom_filter(blocksstable::ObMacroBlocksWriteCtx &bloom_filter_block_ctx)
 {
   int ret = OB_SUCCESS;
@@ -529,6 +592,12 @@ void ObTabletMergeCtx::destroy()
     allocator_.free(merge_progress_);
     merge_progress_ = nullptr;
   }
+  if (OB_NOT_NULL(compaction_filter_) && param_.is_major_merge()) {
+    // only the ttl filter is allocated by ctx, see init_ttl_filter
+    compaction_filter_->~ObICompactionFilter();
+    allocator_.free(compaction_filter_);
+    compaction_filter_ = nullptr;
+  }
   tables_handle_.reset();
   tablet_handle_.reset();
 }
@@ -634,6 +703,7 @@ int ObTabletMergeCtx::get_merge_range(int64_t parallel_idx, ObDatumRange &merge_
 int ObTabletMergeCtx::inner_init_for_major()
 {
   int ret = OB_SUCCESS;
+  int tmp_ret = OB_SUCCESS;
   int64_t multi_version_start = 0;
   int64_t min_reserved_snapshot = 0;
   ObGetMergeTablesParam get_merge_table_param;
@@ -675,6 +745,11 @@ int ObTabletMergeCtx::inner_init_for_major()
   } else if (OB_FAIL(get_table_schema_to_merge())) {
     LOG_WARN("failed to get table schema", K(ret), KPC(this));
   } else if (FALSE_IT(time_guard_.click(ObCompactionTimeGuard::GET_TABLE_SCHEMA))) {
+  } else if (OB_TMP_FAIL(init_ttl_filter())) {
+    // the expired rows are kept until the next major merge
+    LOG_WARN("failed to init ttl filter", K(tmp_ret), K_(param));
+  }
+  if (OB_FAIL(ret)) {
   } else if (OB_FAIL(cal_major_merge_param(get_merge_table_result))) {
     LOG_WARN("fail to cal minor merge param", K(ret), KPC(this));
   } else if (FALSE_IT(time_guard_.click(ObCompactionTimeGuard::CALC_PROGRESSIVE_PARAM))) {
@@ -929,6 +1004,9 @@ int ObTabletMergeCtx::cal_progressive_merge_param(const bool is_schema_changed)
   } else {
     if (param_.is_buf_minor_merge() || 1 == schema_ctx_.table_schema_->get_progressive_merge_num()) {
       is_full_merge_ = true;
+    } else if (OB_NOT_NULL(compaction_filter_) && compaction_filter_->is_full_merge_) {
+      // the filter has to see all the rows, no macro block can be reused
+      is_full_merge_ = true;
     } else {
       is_full_merge_ = false;
     }
@@ -976,6 +1054,57 @@ int ObTabletMergeCtx::init_merge_info()
     LOG_WARN("failed to init merge context", K(ret));
   } else {
     time_guard_.click(ObCompactionTimeGuard::GET_PARALLEL_RANGE);
+    int tmp_ret = OB_SUCCESS;
+    ObTTLCompactionFilter *ttl_filter = nullptr;
+    if (!param_.is_major_merge() || OB_ISNULL(compaction_filter_)) {
+    } else if (FALSE_IT(ttl_filter = static_cast<ObTTLCompactionFilter *>(compaction_filter_))) {
+    } else if (OB_TMP_FAIL(ttl_filter->init_task_states(get_concurrent_cnt()))) {
+      // the expired rows are kept until the next major merge
+      LOG_WARN("failed to init task states of ttl filter", K(tmp_ret), K_(param));
+      ttl_filter->~ObTTLCompactionFilter();
+      allocator_.free(ttl_filter);
+      compaction_filter_ = nullptr;
+    }
+  }
+  return ret;
+}
+
+int ObTabletMergeCtx::init_ttl_filter()
+{
+  int ret = OB_SUCCESS;
+  const ObTableSchema *table_schema = schema_ctx_.table_schema_;
+  ObArenaAllocator tmp_allocator("TTLDesc");
+  ObTTLDescriptor ttl_desc;
+  void *buf = nullptr;
+  ObTTLCompactionFilter *ttl_filter = nullptr;
+  if (OB_UNLIKELY(!param_.is_major_merge() || OB_NOT_NULL(compaction_filter_))) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("ttl filter is only for major merge", K(ret), K_(param), KPC_(compaction_filter));
+  } else if (OB_ISNULL(table_schema) || table_schema->get_comment_str().empty()) {
+    // no ttl
+  } else if (OB_FAIL(ttl_desc.parse_from_comment(table_schema->get_comment_str(), tmp_allocator))) {
+    LOG_WARN("failed to parse ttl descriptor", K(ret), "comment", table_schema->get_comment_str());
+  } else if (!ttl_desc.is_valid()) {
+    // no ttl
+  } else if (!table_schema->is_user_table() || table_schema->get_index_tid_count() > 0) {
+    // the rows of the index would be inconsistent with the data table
+    LOG_INFO("ttl is not supported for the table with index", K(ttl_desc),
+        "table_id", table_schema->get_table_id(), "index_cnt", table_schema->get_index_tid_count());
+  } else if (table_schema->has_lob_column()) {
+    // the outrow lobs of the dropped rows would be left in the lob aux tables
+    LOG_INFO("ttl is not supported for the table with lob column", K(ttl_desc),
+        "table_id", table_schema->get_table_id());
+  } else if (OB_ISNULL(buf = allocator_.alloc(sizeof(ObTTLCompactionFilter)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("failed to alloc ttl filter", K(ret));
+  } else if (FALSE_IT(ttl_filter = new (buf) ObTTLCompactionFilter())) {
+  } else if (OB_FAIL(ttl_filter->init(*table_schema, ttl_desc, sstable_version_range_.snapshot_version_))) {
+    LOG_WARN("failed to init ttl filter", K(ret), K(ttl_desc));
+    ttl_filter->~ObTTLCompactionFilter();
+    allocator_.free(ttl_filter);
+  } else {
+    compaction_filter_ = ttl_filter;
+    FLOG_INFO("succeed to init ttl filter", K_(param), KPC(ttl_filter));
   }
   return ret;
 }
@@ -39,6 +39,8 @@ struct ObSSTableMergeRes;
 
 namespace compaction
 {
+class ObColumnStatCollector;
+
 // used for record output macro blocks
 class ObTabletMergeInfo
 {
@@ -55,6 +57,11 @@ public:
   int create_sstable(ObTabletMergeCtx &ctx);
   ObSSTableMergeInfo &get_sstable_merge_info() { return sstable_merge_info_; }
   blocksstable::ObSSTableIndexBuilder *get_index_builder() const { return index_builder_; }
+  // return null collector if the column stat is not collected by this merge
+  int get_column_stat_collector(const int64_t idx,
+                                const ObDataStoreDesc &desc,
+                                ObColumnStatCollector *&collector);
+  const ObIArray<ObColumnStatCollector *> &get_column_stat_collectors() const { return column_stat_collectors_; }
   void destroy();
   int get_data_macro_block_count(int64_t &macro_block_count);
   TO_STRING_KV(K_(is_inited), K_(sstable_merge_info));
@@ -76,6 +83,7 @@ private:
   ObSSTableMergeInfo sstable_merge_info_;
   common::ObArenaAllocator allocator_;
   blocksstable::ObSSTableIndexBuilder *index_builder_;
+  ObArray<ObColumnStatCollector *> column_stat_collectors_;
 };
 
 struct ObSchemaMergeCtx
@@ -181,6 +189,7 @@ struct ObTabletMergeCtx
   int cal_minor_merge_param();
   int cal_major_merge_param(const ObGetMergeTablesResult &get_merge_table_result);
   int init_merge_info();
+  int init_ttl_filter();
   int cal_progressive_merge_param(const bool is_schema_changed);
   int generate_participant_table_info(char *buf, const int64_t buf_len) const;
   int generate_macro_id_list(char *buf, const int64_t buf_len) const;
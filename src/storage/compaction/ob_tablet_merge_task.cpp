@@ -23,6 +23,7 @@
 #include "ob_tenant_compaction_progress.h"
 #include "ob_compaction_diagnose.h"
 #include "ob_compaction_suggestion.h"
+#include "ob_compaction_column_stat.h"
 #include "ob_partition_merge_progress.h"
 #include "ob_tx_table_merge_task.h"
 #include "storage/ddl/ob_ddl_merge_task.h"
@@ -890,6 +891,13 @@ int ObTabletMergeFinishTask::process()
         LOG_WARN("failed to update tablet report status", K(tmp_ret), K(MTL_ID()), K(tablet_id));
       }
     }
+    if (OB_SUCC(ret) && ctx.param_.is_major_merge()) {
+      int tmp_ret = OB_SUCCESS;
+      // only builds the stats here, they are written by the column stat queue
+      if (OB_TMP_FAIL(ObCompactionColumnStatReporter::report(ctx))) {
+        LOG_WARN("failed to report compaction column stat", K(tmp_ret), K(tablet_id));
+      }
+    }
 
     if (OB_SUCC(ret) && OB_NOT_NULL(ctx.merge_progress_)) {
       int tmp_ret = OB_SUCCESS;
@@ -141,6 +141,7 @@ ObTenantTabletScheduler::ObTenantTabletScheduler()
    sstable_gc_tg_id_(0),
    schedule_interval_(0),
    bf_queue_(),
+   column_stat_queue_(),
    frozen_version_lock_(),
    frozen_version_(INIT_COMPACTION_SCN),
    merged_version_(INIT_COMPACTION_SCN),
@@ -164,6 +165,7 @@ void ObTenantTabletScheduler::destroy()
   TG_DESTROY(merge_loop_tg_id_);
   TG_DESTROY(sstable_gc_tg_id_);
   bf_queue_.destroy();
+  column_stat_queue_.destroy();
   frozen_version_ = 0;
   merged_version_ = 0;
   schedule_stats_.reset();
@@ -199,6 +201,17 @@ int ObTenantTabletScheduler::init()
                                     MTL_ID(),
                                     "bf_queue"))) {
     LOG_WARN("Fail to init bloom filter queue", K(ret));
+  } else if (FALSE_IT(column_stat_queue_.set_run_wrapper(MTL_CTX()))) {
+  } else if (OB_FAIL(column_stat_queue_.init(COLUMN_STAT_REPORT_THREAD_CNT,
+                                             "ColStatReport",
+                                             COLUMN_STAT_TASK_QUEUE_SIZE,
+                                             COLUMN_STAT_TASK_MAP_SIZE,
+                                             COLUMN_STAT_TASK_TOTAL_LIMIT,
+                                             COLUMN_STAT_TASK_HOLD_LIMIT,
+                                             COLUMN_STAT_TASK_PAGE_SIZE,
+                                             MTL_ID(),
+                                             "col_stat_queue"))) {
+    LOG_WARN("Fail to init column stat report queue", K(ret));
   } else {
     schedule_interval_ = schedule_interval;
     is_inited_ = true;
@@ -425,6 +438,23 @@ int ObTenantTabletScheduler::schedule_load_bloomfilter(const blocksstable::Macro
   return ret;
 }
 
+int ObTenantTabletScheduler::schedule_report_column_stat(const common::IObDedupTask &task)
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("The ObTenantTabletScheduler has not been inited", K(ret));
+  } else if (OB_FAIL(column_stat_queue_.add_task(task))) {
+    if (OB_EAGAIN == ret) {
+      // the stats of the same partition are waiting to be written
+      ret = OB_SUCCESS;
+    } else {
+      LOG_WARN("Failed to add column stat report task", K(ret));
+    }
+  }
+  return ret;
+}
+
 int ObTenantTabletScheduler::merge_all()
 {
   int ret = OB_SUCCESS;
@@ -700,6 +730,29 @@ int ObTenantTabletScheduler::schedule_tablet_major_merge(
   return ret;
 }
 
+int ObTenantTabletScheduler::refresh_row_compact_trim_version(ObTablet &tablet)
+{
+  int ret = OB_SUCCESS;
+  ObTableHandleV2 table_handle;
+  memtable::ObMemtable *memtable = nullptr;
+  int64_t multi_version_start = 0;
+  int64_t min_reserved_snapshot = 0;
+  if (OB_FAIL(tablet.get_active_memtable(table_handle))) {
+    if (OB_ENTRY_NOT_EXIST == ret) {
+      ret = OB_SUCCESS;
+    } else {
+      LOG_WARN("failed to get active memtable", K(ret), K(tablet));
+    }
+  } else if (OB_FAIL(table_handle.get_data_memtable(memtable))) {
+    LOG_WARN("failed to get data memtable", K(ret), K(table_handle));
+  } else if (OB_FAIL(tablet.get_kept_multi_version_start(multi_version_start, min_reserved_snapshot))) {
+    LOG_WARN("failed to get kept multi version start", K(ret), K(tablet));
+  } else {
+    memtable->set_row_compact_trim_version(MIN(multi_version_start, min_reserved_snapshot));
+  }
+  return ret;
+}
+
 int ObTenantTabletScheduler::schedule_ls_merge(
     int64_t &merge_version,
     ObLS &ls,
@@ -717,6 +770,11 @@ int ObTenantTabletScheduler::schedule_ls_merge(
     LOG_WARN("failed to build ls tablet iter", K(ret), K(ls));
   } else {
     const ObLSID &ls_id = ls.get_ls_id();
+    if (merged_version_ > INIT_COMPACTION_SCN && merge_version <= merged_version_) {
+      // all the tablets have been scanned and merged to the merge version after start, the cold
+      // tablets without memtable have nothing to merge until they are accessed again
+      tablet_iter.set_skip_idle_cold_tablet();
+    }
     ObTabletID tablet_id;
     ObTabletHandle tablet_handle;
     int tmp_ret = OB_SUCCESS;
@@ -785,6 +843,11 @@ int ObTenantTabletScheduler::schedule_ls_merge(
           ls_merge_finish &= tablet_merge_finish;
         }
 
+        if (GCONF._enable_row_compaction_trim
+            && OB_TMP_FAIL(refresh_row_compact_trim_version(*tablet_handle.get_obj()))) {
+          LOG_WARN("failed to refresh row compact trim version", K(tmp_ret), K(ls_id), K(tablet_id));
+        }
+
         if (OB_SUCC(ret)) {
           need_fast_freeze = false;
           if (!fast_freeze_checker_.need_check()) {
@@ -121,6 +121,9 @@ public:
       const blocksstable::MacroBlockId &macro_id,
       const int64_t prefix_len);
   int schedule_load_bloomfilter(const blocksstable::MacroBlockId &macro_id);
+  // The optimizer stats collected by major merge are written by an async task,
+  // the task will be ignored if the stats of the same partition are in the queue.
+  int schedule_report_column_stat(const common::IObDedupTask &task);
   static bool check_tx_table_ready(ObLS &ls, const int64_t check_log_ts);
   static int check_ls_state(ObLS &ls, bool &need_merge);
   static int schedule_tablet_minor_merge(const share::ObLSID ls_id, ObTablet &tablet);
@@ -134,6 +137,9 @@ public:
   static int schedule_tx_table_merge(
       const share::ObLSID &ls_id,
       ObTablet &tablet);
+  // refresh the version below which the row compactor of the active memtable
+  // could detach the compacted trans nodes, it runs outside the row latch
+  static int refresh_row_compact_trim_version(ObTablet &tablet);
   static bool check_weak_read_ts_ready(
       const int64_t &merge_version,
       ObLS &ls);
@@ -184,6 +190,12 @@ private:
   static const int64_t BF_TASK_TOTAL_LIMIT = 512L * 1024L * 1024L;
   static const int64_t BF_TASK_HOLD_LIMIT = 256L * 1024L * 1024L;
   static const int64_t BF_TASK_PAGE_SIZE = common::OB_MALLOC_MIDDLE_BLOCK_SIZE; //64K
+  static const int64_t COLUMN_STAT_REPORT_THREAD_CNT = 1;
+  static const int64_t COLUMN_STAT_TASK_QUEUE_SIZE = 1024;
+  static const int64_t COLUMN_STAT_TASK_MAP_SIZE = 1024;
+  static const int64_t COLUMN_STAT_TASK_TOTAL_LIMIT = 128L * 1024L * 1024L;
+  static const int64_t COLUMN_STAT_TASK_HOLD_LIMIT = 64L * 1024L * 1024L;
+  static const int64_t COLUMN_STAT_TASK_PAGE_SIZE = common::OB_MALLOC_BIG_BLOCK_SIZE;
 
   static const int64_t NO_MAJOR_MERGE_TYPE_CNT = 3;
   static constexpr ObMergeType MERGE_TYPES[] = {
@@ -202,6 +214,7 @@ private:
   int64_t schedule_interval_;
 
   common::ObDedupQueue bf_queue_;
+  common::ObDedupQueue column_stat_queue_;
   mutable obsys::ObRWLock frozen_version_lock_;
   int64_t frozen_version_;
   int64_t merged_version_; // the merged major version of the local server, may be not accurate after reboot
@@ -311,7 +311,7 @@ int ObSSTableInsertTabletContext::check_null(
 int ObSSTableInsertTabletContext::build_sstable_slice(
     const ObSSTableInsertTabletParam &build_param,
     const blocksstable::ObMacroDataSeq &start_seq,
-    common::ObNewRowIterator &iter,
+    ObISSTableInsertRowIterator &iter,
     int64_t &affected_rows)
 {
   int ret = OB_SUCCESS;
@@ -370,7 +370,6 @@ int ObSSTableInsertTabletContext::build_sstable_slice(
     // maybe the index builder is better built in macro block writer
     data_desc.sstable_index_builder_ = index_builder_;
     data_desc.is_ddl_ = true;
-    ObSSTableInsertRowIterator *tablet_row_iter = reinterpret_cast<ObSSTableInsertRowIterator *>(&iter);
     HEAP_VAR(ObMacroBlockWriter, writer) {
       ObStoreRow row;
       ObNewRow *row_val = NULL;
@@ -420,7 +419,7 @@ int ObSSTableInsertTabletContext::build_sstable_slice(
       while (OB_SUCC(ret)) {
         if (OB_FAIL(THIS_WORKER.check_status())) {
           LOG_WARN("check status failed", K(ret));
-        } else if (OB_FAIL(tablet_row_iter->get_next_row_with_tablet_id(
+        } else if (OB_FAIL(iter.get_next_row_with_tablet_id(
                     build_param.table_id_, rowkey_column_num, snapshot_version, row_val, row_tablet_id))) {
           if (OB_ITER_END != ret) {
             LOG_WARN("get next row failed", K(ret));
@@ -875,7 +874,7 @@ int ObSSTableInsertTableContext::update_context(const int64_t snapshot_version)
 int ObSSTableInsertTableContext::add_sstable_slice(
     const ObSSTableInsertTabletParam &build_param,
     const blocksstable::ObMacroDataSeq &start_seq,
-    common::ObNewRowIterator &iter,
+    ObISSTableInsertRowIterator &iter,
     int64_t &affected_rows)
 {
   int ret = OB_SUCCESS;
@@ -1198,7 +1197,7 @@ int ObSSTableInsertManager::finish_table_context(const int64_t context_id, const
 int ObSSTableInsertManager::add_sstable_slice(
     const ObSSTableInsertTabletParam &param,
     const blocksstable::ObMacroDataSeq &start_seq,
-    common::ObNewRowIterator &iter,
+    ObISSTableInsertRowIterator &iter,
     int64_t &affected_rows)
 {
   int ret = OB_SUCCESS;
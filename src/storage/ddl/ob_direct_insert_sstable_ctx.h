@@ -71,7 +71,23 @@ public:
 
 typedef std::pair<share::ObLSID, common::ObTabletID> LSTabletIDPair;
 
-class ObSSTableInsertRowIterator : public common::ObNewRowIterator
+// The rows are returned in the order of tablet and rowkey, the cells of a row are the rowkey
+// columns, the extra multi-version rowkey columns and then the other columns. A slice of a
+// tablet ends when the returned tablet id changes.
+class ObISSTableInsertRowIterator : public common::ObNewRowIterator
+{
+public:
+  ObISSTableInsertRowIterator() = default;
+  virtual ~ObISSTableInsertRowIterator() = default;
+  virtual int get_next_row_with_tablet_id(
+      const uint64_t table_id,
+      const int64_t rowkey_count,
+      const int64_t snapshot_version,
+      common::ObNewRow *&row,
+      common::ObTabletID &tablet_id) = 0;
+};
+
+class ObSSTableInsertRowIterator : public ObISSTableInsertRowIterator
 {
 public:
   ObSSTableInsertRowIterator(sql::ObExecContext &exec_ctx, sql::ObPxMultiPartSSTableInsertOp *op);
@@ -79,12 +95,12 @@ public:
   virtual void reset() override;
   virtual int get_next_row(common::ObNewRow *&row) override;
   int get_sql_mode(ObSQLMode &sql_mode) const;
-  int get_next_row_with_tablet_id(
+  virtual int get_next_row_with_tablet_id(
       const uint64_t table_id,
       const int64_t rowkey_count,
       const int64_t snapshot_version,
       common::ObNewRow *&row,
-      common::ObTabletID &tablet_id);
+      common::ObTabletID &tablet_id) override;
   common::ObTabletID get_current_tablet_id() const;
 private:
   sql::ObExecContext &exec_ctx_;
@@ -104,7 +120,7 @@ public:
   int build_sstable_slice(
       const ObSSTableInsertTabletParam &build_param,
       const blocksstable::ObMacroDataSeq &start_seq,
-      common::ObNewRowIterator &iter,
+      ObISSTableInsertRowIterator &iter,
       int64_t &affected_rows);
   int create_sstable();
   int inc_finish_count(bool &is_ready);
@@ -174,7 +190,7 @@ public:
   int add_sstable_slice(
       const ObSSTableInsertTabletParam &build_param,
       const blocksstable::ObMacroDataSeq &start_seq,
-      common::ObNewRowIterator &iter,
+      ObISSTableInsertRowIterator &iter,
       int64_t &affected_rows);
   int finish(const bool need_commit);
   int get_tablet_ids(common::ObIArray<ObTabletID> &tablet_ids);
@@ -217,7 +233,7 @@ public:
   int add_sstable_slice(
       const ObSSTableInsertTabletParam &build_param,
       const blocksstable::ObMacroDataSeq &start_seq,
-      common::ObNewRowIterator &iter,
+      ObISSTableInsertRowIterator &iter,
       int64_t &affected_rows);
   void destroy();
   int get_tablet_ids(const int64_t context_id, common::ObIArray<ObTabletID> &tablet_ids);
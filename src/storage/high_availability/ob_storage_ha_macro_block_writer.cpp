@@ -99,6 +99,21 @@ int ObStorageHAMacroBlockWriter::check_macro_block_(
   return ret;
 }
 
+int ObStorageHAMacroBlockWriter::wait_write_handle_(
+    const int64_t io_timeout_ms,
+    blocksstable::ObMacroBlockHandle &write_handle)
+{
+  int ret = OB_SUCCESS;
+  if (write_handle.is_empty()) {
+    // no write in flight
+  } else if (OB_FAIL(write_handle.wait(io_timeout_ms))) {
+    STORAGE_LOG(WARN, "failed to wait write handle", K(ret), K(write_handle));
+  } else {
+    write_handle.reset();
+  }
+  return ret;
+}
+
 int ObStorageHAMacroBlockWriter::process(blocksstable::ObMacroBlocksWriteCtx &copied_ctx)
 {
   int ret = OB_SUCCESS;
@@ -108,13 +123,15 @@ int ObStorageHAMacroBlockWriter::process(blocksstable::ObMacroBlocksWriteCtx &co
   blocksstable::ObBufferReader data(NULL, 0, 0);
   blocksstable::MacroBlockId macro_id;
   blocksstable::ObMacroBlockWriteInfo write_info;
-  blocksstable::ObMacroBlockHandle write_handle;
+  blocksstable::ObMacroBlockHandle write_handles[MAX_WRITE_WINDOW];
+  const int64_t write_window = std::min(MAX_WRITE_WINDOW,
+      std::max(1L, static_cast<int64_t>(GCONF._ha_copy_macro_block_window)));
   copied_ctx.reset();
   int64_t write_count = 0;
   int64_t log_seq_num = 0;
   int64_t data_size = 0;
   obrpc::ObCopyMacroBlockHeader header;
-  write_info.io_desc_.set_category(ObIOCategory::SYS_IO);
+  write_info.io_desc_.set_category(ObIOCategory::MIGRATION_IO);
   write_info.io_desc_.set_wait_event(ObWaitEventIds::DB_FILE_MIGRATE_WRITE);
 
   if (OB_UNLIKELY(!is_inited_)) {
@@ -141,16 +158,17 @@ int ObStorageHAMacroBlockWriter::process(blocksstable::ObMacroBlocksWriteCtx &co
       } else if (OB_FAIL(check_macro_block_(data))) {
         STORAGE_LOG(ERROR, "failed to check macro block, fatal error", K(ret), K(write_count), K(data));
         ret = OB_INVALID_DATA;// overwrite ret
-      } else if (!write_handle.is_empty() && OB_FAIL(write_handle.wait(io_timeout_ms))) {
-        STORAGE_LOG(WARN, "failed to wait write handle", K(ret));
       } else if (header.is_reuse_macro_block_) {
         ret = OB_NOT_SUPPORTED;
         LOG_WARN("header is reuse macro block", K(ret));
       } else {
-        write_info.buffer_ = data.data();
-        write_info.size_ = data.capacity();
-        write_handle.reset();
-        if (OB_FAIL(ObBlockManager::async_write_block(write_info, write_handle))) {
+        // only the oldest write of the window is waited for before its handle is reused
+        blocksstable::ObMacroBlockHandle &write_handle = write_handles[write_count % write_window];
+        if (OB_FAIL(wait_write_handle_(io_timeout_ms, write_handle))) {
+          STORAGE_LOG(WARN, "failed to wait write handle", K(ret), K(write_count), K(write_window));
+        } else if (FALSE_IT(write_info.buffer_ = data.data())) {
+        } else if (FALSE_IT(write_info.size_ = data.capacity())) {
+        } else if (OB_FAIL(ObBlockManager::async_write_block(write_info, write_handle))) {
           STORAGE_LOG(WARN, "fail to async write block", K(ret), K(write_info), K(write_handle));
         } else if (OB_FAIL(copied_ctx.add_macro_block_id(write_handle.get_macro_id()))) {
           STORAGE_LOG(WARN, "fail to add macro id", K(ret), "macro id", write_handle.get_macro_id());
@@ -165,9 +183,9 @@ int ObStorageHAMacroBlockWriter::process(blocksstable::ObMacroBlocksWriteCtx &co
       }
     }
 
-    if (!write_handle.is_empty()) {
-      int tmp_ret = write_handle.wait(io_timeout_ms);
-      if (OB_SUCCESS != tmp_ret) {
+    for (int64_t i = 0; i < write_window; ++i) {
+      blocksstable::ObMacroBlockHandle &write_handle = write_handles[(write_count + i) % write_window];
+      if (OB_SUCCESS != (tmp_ret = wait_write_handle_(io_timeout_ms, write_handle))) {
         STORAGE_LOG(WARN, "failed to wait write handle", K(ret), K(tmp_ret));
         if (OB_SUCC(ret)) {
           ret = tmp_ret;
@@ -52,8 +52,14 @@ public:
   virtual int process(blocksstable::ObMacroBlocksWriteCtx &copied_ctx);
   virtual Type get_type() const { return MACRO_BLOCK_OB_WRITER; }
 private:
+  // the io request copies the data when it is submitted, so the buffer of the reader can be
+  // reused for the next macro block while the previous writes are still in flight
+  static const int64_t MAX_WRITE_WINDOW = 8;
   int check_macro_block_(
       const blocksstable::ObBufferReader &data);
+  int wait_write_handle_(
+      const int64_t io_timeout_ms,
+      blocksstable::ObMacroBlockHandle &write_handle);
   bool is_inited_;
   uint64_t tenant_id_;
   ObICopyMacroBlockReader *reader_;
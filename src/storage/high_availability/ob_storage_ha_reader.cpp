@@ -527,7 +527,8 @@ ObCopyMacroBlockObProducer::ObCopyMacroBlockObProducer()
     copy_macro_range_info_(),
     data_version_(0),
     macro_idx_(0),
-    handle_idx_(0),
+    prefetch_idx_(0),
+    prefetch_window_(0),
     prefetch_meta_time_(0),
     tablet_handle_(),
     sstable_handle_(),
@@ -607,12 +608,14 @@ int ObCopyMacroBlockObProducer::init(
       LOG_WARN("failed to open second meta iterator", K(ret), K(ls_id), K(table_key), K(copy_macro_range_info));
     } else {
       data_version_ = data_version;
-      macro_idx_ = -1;
-      handle_idx_ = 0;
+      macro_idx_ = 0;
+      prefetch_idx_ = 0;
+      prefetch_window_ = std::min(MAX_PREFETCH_WINDOW,
+          std::max(1L, static_cast<int64_t>(GCONF._ha_copy_macro_block_window)));
       meta_ = &sstable_->get_meta();
       is_inited_ = true;
       LOG_INFO("succeed to init macro block producer",
-          K(table_key), K(data_version), K(backfill_tx_log_ts), K(copy_macro_range_info));
+          K(table_key), K(data_version), K(backfill_tx_log_ts), K(copy_macro_range_info), K_(prefetch_window));
     }
   }
 
@@ -636,38 +639,40 @@ int ObCopyMacroBlockObProducer::get_next_macro_block(
   if (!is_inited_) {
     ret = OB_NOT_INIT;
     LOG_WARN("not inited", K(ret));
-  } else if (macro_idx_ < 0 || macro_idx_ > copy_macro_range_info_.macro_block_count_) {
+  } else if (macro_idx_ < 0 || macro_idx_ > copy_macro_range_info_.macro_block_count_
+      || macro_idx_ > prefetch_idx_) {
     ret = OB_ERR_UNEXPECTED;
-    LOG_WARN("invalid macro_idx_", K(ret), K(macro_idx_), K(copy_macro_range_info_));
+    LOG_WARN("invalid macro_idx_", K(ret), K(macro_idx_), K(prefetch_idx_), K(copy_macro_range_info_));
   } else if (copy_macro_range_info_.macro_block_count_ == macro_idx_) {
     ret = OB_ITER_END;
     LOG_INFO("get next macro block end");
-  } else if (!copy_macro_block_handle_[handle_idx_].is_valid()) {
-    ret = OB_ERR_UNEXPECTED;
-    LOG_WARN("copy macro block handle is not valid, cannot wait", K(ret), K(handle_idx_));
-  } else if (!copy_macro_block_handle_[handle_idx_].is_reuse_macro_block_
-      && OB_FAIL(copy_macro_block_handle_[handle_idx_].read_handle_.wait(io_timeout_ms))) {
-    LOG_WARN("failed to wait read handle", K(ret));
   } else {
-    if (copy_macro_block_handle_[handle_idx_].is_reuse_macro_block_) {
-      occupy_size = copy_macro_block_handle_[handle_idx_].end_key_buf_.pos();
-      data.assign(copy_macro_block_handle_[handle_idx_].end_key_buf_.data(), occupy_size);
+    ObCopyMacroBlockHandle &copy_macro_block_handle = copy_macro_block_handle_[macro_idx_ % MAX_PREFETCH_MACRO_BLOCK_NUM];
+    if (!copy_macro_block_handle.is_valid()) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("copy macro block handle is not valid, cannot wait", K(ret), K(macro_idx_));
+    } else if (!copy_macro_block_handle.is_reuse_macro_block_
+        && OB_FAIL(copy_macro_block_handle.read_handle_.wait(io_timeout_ms))) {
+      LOG_WARN("failed to wait read handle", K(ret));
+    } else if (copy_macro_block_handle.is_reuse_macro_block_) {
+      occupy_size = copy_macro_block_handle.end_key_buf_.pos();
+      data.assign(copy_macro_block_handle.end_key_buf_.data(), occupy_size);
       copy_macro_block_header.is_reuse_macro_block_ = true;
       copy_macro_block_header.occupy_size_ = occupy_size;
     } else {
       blocksstable::ObMacroBlockCommonHeader common_header;
       int64_t pos = 0;
       if (OB_FAIL(common_header.deserialize(
-          copy_macro_block_handle_[handle_idx_].read_handle_.get_buffer(),
-          copy_macro_block_handle_[handle_idx_].read_handle_.get_data_size(), pos))) {
+          copy_macro_block_handle.read_handle_.get_buffer(),
+          copy_macro_block_handle.read_handle_.get_data_size(), pos))) {
         STORAGE_LOG(ERROR, "Deserialize common header failed, ", K(ret), "read handle",
-            copy_macro_block_handle_[handle_idx_].read_handle_, K(pos), K(common_header));
+            copy_macro_block_handle.read_handle_, K(pos), K(common_header));
       } else if (OB_FAIL(common_header.check_integrity())) {
         ret = OB_INVALID_DATA;
         STORAGE_LOG(ERROR, "Invalid common header, ", K(ret), K(common_header));
       } else {
         occupy_size = common_header.get_header_size() + common_header.get_payload_size();
-        data.assign(copy_macro_block_handle_[handle_idx_].read_handle_.get_buffer(), occupy_size);
+        data.assign(copy_macro_block_handle.read_handle_.get_buffer(), occupy_size);
         copy_macro_block_header.is_reuse_macro_block_ = false;
         copy_macro_block_header.occupy_size_ = occupy_size;
       }
@@ -675,6 +680,7 @@ int ObCopyMacroBlockObProducer::get_next_macro_block(
   }
 
   if (OB_SUCC(ret)) {
+    ++macro_idx_;
     if (OB_FAIL(prefetch_())) {
       LOG_WARN("failed to do prefetch", K(ret));
     }
@@ -685,46 +691,57 @@ int ObCopyMacroBlockObProducer::get_next_macro_block(
 int ObCopyMacroBlockObProducer::prefetch_()
 {
   int ret = OB_SUCCESS;
-  blocksstable::ObMacroBlockReadInfo read_info;
   prefetch_meta_time_ = ObTimeUtility::current_time();
-  ++macro_idx_;
-  handle_idx_ = (handle_idx_ + 1) % MAX_PREFETCH_MACRO_BLOCK_NUM;
-  copy_macro_block_handle_[handle_idx_].reset();
-  ObDataMacroBlockMeta macro_meta;
 
   if (!is_inited_) {
     ret = OB_NOT_INIT;
     LOG_WARN("not inited", K(ret));
-  } else if (macro_idx_ < 0 || macro_idx_ > copy_macro_range_info_.macro_block_count_) {
-    ret = OB_ERR_UNEXPECTED;
-    LOG_WARN("invalid macro_idx_", K(ret), K(macro_idx_), K(copy_macro_range_info_));
-  } else if (macro_idx_ == copy_macro_range_info_.macro_block_count_) {
-    // no need to
-    LOG_INFO("has finish, no need do prefetch", K(macro_idx_), K(copy_macro_range_info_));
   } else {
-    if (OB_FAIL(second_meta_iterator_.get_next(macro_meta))) {
-      LOG_WARN("failed to get next macro meta", K(ret), K(macro_idx_), K(copy_macro_range_info_));
-    } else if (macro_meta.get_logic_id().logic_version_ <= data_version_) {
-      copy_macro_block_handle_[handle_idx_].is_reuse_macro_block_ = true;
-      if (OB_FAIL(copy_macro_block_handle_[handle_idx_].set_end_key(macro_meta.end_key_))) {
-        LOG_WARN("failed to set end key", K(ret), K(macro_meta), K(macro_idx_), K(copy_macro_range_info_));
-      }
-    } else {
-      copy_macro_block_handle_[handle_idx_].is_reuse_macro_block_ = false;
-      read_info.macro_block_id_ = macro_meta.get_macro_id();
-      read_info.offset_ = 0;
-      read_info.size_ = OB_DEFAULT_MACRO_BLOCK_SIZE;
-      read_info.io_desc_.set_category(ObIOCategory::SYS_IO);
-      read_info.io_desc_.set_wait_event(ObWaitEventIds::DB_FILE_MIGRATE_READ);
-      if (OB_FAIL(ObBlockManager::async_read_block(read_info, copy_macro_block_handle_[handle_idx_].read_handle_))) {
-        STORAGE_LOG(WARN, "Fail to async read block, ", K(ret), K(read_info));
+    while (OB_SUCC(ret)
+        && prefetch_idx_ < copy_macro_range_info_.macro_block_count_
+        && prefetch_idx_ - macro_idx_ < prefetch_window_) {
+      if (OB_FAIL(prefetch_one_())) {
+        LOG_WARN("failed to prefetch macro block", K(ret), K(prefetch_idx_), K(macro_idx_));
       }
     }
+    if (OB_SUCC(ret) && prefetch_idx_ == copy_macro_range_info_.macro_block_count_) {
+      LOG_INFO("has finish, no need do prefetch", K(macro_idx_), K(copy_macro_range_info_));
+    }
+  }
+  return ret;
+}
 
-    if (OB_SUCC(ret)) {
-      LOG_INFO("do prefetch", K(macro_idx_), "macro block count",copy_macro_range_info_.macro_block_count_ ,
-          "logical id", macro_meta.get_logic_id(), "physical id", macro_meta.get_macro_id());
+int ObCopyMacroBlockObProducer::prefetch_one_()
+{
+  int ret = OB_SUCCESS;
+  blocksstable::ObMacroBlockReadInfo read_info;
+  ObDataMacroBlockMeta macro_meta;
+  ObCopyMacroBlockHandle &copy_macro_block_handle = copy_macro_block_handle_[prefetch_idx_ % MAX_PREFETCH_MACRO_BLOCK_NUM];
+  copy_macro_block_handle.reset();
+
+  if (OB_FAIL(second_meta_iterator_.get_next(macro_meta))) {
+    LOG_WARN("failed to get next macro meta", K(ret), K(prefetch_idx_), K(copy_macro_range_info_));
+  } else if (macro_meta.get_logic_id().logic_version_ <= data_version_) {
+    copy_macro_block_handle.is_reuse_macro_block_ = true;
+    if (OB_FAIL(copy_macro_block_handle.set_end_key(macro_meta.end_key_))) {
+      LOG_WARN("failed to set end key", K(ret), K(macro_meta), K(prefetch_idx_), K(copy_macro_range_info_));
     }
+  } else {
+    copy_macro_block_handle.is_reuse_macro_block_ = false;
+    read_info.macro_block_id_ = macro_meta.get_macro_id();
+    read_info.offset_ = 0;
+    read_info.size_ = OB_DEFAULT_MACRO_BLOCK_SIZE;
+    read_info.io_desc_.set_category(ObIOCategory::MIGRATION_IO);
+    read_info.io_desc_.set_wait_event(ObWaitEventIds::DB_FILE_MIGRATE_READ);
+    if (OB_FAIL(ObBlockManager::async_read_block(read_info, copy_macro_block_handle.read_handle_))) {
+      STORAGE_LOG(WARN, "Fail to async read block, ", K(ret), K(read_info));
+    }
+  }
+
+  if (OB_SUCC(ret)) {
+    LOG_INFO("do prefetch", K(prefetch_idx_), "macro block count",copy_macro_range_info_.macro_block_count_ ,
+        "logical id", macro_meta.get_logic_id(), "physical id", macro_meta.get_macro_id());
+    ++prefetch_idx_;
   }
   return ret;
 }
@@ -173,18 +173,23 @@ public:
       ObCopyMacroBlockHeader &copy_macro_block_header);
 
 private:
+  // keep reading ahead until prefetch_window_ macro blocks after the returned one are in flight
   int prefetch_();
+  int prefetch_one_();
 
 private:
-  static const int64_t MAX_PREFETCH_MACRO_BLOCK_NUM = 2;
+  static const int64_t MAX_PREFETCH_WINDOW = 8;
+  // the handle of the macro block returned last is still used by the caller
+  static const int64_t MAX_PREFETCH_MACRO_BLOCK_NUM = MAX_PREFETCH_WINDOW + 1;
   static const int64_t MACRO_META_RESERVE_TIME = 60 * 1000 * 1000LL; // 1minutes
 
   bool is_inited_;
   ObCopyMacroRangeInfo copy_macro_range_info_;
   int64_t data_version_;
-  int64_t macro_idx_;
+  int64_t macro_idx_; //the next macro block to return
   ObCopyMacroBlockHandle copy_macro_block_handle_[MAX_PREFETCH_MACRO_BLOCK_NUM];
-  int64_t handle_idx_;
+  int64_t prefetch_idx_; //the next macro block to prefetch
+  int64_t prefetch_window_;
   int64_t prefetch_meta_time_;
   ObTabletHandle tablet_handle_;
   ObTableHandleV2 sstable_handle_;
@@ -174,18 +174,17 @@ void ObLobManager::transform_query_result_charset(
   byte_len = ObCharset::charpos(coll_type, data + byte_st, len - byte_st, byte_len);
 }
 
-int ObLobManager::get_real_data(
+int ObLobManager::get_piece_data(
     ObLobAccessParam& param,
     const ObLobQueryResult& result,
-    ObString& data)
+    ObString& piece)
 {
   int ret = OB_SUCCESS;
-  ObLobCtx lob_ctx;
   if (result.meta_result_.info_.piece_id_ != ObLobMetaUtil::LOB_META_INLINE_PIECE_ID) {
     ret = OB_ERR_UNEXPECTED;
     LOG_WARN("Invalid piece id.", K(ret), K(result));
-  } else if (result.meta_result_.info_.piece_id_ == ObLobMetaUtil::LOB_META_INLINE_PIECE_ID) {
-    // read data from lob_meta.lob_data
+  } else {
+    // the data is in lob_meta.lob_data, the queried range of it is returned
     uint32_t byte_len = result.meta_result_.len_;
     uint32_t byte_st = result.meta_result_.st_;
     const char *lob_data = result.meta_result_.info_.lob_data_.ptr();
@@ -193,11 +192,24 @@ int ObLobManager::get_real_data(
       transform_query_result_charset(param.coll_type_, lob_data,
         result.meta_result_.info_.byte_len_, byte_len, byte_st);
     }
-    if (data.write(lob_data + byte_st, byte_len) != byte_len) {
-      ret = OB_ERR_INTERVAL_INVALID;
-      LOG_WARN("failed to write buffer to output_data.", K(ret), K(data),
-                K(result.meta_result_.st_), K(result.meta_result_.len_));
-    }
+    piece.assign_ptr(lob_data + byte_st, byte_len);
+  }
+  return ret;
+}
+
+int ObLobManager::get_real_data(
+    ObLobAccessParam& param,
+    const ObLobQueryResult& result,
+    ObString& data)
+{
+  int ret = OB_SUCCESS;
+  ObString piece;
+  if (OB_FAIL(get_piece_data(param, result, piece))) {
+    LOG_WARN("failed to get piece data.", K(ret), K(result));
+  } else if (data.write(piece.ptr(), piece.length()) != piece.length()) {
+    ret = OB_ERR_INTERVAL_INVALID;
+    LOG_WARN("failed to write buffer to output_data.", K(ret), K(data),
+              K(result.meta_result_.st_), K(result.meta_result_.len_));
   }
   return ret;
 }
@@ -333,17 +345,22 @@ int ObLobManager::query(
       } else {
         data.assign_ptr(lob_common->buffer_, param.byte_size_);
       }
-      uint64_t byte_offset = param.offset_;
-      uint32_t byte_len = param.len_;
+      // the same range as the out row lob, offset and len are in chars
+      uint32_t char_len = ObCharset::strlen_char(param.coll_type_, data.ptr(), data.length());
+      uint32_t byte_offset = (param.offset_ > char_len) ? char_len : param.offset_;
+      uint32_t max_len = char_len - byte_offset;
+      uint32_t byte_len = (param.len_ > max_len) ? max_len : param.len_;
+      transform_query_result_charset(param.coll_type_, data.ptr(), data.length(), byte_len, byte_offset);
       if (OB_UNLIKELY(data.length() < byte_offset + byte_len)) {
         ret = OB_SIZE_OVERFLOW;
-        LOG_WARN("data length is not enough.", K(ret), K(byte_offset), K(param.len_));
+        LOG_WARN("data length is not enough.", K(ret), K(byte_offset), K(byte_len), K(param.len_));
       } else {
+        ObString range_data(byte_len, data.ptr() + byte_offset);
         ObLobQueryIter* iter = common::sop_borrow(ObLobQueryIter);
         if (OB_ISNULL(iter)) {
           ret = OB_ERR_UNEXPECTED;
           LOG_WARN("alloc lob meta scan iterator fail", K(ret));
-        } else if (OB_FAIL(iter->open(data))) {
+        } else if (OB_FAIL(iter->open(range_data))) {
           LOG_WARN("do lob meta scan failed.", K(ret), K(data));
         } else {
           result = iter;
@@ -991,13 +1008,13 @@ int ObLobQueryIter::get_next_row(ObString& data)
     ret = OB_ERR_UNEXPECTED;
     LOG_WARN("iter is invalid.", K(ret));
   } else if (is_in_row_) {
-    uint64_t read_size = data.size();
+    uint64_t read_size = data.remain();
     if (cur_pos_ + read_size > inner_data_.length()) {
       read_size = inner_data_.length() - cur_pos_;
     }
     if (cur_pos_ == inner_data_.length()) {
       ret = OB_ITER_END;
-    } else if (data.write(data.ptr() + cur_pos_, read_size) != read_size) {
+    } else if (data.write(inner_data_.ptr() + cur_pos_, read_size) != read_size) {
       ret = OB_ERR_UNEXPECTED;
       LOG_WARN("failed to write output data.", K(data), K(cur_pos_), K(read_size), K(inner_data_));
     } else {
@@ -1018,13 +1035,168 @@ int ObLobQueryIter::get_next_row(ObString& data)
   return ret;
 }
 
+int ObLobQueryIter::get_next_piece(ObString& piece)
+{
+  int ret = OB_SUCCESS;
+  ObLobQueryResult result;
+  if (!is_inited_) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("iter is invalid.", K(ret));
+  } else if (is_in_row_) {
+    // the inrow data is small, return all of the rest as one piece
+    if (cur_pos_ == inner_data_.length()) {
+      ret = OB_ITER_END;
+    } else {
+      piece.assign_ptr(inner_data_.ptr() + cur_pos_, inner_data_.length() - cur_pos_);
+      cur_pos_ = inner_data_.length();
+    }
+  } else if (OB_FAIL(get_next_row(result))) {
+    if (OB_ITER_END != ret) {
+      LOG_WARN("get next query result failed.", K(ret));
+    }
+  } else {
+    ObLobManager *lob_mngr = MTL(ObLobManager*);
+    if (OB_ISNULL(lob_mngr)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("failed to get lob mngr.", K(ret));
+    } else if (OB_FAIL(lob_mngr->get_piece_data(param_, result, piece))) {
+      LOG_WARN("get piece data failed.", K(ret), K(result));
+    }
+  }
+  return ret;
+}
+
 void ObLobQueryIter::reset()
 {
   meta_iter_.reset();
   inner_data_.reset();
+  cur_pos_ = 0;
   is_in_row_ = false;
   is_inited_ = false;
 }
 
+/*************ObLobStreamWriter*****************/
+int ObLobStreamWriter::open(ObLobAccessParam &param)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(is_inited_)) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("lob stream writer init twice", K(ret));
+  } else if (OB_ISNULL(param.allocator_)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(param));
+  } else if (OB_ISNULL(buf_ = static_cast<char *>(
+      param.allocator_->alloc(ObLobMetaUtil::LOB_OPER_PIECE_DATA_SIZE)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("failed to alloc piece buffer", K(ret));
+  } else {
+    param_ = &param;
+    buf_pos_ = 0;
+    append_size_ = 0;
+    is_inited_ = true;
+  }
+  return ret;
+}
+
+int ObLobStreamWriter::append(const ObString &data)
+{
+  int ret = OB_SUCCESS;
+  const int64_t piece_size = ObLobMetaUtil::LOB_OPER_PIECE_DATA_SIZE;
+  int64_t pos = 0;
+  int64_t append_len = 0;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("lob stream writer is not inited", K(ret));
+  }
+  while (OB_SUCC(ret) && pos < data.length()) {
+    if (0 == buf_pos_ && data.length() - pos >= piece_size) {
+      // the full pieces of the chunk are appended without copy
+      if (OB_FAIL(append_pieces(data.ptr() + pos, data.length() - pos, append_len))) {
+        LOG_WARN("failed to append pieces", K(ret), K(pos), K(data.length()));
+      } else {
+        pos += append_len;
+      }
+    } else {
+      const int64_t copy_len = MIN(piece_size - buf_pos_, data.length() - pos);
+      MEMCPY(buf_ + buf_pos_, data.ptr() + pos, copy_len);
+      buf_pos_ += copy_len;
+      pos += copy_len;
+      if (buf_pos_ < piece_size) {
+      } else if (OB_FAIL(append_pieces(buf_, buf_pos_, append_len))) {
+        LOG_WARN("failed to append buffered piece", K(ret), K(buf_pos_));
+      } else {
+        // the incomplete char at the tail is kept for the next piece
+        MEMMOVE(buf_, buf_ + append_len, buf_pos_ - append_len);
+        buf_pos_ -= append_len;
+      }
+    }
+  }
+  return ret;
+}
+
+int ObLobStreamWriter::close()
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("lob stream writer is not inited", K(ret));
+  } else if (buf_pos_ > 0) {
+    if (OB_FAIL(do_append(buf_, buf_pos_))) {
+      LOG_WARN("failed to append the tail", K(ret), K(buf_pos_));
+    } else {
+      buf_pos_ = 0;
+    }
+  }
+  return ret;
+}
+
+void ObLobStreamWriter::reset()
+{
+  if (OB_NOT_NULL(buf_) && OB_NOT_NULL(param_) && OB_NOT_NULL(param_->allocator_)) {
+    param_->allocator_->free(buf_);
+  }
+  param_ = nullptr;
+  buf_ = nullptr;
+  buf_pos_ = 0;
+  append_size_ = 0;
+  is_inited_ = false;
+}
+
+// append the full pieces at the head of data, a char is never split between two appends
+int ObLobStreamWriter::append_pieces(const char *data, const int64_t len, int64_t &append_len)
+{
+  int ret = OB_SUCCESS;
+  const int64_t piece_size = ObLobMetaUtil::LOB_OPER_PIECE_DATA_SIZE;
+  append_len = len / piece_size * piece_size;
+  if (param_->coll_type_ != common::ObCollationType::CS_TYPE_BINARY) {
+    int64_t char_len = 0;
+    append_len = ObCharset::max_bytes_charpos(param_->coll_type_, data, len, append_len, char_len);
+    if (0 == append_len) {
+      // not a valid string of the charset, leave it to the lob manager
+      append_len = len;
+    }
+  }
+  if (OB_FAIL(do_append(data, append_len))) {
+    LOG_WARN("failed to append pieces", K(ret), K(append_len), K(len));
+  }
+  return ret;
+}
+
+int ObLobStreamWriter::do_append(const char *data, const int64_t len)
+{
+  int ret = OB_SUCCESS;
+  ObString append_data(len, data);
+  ObLobManager *lob_mngr = MTL(ObLobManager*);
+  if (OB_ISNULL(lob_mngr)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("failed to get lob mngr.", K(ret));
+  } else if (OB_FAIL(lob_mngr->append(*param_, append_data))) {
+    LOG_WARN("failed to append lob data", K(ret), K(len), KPC(param_));
+  } else {
+    append_size_ += len;
+  }
+  return ret;
+}
+
 } // storage
 } // oceanbase
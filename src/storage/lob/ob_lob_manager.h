@@ -45,7 +45,11 @@ public:
                      cur_pos_(0), is_in_row_(false), is_inited_(false) {}
   int open(ObLobAccessParam &param, ObLobCtx& lob_ctx); // outrow open
   int open(ObString &data); // inrow open
+  // copy the data of the next piece into data, the buffer of data is provided by the caller
   int get_next_row(ObString& data);
+  // zero copy, the piece points to the lob data of the current meta row or the inrow data,
+  // and it is only valid until the next call.
+  int get_next_piece(ObString& piece);
   uint64_t get_cur_pos() { return meta_iter_.get_cur_pos(); }
   void reset();
 private:
@@ -62,6 +66,35 @@ private:
   bool is_inited_;
 };
 
+/**
+ * @brief append a lob chunk by chunk without materializing the whole lob. The chunks are
+ *        buffered and appended as full pieces of LOB_OPER_PIECE_DATA_SIZE, the chunk is not
+ *        copied if the buffer is empty. The pieces written before are never rewritten.
+ */
+class ObLobStreamWriter
+{
+public:
+  ObLobStreamWriter() : param_(nullptr), buf_(nullptr), buf_pos_(0), append_size_(0), is_inited_(false) {}
+  virtual ~ObLobStreamWriter() { reset(); }
+  int open(ObLobAccessParam &param);
+  int append(const ObString &data);
+  // append the buffered tail, the param holds the final lob after this
+  int close();
+  void reset();
+  int64_t get_append_size() const { return append_size_; }
+  TO_STRING_KV(KP_(param), KP_(buf), K_(buf_pos), K_(append_size), K_(is_inited));
+private:
+  int append_pieces(const char *data, const int64_t len, int64_t &append_len);
+  virtual int do_append(const char *data, const int64_t len); // virtual for test
+private:
+  ObLobAccessParam *param_;
+  char *buf_;
+  int64_t buf_pos_;
+  int64_t append_size_;
+  bool is_inited_;
+  DISALLOW_COPY_AND_ASSIGN(ObLobStreamWriter);
+};
+
 class ObLobManager
 {
 public:
@@ -108,6 +141,10 @@ public:
   int get_real_data(ObLobAccessParam& param,
                     const ObLobQueryResult& result,
                     ObString& data);
+  // the queried range of the piece without copy
+  int get_piece_data(ObLobAccessParam& param,
+                     const ObLobQueryResult& result,
+                     ObString& piece);
   int erase(ObLobAccessParam& param);
 
 private:
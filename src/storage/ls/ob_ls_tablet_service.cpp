@@ -21,6 +21,7 @@
 #include "logservice/ob_log_base_header.h"
 #include "logservice/ob_log_base_type.h"
 #include "logservice/ob_log_service.h"
+#include "observer/omt/ob_tenant_config_mgr.h"
 #include "observer/report/ob_i_meta_report.h"
 #include "share/ob_disk_usage_table_operator.h"
 #include "share/ob_rpc_struct.h"
@@ -5264,6 +5265,10 @@ int ObLSTabletService::build_tablet_iter(ObLSTabletIterator &iter)
   int ret = common::OB_SUCCESS;
   GetAllTabletIDOperator op(iter.tablet_ids_);
   iter.ls_tablet_service_ = this;
+  {
+    omt::ObTenantConfigGuard tenant_config(TENANT_CONF(MTL_ID()));
+    iter.keep_cold_tablet_washed_ = tenant_config.is_valid() && tenant_config->_enable_lazy_tablet_load;
+  }
   if (OB_UNLIKELY(!is_inited_)) {
     ret = OB_NOT_INIT;
     STORAGE_LOG(WARN, "not inited", K(ret), K_(is_inited));
@@ -356,10 +356,12 @@ int ObMultiVersionValueIterator::get_next_multi_version_node(const void *&tnode)
         multi_version_iter_ = NULL;
         break;
       } else if (NDT_COMPACT == multi_version_iter_->type_) { // meet compacted node
-        if (multi_version_iter_->trans_version_ > version_range_.multi_version_start_) {
+        if (multi_version_iter_->trans_version_ > version_range_.multi_version_start_
+            && OB_NOT_NULL(multi_version_iter_->prev_)) {
           // ignore compact node
           is_compacted = true;
         } else { // multi_version_iter_->trans_version_ <= multi_version_start
+                 // or the nodes below it have been trimmed by row compactor
           is_node_compacted_ = true;
           record_node = multi_version_iter_;
           multi_version_iter_ = NULL;
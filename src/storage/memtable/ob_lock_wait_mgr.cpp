@@ -116,6 +116,8 @@ int ObLockWaitMgr::init()
     TRANS_LOG(WARN, "ob lock wait mgr already init", K(ret), K(is_inited_));
   } else if (OB_FAIL(row_holder_mapper_.init())) {
     TRANS_LOG(WARN, "can't init row_holder", KR(ret));
+  } else if (OB_FAIL(tablet_stat_map_.init("LockWaitStat", MTL_ID()))) {
+    TRANS_LOG(WARN, "can't init tablet stat map", KR(ret));
   } else {
     share::ObThreadPool::set_run_wrapper(MTL_CTX());
     is_inited_ = true;
@@ -189,6 +191,7 @@ void ObLockWaitMgr::run1()
       if (!ObDeadLockDetectorMgr::is_deadlock_enabled()) {
         row_holder_mapper_.clear();
       }
+      dump_tablet_stat_();
     }
     ob_usleep(10000);
   }
@@ -333,6 +336,13 @@ bool ObLockWaitMgr::wait(Node* node)
         wait_succ = true;
       }
     }
+    if (wait_succ && NULL != node) {
+      TabletLockWaitStat delta;
+      delta.wait_cnt_ = 1;
+      // the request has been waken up before but still conflicts
+      delta.retry_cnt_ = node->try_lock_times_ > 1 ? 1 : 0;
+      record_tablet_stat_(node->tablet_id_, delta);
+    }
     // 4. it should be promised that no other threads is visting the request if
     // the wait sync is needed
     if (NULL != tmp_node) {
@@ -352,8 +362,12 @@ void ObLockWaitMgr::wakeup(uint64_t hash)
     node = fetch_waiter(hash);
 
     if (NULL != node) {
+      TabletLockWaitStat delta;
+      delta.wakeup_cnt_ = 1;
+      delta.wait_time_ = ObTimeUtility::current_time() - node->lock_ts_;
       EVENT_INC(MEMSTORE_WRITE_LOCK_WAKENUP_COUNT);
-      EVENT_ADD(MEMSTORE_WAIT_WRITE_LOCK_TIME, ObTimeUtility::current_time() - node->lock_ts_);
+      EVENT_ADD(MEMSTORE_WAIT_WRITE_LOCK_TIME, delta.wait_time_);
+      record_tablet_stat_(node->tablet_id_, delta);
       node->on_retry_lock(hash);
       (void)repost(node);
     }
@@ -523,11 +537,16 @@ void ObLockWaitMgr::retire_node(ObLink*& tail, Node* node)
 {
   int err = 0;
   Node* tmp_node = NULL;
+  TabletLockWaitStat delta;
+  delta.wakeup_cnt_ = 1;
+  delta.timeout_cnt_ = node->is_timeout() ? 1 : 0;
+  delta.wait_time_ = ObTimeUtility::current_time() - node->lock_ts_;
   EVENT_INC(MEMSTORE_WRITE_LOCK_WAKENUP_COUNT);
-  EVENT_ADD(MEMSTORE_WAIT_WRITE_LOCK_TIME, ObTimeUtility::current_time() - node->lock_ts_);
+  EVENT_ADD(MEMSTORE_WAIT_WRITE_LOCK_TIME, delta.wait_time_);
   while (-EAGAIN == (err = hash_.del(node, tmp_node)))
     ;
   if (0 == err) {
+    record_tablet_stat_(node->tablet_id_, delta);
     node->retire_link_.next_ = tail;
     tail = &node->retire_link_;
   }
@@ -707,6 +726,16 @@ int ObLockWaitMgr::transform_row_lock_to_tx_lock(const ObTabletID &tablet_id,
   return ret;
 }
 
+void ObLockWaitMgr::on_row_lock_acquired(const ObTabletID &tablet_id, const Key &key)
+{
+  uint64_t &hold_key = get_thread_hold_key();
+  if (0 != hold_key && hold_key == hash_rowkey(tablet_id, key)) {
+    // the lock release of current request will wakeup the next waiter, waking
+    // it up at the end of the request only leads to a conflict once more
+    hold_key = 0;
+  }
+}
+
 void ObLockWaitMgr::wakeup(const ObTabletID &tablet_id, const Key& key)
 {
   TRANS_LOG(TRACE, "LockWaitMgr.wakeup.byRowKey", K(tablet_id), K(key), K(lbt()));
@@ -741,6 +770,79 @@ int ObLockWaitMgr::fullfill_row_key(uint64_t hash, char *row_key, int64_t length
   return ret;
 }
 
+int ObLockWaitMgr::get_tablet_lock_wait_stat(const ObTabletID &tablet_id,
+                                             TabletLockWaitStat &stat) const
+{
+  return tablet_stat_map_.get(ObIntWarp(tablet_id.id()), stat);
+}
+
+void ObLockWaitMgr::record_tablet_stat_(const uint64_t tablet_id,
+                                        const TabletLockWaitStat &delta)
+{
+  int ret = OB_SUCCESS;
+  auto add_op = [&delta](const ObIntWarp &, TabletLockWaitStat &stat) -> bool {
+    stat.add(delta);
+    return true;
+  };
+  if (ObTabletID::INVALID_TABLET_ID == tablet_id || OB_INVALID_ID == tablet_id) {
+    // skip the requests not waiting on tablet
+  } else if (OB_SUCC(tablet_stat_map_.operate(ObIntWarp(tablet_id), add_op))) {
+  } else if (OB_ENTRY_NOT_EXIST != ret) {
+    TRANS_LOG(WARN, "update tablet lock wait stat failed", K(ret), K(tablet_id), K(delta));
+  } else if (tablet_stat_map_.count() >= MAX_TABLET_STAT_COUNT) {
+    // too many tablets in the period, skip it until the map is reset
+  } else if (OB_SUCC(tablet_stat_map_.insert(ObIntWarp(tablet_id), delta))) {
+  } else if (OB_ENTRY_EXIST == ret) {
+    // inserted concurrently
+    if (OB_FAIL(tablet_stat_map_.operate(ObIntWarp(tablet_id), add_op))) {
+      TRANS_LOG(WARN, "update tablet lock wait stat failed", K(ret), K(tablet_id), K(delta));
+    }
+  } else {
+    TRANS_LOG(WARN, "insert tablet lock wait stat failed", K(ret), K(tablet_id), K(delta));
+  }
+}
+
+// dump the tablets waited most in the past period, and reset the statistics
+void ObLockWaitMgr::dump_tablet_stat_()
+{
+  static const int64_t TOP_TABLET_COUNT = 8;
+  struct TopTablet {
+    uint64_t tablet_id_;
+    TabletLockWaitStat stat_;
+    TO_STRING_KV(K_(tablet_id), K_(stat));
+  };
+  TopTablet top[TOP_TABLET_COUNT];
+  int64_t top_cnt = 0;
+  int64_t tablet_cnt = tablet_stat_map_.count();
+  auto top_op = [&top, &top_cnt](const ObIntWarp &key, TabletLockWaitStat &stat) -> bool {
+    int64_t pos = top_cnt;
+    if (top_cnt < TOP_TABLET_COUNT) {
+      top_cnt++;
+    } else if (top[TOP_TABLET_COUNT - 1].stat_.wait_cnt_ >= stat.wait_cnt_) {
+      // not the top ones
+      pos = -1;
+    } else {
+      pos = TOP_TABLET_COUNT - 1;
+    }
+    if (pos >= 0) {
+      while (pos > 0 && top[pos - 1].stat_.wait_cnt_ < stat.wait_cnt_) {
+        top[pos] = top[pos - 1];
+        pos--;
+      }
+      top[pos].tablet_id_ = key.get_value();
+      top[pos].stat_ = stat;
+    }
+    return true;
+  };
+  if (0 < tablet_cnt) {
+    (void)tablet_stat_map_.for_each(top_op);
+    tablet_stat_map_.clear();
+    for (int64_t i = 0; i < top_cnt; i++) {
+      TRANS_LOG(INFO, "report tablet lock wait stat", K(tablet_cnt), "top_tablet", top[i]);
+    }
+  }
+}
+
 int ObLockWaitMgr::notify_deadlocked_session(const uint32_t sess_id)
 {
   ObSpinLockGuard guard(deadlocked_sessions_lock_);
@@ -194,6 +194,27 @@ public:
     TO_STRING_KV(K(sess_id_));
   };
   typedef ObSEArray<SessPair, OB_SESSPAIR_COUNT> DeadlockedSessionArray;
+  // lock wait statistics of a tablet, which are dumped and reset periodically
+  struct TabletLockWaitStat {
+    TabletLockWaitStat() : wait_cnt_(0), retry_cnt_(0), wakeup_cnt_(0), timeout_cnt_(0), wait_time_(0) {}
+    void add(const TabletLockWaitStat &other)
+    {
+      wait_cnt_ += other.wait_cnt_;
+      retry_cnt_ += other.retry_cnt_;
+      wakeup_cnt_ += other.wakeup_cnt_;
+      timeout_cnt_ += other.timeout_cnt_;
+      wait_time_ += other.wait_time_;
+    }
+    TO_STRING_KV(K_(wait_cnt), K_(retry_cnt), K_(wakeup_cnt), K_(timeout_cnt), K_(wait_time));
+    // the number of requests put into wait
+    int64_t wait_cnt_;
+    // the number of requests waken up but conflicted again
+    int64_t retry_cnt_;
+    int64_t wakeup_cnt_;
+    int64_t timeout_cnt_;
+    int64_t wait_time_;
+  };
+  static const int64_t MAX_TABLET_STAT_COUNT = 1024;
 
 public:
   ObLockWaitMgr();
@@ -255,6 +276,10 @@ public:
                                     const Key &key,
                                     const transaction::ObTransID &tx_id,
                                     const ObAddr &tx_scheduler);
+  // the request waken up acquired the row lock, the lock is handed off to it
+  // and the next waiter will be waken up when the lock is released, rather
+  // than when the request ends
+  void on_row_lock_acquired(const ObTabletID &tablet_id, const Key &key);
   // wakeup the request waiting on the row
   void wakeup(const ObTabletID &tablet_id, const Key& key);
   // wakeup the request waiting on the transaction
@@ -266,6 +291,7 @@ public:
   DELEGATE_WITH_RET(row_holder_mapper_, reset_hash_holder, void);
   
   Node* next(Node*& iter, Node* target);
+  int get_tablet_lock_wait_stat(const ObTabletID &tablet_id, TabletLockWaitStat &stat) const;
 
   static Node*& get_thread_node()
   {
@@ -347,12 +373,15 @@ private:
   bool is_deadlocked_session_(DeadlockedSessionArray *sessions,
                               const uint32_t sess_id);
   void fetch_deadlocked_sessions_(DeadlockedSessionArray *&sessions);
+  void record_tablet_stat_(const uint64_t tablet_id, const TabletLockWaitStat &delta);
+  void dump_tablet_stat_();
 private:
   ObSpinLock deadlocked_sessions_lock_;
   int32_t deadlocked_sessions_index_;
   DeadlockedSessionArray deadlocked_sessions_[2];
 private:
   RowHolderMapper row_holder_mapper_;
+  ObLinearHashMap<ObIntWarp, TabletLockWaitStat> tablet_stat_map_;
 };
 
 }; // end namespace memtable
@@ -123,6 +123,7 @@ ObMemtable::ObMemtable()
       mode_(lib::Worker::CompatMode::INVALID),
       minor_merged_time_(0),
       contain_hotspot_row_(false),
+      row_compact_trim_version_(0),
       multi_source_data_(local_allocator_),
       multi_source_data_lock_()
 {
@@ -259,6 +260,7 @@ void ObMemtable::destroy()
   is_flushed_ = false;
   is_inited_ = false;
   contain_hotspot_row_ = false;
+  row_compact_trim_version_ = 0;
   snapshot_version_ = INT64_MAX;
 }
 
@@ -1293,6 +1295,13 @@ int ObMemtable::row_compact(ObMvccRow *row,
   return ret;
 }
 
+// The trim version is refreshed by the tablet scheduler outside the row latch,
+// it only grows so that a stale one is always safe for the readers.
+void ObMemtable::set_row_compact_trim_version(const int64_t trim_version)
+{
+  inc_update(&row_compact_trim_version_, trim_version);
+}
+
 int64_t ObMemtable::get_hash_item_count() const
 {
   return query_engine_.hash_size();
@@ -2454,17 +2463,18 @@ int ObMemtable::mvcc_write_(storage::ObStoreCtx &ctx,
     TRANS_LOG(WARN, "register row commit failed", K(ret));
   } else {
     is_new_locked = res.is_new_locked_;
-    /*****[for deadlock]*****/
     if (is_new_locked) {
-      // recored this row is hold by this trans for deadlock detector
       ObLockWaitMgr* p_lock_wait_mgr = MTL(ObLockWaitMgr*);
       if (OB_ISNULL(p_lock_wait_mgr)) {
         TRANS_LOG(WARN, "lock wait mgr is null", K(ret));
       } else {
+        p_lock_wait_mgr->on_row_lock_acquired(key_.get_tablet_id(), *key);
+        /*****[for deadlock]*****/
+        // recored this row is hold by this trans for deadlock detector
         p_lock_wait_mgr->set_hash_holder(key_.get_tablet_id(), *key, mem_ctx->get_tx_id());
+        /***********************/
       }
     }
-    /***********************/
   }
 
   // cannot be serializable when transaction set violation
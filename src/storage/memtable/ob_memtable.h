@@ -321,6 +321,11 @@ public:
   void set_max_schema_version(const int64_t schema_version);
   virtual int64_t get_max_schema_version() const override;
   int row_compact(ObMvccRow *value, const bool for_replay, const int64_t snapshot_version);
+  // get_row_compact_trim_version returns the version below which the compacted
+  // trans nodes of the row can be detached by the row compactor, it is the
+  // cached one set by set_row_compact_trim_version, 0 means no trim
+  int64_t get_row_compact_trim_version() const { return ATOMIC_LOAD(&row_compact_trim_version_); }
+  void set_row_compact_trim_version(const int64_t trim_version);
   int64_t get_hash_item_count() const;
   int64_t get_hash_alloc_memory() const;
   int64_t get_btree_item_count() const;
@@ -544,6 +549,7 @@ private:
   lib::Worker::CompatMode mode_;
   int64_t minor_merged_time_;
   bool contain_hotspot_row_;
+  int64_t row_compact_trim_version_;
   ObMultiSourceData multi_source_data_;
   mutable common::TCRWLock multi_source_data_lock_;
 };
@@ -298,6 +298,11 @@ int ObMemtableRowCompactor::compact(const int64_t snapshot_version)
       insert_compact_node_(compact_node, start);
     }
     tg.click();
+
+    if (GCONF._enable_row_compaction_trim) {
+      trim_compacted_nodes_(memtable_->get_row_compact_trim_version());
+    }
+    tg.click();
   }
 
   return ret;
@@ -586,5 +591,42 @@ void ObMemtableRowCompactor::insert_compact_node_(ObMvccTransNode *tx_node,
   ATOMIC_STORE(&(row_->update_since_compact_), 0);
 }
 
+// Hot rows accumulate thousands of committed versions below the compact nodes.
+// The versions below a compact node whose trans version is not larger than the
+// min reserved snapshot will never be read again(all readers and the mini
+// merge use a snapshot not smaller than it), so we can detach them from the
+// row to shorten the traversal of lock_for_read and the multi version scan.
+//
+// NB: The detached nodes are not freed here, they belongs to the memtable
+// allocator and concurrent readers(without row latch) may still traverse them
+// through their own prev_ pointer, which is kept unchanged.
+void ObMemtableRowCompactor::trim_compacted_nodes_(const int64_t trim_version)
+{
+  // bound the search so that the trim never costs more than the compaction
+  // itself, the row is left untouched if no suitable compact node is found
+  static const int64_t MAX_TRIM_SEARCH_CNT = 1024;
+  ObMvccTransNode *iter = row_->latest_compact_node_;
+  int64_t search_cnt = 0;
+
+  if (0 >= trim_version || INT64_MAX == trim_version) {
+    iter = NULL;
+  }
+  while (NULL != iter
+         && (NDT_COMPACT != iter->type_ || iter->trans_version_ > trim_version)) {
+    if (++search_cnt > MAX_TRIM_SEARCH_CNT) {
+      iter = NULL;
+    } else {
+      iter = iter->prev_;
+    }
+  }
+
+  if (NULL != iter && NULL != iter->prev_) {
+    ATOMIC_STORE(&(iter->prev_), NULL);
+    EVENT_INC(MEMSTORE_ROW_COMPACTION_TRIM_COUNT);
+    TRANS_LOG(DEBUG, "trim compacted trans nodes", K(trim_version), K(search_cnt),
+              KPC(iter), KPC(row_));
+  }
+}
+
 }
 }
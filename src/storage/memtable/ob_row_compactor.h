@@ -127,6 +127,9 @@ private:
                                             ObMvccTransNode *tnode);
   void insert_compact_node_(ObMvccTransNode *trans_node,
                             ObMvccTransNode *save);
+  // detach the tx nodes older than the newest compact node whose trans
+  // version is not larger than trim_version, no reader will ever need them
+  void trim_compacted_nodes_(const int64_t trim_version);
 private:
   bool is_inited_;
   ObMvccRow *row_;
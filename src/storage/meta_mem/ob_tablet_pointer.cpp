@@ -142,7 +142,7 @@ int ObTabletPointer::wash_obj()
   if (OB_FAIL(obj_.ptr_->inc_macro_disk_ref())) {
     LOG_WARN("fail to inc macro disk ref", K(ret), K(obj_));
   } else {
-    FLOG_INFO("succeed to wash one tablet", KP(obj_.ptr_), K(ls_id), K(tablet_id), K(wash_score));
+    LOG_DEBUG("succeed to wash one tablet", KP(obj_.ptr_), K(ls_id), K(tablet_id), K(wash_score));
     reset_obj();
   }
   return ret;
@@ -241,6 +241,18 @@ void ObTabletPointer::get_ddl_kv_mgr(ObDDLKvMgrHandle &ddl_kv_mgr_handle)
   ddl_kv_mgr_handle = ddl_kv_mgr_handle_;
 }
 
+bool ObTabletPointer::has_memory_data()
+{
+  bool bret = false;
+  if (memtable_mgr_handle_.is_valid() && memtable_mgr_handle_.get_memtable_mgr()->has_memtable()) {
+    bret = true;
+  } else {
+    ObMutexGuard guard(ddl_kv_mgr_lock_);
+    bret = ddl_kv_mgr_handle_.is_valid();
+  }
+  return bret;
+}
+
 void ObTabletPointer::remove_ddl_kv_mgr()
 {
   ObMutexGuard guard(ddl_kv_mgr_lock_);
@@ -59,6 +59,8 @@ public:
   int create_ddl_kv_mgr(const share::ObLSID &ls_id, const ObTabletID &tablet_id, ObDDLKvMgrHandle &ddl_kv_mgr_handle);
   void get_ddl_kv_mgr(ObDDLKvMgrHandle &ddl_kv_mgr_handle);
   void remove_ddl_kv_mgr();
+  // the memtables and the ddl kvs are kept by the pointer, they are checked without the tablet
+  bool has_memory_data();
 private:
   int wash_obj();
   virtual int do_post_work_for_load() override;
@@ -1217,6 +1217,54 @@ int ObTenantMetaMemMgr::has_tablet(const ObTabletMapKey &key, bool &is_exist)
   return ret;
 }
 
+int ObTenantMetaMemMgr::check_tablet_in_memory(const ObTabletMapKey &key, bool &is_in_memory)
+{
+  int ret = OB_SUCCESS;
+  ObTabletHandle handle;
+
+  is_in_memory = false;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("ObTenantMetaMemMgr hasn't been initialized", K(ret));
+  } else if (OB_UNLIKELY(!key.is_valid())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(key));
+  } else if (OB_FAIL(tablet_map_.try_get_in_memory_meta_obj(key, is_in_memory, handle))) {
+    if (OB_ENTRY_NOT_EXIST != ret) {
+      LOG_WARN("fail to try get in memory tablet", K(ret), K(key));
+    }
+  }
+  return ret;
+}
+
+int ObTenantMetaMemMgr::check_tablet_has_memory_data(const ObTabletMapKey &key, bool &has_memory_data)
+{
+  int ret = OB_SUCCESS;
+  ObTabletPointerHandle ptr_handle(tablet_map_);
+
+  has_memory_data = true;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("ObTenantMetaMemMgr hasn't been initialized", K(ret));
+  } else if (OB_UNLIKELY(!key.is_valid())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(key));
+  } else if (OB_FAIL(tablet_map_.get(key, ptr_handle))) {
+    if (OB_ENTRY_NOT_EXIST != ret) {
+      LOG_WARN("failed to get ptr handle", K(ret), K(key));
+    }
+  } else {
+    ObTabletPointer *tablet_ptr = static_cast<ObTabletPointer*>(ptr_handle.get_resource_ptr());
+    if (OB_ISNULL(tablet_ptr)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("tablet ptr is NULL", K(ret), K(ptr_handle));
+    } else {
+      has_memory_data = tablet_ptr->has_memory_data();
+    }
+  }
+  return ret;
+}
+
 int ObTenantMetaMemMgr::check_all_meta_mem_released(ObLSService &ls_service, bool &is_released,
     const char *module)
 {
@@ -1460,6 +1508,37 @@ int ObTenantMetaMemMgr::try_wash_tablet()
   return ret;
 }
 
+int ObTenantMetaMemMgr::wash_replayed_tablet(const ObTabletMapKey &key, bool &is_washed)
+{
+  int ret = OB_SUCCESS;
+  ObMetaDiskAddr addr;
+  is_washed = false;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init ObTenantMetaMemMgr", K(ret));
+  } else if (OB_UNLIKELY(!key.is_valid())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(key));
+  } else if (key.tablet_id_.is_inner_tablet()) {
+    // inner tablets are accessed on restart anyway, keep them in memory
+  } else if (OB_FAIL(tablet_map_.get_meta_addr(key, addr))) {
+    LOG_WARN("fail to get tablet addr", K(ret), K(key));
+  } else if (!addr.is_disked()) {
+    // only the tablet with disk address could be loaded again
+  } else {
+    int tmp_ret = pinned_tablet_set_.exist_refactored(key);
+    if (OB_HASH_EXIST == tmp_ret) {
+      LOG_DEBUG("tablet is in tx, should no be washed", K(tmp_ret), K(key));
+    } else if (OB_HASH_NOT_EXIST != tmp_ret) {
+      ret = tmp_ret;
+      LOG_WARN("failed to check whether tablet is in tx", K(ret), K(key));
+    } else if (OB_FAIL(tablet_map_.wash_meta_obj(key, is_washed))) {
+      LOG_WARN("fail to wash replayed tablet", K(ret), K(key));
+    }
+  }
+  return ret;
+}
+
 int64_t ObTenantMetaMemMgr::calc_wash_tablet_cnt() const
 {
   const int64_t used_tablet_cnt = tablet_pool_.get_used_obj_cnt();
@@ -1490,6 +1569,8 @@ int ObTenantMetaMemMgr::write_slog_and_wash_tablet(
     };
     if (OB_FAIL(tablet_map_.wash_meta_obj_with_func(key, old_addr, dump, is_wash))) {
       LOG_WARN("fail to wash meta object with function", K(ret), K(key), K(old_addr));
+    } else if (is_wash) {
+      FLOG_INFO("succeed to wash one tablet", K(key), K(old_addr));
     }
   }
   return ret;
@@ -1511,6 +1592,7 @@ int ObTenantMetaMemMgr::do_wash_candidate_tablet(
     if (OB_FAIL(tablet_map_.wash_meta_obj(key, is_wash))) {
       LOG_WARN("wash tablet obj fail", K(ret), K(candidate));
     } else if (is_wash) {
+      FLOG_INFO("succeed to wash one tablet", K(candidate));
       if (!key.tablet_id_.is_inner_tablet()) {
         ++wash_user_cnt;
       } else {
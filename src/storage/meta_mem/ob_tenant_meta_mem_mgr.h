@@ -164,6 +164,8 @@ public:
       ObTabletHandle &handle);
   int get_tablet_addr(const ObTabletMapKey &key, ObMetaDiskAddr &addr);
   int has_tablet(const ObTabletMapKey &key, bool &is_exist);
+  int check_tablet_in_memory(const ObTabletMapKey &key, bool &is_in_memory);
+  int check_tablet_has_memory_data(const ObTabletMapKey &key, bool &has_memory_data);
   int del_tablet(const ObTabletMapKey &key);
   int check_all_meta_mem_released(
       ObLSService &ls_service,
@@ -183,6 +185,11 @@ public:
       const ObMetaDiskAddr &old_addr,
       const ObMetaDiskAddr &new_addr);
   int try_wash_tablet();
+  // TIPS:
+  //  - only for lazy tablet load, the user tablet is released and loaded by its disk address
+  //    on next access. It is used for the tablets replayed on restart, and for the cold tablets
+  //    loaded by the ls tablet iterator.
+  int wash_replayed_tablet(const ObTabletMapKey &key, bool &is_washed);
   int get_meta_mem_status(common::ObIArray<ObTenantMetaMemStatus> &info) const;
 
   int get_tablet_pointer_tx_data(const ObTabletMapKey &key, ObTabletTxMultiSourceDataUnit &tx_data);
@@ -122,6 +122,8 @@ ObSSTableMergeInfo::ObSSTableMergeInfo()
       multiplexed_macro_block_count_(0),
       new_micro_count_in_new_macro_(0),
       multiplexed_micro_count_in_new_macro_(0),
+      multiplexed_macro_block_size_(0),
+      multiplexed_micro_size_in_new_macro_(0),
       total_row_count_(0),
       incremental_row_count_(0),
       new_flush_data_rate_(0),
@@ -163,6 +165,8 @@ int ObSSTableMergeInfo::add(const ObSSTableMergeInfo &other)
   incremental_row_count_ += other.incremental_row_count_;
   multiplexed_micro_count_in_new_macro_ += other.multiplexed_micro_count_in_new_macro_;
   new_micro_count_in_new_macro_ += other.new_micro_count_in_new_macro_;
+  multiplexed_macro_block_size_ += other.multiplexed_macro_block_size_;
+  multiplexed_micro_size_in_new_macro_ += other.multiplexed_micro_size_in_new_macro_;
 
   if (1 == concurrent_cnt_) {
     // do nothing
@@ -193,6 +197,8 @@ void ObSSTableMergeInfo::reset()
   multiplexed_macro_block_count_ = 0;
   new_micro_count_in_new_macro_ = 0;
   multiplexed_micro_count_in_new_macro_ = 0;
+  multiplexed_macro_block_size_ = 0;
+  multiplexed_micro_size_in_new_macro_ = 0;
   total_row_count_ = 0;
   incremental_row_count_ = 0;
   new_flush_data_rate_ = 0;
@@ -212,12 +218,25 @@ void ObSSTableMergeInfo::dump_info(const char *msg)
 {
   int64_t output_row_per_s = 0;
   int64_t new_macro_KB_per_s = 0;
+  const int64_t reused_size_pct = get_reused_size_pct();
   if (merge_finish_time_ > merge_start_time_) {
     const int64_t merge_cost_time = merge_finish_time_ - merge_start_time_;
     output_row_per_s = (incremental_row_count_ * 1000 * 1000) / merge_cost_time;
     new_macro_KB_per_s = (macro_block_count_ - multiplexed_macro_block_count_) * 2 * 1024 * 1000 * 1000 / merge_cost_time;
   }
-  FLOG_INFO("dump merge info", K(msg), K(output_row_per_s), K(new_macro_KB_per_s), K(*this));
+  FLOG_INFO("dump merge info", K(msg), K(output_row_per_s), K(new_macro_KB_per_s), K(reused_size_pct), K(*this));
+}
+
+int64_t ObSSTableMergeInfo::get_reused_size_pct() const
+{
+  int64_t reused_size_pct = 0;
+  // the reused micro blocks are copied into the new flushed macro blocks
+  const int64_t reused_size = multiplexed_macro_block_size_ + multiplexed_micro_size_in_new_macro_;
+  const int64_t total_size = multiplexed_macro_block_size_ + new_flush_occupy_size_;
+  if (total_size > 0) {
+    reused_size_pct = reused_size * 100 / total_size;
+  }
+  return reused_size_pct;
 }
 
 ObMergeChecksumInfo::ObMergeChecksumInfo()
@@ -115,12 +115,15 @@ public:
   int add(const ObSSTableMergeInfo &other);
   OB_INLINE bool is_major_merge() const { return storage::is_major_merge(merge_type_); }
   void dump_info(const char *msg);
+  // share of the reused bytes among all the bytes of the output sstable
+  int64_t get_reused_size_pct() const;
   void reset();
   TO_STRING_KV(K_(tenant_id), K_(ls_id), K_(tablet_id), K_(compaction_scn),
               "merge_type", merge_type_to_str(merge_type_), "merge_cost_time", merge_finish_time_ - merge_start_time_,
                K_(merge_start_time), K_(merge_finish_time), K_(dag_id), K_(occupy_size), K_(new_flush_occupy_size), K_(original_size),
                K_(compressed_size), K_(macro_block_count), K_(multiplexed_macro_block_count),
                K_(new_micro_count_in_new_macro), K_(multiplexed_micro_count_in_new_macro),
+               K_(multiplexed_macro_block_size), K_(multiplexed_micro_size_in_new_macro),
                K_(total_row_count), K_(incremental_row_count), K_(new_flush_data_rate),
                K_(is_full_merge), K_(progressive_merge_round), K_(progressive_merge_num),
                K_(concurrent_cnt), K_(parallel_merge_info), K_(filter_statistics), K_(participant_table_str),
@@ -142,6 +145,8 @@ public:
   int64_t multiplexed_macro_block_count_;
   int64_t new_micro_count_in_new_macro_;
   int64_t multiplexed_micro_count_in_new_macro_;
+  int64_t multiplexed_macro_block_size_; // occupy size of reused macro blocks
+  int64_t multiplexed_micro_size_in_new_macro_; // size of reused micro blocks copied into new macro blocks
   int64_t total_row_count_;
   int64_t incremental_row_count_;
   int64_t new_flush_data_rate_;
@@ -0,0 +1,88 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX STORAGE
+
+#include "storage/slog_ckpt/ob_parallel_replay_executor.h"
+#include "share/rc/ob_tenant_base.h"
+
+namespace oceanbase
+{
+using namespace common;
+namespace storage
+{
+
+ObParallelReplayExecutor::ObParallelReplayExecutor()
+  : func_(nullptr),
+    task_cnt_(0),
+    next_task_idx_(0),
+    ret_(OB_SUCCESS)
+{
+}
+
+ObParallelReplayExecutor::~ObParallelReplayExecutor()
+{
+  lib::ThreadPool::destroy();
+}
+
+int ObParallelReplayExecutor::execute(const int64_t thread_cnt, const int64_t task_cnt, TaskFunc &func)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(thread_cnt <= 0 || task_cnt < 0 || !func.is_valid())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(thread_cnt), K(task_cnt));
+  } else if (1 == thread_cnt || task_cnt <= 1) {
+    for (int64_t i = 0; OB_SUCC(ret) && i < task_cnt; ++i) {
+      if (OB_FAIL(func(i))) {
+        LOG_WARN("fail to run replay task", K(ret), K(i), K(task_cnt));
+      }
+    }
+  } else {
+    func_ = &func;
+    task_cnt_ = task_cnt;
+    next_task_idx_ = 0;
+    ret_ = OB_SUCCESS;
+    lib::ThreadPool::set_run_wrapper(MTL_CTX());
+    if (OB_FAIL(lib::ThreadPool::set_thread_count(MIN(thread_cnt, task_cnt)))) {
+      LOG_WARN("fail to set thread count", K(ret), K(thread_cnt), K(task_cnt));
+    } else if (OB_FAIL(lib::ThreadPool::start())) {
+      LOG_WARN("fail to start replay threads", K(ret), K(thread_cnt), K(task_cnt));
+      // the started threads stop picking tasks
+      ATOMIC_STORE(&ret_, ret);
+    }
+    // the threads exit after all the tasks are picked
+    lib::ThreadPool::wait();
+    lib::ThreadPool::destroy();
+    if (OB_SUCC(ret)) {
+      ret = ATOMIC_LOAD(&ret_);
+    }
+    func_ = nullptr;
+  }
+  return ret;
+}
+
+void ObParallelReplayExecutor::run1()
+{
+  int ret = OB_SUCCESS;
+  int64_t task_idx = 0;
+  lib::set_thread_name("ReplayExecutor");
+  while (OB_SUCC(ret) && OB_SUCCESS == ATOMIC_LOAD(&ret_)
+         && (task_idx = ATOMIC_FAA(&next_task_idx_, 1)) < task_cnt_) {
+    if (OB_FAIL((*func_)(task_idx))) {
+      LOG_WARN("fail to run replay task", K(ret), K(task_idx), K_(task_cnt));
+      ATOMIC_BCAS(&ret_, OB_SUCCESS, ret);
+    }
+  }
+}
+
+}  // end namespace storage
+}  // namespace oceanbase
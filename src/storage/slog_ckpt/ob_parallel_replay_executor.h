@@ -0,0 +1,52 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OB_STORAGE_CKPT_PARALLEL_REPLAY_EXECUTOR_H_
+#define OB_STORAGE_CKPT_PARALLEL_REPLAY_EXECUTOR_H_
+
+#include "lib/function/ob_function.h"
+#include "lib/thread/thread_pool.h"
+
+namespace oceanbase
+{
+namespace storage
+{
+
+/**
+ * @brief run the independent replay tasks of the startup by a few temporary threads and wait
+ *        for all of them. The tasks are picked in the order of their index, and no more task
+ *        is picked after one of them fails. The threads run in the tenant of the caller.
+ */
+class ObParallelReplayExecutor : public lib::ThreadPool
+{
+public:
+  static const int64_t DEFAULT_THREAD_CNT = 8;
+  typedef common::ObFunction<int(const int64_t task_idx)> TaskFunc;
+
+  ObParallelReplayExecutor();
+  virtual ~ObParallelReplayExecutor();
+  // the tasks are run by the current thread if there is only one thread or one task
+  int execute(const int64_t thread_cnt, const int64_t task_cnt, TaskFunc &func);
+  virtual void run1() override;
+
+private:
+  TaskFunc *func_;
+  int64_t task_cnt_;
+  int64_t next_task_idx_;
+  int ret_;
+  DISALLOW_COPY_AND_ASSIGN(ObParallelReplayExecutor);
+};
+
+}  // end namespace storage
+}  // namespace oceanbase
+
+#endif  // OB_STORAGE_CKPT_PARALLEL_REPLAY_EXECUTOR_H_
@@ -15,6 +15,7 @@
 #include "storage/slog_ckpt/ob_server_checkpoint_slog_handler.h"
 #include "storage/slog_ckpt/ob_server_checkpoint_reader.h"
 #include "storage/slog_ckpt/ob_server_checkpoint_writer.h"
+#include "storage/slog_ckpt/ob_parallel_replay_executor.h"
 #include "storage/ob_super_block_struct.h"
 #include "observer/ob_server_struct.h"
 #include "observer/omt/ob_multi_tenant.h"
@@ -94,6 +95,7 @@ int ObServerCheckpointSlogHandler::start()
   share::ObTenantSwitchGuard guard(&server_tenant_base);
 
   const ObServerSuperBlock &super_block = OB_SERVER_BLOCK_MGR.get_server_super_block();
+  ObTimeGuard time_guard("start_server_checkpoint_slog_handler");
   if (IS_NOT_INIT) {
     ret = OB_NOT_INIT;
     LOG_WARN("not init", K(ret));
@@ -102,10 +104,13 @@ int ObServerCheckpointSlogHandler::start()
     LOG_WARN("super block is invalid", K(ret), K(super_block));
   } else if (OB_FAIL(read_checkpoint(super_block))) {
     LOG_WARN("fail to read_checkpoint", K(ret));
+  } else if (FALSE_IT(time_guard.click("read_checkpoint"))) {
   } else if (OB_FAIL(replay_and_apply_server_slog(super_block.body_.replay_start_point_))) {
     LOG_WARN("fail to replay_sever_slog", K(ret));
+  } else if (FALSE_IT(time_guard.click("replay_slog_and_create_tenants"))) {
   } else if (OB_FAIL(OB_SERVER_BLOCK_MGR.first_mark_device())) { // mark must after finish replay slog
     LOG_WARN("fail to first mark device", K(ret));
+  } else if (FALSE_IT(time_guard.click("first_mark_device"))) {
   } else if(OB_FAIL(enable_replay_clog())) {
     LOG_WARN("fail to enable_replay_clog", K(ret));
   } else if (OB_FAIL(task_timer_.start())) { // start checkpoint task after finsh replay slog
@@ -114,6 +119,7 @@ int ObServerCheckpointSlogHandler::start()
     ATOMIC_STORE(&is_started_, true);
     LOG_INFO("succ to start server checkpoint slog handler");
   }
+  FLOG_INFO("finish start server checkpoint slog handler", K(ret), K(time_guard));
   return ret;
 }
 
@@ -660,6 +666,7 @@ int ObServerCheckpointSlogHandler::applay_replay_result()
 {
   int ret = OB_SUCCESS;
   int64_t tenant_count = tenant_meta_map_for_replay_.size();
+  ObArray<omt::ObTenantMeta> create_commit_tenants;
   for (TENANT_META_MAP::iterator iter = tenant_meta_map_for_replay_.begin();
       OB_SUCC(ret) && iter !=  tenant_meta_map_for_replay_.end(); iter++) {
     const omt::ObTenantMeta &tenant_meta = iter->second;
@@ -677,8 +684,9 @@ int ObServerCheckpointSlogHandler::applay_replay_result()
       }
 
       case omt::ObTenantCreateStatus::CREATE_COMMIT : {
-        if (OB_FAIL(handle_tenant_create_commit(tenant_meta))) {
-          LOG_ERROR("fail to handle tenant create commit", K(ret), K(tenant_meta));
+        // the tenants are independent, they are created in parallel below
+        if (OB_FAIL(create_commit_tenants.push_back(tenant_meta))) {
+          LOG_WARN("fail to push back tenant meta", K(ret), K(tenant_meta));
         }
         break;
       }
@@ -701,6 +709,25 @@ int ObServerCheckpointSlogHandler::applay_replay_result()
     }
   }
 
+  if (OB_SUCC(ret)) {
+    ObParallelReplayExecutor executor;
+    ObParallelReplayExecutor::TaskFunc create_tenant = [&](const int64_t task_idx) -> int {
+      int ret = OB_SUCCESS;
+      const omt::ObTenantMeta &tenant_meta = create_commit_tenants.at(task_idx);
+      const int64_t start_time = ObTimeUtility::current_time();
+      if (OB_FAIL(handle_tenant_create_commit(tenant_meta))) {
+        LOG_ERROR("fail to handle tenant create commit", K(ret), K(tenant_meta));
+      }
+      FLOG_INFO("finish replay create tenant", K(ret), "tenant_id", tenant_meta.super_block_.tenant_id_,
+          "cost_us", ObTimeUtility::current_time() - start_time);
+      return ret;
+    };
+    if (OB_FAIL(executor.execute(ObParallelReplayExecutor::DEFAULT_THREAD_CNT,
+        create_commit_tenants.count(), create_tenant))) {
+      LOG_ERROR("fail to create tenants", K(ret), "create_tenant_cnt", create_commit_tenants.count());
+    }
+  }
+
   if (OB_SUCC(ret) && 0 != tenant_count) {
     GCTX.omt_->set_synced();
   }
@@ -16,7 +16,9 @@
 #include "storage/slog_ckpt/ob_tenant_storage_checkpoint_reader.h"
 #include "storage/slog_ckpt/ob_tenant_storage_checkpoint_writer.h"
 #include "storage/slog_ckpt/ob_server_checkpoint_slog_handler.h"
+#include "storage/slog_ckpt/ob_parallel_replay_executor.h"
 #include "storage/meta_mem/ob_meta_obj_struct.h"
+#include "storage/meta_mem/ob_tenant_meta_mem_mgr.h"
 #include "storage/ob_super_block_struct.h"
 #include "storage/slog/ob_storage_log_replayer.h"
 #include "storage/slog/ob_storage_log.h"
@@ -25,6 +27,7 @@
 #include "storage/tx/ob_timestamp_service.h"
 #include "storage/tx/ob_trans_id_service.h"
 #include "observer/omt/ob_tenant.h"
+#include "observer/omt/ob_tenant_config_mgr.h"
 #include "storage/tx_storage/ob_ls_service.h"
 #include "storage/compaction/ob_tenant_tablet_scheduler.h"
 #include "observer/ob_server_event_history_table_operator.h"
@@ -152,6 +155,7 @@ int ObTenantCheckpointSlogHandler::replay_checkpoint_and_slog(const ObTenantSupe
   int ret = OB_SUCCESS;
   const ObMemAttr mem_attr(MTL_ID(), "TenantReplay");
   const int64_t replay_tablet_cnt = 10003;
+  ObTimeGuard time_guard("replay_tenant_checkpoint_and_slog");
   if (OB_UNLIKELY(!is_inited_)) {
     ret = OB_NOT_INIT;
     LOG_WARN("ObTenantCheckpointSlogHandler not init", K(ret));
@@ -159,13 +163,17 @@ int ObTenantCheckpointSlogHandler::replay_checkpoint_and_slog(const ObTenantSupe
     LOG_WARN("fail to create replay map", K(ret));
   } else if (OB_FAIL(replay_checkpoint(super_block))) {
     LOG_WARN("fail to read_ls_checkpoint", K(ret), K(super_block));
+  } else if (FALSE_IT(time_guard.click("replay_checkpoint"))) {
   } else if (OB_FAIL(replay_tenant_slog(super_block.replay_start_point_))) {
     LOG_WARN("fail to replay_tenant_slog", K(ret));
+  } else if (FALSE_IT(time_guard.click("replay_slog_and_load_tablets"))) {
   } else if (OB_FAIL(MTL(ObLSService*)->gc_ls_after_replay_slog())) {
     LOG_WARN("fail to gc ls after replay slog", K(ret));
   } else {
     replay_tablet_disk_addr_map_.destroy();
+    time_guard.click("gc_ls");
   }
+  FLOG_INFO("finish replay tenant checkpoint and slog", K(ret), K(time_guard));
   return ret;
 }
 
@@ -278,12 +286,13 @@ int ObTenantCheckpointSlogHandler::replay_tenant_slog(const common::ObLogCursor
 int ObTenantCheckpointSlogHandler::replay_load_tablets()
 {
   int ret = OB_SUCCESS;
-  const ObMemAttr mem_attr(MTL_ID(), "TenantReplay");
-  char *buf = nullptr;
-  int64_t buf_len = 0;
-  char *r_buf = nullptr;
-  int64_t r_len = 0;
+  omt::ObTenantConfigGuard tenant_config(TENANT_CONF(MTL_ID()));
+  const bool is_lazy_load = tenant_config.is_valid() && tenant_config->_enable_lazy_tablet_load;
+  int64_t washed_cnt = 0;
+  int64_t inner_tablet_cnt = 0;
+  ObTimeGuard time_guard("replay_load_tablets");
   ObArray<ObTabletMapKey> tablets;
+  ObArray<int64_t> ls_start_idxs; // the first user tablet of each ls in tablets
   ReplayTabletDiskAddrMap::iterator iter = replay_tablet_disk_addr_map_.begin();
   while (OB_SUCC(ret) && iter != replay_tablet_disk_addr_map_.end()) {
     const ObTabletMapKey &key = iter->first;
@@ -313,8 +322,59 @@ int ObTenantCheckpointSlogHandler::replay_load_tablets()
       }
       return ret;
     });
+    for (int64_t i = 0; OB_SUCC(ret) && i < tablets.count(); ++i) {
+      if (tablets.at(i).tablet_id_.is_inner_tablet()) {
+        inner_tablet_cnt = i + 1;
+      } else if (i == inner_tablet_cnt || tablets.at(i).ls_id_ != tablets.at(i - 1).ls_id_) {
+        if (OB_FAIL(ls_start_idxs.push_back(i))) {
+          LOG_WARN("fail to push back ls start idx", K(ret), K(i));
+        }
+      }
+    }
+    time_guard.click("sort");
+  }
+
+  // the inner tablets are loaded before all the user tablets
+  if (OB_FAIL(ret)) {
+  } else if (OB_FAIL(replay_load_tablets(tablets, 0, inner_tablet_cnt, is_lazy_load, washed_cnt))) {
+    LOG_WARN("fail to replay load inner tablets", K(ret), K(inner_tablet_cnt));
+  } else {
+    time_guard.click("load_inner");
+    // the user tablets of different ls are loaded in parallel, the ones of the same ls in order
+    ObParallelReplayExecutor executor;
+    ObParallelReplayExecutor::TaskFunc load_ls_tablets =
+        [&](const int64_t task_idx) -> int {
+      const int64_t start_idx = ls_start_idxs.at(task_idx);
+      const int64_t end_idx = task_idx + 1 < ls_start_idxs.count()
+          ? ls_start_idxs.at(task_idx + 1) : tablets.count();
+      return replay_load_tablets(tablets, start_idx, end_idx, is_lazy_load, washed_cnt);
+    };
+    if (OB_FAIL(executor.execute(ObParallelReplayExecutor::DEFAULT_THREAD_CNT,
+        ls_start_idxs.count(), load_ls_tablets))) {
+      LOG_WARN("fail to replay load user tablets", K(ret), "ls_cnt", ls_start_idxs.count());
+    }
+    time_guard.click("load_user");
   }
-  for (int64_t i = 0; OB_SUCC(ret) && i < tablets.count(); ++i) {
+  FLOG_INFO("finish replay load tablets", K(ret), "tablet_cnt", tablets.count(), K(inner_tablet_cnt),
+      "ls_cnt", ls_start_idxs.count(), K(is_lazy_load), K(washed_cnt), K(time_guard));
+  return ret;
+}
+
+int ObTenantCheckpointSlogHandler::replay_load_tablets(
+    const ObIArray<ObTabletMapKey> &tablets,
+    const int64_t start_idx,
+    const int64_t end_idx,
+    const bool is_lazy_load,
+    int64_t &washed_cnt)
+{
+  int ret = OB_SUCCESS;
+  const ObMemAttr mem_attr(MTL_ID(), "TenantReplay");
+  char *buf = nullptr;
+  int64_t buf_len = 0;
+  char *r_buf = nullptr;
+  int64_t r_len = 0;
+  ObTenantMetaMemMgr *t3m = MTL(ObTenantMetaMemMgr*);
+  for (int64_t i = start_idx; OB_SUCC(ret) && i < end_idx; ++i) {
     const ObTabletMapKey &map_key = tablets.at(i);
     ObMetaDiskAddr tablet_addr;
     ObLSTabletService *ls_tablet_svr = nullptr;
@@ -349,6 +409,14 @@ int ObTenantCheckpointSlogHandler::replay_load_tablets()
     } else if (OB_FAIL(ls_tablet_svr->replay_create_tablet(
         tablet_addr, r_buf, r_len, map_key.tablet_id_))) {
      LOG_WARN("fail to create tablet for replay", K(ret), K(map_key), K(tablet_addr));
+    } else if (is_lazy_load) {
+      // the tablet is loaded by its disk address again on first access
+      bool is_washed = false;
+      if (OB_FAIL(t3m->wash_replayed_tablet(map_key, is_washed))) {
+        LOG_WARN("fail to wash replayed tablet", K(ret), K(map_key), K(tablet_addr));
+      } else if (is_washed) {
+        ATOMIC_INC(&washed_cnt);
+      }
     }
     LOG_INFO("Successfully load tablet", K(map_key), K(tablet_addr));
   }
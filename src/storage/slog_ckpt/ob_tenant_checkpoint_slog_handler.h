@@ -86,6 +86,12 @@ private:
   int update_tablet_meta_addr_and_block_list(ObTenantStorageCheckpointWriter &ckpt_writer);
   int replay_tenant_slog(const common::ObLogCursor &start_point);
   int replay_load_tablets();
+  int replay_load_tablets(
+      const common::ObIArray<ObTabletMapKey> &tablets,
+      const int64_t start_idx,
+      const int64_t end_idx,
+      const bool is_lazy_load,
+      int64_t &washed_cnt);
 
   int inner_replay_update_ls_slog(const ObRedoModuleReplayParam &param);
   int inner_replay_create_ls_slog(const ObRedoModuleReplayParam &param);
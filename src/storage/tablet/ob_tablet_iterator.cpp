@@ -30,7 +30,10 @@ ObLSTabletIterator::ObLSTabletIterator(const int64_t timeout_us)
   : ls_tablet_service_(nullptr),
     tablet_ids_(),
     idx_(0),
-    timeout_us_(timeout_us)
+    timeout_us_(timeout_us),
+    keep_cold_tablet_washed_(false),
+    skip_idle_cold_tablet_(false),
+    cold_tablet_key_()
 {
 }
 
@@ -41,9 +44,12 @@ ObLSTabletIterator::~ObLSTabletIterator()
 
 void ObLSTabletIterator::reset()
 {
+  wash_cold_tablet();
   ls_tablet_service_ = nullptr;
   tablet_ids_.reset();
   idx_ = 0;
+  keep_cold_tablet_washed_ = false;
+  skip_idle_cold_tablet_ = false;
 }
 
 bool ObLSTabletIterator::is_valid() const
@@ -57,19 +63,46 @@ int ObLSTabletIterator::get_next_tablet(ObTabletHandle &handle)
   int ret = OB_SUCCESS;
 
   handle.reset();
+  wash_cold_tablet();
   if (OB_ISNULL(ls_tablet_service_)) {
     ret = OB_ERR_UNEXPECTED;
     LOG_WARN("ls tablet service is nullptr", K(ret), KP(ls_tablet_service_));
   } else {
+    ObTenantMetaMemMgr *t3m = MTL(ObTenantMetaMemMgr*);
+    ObTabletMapKey key;
+    key.ls_id_ = ls_tablet_service_->ls_->get_ls_id();
     do {
       if (OB_UNLIKELY(tablet_ids_.count() == idx_)) {
         ret = OB_ITER_END;
       } else {
         const common::ObTabletID &tablet_id = tablet_ids_.at(idx_);
-        if (OB_FAIL(ls_tablet_service_->get_tablet(tablet_id, handle, timeout_us_))
+        bool is_in_memory = true;
+        bool has_memory_data = true;
+        int tmp_ret = OB_SUCCESS;
+        key.tablet_id_ = tablet_id;
+        if (keep_cold_tablet_washed_ && OB_TMP_FAIL(t3m->check_tablet_in_memory(key, is_in_memory))) {
+          is_in_memory = true;
+          if (OB_ENTRY_NOT_EXIST != tmp_ret) {
+            LOG_WARN("fail to check tablet in memory", K(tmp_ret), K(key));
+          }
+        } else if (!is_in_memory && skip_idle_cold_tablet_
+            && OB_TMP_FAIL(t3m->check_tablet_has_memory_data(key, has_memory_data))) {
+          has_memory_data = true;
+          if (OB_ENTRY_NOT_EXIST != tmp_ret) {
+            LOG_WARN("fail to check tablet has memory data", K(tmp_ret), K(key));
+          }
+        }
+        if (!is_in_memory && !has_memory_data) {
+          // the cold tablet has nothing to do for the caller, it is not loaded
+          ret = OB_TABLET_NOT_EXIST;
+          ++idx_;
+        } else if (OB_FAIL(ls_tablet_service_->get_tablet(tablet_id, handle, timeout_us_))
             && OB_TABLET_NOT_EXIST != ret) {
           LOG_WARN("fail to get tablet", K(ret), K(idx_), K(tablet_id), K_(timeout_us));
         } else {
+          if (OB_SUCC(ret) && !is_in_memory) {
+            cold_tablet_key_ = key;
+          }
           handle.set_wash_priority(WashTabletPriority::WTP_LOW);
           ++idx_;
         }
@@ -80,6 +113,19 @@ int ObLSTabletIterator::get_next_tablet(ObTabletHandle &handle)
   return ret;
 }
 
+void ObLSTabletIterator::wash_cold_tablet()
+{
+  int tmp_ret = OB_SUCCESS;
+  bool is_washed = false;
+  if (cold_tablet_key_.is_valid()) {
+    // the tablet is still held by the caller if it isn't washed, it's released by the t3m later
+    if (OB_TMP_FAIL(MTL(ObTenantMetaMemMgr*)->wash_replayed_tablet(cold_tablet_key_, is_washed))) {
+      LOG_WARN("fail to wash cold tablet", K(tmp_ret), K_(cold_tablet_key));
+    }
+    cold_tablet_key_.reset();
+  }
+}
+
 // only for write_checkpoint
 int ObLSTabletIterator::get_next_tablet_addr(ObTabletMapKey &key, ObMetaDiskAddr &addr)
 {
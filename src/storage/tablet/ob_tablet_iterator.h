@@ -19,6 +19,7 @@
 #include "common/ob_tablet_id.h"
 #include "share/ob_ls_id.h"
 #include "storage/tablet/ob_tablet_common.h"
+#include "storage/meta_mem/ob_tablet_map_key.h"
 #include "storage/meta_mem/ob_tablet_pointer.h"
 
 namespace oceanbase
@@ -28,7 +29,6 @@ namespace storage
 struct ObMetaDiskAddr;
 class ObLSTabletService;
 class ObTabletHandle;
-class ObTabletMapKey;
 
 class ObLSTabletIterator final
 {
@@ -45,13 +45,24 @@ public:
 
   void reset();
   bool is_valid() const;
+  // for the scans only working on the data in memory, the cold tablets without memtable or
+  // ddl kv are skipped by get_next_tablet instead of being loaded, only with lazy tablet load.
+  void set_skip_idle_cold_tablet() { skip_idle_cold_tablet_ = true; }
 
-  TO_STRING_KV(KP_(ls_tablet_service), K_(tablet_ids), K_(idx), K_(timeout_us));
+  TO_STRING_KV(KP_(ls_tablet_service), K_(tablet_ids), K_(idx), K_(timeout_us),
+      K_(keep_cold_tablet_washed), K_(skip_idle_cold_tablet), K_(cold_tablet_key));
+private:
+  // the washed tablet loaded by get_next_tablet is washed again once the caller moves on,
+  // so that the background scans of the ls don't keep the cold tablets in memory.
+  void wash_cold_tablet();
 private:
   ObLSTabletService *ls_tablet_service_;
   common::ObSEArray<common::ObTabletID, ObTabletCommon::DEFAULT_ITERATOR_TABLET_ID_CNT> tablet_ids_;
   int64_t idx_;
   const int64_t timeout_us_;
+  bool keep_cold_tablet_washed_;
+  bool skip_idle_cold_tablet_;
+  ObTabletMapKey cold_tablet_key_;
 };
 
 class ObLSTabletIDIterator final
@@ -178,5 +178,91 @@ int ObGTSLocalCache::update_base_ts(const int64_t base_ts)
   return ret;
 }
 
+void ObGTSLease::reset()
+{
+  SpinWLockGuard guard(lock_);
+  srr_.reset();
+  gts_ = 0;
+  leader_epoch_ = 0;
+  expire_ts_.reset();
+  max_clock_skew_ns_ = 0;
+  last_issued_ts_ = 0;
+}
+
+void ObGTSLease::invalidate()
+{
+  SpinWLockGuard guard(lock_);
+  srr_.reset();
+  gts_ = 0;
+  expire_ts_.reset();
+}
+
+int ObGTSLease::renew(const MonotonicTs srr,
+                      const int64_t gts,
+                      const int64_t leader_epoch,
+                      const int64_t lease_duration_us,
+                      const int64_t max_clock_skew_ns)
+{
+  int ret = OB_SUCCESS;
+
+  if (OB_UNLIKELY(!srr.is_valid()) || OB_UNLIKELY(gts <= 0) || gts >= INT64_MAX/2
+      || OB_UNLIKELY(leader_epoch <= 0)
+      || OB_UNLIKELY(lease_duration_us < 0) || OB_UNLIKELY(max_clock_skew_ns < 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    TRANS_LOG(WARN, "invalid argument", KR(ret), K(srr), K(gts), K(leader_epoch),
+              K(lease_duration_us), K(max_clock_skew_ns));
+  } else {
+    SpinWLockGuard guard(lock_);
+    // the response of gts request may arrive out of order, only the newer one
+    // renews the lease, and the gts from a deposed leader never does
+    if (leader_epoch > leader_epoch_
+        || (leader_epoch == leader_epoch_ && srr > srr_)) {
+      srr_ = srr;
+      gts_ = gts;
+      leader_epoch_ = leader_epoch;
+      expire_ts_ = srr + MonotonicTs(lease_duration_us);
+      max_clock_skew_ns_ = max_clock_skew_ns;
+    }
+  }
+
+  return ret;
+}
+
+bool ObGTSLease::is_valid(const MonotonicTs now) const
+{
+  SpinRLockGuard guard(lock_);
+  return srr_.is_valid() && now >= srr_ && now < expire_ts_;
+}
+
+int ObGTSLease::get_ts(const MonotonicTs now, int64_t &ts)
+{
+  int ret = OB_SUCCESS;
+
+  if (OB_UNLIKELY(!now.is_valid())) {
+    ret = OB_INVALID_ARGUMENT;
+    TRANS_LOG(WARN, "invalid argument", KR(ret), K(now));
+  } else {
+    SpinRLockGuard guard(lock_);
+    if (!srr_.is_valid() || now < srr_ || now >= expire_ts_) {
+      ret = OB_EAGAIN;
+    } else {
+      const int64_t elapsed_ns = (now.mts_ - srr_.mts_) * 1000;
+      const int64_t upper_gts = gts_ + elapsed_ns + elapsed_ns / 1000000 * MAX_CLOCK_DRIFT_PPM
+                                + max_clock_skew_ns_;
+      // issue the timestamps monotonically
+      int64_t last_issued_ts = ATOMIC_LOAD(&last_issued_ts_);
+      int64_t issued_ts = 0;
+      do {
+        issued_ts = max(last_issued_ts + 1, upper_gts);
+      } while (last_issued_ts != (last_issued_ts = ATOMIC_VCAS(&last_issued_ts_,
+                                                              last_issued_ts,
+                                                              issued_ts)));
+      ts = issued_ts;
+    }
+  }
+
+  return ret;
+}
+
 } // transaction
 } // oceanbase
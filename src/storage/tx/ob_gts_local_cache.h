@@ -18,6 +18,7 @@
 #include "share/ob_errno.h"
 #include "lib/utility/ob_print_utils.h"
 #include "lib/utility/utility.h"
+#include "lib/lock/ob_spin_rwlock.h"
 
 namespace oceanbase
 {
@@ -61,6 +62,67 @@ private:
   MonotonicTs receive_gts_ts_;
 };
 
+// Timestamp lease issues timestamps locally after a gts is fetched from the gts
+// leader, so that acquiring a read snapshot need not wait for a gts round trip
+// while the lease is valid.
+//
+// The gts leader generates gts by its physical clock, hence the gts issued by
+// the leader at any moment t after the request is sent(srr) is no more than
+// gts + (t - srr) * (1 + MAX_CLOCK_DRIFT), given that the gts is generated
+// after srr. The lease issues max(last_issued + 1, that bound + max_clock_skew),
+// which is no less than any gts issued by the leader before, and any
+// transaction committed before gets a smaller commit version. The lease
+// expires after lease_duration since srr, so that the deviation is bounded.
+//
+// The bound does not hold across gts leader switch, since the new leader
+// resumes from the pre-allocated limited id of the old one, which may be far
+// ahead of the clock. So the lease is only renewed by the gts carrying the
+// epoch of the leader, and the new leader does not issue any gts until
+// lease_duration has passed since it takes over(see ObTimestampService), by
+// then all leases granted by the old leader have expired. The gts from an
+// older epoch never renews the lease.
+//
+// NB: the timestamps issued by lease are ahead of the gts leader, they can be
+// used as read snapshot but must not be used to update the gts local cache.
+class ObGTSLease
+{
+public:
+  // the max drift rate of clock, in parts per million
+  static const int64_t MAX_CLOCK_DRIFT_PPM = 1000;
+public:
+  ObGTSLease() { reset(); }
+  ~ObGTSLease() { destroy(); }
+  void reset();
+  void destroy() { reset(); }
+  // renew the lease with the gts fetched by the request sent at srr from the
+  // gts leader of leader_epoch
+  int renew(const MonotonicTs srr,
+            const int64_t gts,
+            const int64_t leader_epoch,
+            const int64_t lease_duration_us,
+            const int64_t max_clock_skew_ns);
+  // stop issuing timestamps until renewed again, the leader epoch and the
+  // issued timestamp are kept
+  void invalidate();
+  // issue a timestamp at now, OB_EAGAIN is returned if the lease is expired
+  int get_ts(const MonotonicTs now, int64_t &ts);
+  bool is_valid(const MonotonicTs now) const;
+
+  TO_STRING_KV(K_(srr), K_(gts), K_(leader_epoch), K_(expire_ts), K_(max_clock_skew_ns),
+               K_(last_issued_ts));
+private:
+  mutable common::SpinRWLock lock_;
+  // send rpc request timestamp of the gts
+  MonotonicTs srr_;
+  int64_t gts_;
+  // the epoch of the gts leader who issued the gts
+  int64_t leader_epoch_;
+  MonotonicTs expire_ts_;
+  int64_t max_clock_skew_ns_;
+  // the max timestamp issued by the lease
+  int64_t last_issued_ts_;
+};
+
 } // transaction
 } // oceanbase
 
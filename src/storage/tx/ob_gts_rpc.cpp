@@ -36,7 +36,7 @@ using namespace share;
 namespace obrpc
 {
 
-OB_SERIALIZE_MEMBER(ObGtsRpcResult, tenant_id_, status_, srr_.mts_, gts_start_, gts_end_);
+OB_SERIALIZE_MEMBER(ObGtsRpcResult, tenant_id_, status_, srr_.mts_, gts_start_, gts_end_, leader_epoch_);
 
 int ObGtsRpcResult::init(const uint64_t tenant_id, const int status,
     const MonotonicTs srr, const int64_t gts_start, const int64_t gts_end)
@@ -64,6 +64,7 @@ void ObGtsRpcResult::reset()
   srr_.reset();
   gts_start_ = 0;
   gts_end_ = 0;
+  leader_epoch_ = 0;
 }
 
 bool ObGtsRpcResult::is_valid() const
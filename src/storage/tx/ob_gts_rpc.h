@@ -58,9 +58,11 @@ public:
   transaction::MonotonicTs get_srr() const { return srr_; }
   int64_t get_gts_start() const { return gts_start_; }
   int64_t get_gts_end() const { return gts_end_; }
+  void set_leader_epoch(const int64_t leader_epoch) { leader_epoch_ = leader_epoch; }
+  int64_t get_leader_epoch() const { return leader_epoch_; }
   void reset();
   bool is_valid() const;
-  TO_STRING_KV(K_(tenant_id), K_(status), K_(srr), K_(gts_start), K_(gts_end));
+  TO_STRING_KV(K_(tenant_id), K_(status), K_(srr), K_(gts_start), K_(gts_end), K_(leader_epoch));
 public:
   static const int64_t OB_GTS_RPC_TIMEOUT = 1 * 1000 * 1000;
 private:
@@ -69,6 +71,9 @@ private:
   transaction::MonotonicTs srr_;
   int64_t gts_start_;
   int64_t gts_end_;
+  // the epoch of the gts leader, 0 if the gts can not be used to renew the
+  // gts lease(e.g. issued by the standby timestamp service)
+  int64_t leader_epoch_;
 };
 
 class ObGtsRpcProxy : public obrpc::ObRpcProxy
@@ -217,6 +222,7 @@ private:
         } else if (OB_FAIL(ts_mgr_->update_gts(result.get_tenant_id(),
                                                result.get_srr(),
                                                result.get_gts_start(),
+                                               result.get_leader_epoch(),
                                                transaction::TS_SOURCE_GTS,
                                                update))) {
         } else if (!update) {
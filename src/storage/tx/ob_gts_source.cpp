@@ -21,6 +21,7 @@
 #include "ob_timestamp_access.h"
 #include "ob_location_adapter.h"
 #include "share/ob_ls_id.h"
+#include "share/config/ob_server_config.h"
 
 namespace oceanbase
 {
@@ -41,6 +42,7 @@ void ObGtsStatistics::reset()
   try_get_gts_with_stc_cnt_ = 0;
   wait_gts_elapse_cnt_ = 0;
   try_wait_gts_elapse_cnt_ = 0;
+  get_gts_by_lease_cnt_ = 0;
 }
 
 int ObGtsStatistics::init(const uint64_t tenant_id)
@@ -67,7 +69,8 @@ void ObGtsStatistics::statistics()
                       "try_get_gts_cache_cnt", ATOMIC_LOAD(&try_get_gts_cache_cnt_),
                       "try_get_gts_with_stc_cnt", ATOMIC_LOAD(&try_get_gts_with_stc_cnt_),
                       "wait_gts_elapse_cnt", ATOMIC_LOAD(&wait_gts_elapse_cnt_),
-                      "try_wait_gts_elapse_cnt", ATOMIC_LOAD(&try_wait_gts_elapse_cnt_));
+                      "try_wait_gts_elapse_cnt", ATOMIC_LOAD(&try_wait_gts_elapse_cnt_),
+                      "get_gts_by_lease_cnt", ATOMIC_LOAD(&get_gts_by_lease_cnt_));
       ATOMIC_STORE(&gts_rpc_cnt_, 0);
       ATOMIC_STORE(&get_gts_cache_cnt_, 0);
       ATOMIC_STORE(&get_gts_with_stc_cnt_, 0);
@@ -75,6 +78,7 @@ void ObGtsStatistics::statistics()
       ATOMIC_STORE(&try_get_gts_with_stc_cnt_, 0);
       ATOMIC_STORE(&wait_gts_elapse_cnt_, 0);
       ATOMIC_STORE(&try_wait_gts_elapse_cnt_, 0);
+      ATOMIC_STORE(&get_gts_by_lease_cnt_, 0);
     }
   }
 
@@ -86,6 +90,7 @@ void ObGtsSource::reset()
   is_inited_ = false;
   tenant_id_ = 0;
   gts_local_cache_.reset();
+  gts_lease_.reset();
   server_.reset();
   gts_request_rpc_ = NULL;
   location_adapter_ = NULL;
@@ -195,6 +200,24 @@ int ObGtsSource::get_gts(const MonotonicTs stc,
                          ObTsCbTask *task,
                          int64_t &gts,
                          MonotonicTs &receive_gts_ts)
+{
+  const bool is_read_snapshot = false;
+  return get_gts_(stc, task, is_read_snapshot, gts, receive_gts_ts);
+}
+
+int ObGtsSource::get_read_snapshot(const MonotonicTs stc,
+                                   int64_t &snapshot,
+                                   MonotonicTs &receive_gts_ts)
+{
+  const bool is_read_snapshot = true;
+  return get_gts_(stc, NULL, is_read_snapshot, snapshot, receive_gts_ts);
+}
+
+int ObGtsSource::get_gts_(const MonotonicTs stc,
+                          ObTsCbTask *task,
+                          const bool is_read_snapshot,
+                          int64_t &gts,
+                          MonotonicTs &receive_gts_ts)
 {
   int ret = OB_SUCCESS;
   int tmp_ret = OB_SUCCESS;
@@ -250,6 +273,18 @@ int ObGtsSource::get_gts(const MonotonicTs stc,
         }
       }
       TRANS_LOG(DEBUG, "after query gts", KR(tmp_ret), K(leader), K(need_send_rpc));
+      // Only the read snapshot uses the timestamp issued by the lease instead
+      // of waiting for the gts round trip, all other callers(commit version,
+      // snapshot validation, etc.) still get the gts from the gts leader.
+      if (is_read_snapshot && GCONF._gts_lease_duration > 0) {
+        const MonotonicTs now = MonotonicTs::current_time();
+        if (OB_SUCCESS == (tmp_ret = gts_lease_.get_ts(now, tmp_gts))) {
+          gts = tmp_gts;
+          receive_gts_ts = now;
+          ret = OB_SUCCESS;
+          gts_statistics_.inc_get_gts_by_lease_cnt();
+        }
+      }
     }
     // If ret is not OB_SUCCESS, it means that an asynchronous task needs to be added to wait for the subsequent gts value
     if (OB_FAIL(ret) && NULL != task) {
@@ -648,6 +683,22 @@ int ObGtsSource::refresh_gts_(const bool need_refresh)
   return ret;
 }
 
+void ObGtsSource::renew_gts_lease_(const MonotonicTs srr, const int64_t gts, const int64_t leader_epoch)
+{
+  int tmp_ret = OB_SUCCESS;
+  const int64_t lease_duration_us = GCONF._gts_lease_duration;
+  const int64_t max_clock_skew_ns = GCONF._gts_lease_max_clock_skew * 1000;
+  if (0 >= lease_duration_us) {
+    // lease is disabled
+  } else if (0 >= leader_epoch) {
+    // the gts leader does not guarantee the lease across leader switch
+  } else if (OB_SUCCESS != (tmp_ret = gts_lease_.renew(srr, gts, leader_epoch, lease_duration_us,
+                                                       max_clock_skew_ns))) {
+    TRANS_LOG(WARN, "renew gts lease failed", K(tmp_ret), K(srr), K(gts), K(leader_epoch),
+              K(lease_duration_us));
+  }
+}
+
 void ObGtsSource::statistics_()
 {
   gts_statistics_.statistics();
@@ -655,6 +706,7 @@ void ObGtsSource::statistics_()
 
 int ObGtsSource::update_gts(const MonotonicTs srr,
                             const int64_t gts,
+                            const int64_t leader_epoch,
                             const MonotonicTs receive_gts_ts,
                             bool &update)
 {
@@ -670,6 +722,7 @@ int ObGtsSource::update_gts(const MonotonicTs srr,
     TRANS_LOG(WARN, "gts local cache update error", KR(ret), K(srr), K(gts),
               K(receive_gts_ts), K(update));
   } else {
+    renew_gts_lease_(srr, gts, leader_epoch);
     TRANS_LOG(DEBUG, "gts local cache update success", K(srr), K(gts));
   }
 
@@ -730,6 +783,9 @@ int ObGtsSource::handle_gts_err_response(const ObGtsErrResponse &err_msg)
     TRANS_LOG(WARN, "invalid argument", KR(ret), K(err_msg));
   } else {
     if (OB_NOT_MASTER == err_msg.get_status()) {
+      // the gts leader may be switched, stop issuing timestamps by the lease
+      // until the gts is fetched from the new leader
+      gts_lease_.invalidate();
       gts_cache_leader_.reset();
       refresh_gts_location_();
     }
@@ -51,6 +51,7 @@ public:
   void inc_try_get_gts_with_stc_cnt() { ATOMIC_INC(&try_get_gts_with_stc_cnt_); }
   void inc_wait_gts_elapse_cnt() { ATOMIC_INC(&wait_gts_elapse_cnt_); }
   void inc_try_wait_gts_elapse_cnt() { ATOMIC_INC(&try_wait_gts_elapse_cnt_); }
+  void inc_get_gts_by_lease_cnt() { ATOMIC_INC(&get_gts_by_lease_cnt_); }
   void statistics();
 private:
   uint64_t tenant_id_;
@@ -64,6 +65,7 @@ private:
 
   int64_t wait_gts_elapse_cnt_;
   int64_t try_wait_gts_elapse_cnt_;
+  int64_t get_gts_by_lease_cnt_;
 };
 
 class ObGtsSource : public ObITsSource
@@ -78,7 +80,8 @@ public:
   uint64_t get_tenant_id() const { return tenant_id_; }
   int handle_gts_err_response(const ObGtsErrResponse &msg);
   int handle_gts_result(const uint64_t tenant_id, const int64_t queue_index);
-  int update_gts(const MonotonicTs srr, const int64_t gts, const MonotonicTs receive_gts_ts, bool &update);
+  int update_gts(const MonotonicTs srr, const int64_t gts, const int64_t leader_epoch,
+                 const MonotonicTs receive_gts_ts, bool &update);
   int get_srr(MonotonicTs &srr);
   int get_latest_srr(MonotonicTs &latest_srr);
   int64_t get_task_count() const;
@@ -87,6 +90,7 @@ public:
   int update_gts(const int64_t gts, bool &update);
   int get_gts(const MonotonicTs stc, ObTsCbTask *task, int64_t &gts, MonotonicTs &receive_gts_ts);
   int get_gts(ObTsCbTask *task, int64_t &gts);
+  int get_read_snapshot(const MonotonicTs stc, int64_t &snapshot, MonotonicTs &receive_gts_ts);
   int wait_gts_elapse(const int64_t ts, ObTsCbTask *task, bool &need_wait);
   int wait_gts_elapse(const int64_t ts);
   int refresh_gts(const bool need_refresh);
@@ -94,7 +98,7 @@ public:
   int get_base_ts(int64_t &base_ts);
   bool is_external_consistent() { return true; }
   int refresh_gts_location() { return refresh_gts_location_(); }
-  TO_STRING_KV(K_(tenant_id), K_(gts_local_cache), K_(server), K_(gts_cache_leader));
+  TO_STRING_KV(K_(tenant_id), K_(gts_local_cache), K_(gts_lease), K_(server), K_(gts_cache_leader));
 private:
   int get_gts_leader_(common::ObAddr &leader);
   int refresh_gts_location_();
@@ -106,6 +110,12 @@ private:
                                             MonotonicTs &receive_gts_ts);
   int get_gts_from_local_timestamp_service_(common::ObAddr &leader,
                                             int64_t &gts);
+  int get_gts_(const MonotonicTs stc,
+               ObTsCbTask *task,
+               const bool is_read_snapshot,
+               int64_t &gts,
+               MonotonicTs &receive_gts_ts);
+  void renew_gts_lease_(const MonotonicTs srr, const int64_t gts, const int64_t leader_epoch);
 public:
   static const int64_t GET_GTS_QUEUE_COUNT = 1;
   static const int64_t WAIT_GTS_QUEUE_COUNT = 1;
@@ -115,6 +125,7 @@ private:
   bool is_inited_;
   int64_t tenant_id_;
   ObGTSLocalCache gts_local_cache_;
+  ObGTSLease gts_lease_;
   ObGTSTaskQueue queue_[TOTAL_GTS_QUEUE_COUNT];
   common::ObAddr server_;
   ObIGtsRequestRpc *gts_request_rpc_;
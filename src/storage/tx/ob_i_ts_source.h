@@ -60,6 +60,7 @@ public:
   virtual int update_gts(const int64_t gts, bool &update) = 0;
   virtual int get_gts(const MonotonicTs stc, ObTsCbTask *task, int64_t &gts, MonotonicTs &receive_gts_ts) = 0;
   virtual int get_gts(ObTsCbTask *task, int64_t &gts) = 0;
+  virtual int get_read_snapshot(const MonotonicTs stc, int64_t &snapshot, MonotonicTs &receive_gts_ts) = 0;
   virtual int wait_gts_elapse(const int64_t gts, ObTsCbTask *task, bool &need_wait) = 0;
   virtual int wait_gts_elapse(const int64_t gts) = 0;
   virtual int refresh_gts(const bool need_refresh) = 0;
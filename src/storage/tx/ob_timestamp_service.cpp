@@ -16,6 +16,8 @@
 #include "observer/ob_server_struct.h"
 #include "observer/ob_srv_network_frame.h"
 #include "ob_timestamp_access.h"
+#include "ob_gts_local_cache.h"
+#include "share/config/ob_server_config.h"
 #include "storage/tx_storage/ob_ls_map.h"
 #include "storage/tx_storage/ob_ls_service.h"
 
@@ -64,12 +66,11 @@ int ObTimestampService::handle_request(const ObGtsRequest &request, ObGtsRpcResu
     const MonotonicTs srr = request.get_srr();
     const uint64_t tenant_id = request.get_tenant_id();
     const ObAddr &requester = request.get_sender();
-    int64_t end_id = 0;
     if (requester == self_) {
      // Go local call to get gts
      TRANS_LOG(DEBUG, "handle local gts request", K(requester));
      ret = handle_local_request_(request, result);
-    } else if (OB_FAIL(get_number(1, ObTimeUtility::current_time_ns(), gts, end_id))) {
+    } else if (OB_FAIL(get_timestamp(ObTimeUtility::current_time_ns(), gts))) {
       if (EXECUTE_COUNT_PER_SEC(10)) {
         TRANS_LOG(WARN, "get timestamp failed", KR(ret));
       }
@@ -87,6 +88,8 @@ int ObTimestampService::handle_request(const ObGtsRequest &request, ObGtsRpcResu
     } else {
       if (OB_FAIL(result.init(tenant_id, ret, srr, gts, gts))) {
         TRANS_LOG(WARN, "gts result init failed", KR(ret), K(request));
+      } else {
+        result.set_leader_epoch(ATOMIC_LOAD(&leader_epoch_));
       }
     }
   }
@@ -118,8 +121,7 @@ int ObTimestampService::handle_local_request_(const ObGtsRequest &request, obrpc
   int64_t gts = 0;
   const uint64_t tenant_id = request.get_tenant_id();
   const MonotonicTs srr = request.get_srr();
-  int64_t end_id = 0;
-  if (OB_FAIL(get_number(1, ObTimeUtility::current_time_ns(), gts, end_id))) {
+  if (OB_FAIL(get_timestamp(ObTimeUtility::current_time_ns(), gts))) {
     if (EXECUTE_COUNT_PER_SEC(10)) {
       TRANS_LOG(WARN, "get timestamp failed", KR(ret));
     }
@@ -130,7 +132,25 @@ int ObTimestampService::handle_local_request_(const ObGtsRequest &request, obrpc
   } else {
     if (OB_FAIL(result.init(tenant_id, ret, srr, gts, gts))) {
       TRANS_LOG(WARN, "local gts result init failed", KR(ret), K(request));
+    } else {
+      result.set_leader_epoch(ATOMIC_LOAD(&leader_epoch_));
+    }
+  }
+  return ret;
+}
+
+int ObTimestampService::get_timestamp(const int64_t base_id, int64_t &gts)
+{
+  int ret = OB_SUCCESS;
+  int64_t unused_id = 0;
+  if (ObTimeUtility::current_time() < ATOMIC_LOAD(&gts_lease_wait_ts_)) {
+    ret = OB_EAGAIN;
+    if (EXECUTE_COUNT_PER_SEC(10)) {
+      TRANS_LOG(INFO, "wait for the gts leases of previous leader to expire", K(ret),
+                K_(gts_lease_wait_ts));
     }
+  } else {
+    ret = get_number(1, base_id, gts, unused_id);
   }
   return ret;
 }
@@ -170,9 +190,22 @@ int ObTimestampService::switch_to_leader()
     TRANS_LOG(WARN, "ls set fail", K(ret));
   } else {
     int64_t version = 0;
+    common::ObRole role = common::ObRole::INVALID_ROLE;
+    int64_t proposal_id = 0;
     if (OB_FAIL(ls_->get_log_handler()->get_max_ts_ns(version))) {
       TRANS_LOG(WARN, "get max ts fail", K(ret));
+    } else if (OB_FAIL(ls_->get_log_handler()->get_role(role, proposal_id))) {
+      TRANS_LOG(WARN, "get ls role fail", K(ret));
     } else {
+      // the gts leases granted by the previous leader last for at most
+      // _gts_lease_duration of the requester's clock
+      const int64_t lease_duration_us = GCONF._gts_lease_duration;
+      if (lease_duration_us > 0) {
+        ATOMIC_STORE(&gts_lease_wait_ts_, ObTimeUtility::current_time() + lease_duration_us
+                     + lease_duration_us / 1000000 * ObGTSLease::MAX_CLOCK_DRIFT_PPM
+                     + GCONF._gts_lease_max_clock_skew);
+      }
+      ATOMIC_STORE(&leader_epoch_, proposal_id);
       if (version >= ATOMIC_LOAD(&limited_id_)) {
         inc_update(&last_id_, version);
         ATOMIC_STORE(&tmp_last_id_, 0);
@@ -188,7 +221,8 @@ int ObTimestampService::switch_to_leader()
         TRANS_LOG(ERROR, "snapshot rolls back", K(standby_last_id), K(tmp_last_id), "limit_id", ATOMIC_LOAD(&limited_id_));
       }
       MTL(ObTimestampAccess *)->set_service_type(ObTimestampAccess::ServiceType::GTS_LEADER);
-      TRANS_LOG(INFO, "ObTimestampService switch to leader success", K(ret), K(version), K(last_id_), "service_type", MTL(ObTimestampAccess *)->get_service_type());
+      TRANS_LOG(INFO, "ObTimestampService switch to leader success", K(ret), K(version), K(last_id_),
+                K_(leader_epoch), K_(gts_lease_wait_ts), "service_type", MTL(ObTimestampAccess *)->get_service_type());
     }
   }
 
@@ -40,7 +40,7 @@ class ObGtsRequest;
 class ObTimestampService : public ObIDService
 {
 public:
-  ObTimestampService() {}
+  ObTimestampService() : leader_epoch_(0), gts_lease_wait_ts_(0) {}
   ~ObTimestampService() {}
   int init(rpc::frame::ObReqTransport *req_transport);
   static int mtl_init(ObTimestampService *&timestamp_service);
@@ -55,6 +55,8 @@ public:
   // nano second
   static const int64_t TIMESTAMP_PREALLOCATED_RANGE = palf::election::MAX_LEASE_TIME * 1000;
   int handle_request(const ObGtsRequest &request, obrpc::ObGtsRpcResult &result);
+  // get a gts not smaller than base_id as the gts leader
+  int get_timestamp(const int64_t base_id, int64_t &gts);
   int switch_to_follower_gracefully();
   void switch_to_follower_forcedly();
   int resume_leader();
@@ -62,6 +64,13 @@ public:
   int64_t get_limited_id() const { return limited_id_; }
 private:
   ObGtsResponseRpc rpc_;
+  // the proposal id of the ls when taking over, carried by the gts responses
+  // so that the gts lease of requesters can tell the leaders apart
+  int64_t leader_epoch_;
+  // the new leader resumes from the limited id of the previous one, which may
+  // be far ahead of the clock, so it issues no gts until the gts leases granted
+  // by the previous leader have expired
+  int64_t gts_lease_wait_ts_;
   int handle_local_request_(const ObGtsRequest &request, obrpc::ObGtsRpcResult &result);
 };
 
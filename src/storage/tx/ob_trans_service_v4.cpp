@@ -1448,7 +1448,7 @@ int ObTransService::acquire_global_snapshot__(const int64_t expire_ts,
     MonotonicTs rts(0);
     if (n >= expire_ts) {
       ret = OB_TIMEOUT;
-    } else if (OB_FAIL(ts_mgr_->get_gts(tenant_id_, now, NULL, snapshot, rts))) {
+    } else if (OB_FAIL(ts_mgr_->get_read_snapshot(tenant_id_, now, snapshot, rts))) {
       if (OB_EAGAIN == ret) {
         if (interrupt_checker()) {
           ret = OB_ERR_INTERRUPTED;
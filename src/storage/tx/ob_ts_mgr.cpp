@@ -545,6 +545,7 @@ int ObTsMgr::handle_gts_result(const uint64_t tenant_id, const int64_t queue_ind
 int ObTsMgr::update_gts(const uint64_t tenant_id,
                         const MonotonicTs srr,
                         const int64_t gts,
+                        const int64_t leader_epoch,
                         const int ts_type,
                         bool &update)
 {
@@ -580,8 +581,9 @@ int ObTsMgr::update_gts(const uint64_t tenant_id,
       if (OB_ISNULL(gts_source = ts_source_info->get_gts_source())) {
         ret = OB_ERR_UNEXPECTED;
         TRANS_LOG(WARN, "gts source is NULL", KR(ret), K(tenant_id));
-      } else if (OB_FAIL(gts_source->update_gts(srr, gts, receive_gts_ts, update))) {
-        TRANS_LOG(WARN, "update gts cache failed", KR(ret), K(tenant_id), K(srr), K(gts));
+      } else if (OB_FAIL(gts_source->update_gts(srr, gts, leader_epoch, receive_gts_ts, update))) {
+        TRANS_LOG(WARN, "update gts cache failed", KR(ret), K(tenant_id), K(srr), K(gts),
+                  K(leader_epoch));
       } else {
         // do nothing
       }
@@ -775,6 +777,26 @@ int ObTsMgr::get_gts(const uint64_t tenant_id,
                      ObTsCbTask *task,
                      int64_t &gts,
                      MonotonicTs &receive_gts_ts)
+{
+  const bool is_read_snapshot = false;
+  return get_gts_(tenant_id, stc, task, is_read_snapshot, gts, receive_gts_ts);
+}
+
+int ObTsMgr::get_read_snapshot(const uint64_t tenant_id,
+                               const MonotonicTs stc,
+                               int64_t &snapshot,
+                               MonotonicTs &receive_gts_ts)
+{
+  const bool is_read_snapshot = true;
+  return get_gts_(tenant_id, stc, NULL, is_read_snapshot, snapshot, receive_gts_ts);
+}
+
+int ObTsMgr::get_gts_(const uint64_t tenant_id,
+                      const MonotonicTs stc,
+                      ObTsCbTask *task,
+                      const bool is_read_snapshot,
+                      int64_t &gts,
+                      MonotonicTs &receive_gts_ts)
 {
   int ret = OB_SUCCESS;
 
@@ -805,6 +827,14 @@ int ObTsMgr::get_gts(const uint64_t tenant_id,
         if (OB_ISNULL(ts_source = source_guard.get_ts_source())) {
           ret = OB_ERR_UNEXPECTED;
           TRANS_LOG(WARN, "ts source is NULL", K(ret));
+        } else if (is_read_snapshot) {
+          if (OB_FAIL(ts_source->get_read_snapshot(stc, gts, receive_gts_ts))) {
+            if (OB_EAGAIN != ret) {
+              TRANS_LOG(WARN, "get read snapshot error", K(ret), K(tenant_id), K(stc));
+            }
+          } else {
+            break;
+          }
         } else if (OB_FAIL(ts_source->get_gts(stc, task, gts, receive_gts_ts))) {
           if (OB_EAGAIN != ret) {
             TRANS_LOG(WARN, "get gts error", K(ret), K(tenant_id), K(stc), KP(task));
@@ -87,6 +87,12 @@ public:
                       int64_t &gts,
                       MonotonicTs &receive_gts_ts) = 0;
   virtual int get_gts(const uint64_t tenant_id, ObTsCbTask *task, int64_t &gts) = 0;
+  // get a timestamp which is only used as read snapshot, it may be issued by
+  // the gts lease without waiting for the gts leader
+  virtual int get_read_snapshot(const uint64_t tenant_id,
+                                const MonotonicTs stc,
+                                int64_t &snapshot,
+                                MonotonicTs &receive_gts_ts) = 0;
   virtual int get_ts_sync(const uint64_t tenant_id, const int64_t timeout_ts,
       int64_t &ts, bool &is_external_consistent) = 0;
   /*
@@ -341,7 +347,8 @@ public:
 
   int handle_gts_err_response(const ObGtsErrResponse &msg);
   int handle_gts_result(const uint64_t tenant_id, const int64_t queue_index, const int ts_type);
-  int update_gts(const uint64_t tenant_id, const MonotonicTs srr, const int64_t gts, const int ts_type, bool &update);
+  int update_gts(const uint64_t tenant_id, const MonotonicTs srr, const int64_t gts,
+                 const int64_t leader_epoch, const int ts_type, bool &update);
   int delete_tenant(const uint64_t tenant_id);
 public:
   int update_gts(const uint64_t tenant_id, const int64_t gts, bool &update);
@@ -358,6 +365,10 @@ public:
   //1. 如果task == NULL，说明调用者不需要异步回调，直接返回报错，由调用者处理
   //2. 如果task != NULL，需要注册异步回调任务
   int get_gts(const uint64_t tenant_id, ObTsCbTask *task, int64_t &gts);
+  int get_read_snapshot(const uint64_t tenant_id,
+                        const MonotonicTs stc,
+                        int64_t &snapshot,
+                        MonotonicTs &receive_gts_ts);
   int get_ts_sync(const uint64_t tenant_id, const int64_t timeout_ts,
       int64_t &ts, bool &is_external_consistent);
   /*
@@ -387,6 +398,12 @@ private:
   static const int64_t TS_SOURCE_INFO_OBSOLETE_TIME = 120 * 1000 * 1000;
   static const int64_t TS_SOURCE_INFO_CACHE_NUM = 4096;
 private:
+  int get_gts_(const uint64_t tenant_id,
+               const MonotonicTs stc,
+               ObTsCbTask *task,
+               const bool is_read_snapshot,
+               int64_t &gts,
+               MonotonicTs &receive_gts_ts);
   int get_ts_source_info_opt_(const uint64_t tenant_id, ObTsSourceInfoGuard &guard,
       const bool need_create_tenant, const bool need_update_access_ts);
   int get_ts_source_info_(const uint64_t tenant_id, ObTsSourceInfoGuard &guard,
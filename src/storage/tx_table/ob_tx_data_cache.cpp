@@ -0,0 +1,145 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include "storage/tx_table/ob_tx_data_cache.h"
+#include "lib/allocator/ob_malloc.h"
+#include "lib/atomic/ob_atomic.h"
+
+namespace oceanbase
+{
+namespace storage
+{
+using namespace oceanbase::transaction;
+
+int ObTxDataLookupCache::init(const ObMemAttr &mem_attr)
+{
+  int ret = OB_SUCCESS;
+  STATIC_ASSERT(0 == (SLOT_CNT & (SLOT_CNT - 1)), "slot count should be power of 2");
+  void *buf = nullptr;
+  if (OB_NOT_NULL(slots_)) {
+    ret = OB_INIT_TWICE;
+    STORAGE_LOG(WARN, "tx data lookup cache init twice", KR(ret));
+  } else if (OB_ISNULL(buf = ob_malloc(sizeof(Slot) * SLOT_CNT, mem_attr))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    STORAGE_LOG(WARN, "alloc tx data lookup cache failed", KR(ret));
+  } else {
+    // tx id 0 is invalid, so the zeroed slots never hit
+    MEMSET(buf, 0, sizeof(Slot) * SLOT_CNT);
+    slots_ = static_cast<Slot *>(buf);
+  }
+  return ret;
+}
+
+void ObTxDataLookupCache::destroy()
+{
+  if (OB_NOT_NULL(slots_)) {
+    ob_free(slots_);
+    slots_ = nullptr;
+  }
+}
+
+void ObTxDataLookupCache::clear()
+{
+  if (OB_NOT_NULL(slots_)) {
+    for (int64_t i = 0; i < SLOT_CNT; i++) {
+      Slot &slot = slots_[i];
+      int64_t seq = ATOMIC_LOAD(&slot.seq_);
+      // wait for the concurrent writer, clear is only called when the tx data
+      // table goes offline, which is rare
+      while ((seq & 1) || !ATOMIC_BCAS(&slot.seq_, seq, seq + 1)) {
+        PAUSE();
+        seq = ATOMIC_LOAD(&slot.seq_);
+      }
+      slot.commit_data_.tx_id_ = ObTransID();
+      slot.is_not_exist_ = false;
+      ATOMIC_STORE(&slot.seq_, seq + 2);
+    }
+  }
+}
+
+int ObTxDataLookupCache::get(const ObTransID tx_id,
+                             const int64_t memtable_head,
+                             const int64_t memtable_tail,
+                             ObTxCommitData &commit_data,
+                             bool &is_not_exist) const
+{
+  int ret = OB_ENTRY_NOT_EXIST;
+  is_not_exist = false;
+  if (OB_NOT_NULL(slots_) && tx_id.is_valid()) {
+    const Slot &slot = get_slot_(tx_id);
+    const int64_t seq = ATOMIC_LOAD(&slot.seq_);
+    if (0 == (seq & 1)) {
+      const ObTxCommitData tmp_data = slot.commit_data_;
+      const bool tmp_not_exist = slot.is_not_exist_;
+      const int64_t tmp_head = slot.memtable_head_;
+      const int64_t tmp_tail = slot.memtable_tail_;
+      MEM_BARRIER();
+      if (seq != ATOMIC_LOAD(&slot.seq_) || tmp_data.tx_id_ != tx_id) {
+        // overwritten or being written
+      } else if (!tmp_not_exist) {
+        commit_data = tmp_data;
+        ret = OB_SUCCESS;
+      } else if (tmp_head == memtable_head && tmp_tail == memtable_tail) {
+        is_not_exist = true;
+        ret = OB_SUCCESS;
+      } else {
+        // the memtables have been changed, the tx data may be in sstable now
+      }
+    }
+  }
+  return ret;
+}
+
+void ObTxDataLookupCache::put(const ObTxData &tx_data)
+{
+  if (OB_NOT_NULL(slots_)
+      && tx_data.tx_id_.is_valid()
+      && (ObTxData::COMMIT == tx_data.state_ || ObTxData::ABORT == tx_data.state_)
+      && OB_ISNULL(tx_data.undo_status_list_.head_)) {
+    write_(tx_data.tx_id_, false, 0, 0, &tx_data);
+  }
+}
+
+void ObTxDataLookupCache::put_not_exist(const ObTransID tx_id,
+                                        const int64_t memtable_head,
+                                        const int64_t memtable_tail)
+{
+  if (OB_NOT_NULL(slots_) && tx_id.is_valid()) {
+    write_(tx_id, true, memtable_head, memtable_tail, nullptr);
+  }
+}
+
+void ObTxDataLookupCache::write_(const ObTransID tx_id,
+                                 const bool is_not_exist,
+                                 const int64_t memtable_head,
+                                 const int64_t memtable_tail,
+                                 const ObTxCommitData *commit_data)
+{
+  Slot &slot = get_slot_(tx_id);
+  const int64_t seq = ATOMIC_LOAD(&slot.seq_);
+  // give up if others are writing the same slot, the cache is best effort
+  if (0 == (seq & 1) && ATOMIC_BCAS(&slot.seq_, seq, seq + 1)) {
+    if (OB_NOT_NULL(commit_data)) {
+      slot.commit_data_ = *commit_data;
+    } else {
+      slot.commit_data_.reset();
+    }
+    slot.commit_data_.tx_id_ = tx_id;
+    slot.is_not_exist_ = is_not_exist;
+    slot.memtable_head_ = memtable_head;
+    slot.memtable_tail_ = memtable_tail;
+    ATOMIC_STORE(&slot.seq_, seq + 2);
+  }
+}
+
+}  // namespace storage
+}  // namespace oceanbase
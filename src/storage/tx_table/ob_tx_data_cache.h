@@ -0,0 +1,100 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_STORAGE_OB_TX_DATA_CACHE
+#define OCEANBASE_STORAGE_OB_TX_DATA_CACHE
+
+#include "lib/alloc/alloc_struct.h"
+#include "storage/tx/ob_tx_data_define.h"
+
+namespace oceanbase
+{
+namespace storage
+{
+
+// ObTxDataLookupCache caches the decided state of the transactions whose tx
+// data has been read from the tx data sstable, so that the readers of the rows
+// left by these transactions need not to read the sstable again.
+//
+// The cache is a fixed size array of slots indexed by the hash of tx id, a new
+// entry simply overwrites the old one in the same slot. Each slot is protected
+// by a sequence number which is odd during writing, the reader retries nothing
+// and treats a concurrent writing as a miss, so neither side ever blocks.
+//
+// Only the transactions which are committed or aborted and have no undo
+// actions are cached, whose tx data never changes again. The tx data which is
+// not found is cached with the range of tx data memtables, the entry is valid
+// only if the memtables are not changed since then, because the tx data of a
+// transaction without tx ctx can only be moved into the sstable by flushing
+// the memtables.
+class ObTxDataLookupCache
+{
+public:
+  static const int64_t SLOT_CNT = 4096;
+
+  ObTxDataLookupCache() : slots_(nullptr) {}
+  ~ObTxDataLookupCache() { destroy(); }
+  int init(const ObMemAttr &mem_attr);
+  void destroy();
+  // drop all the cached entries
+  void clear();
+  bool is_inited() const { return nullptr != slots_; }
+
+  /**
+   * @brief get the cached tx data of the transaction
+   *
+   * @param[in] tx_id, the transaction to look up
+   * @param[in] memtable_head, memtable_tail, the current range of tx data memtables
+   * @param[out] commit_data, the cached tx data if it exists
+   * @param[out] is_not_exist, whether the tx data is known not to exist
+   * @return OB_SUCCESS if hit, OB_ENTRY_NOT_EXIST if miss
+   */
+  int get(const transaction::ObTransID tx_id,
+          const int64_t memtable_head,
+          const int64_t memtable_tail,
+          ObTxCommitData &commit_data,
+          bool &is_not_exist) const;
+  // cache the tx data if its state is decided, the others are ignored
+  void put(const ObTxData &tx_data);
+  void put_not_exist(const transaction::ObTransID tx_id,
+                     const int64_t memtable_head,
+                     const int64_t memtable_tail);
+
+private:
+  struct Slot
+  {
+    // odd means the slot is being written
+    int64_t seq_;
+    bool is_not_exist_;
+    int64_t memtable_head_;
+    int64_t memtable_tail_;
+    ObTxCommitData commit_data_;
+  } CACHE_ALIGNED;
+
+  Slot &get_slot_(const transaction::ObTransID tx_id) const
+  {
+    return slots_[tx_id.hash() & (SLOT_CNT - 1)];
+  }
+  void write_(const transaction::ObTransID tx_id,
+              const bool is_not_exist,
+              const int64_t memtable_head,
+              const int64_t memtable_tail,
+              const ObTxCommitData *commit_data);
+
+private:
+  Slot *slots_;
+};
+
+}  // namespace storage
+}  // namespace oceanbase
+
+#endif  // OCEANBASE_STORAGE_OB_TX_DATA_CACHE
@@ -11,6 +11,7 @@
  */
 
 #include "storage/tx_table/ob_tx_data_table.h"
+#include "lib/stat/ob_diagnose_info.h"
 #include "lib/lock/ob_tc_rwlock.h"
 #include "lib/time/ob_time_utility.h"
 #include "share/rc/ob_tenant_base.h"
@@ -60,6 +61,8 @@ int ObTxDataTable::init(ObLS *ls, ObTxCtxTable *tx_ctx_table)
   } else if (FALSE_IT(arena_allocator_.set_attr(mem_attr_))) {
   } else if (OB_FAIL(init_tx_data_read_schema_())) {
     STORAGE_LOG(WARN, "init tx data read ctx failed.", KR(ret), K(tablet_id_));
+  } else if (OB_FAIL(lookup_cache_.init(mem_attr_))) {
+    STORAGE_LOG(WARN, "init tx data lookup cache failed.", KR(ret), K(tablet_id_));
   } else {
     slice_allocator_.set_nway(ObTxDataTable::TX_DATA_MAX_CONCURRENCY);
 
@@ -184,6 +187,7 @@ void ObTxDataTable::reset()
   memtable_mgr_ = nullptr;
   tx_ctx_table_ = nullptr;
   memtables_cache_.reuse();
+  lookup_cache_.destroy();
   slice_allocator_.purge_extra_cached_block(0);
   is_started_ = false;
   is_inited_ = false;
@@ -208,6 +212,7 @@ int ObTxDataTable::offline()
     min_start_log_ts_in_ctx_ = 0;
     last_update_min_start_log_ts_ = 0;
     calc_upper_trans_version_cache_.reset();
+    lookup_cache_.clear();
   }
   return ret;  
 }
@@ -500,6 +505,7 @@ int ObTxDataTable::check_with_tx_data(const ObTransID tx_id, ObITxDataCheckFunct
     STORAGE_LOG(WARN, "tx data table is not init.", KR(ret), KP(this), K(tx_id));
   } else if (OB_SUCC(check_tx_data_in_memtable_(tx_id, fn))) {
     // successfully do check function in memtable, check done
+    EVENT_INC(TX_DATA_MEMTABLE_HIT_COUNT);
     STORAGE_LOG(DEBUG, "tx data table check with tx memtable data succeed", K(tx_id), K(fn));
   } else if (OB_TRANS_CTX_NOT_EXIST == ret && OB_SUCC(check_tx_data_in_sstable_(tx_id, fn))) {
     // successfully do check function in sstable
@@ -644,12 +650,35 @@ int ObTxDataTable::check_tx_data_in_sstable_(const ObTransID tx_id, ObITxDataChe
 {
   int ret = OB_SUCCESS;
   ObTxData *tx_data = nullptr;
+  int64_t memtable_head = -1;
+  int64_t memtable_tail = -1;
 
-  if (OB_FAIL(get_tx_data_in_sstable_(tx_id, tx_data))) {
+  if (OB_FAIL(get_memtable_mgr_()->get_memtable_range(memtable_head, memtable_tail))) {
+    STORAGE_LOG(WARN, "get memtable range failed.", KR(ret), K(tx_id));
+  } else if (OB_ENTRY_NOT_EXIST != (ret = check_tx_data_in_lookup_cache_(tx_id,
+                                                                        memtable_head,
+                                                                        memtable_tail,
+                                                                        fn))) {
+    // hit in lookup cache
+  } else if (FALSE_IT(EVENT_INC(TX_DATA_LOOKUP_CACHE_MISS_COUNT))) {
+  } else if (OB_FAIL(get_tx_data_in_sstable_(tx_id, tx_data))) {
+    if (OB_TRANS_CTX_NOT_EXIST == ret) {
+      int64_t cur_memtable_head = -1;
+      int64_t cur_memtable_tail = -1;
+      // the tx data may have been flushed into sstable during reading, so the miss is cached only
+      // if the memtables are not changed
+      if (OB_SUCCESS == get_memtable_mgr_()->get_memtable_range(cur_memtable_head, cur_memtable_tail)
+          && cur_memtable_head == memtable_head
+          && cur_memtable_tail == memtable_tail) {
+        lookup_cache_.put_not_exist(tx_id, memtable_head, memtable_tail);
+      }
+    }
     STORAGE_LOG(WARN, "get tx data from sstable failed.", KR(ret), K(tx_id));
   } else if (OB_ISNULL(tx_data)) {
     ret = OB_ERR_UNEXPECTED;
     STORAGE_LOG(ERROR, "unexpected nullptr of tx data", KR(ret), K(tx_id));
+  } else if (FALSE_IT(EVENT_INC(TX_DATA_SSTABLE_READ_COUNT))) {
+  } else if (FALSE_IT(lookup_cache_.put(*tx_data))) {
   } else if (OB_FAIL(fn(*tx_data))) {
     STORAGE_LOG(WARN, "check tx data in sstable failed.", KR(ret), KP(this), K(tablet_id_));
   }
@@ -661,6 +690,33 @@ int ObTxDataTable::check_tx_data_in_sstable_(const ObTransID tx_id, ObITxDataChe
   return ret;
 }
 
+int ObTxDataTable::check_tx_data_in_lookup_cache_(const ObTransID tx_id,
+                                                  const int64_t memtable_head,
+                                                  const int64_t memtable_tail,
+                                                  ObITxDataCheckFunctor &fn)
+{
+  int ret = OB_SUCCESS;
+  ObTxCommitData commit_data;
+  bool is_not_exist = false;
+
+  if (OB_FAIL(lookup_cache_.get(tx_id, memtable_head, memtable_tail, commit_data, is_not_exist))) {
+    // miss, read it from sstable
+  } else if (is_not_exist) {
+    EVENT_INC(TX_DATA_LOOKUP_CACHE_HIT_COUNT);
+    ret = OB_TRANS_CTX_NOT_EXIST;
+  } else {
+    EVENT_INC(TX_DATA_LOOKUP_CACHE_HIT_COUNT);
+    // the cached tx data has no undo actions
+    ObTxData tx_data;
+    tx_data = commit_data;
+    if (OB_FAIL(fn(tx_data))) {
+      STORAGE_LOG(WARN, "check tx data in lookup cache failed.", KR(ret), KP(this), K(tablet_id_),
+                  K(tx_data));
+    }
+  }
+  return ret;
+}
+
 int ObTxDataTable::get_tx_data_in_sstable_(const transaction::ObTransID tx_id, ObTxData *&tx_data)
 {
   int ret = OB_SUCCESS;
@@ -1125,18 +1181,10 @@ int ObTxDataTable::calc_upper_trans_version_(const int64_t sstable_end_log_ts,
   int ret = OB_SUCCESS;
 
   const auto &array = calc_upper_trans_version_cache_.commit_versions_.array_;
-  int l = 0;
-  int r = array.count() - 1;
-
-  // Binary find the first start_log_ts that is greater than or equal to sstable_end_log_ts
-  while (l < r) {
-    int mid = (l + r) >> 1;
-    if (array.at(mid).start_log_ts_ < sstable_end_log_ts) {
-      l = mid + 1;
-    } else {
-      r = mid;
-    }
-  }
+  // Find the first start_log_ts that is greater than or equal to sstable_end_log_ts, use the last
+  // one if all of them are less than sstable_end_log_ts.
+  const int64_t l = std::min(calc_upper_trans_version_cache_.commit_versions_.lower_bound(sstable_end_log_ts),
+                             std::max(array.count() - 1, 0L));
 
   // Check if the start_log_ts is greater than or equal to the sstable_end_log_ts. If not, delay the
   // upper_trans_version calculation to the next time.
@@ -17,6 +17,7 @@
 #include "lib/future/ob_future.h"
 #include "storage/tx_table/ob_tx_data_memtable_mgr.h"
 #include "storage/tx_table/ob_tx_table_define.h"
+#include "storage/tx_table/ob_tx_data_cache.h"
 #include "share/ob_occam_timer.h"
 namespace oceanbase
 {
@@ -115,7 +116,8 @@ public:  // ObTxDataTable
       memtable_mgr_(nullptr),
       tx_ctx_table_(nullptr),
       read_schema_(),
-      memtables_cache_() {}
+      memtables_cache_(),
+      lookup_cache_() {}
   ~ObTxDataTable() {}
 
   virtual int init(ObLS *ls, ObTxCtxTable *tx_ctx_table);
@@ -242,6 +244,11 @@ private:
 
   int check_tx_data_in_sstable_(const transaction::ObTransID tx_id, ObITxDataCheckFunctor &fn);
 
+  int check_tx_data_in_lookup_cache_(const transaction::ObTransID tx_id,
+                                     const int64_t memtable_head,
+                                     const int64_t memtable_tail,
+                                     ObITxDataCheckFunctor &fn);
+
   int get_tx_data_in_cache_(const transaction::ObTransID tx_id, ObTxData *&tx_data);
 
   int get_tx_data_in_sstable_(const transaction::ObTransID tx_id, ObTxData *&tx_data);
@@ -333,6 +340,8 @@ private:
   TxDataReadSchema read_schema_;
   CalcUpperTransVersionCache calc_upper_trans_version_cache_;
   MemtableHandlesCache memtables_cache_;
+  // cache the tx data read from sstable
+  ObTxDataLookupCache lookup_cache_;
 };  // tx_table
 
 
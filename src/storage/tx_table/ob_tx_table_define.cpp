@@ -393,6 +393,28 @@ bool ObCommitVersionsArray::is_valid()
   return bool_ret;
 }
 
+// The binary search has no data dependent branch, so it suffers no branch miss on the randomly
+// distributed keys. When the range is small enough, the nodes less than the key are counted
+// without branch, which is vectorized by the compiler.
+int64_t ObCommitVersionsArray::lower_bound(const int64_t start_log_ts) const
+{
+  const Node *base = array_.get_data();
+  int64_t n = array_.count();
+  int64_t pos = 0;
+  if (n > 0) {
+    while (n > LINEAR_SCAN_THRESHOLD) {
+      const int64_t half = n >> 1;
+      pos = (base[pos + half].start_log_ts_ < start_log_ts) ? pos + half : pos;
+      n -= half;
+    }
+    int64_t less_cnt = 0;
+    for (int64_t i = 0; i < n; i++) {
+      less_cnt += (base[pos + i].start_log_ts_ < start_log_ts);
+    }
+    pos += less_cnt;
+  }
+  return pos;
+}
 
 } // end namespace transaction
 } // end namespace oceanbase
@@ -236,6 +236,10 @@ public:
 
   bool is_valid();
 
+  // return the index of the first node whose start_log_ts is not less than the given one, or the
+  // count of nodes if there is no such node. The nodes should be sorted by start_log_ts.
+  int64_t lower_bound(const int64_t start_log_ts) const;
+
   static void print_to_stderr(const ObCommitVersionsArray &commit_versions)
   {
     fprintf(stderr, "pre-process data for upper trans version calculation : ");
@@ -257,6 +261,10 @@ private:
   int deserialize_(const char *buf, const int64_t data_len, int64_t &pos);
   int64_t get_serialize_size_() const;
 
+private:
+  // the lower bound is found by scanning when the range is narrowed to this count
+  static const int64_t LINEAR_SCAN_THRESHOLD = 16;
+
 public:
   ObSEArray<Node, 128> array_;
 };
@@ -139,6 +139,47 @@ DEF_COMMAND(TRANS, dump_single_tx_data, 1, "tenant_id:ls_id:tx_id # dump a singl
   return ret;
 }
 
+DEF_COMMAND(SERVER, dump_io_latency_histogram, 1, "[tenant_id] # dump io latency histograms of the tenant or all tenants to observer log")
+{
+  int ret = OB_SUCCESS;
+  string arg_str;
+  obrpc::ObDumpIOLatencyHistogramArg arg;
+  if (cmd_.length() > action_name_.length()) {
+    arg_str = cmd_.substr(action_name_.length() + 1);
+    if (1 != sscanf(arg_str.c_str(), "%lu", &arg.tenant_id_)) {
+      ret = OB_INVALID_ARGUMENT;
+      COMMON_LOG(WARN, "invalid arg", K(ret));
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (OB_SUCCESS != (ret = client_->dump_io_latency_histogram(arg))) {
+    COMMON_LOG(ERROR, "send req fail", K(ret));
+  }
+  COMMON_LOG(INFO, "dump_io_latency_histogram", K(ret), K(arg));
+  return ret;
+}
+
+DEF_COMMAND(SERVER, reset_io_latency_histogram, 1, "[tenant_id] # dump io latency histograms of the tenant or all tenants to observer log and reset them")
+{
+  int ret = OB_SUCCESS;
+  string arg_str;
+  obrpc::ObDumpIOLatencyHistogramArg arg;
+  arg.need_reset_ = true;
+  if (cmd_.length() > action_name_.length()) {
+    arg_str = cmd_.substr(action_name_.length() + 1);
+    if (1 != sscanf(arg_str.c_str(), "%lu", &arg.tenant_id_)) {
+      ret = OB_INVALID_ARGUMENT;
+      COMMON_LOG(WARN, "invalid arg", K(ret));
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (OB_SUCCESS != (ret = client_->dump_io_latency_histogram(arg))) {
+    COMMON_LOG(ERROR, "send req fail", K(ret));
+  }
+  COMMON_LOG(INFO, "reset_io_latency_histogram", K(ret), K(arg));
+  return ret;
+}
+
 DEF_COMMAND(TRANS, force_set_replica_num, 1, "table_id:partition_idx:partition_cnt replica_num # force set replica_num")
 {
   return OB_NOT_SUPPORTED;
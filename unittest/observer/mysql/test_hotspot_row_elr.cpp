@@ -0,0 +1,72 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include "lib/utility/ob_test_util.h"
+#include "observer/mysql/ob_query_retry_ctrl.h"
+#include "sql/session/ob_sql_session_info.h"
+
+using namespace oceanbase::common;
+using namespace oceanbase::sql;
+using namespace oceanbase::observer;
+
+TEST(TestHotspotRowElr, threshold)
+{
+  // 0 disables the hotspot row early lock release
+  ASSERT_FALSE(ObQueryRetryCtrl::is_hotspot_row_conflict(true, 1000000, 0));
+  ASSERT_FALSE(ObQueryRetryCtrl::is_hotspot_row_conflict(true, 99, 100));
+  ASSERT_TRUE(ObQueryRetryCtrl::is_hotspot_row_conflict(true, 100, 100));
+  ASSERT_TRUE(ObQueryRetryCtrl::is_hotspot_row_conflict(true, 101, 100));
+}
+
+TEST(TestHotspotRowElr, autocommit_only)
+{
+  // the row locks of an explicit transaction are held by the whole transaction
+  ASSERT_FALSE(ObQueryRetryCtrl::is_hotspot_row_conflict(false, 101, 100));
+
+  ObSQLSessionInfo session;
+  session.set_autocommit(true);
+  session.set_explicit_start_trans(false);
+  ASSERT_FALSE(session.need_hotspot_row_elr());
+
+  session.set_hotspot_row_elr_expire_ts(ObTimeUtility::current_time()
+                                        + ObQueryRetryCtrl::HOTSPOT_ROW_ELR_DURATION);
+  ASSERT_TRUE(session.need_hotspot_row_elr());
+
+  session.set_explicit_start_trans(true);
+  ASSERT_FALSE(session.need_hotspot_row_elr());
+  session.set_explicit_start_trans(false);
+
+  session.set_autocommit(false);
+  ASSERT_FALSE(session.need_hotspot_row_elr());
+  session.set_autocommit(true);
+  ASSERT_TRUE(session.need_hotspot_row_elr());
+}
+
+TEST(TestHotspotRowElr, decay)
+{
+  ObSQLSessionInfo session;
+  session.set_autocommit(true);
+  session.set_explicit_start_trans(false);
+
+  session.set_hotspot_row_elr_expire_ts(ObTimeUtility::current_time() + 100 * 1000L);
+  ASSERT_TRUE(session.need_hotspot_row_elr());
+  usleep(200 * 1000L);
+  ASSERT_FALSE(session.need_hotspot_row_elr());
+}
+
+int main(int argc, char **argv)
+{
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
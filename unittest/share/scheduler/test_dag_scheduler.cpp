@@ -1611,6 +1611,53 @@ TEST_F(TestDagScheduler, test_large_thread_cnt_2)
   scheduler->destroy();
 }
 */
+
+TEST(TestCompactionConcurrencyController, adjust)
+{
+  typedef ObCompactionConcurrencyController Controller;
+  const int64_t rt_threshold_us = 10 * 1000;
+  const int32_t score = 10;
+  Controller controller;
+  EXPECT_EQ(score, controller.get_limit(ObDagPrio::DAG_PRIO_COMPACTION_LOW, score));
+
+  // throttle by half until the min factor
+  controller.update(rt_threshold_us, rt_threshold_us + 1, false);
+  EXPECT_EQ(score / 2, controller.get_limit(ObDagPrio::DAG_PRIO_COMPACTION_LOW, score));
+  EXPECT_EQ(score / 2, controller.get_limit(ObDagPrio::DAG_PRIO_COMPACTION_HIGH, score));
+  for (int64_t i = 0; i < 10; ++i) {
+    controller.update(rt_threshold_us, rt_threshold_us + 1, false);
+  }
+  EXPECT_EQ(score * Controller::MIN_FACTOR_PCT / 100,
+      controller.get_limit(ObDagPrio::DAG_PRIO_COMPACTION_LOW, score));
+  EXPECT_EQ(1, controller.get_limit(ObDagPrio::DAG_PRIO_COMPACTION_LOW, 1));
+  // other priorities are never adjusted
+  EXPECT_EQ(score, controller.get_limit(ObDagPrio::DAG_PRIO_HA_HIGH, score));
+
+  // hold while the latency is between half of the threshold and the threshold
+  const int32_t limit = controller.get_limit(ObDagPrio::DAG_PRIO_COMPACTION_LOW, score);
+  controller.update(rt_threshold_us, rt_threshold_us / 2, false);
+  EXPECT_EQ(limit, controller.get_limit(ObDagPrio::DAG_PRIO_COMPACTION_LOW, score));
+
+  // memstore pressure boosts mini and minor merge at once
+  controller.update(rt_threshold_us, rt_threshold_us + 1, true);
+  EXPECT_LT(score, controller.get_limit(ObDagPrio::DAG_PRIO_COMPACTION_HIGH, score));
+  EXPECT_LT(score, controller.get_limit(ObDagPrio::DAG_PRIO_COMPACTION_MID, score));
+  EXPECT_EQ(limit, controller.get_limit(ObDagPrio::DAG_PRIO_COMPACTION_LOW, score));
+
+  // grow up to the max factor when idle
+  for (int64_t i = 0; i < 100; ++i) {
+    controller.update(rt_threshold_us, 0, false);
+  }
+  EXPECT_EQ(score * Controller::MAX_FACTOR_PCT / 100,
+      controller.get_limit(ObDagPrio::DAG_PRIO_COMPACTION_LOW, score));
+  EXPECT_EQ(score * Controller::MAX_FACTOR_PCT / 100,
+      controller.get_limit(ObDagPrio::DAG_PRIO_COMPACTION_HIGH, score));
+
+  // disabled
+  controller.update(0, rt_threshold_us + 1, false);
+  EXPECT_TRUE(controller.is_default());
+  EXPECT_EQ(score, controller.get_limit(ObDagPrio::DAG_PRIO_COMPACTION_LOW, score));
+}
 }
 }
 
@@ -0,0 +1,222 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL
+
+#include <gtest/gtest.h>
+#define private public
+#include "storage/blocksstable/ob_block_manager.h"
+#undef private
+#include "sql/ob_sql_init.h"
+#include "sql/parser/ob_parser.h"
+#include "sql/resolver/cmd/ob_load_data_stmt.h"
+#include "sql/engine/cmd/ob_load_data_direct_impl.h"
+
+using namespace oceanbase::sql;
+using namespace oceanbase::common;
+using namespace oceanbase::storage;
+using namespace oceanbase::blocksstable;
+
+class TestLoadDataDirect : public ::testing::Test
+{
+public:
+  static const int64_t SNAPSHOT_VERSION = 100;
+  TestLoadDataDirect()
+    : allocator_("LoadDirectTest"), sort_ret_(OB_SUCCESS), compare_(sort_ret_, 1) {}
+  virtual void SetUp();
+  virtual void TearDown();
+  // the rowkey is the first cell and the value is the second one
+  int add_row(const int64_t tablet_id, const int64_t seq, const char *key, const char *value);
+  int check_next_row(const char *key, const char *value, const int64_t tablet_id);
+protected:
+  ObArenaAllocator allocator_;
+  int sort_ret_;
+  ObLoadDataDirectRowCompare compare_;
+  ObLoadDataDirectSorter sorter_;
+  ObLoadDataDirectParam param_;
+  ObLoadDataDirectRowIterator row_iter_;
+};
+
+void TestLoadDataDirect::SetUp()
+{
+  OB_SERVER_BLOCK_MGR.super_block_.body_.macro_block_size_ = ObLoadDataDirectImpl::FILE_BUFFER_SIZE;
+  ObLoadDataDirectColumn column;
+  param_.tenant_id_ = OB_SYS_TENANT_ID;
+  param_.rowkey_cnt_ = 1;
+  ASSERT_EQ(OB_SUCCESS, param_.columns_.push_back(column));
+  ASSERT_EQ(OB_SUCCESS, param_.columns_.push_back(column));
+  ASSERT_EQ(OB_SUCCESS, sorter_.init(ObLoadDataDirectImpl::MERGE_MEMORY_LIMIT,
+                                     ObLoadDataDirectImpl::FILE_BUFFER_SIZE,
+                                     ObTimeUtility::current_time() + 60 * 1000 * 1000L,
+                                     OB_SYS_TENANT_ID,
+                                     &compare_));
+}
+
+void TestLoadDataDirect::TearDown()
+{
+  row_iter_.reset();
+  sorter_.clean_up();
+  allocator_.reset();
+}
+
+int TestLoadDataDirect::add_row(const int64_t tablet_id,
+                                const int64_t seq,
+                                const char *key,
+                                const char *value)
+{
+  int ret = OB_SUCCESS;
+  ObLoadDataDirectRow row;
+  ObObj *cells = static_cast<ObObj *>(allocator_.alloc(sizeof(ObObj) * 2));
+  if (OB_ISNULL(cells)) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+  } else {
+    cells[0].set_varchar(key);
+    cells[0].set_collation_type(CS_TYPE_UTF8MB4_BIN);
+    cells[1].set_varchar(value);
+    cells[1].set_collation_type(CS_TYPE_UTF8MB4_BIN);
+    row.tablet_id_ = ObTabletID(tablet_id);
+    row.seq_ = seq;
+    row.cell_cnt_ = 2;
+    row.cells_ = cells;
+    ret = sorter_.add_item(row);
+  }
+  return ret;
+}
+
+int TestLoadDataDirect::check_next_row(const char *key, const char *value, const int64_t tablet_id)
+{
+  int ret = OB_SUCCESS;
+  ObNewRow *row = NULL;
+  ObTabletID row_tablet_id;
+  if (OB_FAIL(row_iter_.get_next_row_with_tablet_id(param_.table_id_, param_.rowkey_cnt_,
+                                                    SNAPSHOT_VERSION, row, row_tablet_id))) {
+  } else if (OB_ISNULL(row) || 4 != row->count_) {
+    ret = OB_ERR_UNEXPECTED;
+  } else if (row_tablet_id != ObTabletID(tablet_id)
+             || row->cells_[0].get_string() != ObString::make_string(key)
+             || row->cells_[1].get_int() != -SNAPSHOT_VERSION
+             || row->cells_[2].get_int() != 0
+             || row->cells_[3].get_string() != ObString::make_string(value)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("unexpected row", K(ret), KPC(row), K(row_tablet_id), K(key), K(value), K(tablet_id));
+  }
+  return ret;
+}
+
+TEST_F(TestLoadDataDirect, replace_keeps_last_line)
+{
+  param_.dupl_action_ = ObLoadDupActionType::LOAD_REPLACE;
+  ASSERT_EQ(OB_SUCCESS, add_row(2, 3, "k1", "v4"));
+  ASSERT_EQ(OB_SUCCESS, add_row(1, 2, "k2", "v3"));
+  ASSERT_EQ(OB_SUCCESS, add_row(1, 1, "k1", "v2"));
+  ASSERT_EQ(OB_SUCCESS, add_row(1, 0, "k1", "v1"));
+  ASSERT_EQ(OB_SUCCESS, sorter_.do_sort(true));
+  ASSERT_EQ(OB_SUCCESS, row_iter_.init(sorter_, param_));
+
+  ObTabletID tablet_id;
+  ASSERT_EQ(OB_SUCCESS, row_iter_.peek_tablet_id(tablet_id));
+  ASSERT_EQ(ObTabletID(1), tablet_id);
+  row_iter_.set_tablet_id(tablet_id);
+  ASSERT_EQ(OB_SUCCESS, check_next_row("k1", "v2", 1));
+  ASSERT_EQ(OB_SUCCESS, check_next_row("k2", "v3", 1));
+  // the same rowkey in another tablet is not a duplicate, the next tablet is returned
+  ObNewRow *row = NULL;
+  ASSERT_EQ(OB_SUCCESS, row_iter_.get_next_row_with_tablet_id(param_.table_id_, param_.rowkey_cnt_,
+                                                              SNAPSHOT_VERSION, row, tablet_id));
+  ASSERT_EQ(ObTabletID(2), tablet_id);
+  row_iter_.set_tablet_id(tablet_id);
+  ASSERT_EQ(OB_SUCCESS, check_next_row("k1", "v4", 2));
+  ASSERT_EQ(OB_ITER_END, row_iter_.get_next_row_with_tablet_id(param_.table_id_, param_.rowkey_cnt_,
+                                                              SNAPSHOT_VERSION, row, tablet_id));
+  ASSERT_EQ(OB_ITER_END, row_iter_.peek_tablet_id(tablet_id));
+  ASSERT_EQ(1, row_iter_.get_duplicated_row_cnt());
+}
+
+TEST_F(TestLoadDataDirect, ignore_keeps_first_line)
+{
+  param_.dupl_action_ = ObLoadDupActionType::LOAD_IGNORE;
+  ASSERT_EQ(OB_SUCCESS, add_row(1, 2, "k1", "v3"));
+  ASSERT_EQ(OB_SUCCESS, add_row(1, 0, "k1", "v1"));
+  ASSERT_EQ(OB_SUCCESS, add_row(1, 1, "k1", "v2"));
+  ASSERT_EQ(OB_SUCCESS, sorter_.do_sort(true));
+  ASSERT_EQ(OB_SUCCESS, row_iter_.init(sorter_, param_));
+
+  ObTabletID tablet_id;
+  ObNewRow *row = NULL;
+  ASSERT_EQ(OB_SUCCESS, row_iter_.peek_tablet_id(tablet_id));
+  row_iter_.set_tablet_id(tablet_id);
+  ASSERT_EQ(OB_SUCCESS, check_next_row("k1", "v1", 1));
+  ASSERT_EQ(OB_ITER_END, row_iter_.get_next_row_with_tablet_id(param_.table_id_, param_.rowkey_cnt_,
+                                                              SNAPSHOT_VERSION, row, tablet_id));
+  ASSERT_EQ(2, row_iter_.get_duplicated_row_cnt());
+}
+
+TEST_F(TestLoadDataDirect, stop_on_dup)
+{
+  param_.dupl_action_ = ObLoadDupActionType::LOAD_STOP_ON_DUP;
+  ASSERT_EQ(OB_SUCCESS, add_row(1, 0, "k1", "v1"));
+  ASSERT_EQ(OB_SUCCESS, add_row(1, 1, "k1", "v2"));
+  ASSERT_EQ(OB_SUCCESS, sorter_.do_sort(true));
+  ASSERT_EQ(OB_SUCCESS, row_iter_.init(sorter_, param_));
+
+  ObTabletID tablet_id;
+  ObNewRow *row = NULL;
+  ASSERT_EQ(OB_SUCCESS, row_iter_.peek_tablet_id(tablet_id));
+  row_iter_.set_tablet_id(tablet_id);
+  ASSERT_EQ(OB_ERR_PRIMARY_KEY_DUPLICATE,
+            row_iter_.get_next_row_with_tablet_id(param_.table_id_, param_.rowkey_cnt_,
+                                                  SNAPSHOT_VERSION, row, tablet_id));
+}
+
+static bool find_node(const ParseNode *node, const ObItemType type)
+{
+  bool found = false;
+  if (NULL != node) {
+    found = (type == node->type_);
+    for (int64_t i = 0; !found && i < node->num_child_; ++i) {
+      found = find_node(node->children_[i], type);
+    }
+  }
+  return found;
+}
+
+TEST(TestLoadDataDirectHint, append_hint)
+{
+  ObArenaAllocator allocator;
+  ObParser parser(allocator, SMO_DEFAULT);
+  ParseResult parse_result;
+  ObString query = ObString::make_string("load data /*+ APPEND */ infile 'a.csv' into table t");
+  ASSERT_EQ(OB_SUCCESS, parser.parse(query, parse_result));
+  ASSERT_TRUE(find_node(parse_result.result_tree_, T_APPEND));
+  parser.free_result(parse_result);
+
+  query = ObString::make_string("load data /*+ PARALLEL(4) */ infile 'a.csv' into table t");
+  ASSERT_EQ(OB_SUCCESS, parser.parse(query, parse_result));
+  ASSERT_FALSE(find_node(parse_result.result_tree_, T_APPEND));
+  parser.free_result(parse_result);
+
+  ObLoadDataHint hint;
+  int64_t value = -1;
+  ASSERT_EQ(OB_SUCCESS, hint.get_value(ObLoadDataHint::DIRECT_LOAD, value));
+  ASSERT_EQ(0, value);
+  ASSERT_EQ(OB_SUCCESS, hint.set_value(ObLoadDataHint::DIRECT_LOAD, 1));
+  ASSERT_EQ(OB_SUCCESS, hint.get_value(ObLoadDataHint::DIRECT_LOAD, value));
+  ASSERT_EQ(1, value);
+}
+
+int main(int argc, char **argv)
+{
+  init_sql_factories();
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,191 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL
+
+#include <gtest/gtest.h>
+#include <string>
+#include "lib/time/ob_time_utility.h"
+#include "sql/ob_sql_init.h"
+#include "sql/engine/cmd/ob_load_data_parser.h"
+#include "sql/resolver/cmd/ob_load_data_stmt.h"
+
+using namespace oceanbase::sql;
+using namespace oceanbase::common;
+
+namespace oceanbase
+{
+namespace unittest
+{
+
+static const int64_t COLUMN_NUM = 8;
+
+// the fields of all the lines are joined, so that the results of two scans can be compared
+static int scan_all(ObCSVGeneralParser &parser,
+                    const std::string &data,
+                    std::string &escape_buf,
+                    std::string &result,
+                    int64_t &line_cnt)
+{
+  int ret = OB_SUCCESS;
+  const char *ptr = data.data();
+  const char *end = data.data() + data.length();
+  ObSEArray<ObCSVGeneralParser::LineErrRec, 16> errors;
+  auto join_fields = [&](ObIArray<ObCSVGeneralParser::FieldValue> &fields) -> int {
+    for (int64_t i = 0; i < fields.count(); ++i) {
+      if (fields.at(i).is_null_) {
+        result.append("<NULL>");
+      } else {
+        result.append(fields.at(i).ptr_, fields.at(i).len_);
+      }
+      result.push_back('\x01');
+    }
+    result.push_back('\x02');
+    return OB_SUCCESS;
+  };
+  result.clear();
+  line_cnt = 0;
+  while (OB_SUCC(ret) && ptr < end) {
+    int64_t nrows = 1024;
+    escape_buf.resize(data.length() + 1);
+    ret = parser.scan<decltype(join_fields), true>(ptr, end, nrows,
+                                                   &escape_buf[0], &escape_buf[0] + escape_buf.length(),
+                                                   join_fields, errors, true);
+    line_cnt += nrows;
+    if (0 == nrows) {
+      break;
+    }
+  }
+  return ret;
+}
+
+static void gen_data(const int64_t line_cnt, const bool is_enclosed, std::string &data)
+{
+  const char *values[] = {
+    "12345", "oceanbase", "3.1415926", "2022-06-01 12:00:00", "\\N", "",
+    "中文字段", "a\\tb\\\\c", "tail\xe4", "mixed 数据 with ascii",
+    "a very long field which does not contain any separator, to make the simd scan worthwhile"
+  };
+  data.clear();
+  for (int64_t i = 0; i < line_cnt; ++i) {
+    for (int64_t j = 0; j < COLUMN_NUM; ++j) {
+      const char *value = values[(i * 7 + j * 3) % ARRAYSIZEOF(values)];
+      if (is_enclosed && 0 == (i + j) % 3) {
+        data.append("\"").append(value).append(" \"\"quoted\"\", with ,").append("\"");
+      } else {
+        data.append(value);
+      }
+      data.push_back(COLUMN_NUM - 1 == j ? '\n' : ',');
+    }
+  }
+}
+
+TEST(TestCSVStructuralIndex, next)
+{
+  ObCSVStructuralIndex index;
+  std::string data;
+  for (int64_t i = 0; i < 1000; ++i) {
+    data.push_back(0 == i % 37 ? ',' : (0 == i % 101 ? '\n' : 'x'));
+  }
+  ASSERT_FALSE(index.is_valid());
+  ASSERT_EQ(OB_SUCCESS, index.add_char(','));
+  ASSERT_EQ(OB_SUCCESS, index.add_char('\n'));
+  ASSERT_EQ(OB_SUCCESS, index.add_char(','));
+  ASSERT_EQ(OB_SUCCESS, index.add_char(INT64_MAX));
+  ASSERT_TRUE(index.is_valid());
+  const char *begin = data.data();
+  const char *end = data.data() + data.length();
+  int64_t found_cnt = 0;
+  for (const char *p = index.next(begin, end); p < end; p = index.next(p + 1, end)) {
+    ASSERT_TRUE(',' == *p || '\n' == *p);
+    ++found_cnt;
+  }
+  int64_t expect_cnt = 0;
+  for (int64_t i = 0; i < static_cast<int64_t>(data.length()); ++i) {
+    expect_cnt += (',' == data[i] || '\n' == data[i]) ? 1 : 0;
+  }
+  ASSERT_EQ(expect_cnt, found_cnt);
+  // the block is rebuilt if the search goes back
+  index.reuse();
+  ASSERT_EQ(begin + 37, index.next(begin + 1, end));
+  ASSERT_EQ(begin, index.next(begin, end));
+  ASSERT_EQ(end - 1, index.next(end - 1, end));
+  ASSERT_EQ(end - 1, index.next(end - 2, end - 1));
+  ASSERT_EQ(OB_SUCCESS, index.add_char('"'));
+  ASSERT_EQ(OB_SUCCESS, index.add_char('\\'));
+  ASSERT_EQ(OB_SIZE_OVERFLOW, index.add_char('|'));
+}
+
+static void compare_and_bench(const ObDataInFileStruct &file_struct,
+                              const ObCollationType cs_type,
+                              const bool is_enclosed)
+{
+  const int64_t line_cnt = 200000;
+  std::string data;
+  std::string escape_buf;
+  std::string normal_result;
+  std::string index_result;
+  int64_t normal_lines = 0;
+  int64_t index_lines = 0;
+  ObCSVGeneralParser parser;
+  gen_data(line_cnt, is_enclosed, data);
+  ASSERT_EQ(OB_SUCCESS, parser.init(file_struct, COLUMN_NUM, cs_type));
+
+  parser.set_use_structural_index(false);
+  int64_t start_time = ObTimeUtility::current_time();
+  ASSERT_EQ(OB_SUCCESS, scan_all(parser, data, escape_buf, normal_result, normal_lines));
+  const int64_t normal_us = ObTimeUtility::current_time() - start_time + 1;
+
+  parser.set_use_structural_index(true);
+  ASSERT_TRUE(parser.get_opt_params().use_structural_index_);
+  start_time = ObTimeUtility::current_time();
+  ASSERT_EQ(OB_SUCCESS, scan_all(parser, data, escape_buf, index_result, index_lines));
+  const int64_t index_us = ObTimeUtility::current_time() - start_time + 1;
+
+  ASSERT_EQ(line_cnt, normal_lines);
+  ASSERT_EQ(normal_lines, index_lines);
+  ASSERT_TRUE(normal_result == index_result);
+  fprintf(stdout, "## cs_type:%d enclosed:%d size:%ldM byte by byte:%ldM/s structural index:%ldM/s\n",
+          cs_type, is_enclosed, (int64_t)data.length() >> 20,
+          (int64_t)(data.length() * USECS_PER_SEC / normal_us) >> 20,
+          (int64_t)(data.length() * USECS_PER_SEC / index_us) >> 20);
+}
+
+TEST(TestParserBenchmark, escaped_fields)
+{
+  ObDataInFileStruct file_struct;
+  file_struct.field_term_str_ = ",";
+  compare_and_bench(file_struct, CS_TYPE_UTF8MB4_BIN, false);
+  compare_and_bench(file_struct, CS_TYPE_BINARY, false);
+  compare_and_bench(file_struct, CS_TYPE_GBK_BIN, false);
+}
+
+TEST(TestParserBenchmark, enclosed_fields)
+{
+  ObDataInFileStruct file_struct;
+  file_struct.field_term_str_ = ",";
+  file_struct.field_enclosed_str_ = "\"";
+  file_struct.field_enclosed_char_ = '"';
+  compare_and_bench(file_struct, CS_TYPE_UTF8MB4_BIN, true);
+  compare_and_bench(file_struct, CS_TYPE_GB18030_BIN, true);
+}
+
+} // namespace unittest
+} // namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  init_sql_factories();
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -1242,6 +1242,79 @@ TEST_F(TestTmpFile, test_write_more_than_one_macro_block)
   ObTmpFileManager::get_instance().remove(fd);
 }
 
+TEST_F(TestTmpFile, test_compressed_wash)
+{
+  int ret = OB_SUCCESS;
+  int64_t dir = -1;
+  int64_t fd = -1;
+  const int64_t macro_block_size = OB_SERVER_BLOCK_MGR.get_macro_block_size();
+  const int64_t write_size = 3 * macro_block_size;
+  ObTmpFileIOInfo io_info;
+  ObTmpFileIOHandle handle;
+  ObTmpTenantFileStoreHandle store_handle;
+  ret = ObTmpFileManager::get_instance().alloc_dir(dir);
+  ASSERT_EQ(OB_SUCCESS, ret);
+  ret = ObTmpFileManager::get_instance().open(fd, dir);
+  ASSERT_EQ(OB_SUCCESS, ret);
+  ASSERT_EQ(OB_SUCCESS, OB_TMP_FILE_STORE.get_store(1, store_handle));
+  // only one block is kept in memory and the washed blocks are compressed.
+  ObTmpTenantMemBlockManager &mem_block_manager = store_handle.get_tenant_store()->tmp_mem_block_manager_;
+  mem_block_manager.last_tenant_mem_block_num_ = 1;
+  mem_block_manager.last_enable_compress_ = true;
+  mem_block_manager.last_access_tenant_config_ts_ = ObClockGenerator::getClock();
+
+  char *write_buf = new char [write_size];
+  for (int64_t i = 0; i < write_size; ++i) {
+    write_buf[i] = static_cast<char>((i / 64) % 256);
+  }
+  char *read_buf = new char [write_size];
+  io_info.fd_ = fd;
+  io_info.tenant_id_ = 1;
+  io_info.io_desc_.set_category(ObIOCategory::USER_IO);
+  io_info.io_desc_.set_wait_event(2);
+  io_info.buf_ = write_buf;
+  io_info.size_ = write_size;
+  const int64_t timeout_ms = 5000;
+  ret = ObTmpFileManager::get_instance().write(io_info, timeout_ms);
+  ASSERT_EQ(OB_SUCCESS, ret);
+  // the washed blocks are compressed after the lock is released, none is left queued.
+  ASSERT_TRUE(mem_block_manager.wash_block_ids_.empty());
+
+  // drop the washed blocks from the block cache, so that they are read from disk.
+  int64_t compressed_cnt = 0;
+  ObTmpTenantMacroBlockManager::TmpMacroBlockMap::iterator iter;
+  ObTmpTenantMacroBlockManager &block_manager = store_handle.get_tenant_store()->tmp_block_manager_;
+  for (iter = block_manager.blocks_.begin(); iter != block_manager.blocks_.end(); ++iter) {
+    ObTmpMacroBlock *block = iter->second;
+    if (block->is_disked() && block->is_compressed()) {
+      ASSERT_GT(block->get_compressed_size(), 0);
+      ASSERT_LE(block->get_compressed_size(), OB_TMP_FILE_STORE.get_block_size() * 3 / 4);
+      ObTmpBlockCacheKey key(block->get_block_id(), 1);
+      ObTmpBlockCache::get_instance().erase(key);
+      ++compressed_cnt;
+    }
+  }
+  ASSERT_GT(compressed_cnt, 0);
+
+  io_info.buf_ = read_buf;
+  ret = ObTmpFileManager::get_instance().pread(io_info, 0, timeout_ms, handle);
+  ASSERT_EQ(OB_SUCCESS, ret);
+  ASSERT_EQ(write_size, handle.get_data_size());
+  ASSERT_EQ(0, memcmp(handle.get_buffer(), write_buf, write_size));
+
+  // the decompressed blocks are put into the block cache by the read above.
+  io_info.size_ = 1000;
+  ret = ObTmpFileManager::get_instance().pread(io_info, macro_block_size - 500, timeout_ms, handle);
+  ASSERT_EQ(OB_SUCCESS, ret);
+  ASSERT_EQ(1000, handle.get_data_size());
+  ASSERT_EQ(0, memcmp(handle.get_buffer(), write_buf + macro_block_size - 500, 1000));
+
+  mem_block_manager.last_access_tenant_config_ts_ = 0;
+  ObTmpFileManager::get_instance().remove(fd);
+  delete[] write_buf;
+  delete[] read_buf;
+}
+
 TEST_F(TestTmpFile, test_single_dir_two_file)
 {
   int ret = OB_SUCCESS;
@@ -0,0 +1,277 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+#define private public
+#define protected public
+#include "lib/ob_errno.h"
+#include "lib/random/ob_random.h"
+#include "common/rowkey/ob_store_rowkey.h"
+#include "share/config/ob_server_config.h"
+#include "storage/memtable/ob_lock_wait_mgr.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace memtable;
+using namespace transaction;
+
+namespace unittest
+{
+
+static const int64_t MAX_CLIENT_COUNT = 64;
+static const int64_t MAX_ROW_COUNT = 64;
+
+// repost the waken up request by marking its client runnable
+class ObMockLockWaitMgr : public ObLockWaitMgr
+{
+public:
+  ObMockLockWaitMgr() : repost_cnt_(0)
+  {
+    memset(woken_, 0, sizeof(woken_));
+  }
+  virtual int repost(Node *node) override
+  {
+    ATOMIC_INC(&repost_cnt_);
+    ATOMIC_STORE(&woken_[node - nodes_], true);
+    return OB_SUCCESS;
+  }
+  // remove the node which is not waken up in time from the wait queue, it
+  // returns false if the node has been fetched by the waker
+  bool cancel(Node *node)
+  {
+    int err = 0;
+    Node *tmp_node = NULL;
+    {
+      CriticalGuard(get_qs());
+      while (-EAGAIN == (err = hash_.del(node, tmp_node)))
+        ;
+    }
+    if (NULL != tmp_node) {
+      WaitQuiescent(get_qs());
+    }
+    return 0 == err;
+  }
+  Node nodes_[MAX_CLIENT_COUNT];
+  bool woken_[MAX_CLIENT_COUNT];
+  int64_t repost_cnt_;
+};
+
+class TestLockWaitMgr : public ::testing::Test
+{
+public:
+  TestLockWaitMgr() : tablet_id_(200001)
+  {
+    for (int64_t i = 0; i < MAX_ROW_COUNT; i++) {
+      objs_[i].set_int(i);
+      rowkeys_[i].assign(&objs_[i], 1);
+      owners_[i] = 0;
+    }
+  }
+  virtual void SetUp() override
+  {
+    // the requests are not bound to sessions in the test
+    GCONF._lcl_op_interval = 0;
+    ASSERT_EQ(OB_SUCCESS, mgr_.init());
+  }
+  virtual void TearDown() override
+  {
+    mgr_.destroy();
+  }
+  // try to lock the row, or wait on it if the row is locked by others
+  bool lock_or_wait(const int64_t client, const int64_t row, const int64_t recv_ts, bool &waiting)
+  {
+    bool locked = false;
+    rpc::ObLockWaitNode &node = mgr_.nodes_[client];
+    mgr_.setup(node, recv_ts);
+    waiting = false;
+    if (ATOMIC_BCAS(&owners_[row], 0, client + 1)) {
+      ObLockWaitMgr::Key key(&rowkeys_[row]);
+      mgr_.on_row_lock_acquired(tablet_id_, key);
+      bool unused = false;
+      mgr_.post_process(false, unused);
+      locked = true;
+    } else {
+      ObFunction<int(bool&, bool&)> recheck_func([&](bool &is_locked, bool &wait_on_row) -> int {
+        is_locked = 0 != ATOMIC_LOAD(&owners_[row]);
+        wait_on_row = true;
+        return OB_SUCCESS;
+      });
+      ATOMIC_STORE(&mgr_.woken_[client], false);
+      EXPECT_EQ(OB_SUCCESS, mgr_.post_lock(OB_TRY_LOCK_ROW_CONFLICT,
+                                           tablet_id_,
+                                           rowkeys_[row],
+                                           ObTimeUtility::current_time() + 10 * 1000 * 1000,
+                                           false, /*is_remote_sql*/
+                                           false, /*can_elr*/
+                                           0,
+                                           0,
+                                           ObTransID(client + 1),
+                                           ObTransID(ATOMIC_LOAD(&owners_[row])),
+                                           recheck_func));
+      bool need_wait = false;
+      waiting = mgr_.post_process(true, need_wait);
+    }
+    ObLockWaitMgr::clear_thread_node();
+    return locked;
+  }
+  void unlock(const int64_t client, const int64_t row)
+  {
+    ObLockWaitMgr::Key key(&rowkeys_[row]);
+    EXPECT_TRUE(ATOMIC_BCAS(&owners_[row], client + 1, 0));
+    mgr_.wakeup(tablet_id_, key);
+  }
+
+  ObMockLockWaitMgr mgr_;
+  ObTabletID tablet_id_;
+  ObObj objs_[MAX_ROW_COUNT];
+  ObStoreRowkey rowkeys_[MAX_ROW_COUNT];
+  int64_t owners_[MAX_ROW_COUNT];
+};
+
+TEST_F(TestLockWaitMgr, fifo_wakeup)
+{
+  bool waiting = false;
+  ASSERT_TRUE(lock_or_wait(0, 0, 100, waiting));
+  for (int64_t i = 1; i <= 3; i++) {
+    ASSERT_FALSE(lock_or_wait(i, 0, 100 + i, waiting));
+    ASSERT_TRUE(waiting);
+  }
+  // only the first waiter is waken up on each release
+  unlock(0, 0);
+  EXPECT_EQ(1, mgr_.repost_cnt_);
+  EXPECT_TRUE(mgr_.woken_[1]);
+  EXPECT_FALSE(mgr_.woken_[2]);
+  EXPECT_FALSE(mgr_.woken_[3]);
+
+  ObLockWaitMgr::TabletLockWaitStat stat;
+  ASSERT_EQ(OB_SUCCESS, mgr_.get_tablet_lock_wait_stat(tablet_id_, stat));
+  EXPECT_EQ(3, stat.wait_cnt_);
+  EXPECT_EQ(1, stat.wakeup_cnt_);
+  EXPECT_EQ(0, stat.retry_cnt_);
+}
+
+TEST_F(TestLockWaitMgr, handoff)
+{
+  bool waiting = false;
+  ASSERT_TRUE(lock_or_wait(0, 0, 100, waiting));
+  ASSERT_FALSE(lock_or_wait(1, 0, 101, waiting));
+  ASSERT_FALSE(lock_or_wait(2, 0, 102, waiting));
+  unlock(0, 0);
+  ASSERT_TRUE(mgr_.woken_[1]);
+
+  // the waken up request acquires the lock, the next waiter keeps waiting
+  // until the lock is released, rather than the request ends
+  ASSERT_TRUE(lock_or_wait(1, 0, 101, waiting));
+  EXPECT_EQ(1, mgr_.repost_cnt_);
+  EXPECT_FALSE(mgr_.woken_[2]);
+  unlock(1, 0);
+  EXPECT_EQ(2, mgr_.repost_cnt_);
+  EXPECT_TRUE(mgr_.woken_[2]);
+}
+
+TEST_F(TestLockWaitMgr, wakeup_at_request_end)
+{
+  bool waiting = false;
+  ASSERT_TRUE(lock_or_wait(0, 0, 100, waiting));
+  ASSERT_FALSE(lock_or_wait(1, 0, 101, waiting));
+  ASSERT_FALSE(lock_or_wait(2, 0, 102, waiting));
+  unlock(0, 0);
+  ASSERT_TRUE(mgr_.woken_[1]);
+
+  // the waken up request does not touch the row any more, the next waiter is
+  // waken up at the end of the request
+  rpc::ObLockWaitNode &node = mgr_.nodes_[1];
+  bool unused = false;
+  mgr_.setup(node, 101);
+  mgr_.post_process(false, unused);
+  ObLockWaitMgr::clear_thread_node();
+  EXPECT_EQ(2, mgr_.repost_cnt_);
+  EXPECT_TRUE(mgr_.woken_[2]);
+}
+
+// N clients contend on K rows, each client locks a random row, holds it for a
+// while and releases it.
+TEST_F(TestLockWaitMgr, contention_benchmark)
+{
+  const int64_t client_cnt = 32;
+  const int64_t row_cnt = 4;
+  const int64_t lock_cnt_per_client = 2000;
+  const int64_t hold_time_us = 10;
+  int64_t conflict_cnt = 0;
+  int64_t cancel_cnt = 0;
+  std::vector<std::thread> clients;
+  const int64_t start_ts = ObTimeUtility::current_time();
+  for (int64_t i = 0; i < client_cnt; i++) {
+    clients.push_back(std::thread([&, i]() {
+      int64_t row = ObRandom::rand(0, row_cnt - 1);
+      int64_t recv_ts = ObTimeUtility::current_time();
+      int64_t lock_cnt = 0;
+      while (lock_cnt < lock_cnt_per_client) {
+        bool waiting = false;
+        if (lock_or_wait(i, row, recv_ts, waiting)) {
+          ob_usleep(hold_time_us);
+          unlock(i, row);
+          // the node is reused by the next request of the client
+          mgr_.nodes_[i].try_lock_times_ = 0;
+          lock_cnt++;
+          row = ObRandom::rand(0, row_cnt - 1);
+          recv_ts = ObTimeUtility::current_time();
+        } else {
+          ATOMIC_INC(&conflict_cnt);
+          if (waiting) {
+            const int64_t wait_start_ts = ObTimeUtility::current_time();
+            while (!ATOMIC_LOAD(&mgr_.woken_[i])) {
+              if (ObTimeUtility::current_time() - wait_start_ts > 1000
+                  && mgr_.cancel(&mgr_.nodes_[i])) {
+                // missed the wakeup, which is done by the background thread
+                ATOMIC_INC(&cancel_cnt);
+                break;
+              }
+              sched_yield();
+            }
+          }
+        }
+      }
+    }));
+  }
+  for (auto &client : clients) {
+    client.join();
+  }
+  const int64_t elapsed_us = ObTimeUtility::current_time() - start_ts;
+  const int64_t lock_cnt = client_cnt * lock_cnt_per_client;
+  ObLockWaitMgr::TabletLockWaitStat stat;
+  ASSERT_EQ(OB_SUCCESS, mgr_.get_tablet_lock_wait_stat(tablet_id_, stat));
+  STORAGE_LOG(INFO, "lock wait benchmark", K(client_cnt), K(row_cnt), K(lock_cnt), K(elapsed_us),
+              "lock_per_sec", lock_cnt * 1000000 / (elapsed_us + 1),
+              K(conflict_cnt), K(cancel_cnt), "repost_cnt", mgr_.repost_cnt_, K(stat));
+  std::cout << "clients=" << client_cnt << " rows=" << row_cnt
+            << " locks=" << lock_cnt << " elapsed_us=" << elapsed_us
+            << " conflicts=" << conflict_cnt << " wakeups=" << mgr_.repost_cnt_
+            << " retries=" << stat.retry_cnt_ << " cancels=" << cancel_cnt << std::endl;
+  EXPECT_TRUE(mgr_.is_hash_empty());
+}
+
+} // end namespace unittest
+} // end namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  system("rm -rf test_lock_wait_mgr.log*");
+  OB_LOGGER.set_file_name("test_lock_wait_mgr.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
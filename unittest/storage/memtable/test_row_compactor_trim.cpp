@@ -0,0 +1,157 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+
+#define private public
+#define protected public
+#include "storage/memtable/ob_row_compactor.h"
+#include "storage/memtable/mvcc/ob_mvcc_row.h"
+#include "storage/memtable/mvcc/ob_multi_version_iterator.h"
+
+namespace oceanbase
+{
+namespace unittest
+{
+using namespace oceanbase::common;
+using namespace oceanbase::memtable;
+
+// The row looks like(from newest to oldest):
+//   n6(60) -> c5(50, compact) -> n4(40) -> n3(30) -> c2(20, compact) -> n1(10) -> n0(5)
+class TestRowCompactorTrim : public ::testing::Test
+{
+public:
+  static const int64_t NODE_CNT = 7;
+  virtual void SetUp() override
+  {
+    const int64_t versions[NODE_CNT] = {5, 10, 20, 30, 40, 50, 60};
+    row_.reset();
+    for (int64_t i = 0; i < NODE_CNT; i++) {
+      nodes_[i].trans_version_ = versions[i];
+      nodes_[i].type_ = NDT_NORMAL;
+      nodes_[i].set_committed();
+      nodes_[i].prev_ = (0 == i ? NULL : &nodes_[i - 1]);
+      nodes_[i].next_ = (NODE_CNT - 1 == i ? NULL : &nodes_[i + 1]);
+    }
+    nodes_[2].type_ = NDT_COMPACT;
+    nodes_[5].type_ = NDT_COMPACT;
+    row_.list_head_ = &nodes_[NODE_CNT - 1];
+    row_.latest_compact_node_ = &nodes_[5];
+    compactor_.row_ = &row_;
+  }
+
+  int64_t chain_length() const
+  {
+    int64_t cnt = 0;
+    for (ObMvccTransNode *iter = row_.get_list_head(); NULL != iter; iter = iter->prev_) {
+      cnt++;
+    }
+    return cnt;
+  }
+
+  ObMvccTransNode nodes_[NODE_CNT];
+  ObMvccRow row_;
+  ObMemtableRowCompactor compactor_;
+};
+
+TEST_F(TestRowCompactorTrim, trim_below_trim_version)
+{
+  // no compact node is old enough, the row is left untouched
+  compactor_.trim_compacted_nodes_(15);
+  EXPECT_EQ(NODE_CNT, chain_length());
+  EXPECT_EQ(&nodes_[1], nodes_[2].prev_);
+
+  // invalid trim versions never trim
+  compactor_.trim_compacted_nodes_(0);
+  compactor_.trim_compacted_nodes_(INT64_MAX);
+  EXPECT_EQ(NODE_CNT, chain_length());
+
+  // the newest compact node not larger than the trim version is kept and the
+  // nodes below it are detached
+  compactor_.trim_compacted_nodes_(45);
+  EXPECT_EQ(5, chain_length());
+  EXPECT_EQ(NULL, nodes_[2].prev_);
+  EXPECT_EQ(&nodes_[3], nodes_[2].next_);
+
+  // trim again with a larger version cuts at the latest compact node
+  compactor_.trim_compacted_nodes_(50);
+  EXPECT_EQ(2, chain_length());
+  EXPECT_EQ(NULL, nodes_[5].prev_);
+}
+
+TEST_F(TestRowCompactorTrim, reader_positioned_on_trimmed_node)
+{
+  // a reader without the row latch already stands on n1 before the trim
+  ObMvccTransNode *reader_pos = &nodes_[1];
+  compactor_.trim_compacted_nodes_(25);
+  EXPECT_EQ(NULL, nodes_[2].prev_);
+
+  // the detached nodes keep their own prev_, so the reader can finish its
+  // traversal as if nothing happened
+  int64_t cnt = 0;
+  int64_t last_version = INT64_MAX;
+  for (ObMvccTransNode *iter = reader_pos; NULL != iter; iter = iter->prev_) {
+    EXPECT_LT(iter->trans_version_, last_version);
+    last_version = iter->trans_version_;
+    cnt++;
+  }
+  EXPECT_EQ(2, cnt);
+  EXPECT_EQ(&nodes_[0], nodes_[1].prev_);
+}
+
+TEST_F(TestRowCompactorTrim, multi_version_iter_on_trimmed_row)
+{
+  compactor_.trim_compacted_nodes_(25);
+
+  // the multi version start of the mini merge is below the trimmed compact
+  // node, which must be output as the compacted row rather than be skipped
+  ObMultiVersionValueIterator iter;
+  iter.is_inited_ = true;
+  iter.version_range_.base_version_ = 0;
+  iter.version_range_.multi_version_start_ = 10;
+  iter.version_range_.snapshot_version_ = INT64_MAX;
+  iter.multi_version_iter_ = &nodes_[4];
+
+  const void *tnode = NULL;
+  EXPECT_EQ(OB_SUCCESS, iter.get_next_multi_version_node(tnode));
+  EXPECT_EQ(&nodes_[4], tnode);
+  EXPECT_FALSE(iter.is_node_compacted());
+  EXPECT_EQ(OB_SUCCESS, iter.get_next_multi_version_node(tnode));
+  EXPECT_EQ(&nodes_[3], tnode);
+  EXPECT_EQ(OB_SUCCESS, iter.get_next_multi_version_node(tnode));
+  EXPECT_EQ(&nodes_[2], tnode);
+  EXPECT_TRUE(iter.is_node_compacted());
+  EXPECT_EQ(OB_ITER_END, iter.get_next_multi_version_node(tnode));
+
+  // an untrimmed compact node above the multi version start is still skipped
+  iter.reset();
+  iter.is_inited_ = true;
+  iter.version_range_.base_version_ = 0;
+  iter.version_range_.multi_version_start_ = 10;
+  iter.version_range_.snapshot_version_ = INT64_MAX;
+  iter.multi_version_iter_ = &nodes_[5];
+  EXPECT_EQ(OB_SUCCESS, iter.get_next_multi_version_node(tnode));
+  EXPECT_EQ(&nodes_[4], tnode);
+  EXPECT_FALSE(iter.is_node_compacted());
+}
+
+} // end unittest
+} // end oceanbase
+
+int main(int argc, char **argv)
+{
+  system("rm -rf test_row_compactor_trim.log*");
+  OB_LOGGER.set_file_name("test_row_compactor_trim.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
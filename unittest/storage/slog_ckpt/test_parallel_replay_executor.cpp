@@ -0,0 +1,82 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX STORAGE
+
+#include <gtest/gtest.h>
+#include "storage/slog_ckpt/ob_parallel_replay_executor.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace storage;
+
+namespace unittest
+{
+
+TEST(TestParallelReplayExecutor, execute)
+{
+  const int64_t task_cnt = 1000;
+  int64_t done_flags[task_cnt];
+  int64_t sum = 0;
+  MEMSET(done_flags, 0, sizeof(done_flags));
+  ObParallelReplayExecutor executor;
+  ObParallelReplayExecutor::TaskFunc func = [&](const int64_t task_idx) -> int {
+    ATOMIC_INC(&done_flags[task_idx]);
+    ATOMIC_AAF(&sum, task_idx);
+    return OB_SUCCESS;
+  };
+  ASSERT_EQ(OB_SUCCESS, executor.execute(4, task_cnt, func));
+  ASSERT_EQ(task_cnt * (task_cnt - 1) / 2, sum);
+  for (int64_t i = 0; i < task_cnt; ++i) {
+    ASSERT_EQ(1, done_flags[i]);
+  }
+
+  // the executor could be used again, and by the current thread only
+  sum = 0;
+  ASSERT_EQ(OB_SUCCESS, executor.execute(8, 3, func));
+  ASSERT_EQ(3, sum);
+  sum = 0;
+  ASSERT_EQ(OB_SUCCESS, executor.execute(1, 10, func));
+  ASSERT_EQ(45, sum);
+  ASSERT_EQ(OB_SUCCESS, executor.execute(4, 0, func));
+  ASSERT_EQ(OB_INVALID_ARGUMENT, executor.execute(0, 10, func));
+}
+
+TEST(TestParallelReplayExecutor, fail)
+{
+  const int64_t task_cnt = 10000;
+  int64_t run_cnt = 0;
+  ObParallelReplayExecutor executor;
+  ObParallelReplayExecutor::TaskFunc func = [&](const int64_t task_idx) -> int {
+    ATOMIC_INC(&run_cnt);
+    return 100 == task_idx ? OB_ERR_UNEXPECTED : OB_SUCCESS;
+  };
+  ASSERT_EQ(OB_ERR_UNEXPECTED, executor.execute(4, task_cnt, func));
+  // no more task is picked after the failure
+  ASSERT_LT(run_cnt, task_cnt);
+  run_cnt = 0;
+  ASSERT_EQ(OB_ERR_UNEXPECTED, executor.execute(1, task_cnt, func));
+  ASSERT_EQ(101, run_cnt);
+}
+
+}  // end namespace unittest
+}  // end namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  system("rm -f test_parallel_replay_executor.log*");
+  OB_LOGGER.set_file_name("test_parallel_replay_executor.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
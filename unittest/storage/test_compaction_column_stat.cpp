@@ -0,0 +1,239 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#define private public
+#include "storage/compaction/ob_compaction_column_stat.h"
+#undef private
+#include "share/stat/ob_column_stat.h"
+#include "share/stat/ob_opt_column_stat.h"
+#include "share/stat/ob_opt_table_stat.h"
+#include "sql/engine/expr/ob_expr_estimate_ndv.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace blocksstable;
+using namespace compaction;
+using namespace share::schema;
+
+namespace unittest
+{
+
+static ObDatumCmpFuncType get_int_cmp_func()
+{
+  return ObDatumFuncs::get_basic_func(ObIntType, CS_TYPE_BINARY)->null_first_cmp_;
+}
+
+TEST(TestEquiDepthSampler, exact)
+{
+  ObArenaAllocator allocator;
+  ObEquiDepthSampler sampler;
+  ObStorageDatum datum;
+  ASSERT_EQ(OB_SUCCESS, sampler.init(get_int_cmp_func(), allocator));
+  for (int64_t i = 0; i < 100; ++i) {
+    datum.set_int(i);
+    ASSERT_EQ(OB_SUCCESS, sampler.add(datum));
+    ASSERT_EQ(OB_SUCCESS, sampler.add(datum));
+  }
+  ASSERT_EQ(OB_SUCCESS, sampler.finish());
+  ASSERT_TRUE(sampler.is_exact());
+  ASSERT_EQ(100, sampler.get_sample_cnt());
+  for (int64_t i = 0; i < sampler.get_sample_cnt(); ++i) {
+    const ObEquiDepthSampler::Sample &sample = sampler.get_sample(i);
+    ASSERT_EQ(i, sample.holder_->get().get_int());
+    ASSERT_EQ(2, sample.repeat_cnt_);
+    ASSERT_EQ((i + 1) * 2, sample.endpoint_num_);
+  }
+}
+
+TEST(TestEquiDepthSampler, bounded)
+{
+  ObArenaAllocator allocator;
+  ObEquiDepthSampler sampler;
+  ObStorageDatum datum;
+  const int64_t value_cnt = 100000;
+  ASSERT_EQ(OB_SUCCESS, sampler.init(get_int_cmp_func(), allocator));
+  for (int64_t i = 0; i < value_cnt; ++i) {
+    datum.set_int(i);
+    for (int64_t j = 0; j < 3; ++j) {
+      ASSERT_EQ(OB_SUCCESS, sampler.add(datum));
+    }
+  }
+  ASSERT_EQ(OB_SUCCESS, sampler.finish());
+  ASSERT_FALSE(sampler.is_exact());
+  ASSERT_LE(sampler.get_sample_cnt(), ObEquiDepthSampler::MAX_SAMPLE_CNT);
+  ASSERT_GE(sampler.get_sample_cnt(), ObEquiDepthSampler::MAX_SAMPLE_CNT / 4);
+  ASSERT_EQ(0, sampler.get_sample(0).holder_->get().get_int());
+  const ObEquiDepthSampler::Sample &last = sampler.get_sample(sampler.get_sample_cnt() - 1);
+  ASSERT_EQ(value_cnt - 1, last.holder_->get().get_int());
+  ASSERT_EQ(value_cnt * 3, last.endpoint_num_);
+  for (int64_t i = 1; i < sampler.get_sample_cnt(); ++i) {
+    const ObEquiDepthSampler::Sample &prev = sampler.get_sample(i - 1);
+    const ObEquiDepthSampler::Sample &cur = sampler.get_sample(i);
+    ASSERT_LT(prev.holder_->get().get_int(), cur.holder_->get().get_int());
+    ASSERT_EQ(cur.holder_->get().get_int() * 3 + 3, cur.endpoint_num_);
+    ASSERT_EQ(3, cur.repeat_cnt_);
+  }
+}
+
+TEST(TestColumnStatCollector, add_row)
+{
+  ObArenaAllocator allocator;
+  ObSEArray<ObColDesc, 4> col_descs;
+  ObColDesc col_desc;
+  col_desc.col_type_.set_int();
+  col_desc.col_id_ = OB_APP_MIN_COLUMN_ID;
+  ASSERT_EQ(OB_SUCCESS, col_descs.push_back(col_desc));
+  col_desc.col_id_ = OB_HIDDEN_TRANS_VERSION_COLUMN_ID;
+  ASSERT_EQ(OB_SUCCESS, col_descs.push_back(col_desc));
+  col_desc.col_id_ = OB_HIDDEN_SQL_SEQUENCE_COLUMN_ID;
+  ASSERT_EQ(OB_SUCCESS, col_descs.push_back(col_desc));
+  col_desc.col_id_ = OB_APP_MIN_COLUMN_ID + 1;
+  ASSERT_EQ(OB_SUCCESS, col_descs.push_back(col_desc));
+
+  ObColumnStatCollector collector;
+  ObDatumRow row;
+  const int64_t row_cnt = 10000;
+  ASSERT_EQ(OB_SUCCESS, collector.init(col_descs));
+  ASSERT_EQ(2, collector.get_column_cnt());
+  ASSERT_EQ(OB_SUCCESS, row.init(allocator, col_descs.count()));
+  for (int64_t i = 0; i < row_cnt; ++i) {
+    row.storage_datums_[0].set_int(i);
+    row.storage_datums_[1].set_int(-1);
+    row.storage_datums_[2].set_int(0);
+    if (0 == i % 10) {
+      row.storage_datums_[3].set_null();
+    } else {
+      row.storage_datums_[3].set_int(i % 100);
+    }
+    ASSERT_EQ(OB_SUCCESS, collector.add_row(row));
+  }
+  ASSERT_EQ(OB_SUCCESS, collector.finish());
+  ASSERT_TRUE(collector.is_complete());
+  ASSERT_EQ(row_cnt, collector.get_row_cnt());
+
+  const ObColumnStatCollector::ColumnStat &key_column = collector.get_column(0);
+  ASSERT_EQ(OB_APP_MIN_COLUMN_ID, key_column.column_id_);
+  ASSERT_EQ(0, key_column.num_null_);
+  ASSERT_EQ(0, key_column.min_.get().get_int());
+  ASSERT_EQ(row_cnt - 1, key_column.max_.get().get_int());
+  ASSERT_TRUE(nullptr != key_column.sampler_);
+  ASSERT_EQ(row_cnt, key_column.sampler_->get_row_cnt());
+
+  const ObColumnStatCollector::ColumnStat &column = collector.get_column(1);
+  double ndv = 0;
+  ASSERT_EQ(OB_APP_MIN_COLUMN_ID + 1, column.column_id_);
+  ASSERT_EQ(row_cnt / 10, column.num_null_);
+  ASSERT_EQ(row_cnt - row_cnt / 10, column.num_not_null_);
+  ASSERT_EQ(1, column.min_.get().get_int());
+  ASSERT_EQ(99, column.max_.get().get_int());
+  ASSERT_TRUE(nullptr == column.sampler_);
+  ASSERT_EQ(OB_SUCCESS, sql::ObExprEstimateNdv::llc_estimate_ndv(
+      ndv, ObString(ObColumnStat::NUM_LLC_BUCKET, column.llc_bitmap_)));
+  ASSERT_GT(ndv, 80);
+  ASSERT_LT(ndv, 120);
+
+  // the stats are discarded once some rows are not seen
+  collector.set_incomplete();
+  ASSERT_EQ(OB_SUCCESS, collector.add_row(row));
+  ASSERT_EQ(row_cnt, collector.get_row_cnt());
+  ASSERT_FALSE(collector.is_complete());
+}
+
+TEST(TestColumnStatReportTask, deep_copy)
+{
+  ObArenaAllocator allocator;
+  ObOptTableStat table_stat;
+  ObOptColumnStat *column_stats[2] = {nullptr, nullptr};
+  const int64_t column_cnt = 2;
+  table_stat.set_table_id(500001);
+  table_stat.set_partition_id(500002);
+  table_stat.set_row_count(100);
+  for (int64_t i = 0; i < column_cnt; ++i) {
+    column_stats[i] = OB_NEWx(ObOptColumnStat, &allocator, allocator);
+    ASSERT_TRUE(nullptr != column_stats[i]);
+    column_stats[i]->set_table_id(500001);
+    column_stats[i]->set_partition_id(500002);
+    column_stats[i]->set_column_id(OB_APP_MIN_COLUMN_ID + i);
+    column_stats[i]->set_num_distinct(10 * (i + 1));
+    ObObj value;
+    value.set_int(i);
+    column_stats[i]->set_min_value(value);
+    column_stats[i]->set_max_value(value);
+  }
+  // only the leading column has a rebuilt histogram
+  ObObj endpoint;
+  endpoint.set_int(7);
+  ASSERT_EQ(OB_SUCCESS, column_stats[0]->add_bucket(100, endpoint, 100));
+  column_stats[0]->get_histogram().set_type(ObHistType::FREQUENCY);
+  column_stats[0]->get_histogram().set_sample_size(100);
+
+  ObColumnStatReportTask task;
+  ASSERT_EQ(OB_INVALID_ARGUMENT, task.init(OB_INVALID_TENANT_ID, table_stat, column_stats, column_cnt));
+  ASSERT_EQ(OB_SUCCESS, task.init(1001, table_stat, column_stats, column_cnt));
+  ASSERT_EQ(OB_INIT_TWICE, task.init(1001, table_stat, column_stats, column_cnt));
+
+  const int64_t buf_size = task.get_deep_copy_size();
+  char *buf = static_cast<char *>(allocator.alloc(buf_size));
+  ASSERT_TRUE(nullptr != buf);
+  ASSERT_TRUE(nullptr == task.deep_copy(buf, buf_size - 1));
+  ObColumnStatReportTask *copy = static_cast<ObColumnStatReportTask *>(task.deep_copy(buf, buf_size));
+  ASSERT_TRUE(nullptr != copy);
+  ASSERT_TRUE(copy->is_copy_);
+  ASSERT_TRUE(task == *copy);
+  ASSERT_EQ(task.hash(), copy->hash());
+
+  // the copy does not reference the stats of the merge
+  ASSERT_NE(&table_stat, copy->table_stat_);
+  ASSERT_EQ(100, copy->table_stat_->get_row_count());
+  ASSERT_EQ(column_cnt, copy->column_cnt_);
+  for (int64_t i = 0; i < column_cnt; ++i) {
+    const ObOptColumnStat *col_stat = copy->column_stats_[i];
+    ASSERT_NE(column_stats[i], col_stat);
+    ASSERT_TRUE(reinterpret_cast<const char *>(col_stat) >= buf);
+    ASSERT_TRUE(reinterpret_cast<const char *>(col_stat) < buf + buf_size);
+    ASSERT_EQ(OB_APP_MIN_COLUMN_ID + i, col_stat->get_column_id());
+    ASSERT_EQ(10 * (i + 1), col_stat->get_num_distinct());
+    ASSERT_EQ(i, col_stat->get_min_value().get_int());
+  }
+  ASSERT_TRUE(copy->column_stats_[0]->get_histogram().is_valid());
+  ASSERT_EQ(1, copy->column_stats_[0]->get_histogram().get_bucket_size());
+  ASSERT_EQ(7, copy->column_stats_[0]->get_histogram().get(0).endpoint_value_.get_int());
+  // the histogram of the other column is left for keep_histograms_
+  ASSERT_FALSE(copy->column_stats_[1]->get_histogram().is_valid());
+
+  // the report of another partition is not deduplicated
+  ObOptTableStat other_table_stat;
+  ObColumnStatReportTask other_task;
+  other_table_stat.set_table_id(500001);
+  other_table_stat.set_partition_id(500003);
+  ASSERT_EQ(OB_SUCCESS, other_task.init(1001, other_table_stat, column_stats, column_cnt));
+  ASSERT_FALSE(other_task == *copy);
+
+  copy->~ObColumnStatReportTask();
+  for (int64_t i = 0; i < column_cnt; ++i) {
+    column_stats[i]->~ObOptColumnStat();
+  }
+}
+
+} // namespace unittest
+} // namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  system("rm -f test_compaction_column_stat.log*");
+  OB_LOGGER.set_file_name("test_compaction_column_stat.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
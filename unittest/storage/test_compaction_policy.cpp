@@ -32,6 +32,7 @@
 #include "storage/test_dml_common.h"
 #include "storage/mockcontainer/mock_ob_iterator.h"
 #include "storage/slog_ckpt/ob_server_checkpoint_slog_handler.h"
+#include "observer/omt/ob_tenant_config_mgr.h"
 
 
 namespace oceanbase
@@ -103,6 +104,7 @@ public:
     const int64_t snapshot_gc_ts,
     common::ObIArray<ObTenantFreezeInfoMgr::FreezeInfo> &freeze_infos,
     common::ObIArray<share::ObSnapshotInfo> &snapshots);
+  static int set_uncommitted_row_backfill(const bool enable);
 
 public:
   TestCompactionPolicy();
@@ -535,6 +537,18 @@ int TestCompactionPolicy::prepare_freeze_info(
   return ret;
 }
 
+int TestCompactionPolicy::set_uncommitted_row_backfill(const bool enable)
+{
+  int ret = OB_SUCCESS;
+  omt::ObTenantConfigGuard tenant_config(TENANT_CONF(MTL_ID()));
+  if (OB_UNLIKELY(!tenant_config.is_valid())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("tenant config is invalid", K(ret));
+  } else {
+    tenant_config->_enable_uncommitted_row_backfill = enable;
+  }
+  return ret;
+}
 
 TEST_F(TestCompactionPolicy, basic_create_sstable)
 {
@@ -765,6 +779,119 @@ TEST_F(TestCompactionPolicy, check_minor_merge_basic)
   ASSERT_EQ(5, result.handle_.get_count());
 }
 
+TEST_F(TestCompactionPolicy, check_backfill_uncommitted_rows)
+{
+  int ret = OB_SUCCESS;
+  common::ObArray<ObTenantFreezeInfoMgr::FreezeInfo> freeze_info;
+  common::ObArray<share::ObSnapshotInfo> snapshots;
+  ASSERT_EQ(OB_SUCCESS, freeze_info.push_back(ObTenantFreezeInfoMgr::FreezeInfo(1, 1, 0)));
+
+  ret = TestCompactionPolicy::prepare_freeze_info(500, freeze_info, snapshots);
+  ASSERT_EQ(OB_SUCCESS, ret);
+
+  const char *key_data =
+      "table_type    start_scn    end_scn    max_ver    upper_ver\n"
+      "10            0            1          1          1        \n"
+      "11            1            200        200        250      \n";
+
+  ret = prepare_tablet(key_data, 200, 200);
+  ASSERT_EQ(OB_SUCCESS, ret);
+  ASSERT_EQ(OB_SUCCESS, set_uncommitted_row_backfill(true));
+
+  ObTablet &tablet = *tablet_handle_.get_obj();
+  ObSSTable *sstable = static_cast<ObSSTable *>(minor_tables_.at(0).get_table());
+  bool need_merge = false;
+  // the only minor sstable has no uncommitted row
+  ASSERT_FALSE(ObPartitionMergePolicy::need_backfill_uncommitted_rows(*sstable));
+  ASSERT_EQ(OB_SUCCESS, ObPartitionMergePolicy::check_need_mini_minor_merge(tablet, need_merge));
+  ASSERT_FALSE(need_merge);
+
+  // all the uncommitted rows are decided, the sstable is rewritten alone
+  sstable->meta_.basic_meta_.contain_uncommitted_row_ = true;
+  ASSERT_TRUE(ObPartitionMergePolicy::need_backfill_uncommitted_rows(*sstable));
+  ASSERT_EQ(OB_SUCCESS, ObPartitionMergePolicy::check_need_mini_minor_merge(tablet, need_merge));
+  ASSERT_TRUE(need_merge);
+
+  ObGetMergeTablesResult result;
+  result.suggest_merge_type_ = ObMergeType::MINI_MINOR_MERGE;
+  ASSERT_EQ(OB_SUCCESS, result.handle_.add_table(sstable));
+  ASSERT_EQ(OB_SUCCESS, ObPartitionMergePolicy::refine_mini_minor_merge_result(result));
+  ASSERT_EQ(ObMergeType::MINOR_MERGE, result.suggest_merge_type_);
+  ASSERT_EQ(1, result.handle_.get_count());
+  ASSERT_EQ(OB_SUCCESS, set_uncommitted_row_backfill(false));
+}
+
+TEST_F(TestCompactionPolicy, check_no_backfill_undecided_rows)
+{
+  int ret = OB_SUCCESS;
+  common::ObArray<ObTenantFreezeInfoMgr::FreezeInfo> freeze_info;
+  common::ObArray<share::ObSnapshotInfo> snapshots;
+  ASSERT_EQ(OB_SUCCESS, freeze_info.push_back(ObTenantFreezeInfoMgr::FreezeInfo(1, 1, 0)));
+
+  ret = TestCompactionPolicy::prepare_freeze_info(500, freeze_info, snapshots);
+  ASSERT_EQ(OB_SUCCESS, ret);
+
+  const char *key_data =
+      "table_type    start_scn    end_scn    max_ver    upper_ver\n"
+      "10            0            1          1          1        \n"
+      "11            1            200        200        9223372036854775807\n";
+
+  ret = prepare_tablet(key_data, 200, 200);
+  ASSERT_EQ(OB_SUCCESS, ret);
+  ASSERT_EQ(OB_SUCCESS, set_uncommitted_row_backfill(true));
+
+  // the upper trans version is not calculated until all the transactions are decided
+  ObTablet &tablet = *tablet_handle_.get_obj();
+  ObSSTable *sstable = static_cast<ObSSTable *>(minor_tables_.at(0).get_table());
+  sstable->meta_.basic_meta_.contain_uncommitted_row_ = true;
+  ASSERT_EQ(INT64_MAX, sstable->get_upper_trans_version());
+  ASSERT_FALSE(ObPartitionMergePolicy::need_backfill_uncommitted_rows(*sstable));
+  bool need_merge = true;
+  ASSERT_EQ(OB_SUCCESS, ObPartitionMergePolicy::check_need_mini_minor_merge(tablet, need_merge));
+  ASSERT_FALSE(need_merge);
+
+  ObGetMergeTablesResult result;
+  result.suggest_merge_type_ = ObMergeType::MINI_MINOR_MERGE;
+  ASSERT_EQ(OB_SUCCESS, result.handle_.add_table(sstable));
+  ASSERT_EQ(OB_SUCCESS, ObPartitionMergePolicy::refine_mini_minor_merge_result(result));
+  ASSERT_EQ(0, result.handle_.get_count());
+  ASSERT_EQ(OB_SUCCESS, set_uncommitted_row_backfill(false));
+}
+
+TEST_F(TestCompactionPolicy, check_backfill_disabled)
+{
+  int ret = OB_SUCCESS;
+  common::ObArray<ObTenantFreezeInfoMgr::FreezeInfo> freeze_info;
+  common::ObArray<share::ObSnapshotInfo> snapshots;
+  ASSERT_EQ(OB_SUCCESS, freeze_info.push_back(ObTenantFreezeInfoMgr::FreezeInfo(1, 1, 0)));
+
+  ret = TestCompactionPolicy::prepare_freeze_info(500, freeze_info, snapshots);
+  ASSERT_EQ(OB_SUCCESS, ret);
+
+  const char *key_data =
+      "table_type    start_scn    end_scn    max_ver    upper_ver\n"
+      "10            0            1          1          1        \n"
+      "11            1            200        200        250      \n";
+
+  ret = prepare_tablet(key_data, 200, 200);
+  ASSERT_EQ(OB_SUCCESS, ret);
+  ASSERT_EQ(OB_SUCCESS, set_uncommitted_row_backfill(false));
+
+  ObTablet &tablet = *tablet_handle_.get_obj();
+  ObSSTable *sstable = static_cast<ObSSTable *>(minor_tables_.at(0).get_table());
+  sstable->meta_.basic_meta_.contain_uncommitted_row_ = true;
+  ASSERT_TRUE(ObPartitionMergePolicy::need_backfill_uncommitted_rows(*sstable));
+  bool need_merge = true;
+  ASSERT_EQ(OB_SUCCESS, ObPartitionMergePolicy::check_need_mini_minor_merge(tablet, need_merge));
+  ASSERT_FALSE(need_merge);
+
+  ObGetMergeTablesResult result;
+  result.suggest_merge_type_ = ObMergeType::MINI_MINOR_MERGE;
+  ASSERT_EQ(OB_SUCCESS, result.handle_.add_table(sstable));
+  ASSERT_EQ(OB_SUCCESS, ObPartitionMergePolicy::refine_mini_minor_merge_result(result));
+  ASSERT_EQ(0, result.handle_.get_count());
+}
+
 TEST_F(TestCompactionPolicy, check_no_need_minor_merge)
 {
   int ret = OB_SUCCESS;
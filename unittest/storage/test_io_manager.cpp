@@ -191,6 +191,93 @@ TEST_F(TestIOStruct, IOFlag)
   ASSERT_FALSE(flag2.is_valid());
 }
 
+TEST_F(TestIOStruct, IOCategoryLimit)
+{
+  // the categories split from sys io
+  ASSERT_EQ(ObIOCategory::COMPACTION_IO, get_io_category_enum("compaction"));
+  ASSERT_EQ(ObIOCategory::MIGRATION_IO, get_io_category_enum("MIGRATION"));
+  ASSERT_EQ(ObIOCategory::BACKUP_IO, get_io_category_enum("backup"));
+  ASSERT_TRUE(is_sys_sub_category(ObIOCategory::BACKUP_IO));
+  ASSERT_FALSE(is_sys_sub_category(ObIOCategory::USER_IO));
+  set_thread_sys_io_category(ObIOCategory::COMPACTION_IO);
+  ASSERT_EQ(ObIOCategory::COMPACTION_IO, get_thread_sys_io_category());
+  set_thread_sys_io_category(ObIOCategory::MAX_CATEGORY);
+
+  // normal usage
+  ObTenantIOConfig io_config;
+  ObTenantIOConfig io_config2;
+  ASSERT_SUCC(io_config.parse_category_limit_config(""));
+  ASSERT_TRUE(io_config == io_config2);
+  ASSERT_SUCC(io_config.parse_category_limit_config("backup: 0,0,200,100; compaction: 1000,2000,0,0"));
+  const ObTenantIOConfig::CategoryLimit &backup_limit = io_config.category_limits_[static_cast<int>(ObIOCategory::BACKUP_IO)];
+  ASSERT_EQ(0, backup_limit.max_iops_[static_cast<int>(ObIOMode::READ)]);
+  ASSERT_EQ(200L * 1024L * 1024L, backup_limit.max_bandwidth_[static_cast<int>(ObIOMode::READ)]);
+  ASSERT_EQ(100L * 1024L * 1024L, backup_limit.max_bandwidth_[static_cast<int>(ObIOMode::WRITE)]);
+  const ObTenantIOConfig::CategoryLimit &compaction_limit = io_config.category_limits_[static_cast<int>(ObIOCategory::COMPACTION_IO)];
+  ASSERT_EQ(1000, compaction_limit.max_iops_[static_cast<int>(ObIOMode::READ)]);
+  ASSERT_EQ(2000, compaction_limit.max_iops_[static_cast<int>(ObIOMode::WRITE)]);
+  ASSERT_EQ(0, compaction_limit.max_bandwidth_[static_cast<int>(ObIOMode::WRITE)]);
+  ASSERT_FALSE(io_config == io_config2);
+
+  // invalid config
+  ASSERT_FAIL(io_config2.parse_category_limit_config("unknown: 0,0,200,200"));
+  ASSERT_FAIL(io_config2.parse_category_limit_config("backup: 0,0,-1,200"));
+  ASSERT_FAIL(io_config2.parse_category_limit_config("backup: 0,0"));
+}
+
+TEST_F(TestIOStruct, IOLatencyHistogram)
+{
+  // bucket of the latency
+  for (int64_t latency_us = 0; latency_us < 100000; latency_us += 7) {
+    const int64_t idx = ObIOLatencyHistogram::get_bucket_idx(latency_us);
+    ASSERT_LT(idx, ObIOLatencyHistogram::BUCKET_CNT);
+    ASSERT_GE(ObIOLatencyHistogram::get_bucket_upper_bound(idx), latency_us);
+    ASSERT_LE(ObIOLatencyHistogram::get_bucket_upper_bound(idx), latency_us + latency_us / ObIOLatencyHistogram::SUB_BUCKET_CNT);
+    if (idx > 0) {
+      ASSERT_LT(ObIOLatencyHistogram::get_bucket_upper_bound(idx - 1), latency_us);
+    }
+  }
+  ASSERT_EQ(ObIOLatencyHistogram::BUCKET_CNT - 1, ObIOLatencyHistogram::get_bucket_idx(INT64_MAX));
+
+  // percentiles
+  ObIOLatencyHistogram histogram;
+  ASSERT_EQ(0, histogram.get_percentile(99));
+  for (int64_t i = 1; i <= 1000; ++i) {
+    histogram.record(i);
+  }
+  ASSERT_EQ(1000, histogram.get_count());
+  ASSERT_EQ(1000, histogram.get_max());
+  ASSERT_EQ(500500, histogram.get_sum());
+  ASSERT_GE(histogram.get_percentile(50), 500);
+  ASSERT_LE(histogram.get_percentile(50), 500 + 500 / ObIOLatencyHistogram::SUB_BUCKET_CNT);
+  ASSERT_GE(histogram.get_percentile(99), 990);
+  ASSERT_EQ(1000, histogram.get_percentile(100));
+  histogram.reset();
+  ASSERT_EQ(0, histogram.get_count());
+  ASSERT_EQ(0, histogram.get_max());
+  ASSERT_EQ(0, histogram.get_percentile(99));
+  histogram.record(10);
+  ASSERT_EQ(10, histogram.get_percentile(99));
+
+  // module of the request
+  ObIOFlag flag;
+  flag.set_mode(ObIOMode::READ);
+  flag.set_category(ObIOCategory::USER_IO);
+  flag.set_wait_event(ObWaitEventIds::DB_FILE_DATA_READ);
+  ASSERT_EQ(ObIOModule::DATA, flag.get_module());
+  flag.set_wait_event(ObWaitEventIds::ROW_STORE_DISK_WRITE);
+  ASSERT_EQ(ObIOModule::TMP_FILE, flag.get_module());
+  flag.set_category(ObIOCategory::SYS_IO);
+  flag.set_wait_event(ObWaitEventIds::DB_FILE_COMPACT_READ);
+  ASSERT_EQ(ObIOModule::COMPACTION, flag.get_module());
+  flag.set_category(ObIOCategory::BACKUP_IO);
+  flag.set_wait_event(ObWaitEventIds::DB_FILE_MIGRATE_READ);
+  ASSERT_EQ(ObIOModule::BACKUP, flag.get_module());
+  flag.set_category(ObIOCategory::SYS_IO);
+  flag.set_wait_event(99);
+  ASSERT_EQ(ObIOModule::OTHER, flag.get_module());
+}
+
 TEST_F(TestIOStruct, IOInfo)
 {
   // default invalid
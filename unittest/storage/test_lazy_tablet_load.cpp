@@ -0,0 +1,300 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+
+#define USING_LOG_PREFIX STORAGE
+
+#define protected public
+#define private public
+
+#include "common/ob_tablet_id.h"
+#include "share/rc/ob_tenant_base.h"
+#include "storage/ls/ob_ls.h"
+#include "storage/meta_mem/ob_meta_pointer_map.h"
+#include "storage/meta_mem/ob_tenant_meta_mem_mgr.h"
+#include "storage/meta_mem/ob_tablet_map_key.h"
+#include "storage/tablet/ob_tablet_iterator.h"
+
+namespace oceanbase
+{
+using namespace share;
+namespace storage
+{
+
+static int64_t load_tablet_cnt = 0;
+
+// load an empty tablet instead of reading the tablet from disk
+template<>
+int ObMetaPointerMap<ObTabletMapKey, ObTablet>::load_meta_obj(
+    const ObTabletMapKey &key,
+    ObMetaPointer<ObTablet> *meta_pointer,
+    common::ObIAllocator &allocator,
+    ObMetaDiskAddr &load_addr,
+    ObTablet *&t,
+    const bool using_obj_pool)
+{
+  int ret = OB_SUCCESS;
+  UNUSEDx(allocator, using_obj_pool);
+  if (OB_FAIL(MTL(ObTenantMetaMemMgr*)->tablet_pool_.acquire(t))) {
+    LOG_WARN("fail to acquire tablet", K(ret));
+  } else {
+    t->tablet_meta_.ls_id_ = key.ls_id_;
+    t->tablet_meta_.tablet_id_ = key.tablet_id_;
+    t->is_inited_ = true;
+    load_addr = meta_pointer->get_addr();
+    ++load_tablet_cnt;
+  }
+  return ret;
+}
+
+class TestLazyTabletLoad : public ::testing::Test
+{
+public:
+  TestLazyTabletLoad();
+  virtual ~TestLazyTabletLoad() = default;
+
+  virtual void SetUp() override;
+  virtual void TearDown() override;
+
+  // put a tablet with the given disk address into the tablet map of t3m
+  void put_tablet(const ObTabletMapKey &key, const ObMetaDiskAddr &addr);
+
+private:
+  static constexpr uint64_t TEST_TENANT_ID = 500;
+  ObTenantBase tenant_base_;
+  ObLS fake_ls_;
+  ObLSHandle ls_handle_;
+};
+
+TestLazyTabletLoad::TestLazyTabletLoad()
+  : tenant_base_(TEST_TENANT_ID)
+{
+}
+
+void TestLazyTabletLoad::SetUp()
+{
+  ObTenantMetaMemMgr *t3m = OB_NEW(ObTenantMetaMemMgr, ObModIds::TEST, TEST_TENANT_ID);
+  ASSERT_EQ(OB_SUCCESS, t3m->init());
+
+  tenant_base_.set(t3m);
+  ObTenantEnv::set_tenant(&tenant_base_);
+  ASSERT_EQ(OB_SUCCESS, tenant_base_.init());
+
+  observer::ObIMetaReport *fake_reporter = (observer::ObIMetaReport *)0xff;
+  ASSERT_EQ(OB_SUCCESS, fake_ls_.get_tablet_svr()->init(&fake_ls_, fake_reporter));
+  ls_handle_.ls_ = &fake_ls_;
+  load_tablet_cnt = 0;
+}
+
+void TestLazyTabletLoad::TearDown()
+{
+  ObTenantMetaMemMgr *t3m = MTL(ObTenantMetaMemMgr*);
+  ls_handle_.ls_ = nullptr;
+  t3m->stop();
+  t3m->wait();
+  t3m->destroy();
+  tenant_base_.destroy();
+}
+
+void TestLazyTabletLoad::put_tablet(const ObTabletMapKey &key, const ObMetaDiskAddr &addr)
+{
+  ObTenantMetaMemMgr *t3m = MTL(ObTenantMetaMemMgr*);
+  ObMemtableMgrHandle memtable_mgr_hdl;
+  ASSERT_EQ(OB_SUCCESS, t3m->acquire_tablet_memtable_mgr(memtable_mgr_hdl));
+  ObTabletPointer tablet_ptr(ls_handle_, memtable_mgr_hdl);
+  ObMetaDiskAddr none_addr;
+  none_addr.set_none_addr();
+  tablet_ptr.set_addr_with_reset_obj(none_addr);
+  ASSERT_EQ(OB_SUCCESS, t3m->tablet_map_.set(key, tablet_ptr));
+
+  ObMetaObj<ObTablet> tablet_obj;
+  ASSERT_EQ(OB_SUCCESS, t3m->tablet_pool_.acquire(tablet_obj.ptr_));
+  tablet_obj.pool_ = &t3m->tablet_pool_;
+  tablet_obj.ptr_->tablet_meta_.ls_id_ = key.ls_id_;
+  tablet_obj.ptr_->tablet_meta_.tablet_id_ = key.tablet_id_;
+  tablet_obj.ptr_->is_inited_ = true;
+  ObTabletHandle handle;
+  handle.set_obj(tablet_obj);
+  ASSERT_EQ(OB_SUCCESS, t3m->tablet_map_.set_meta_obj(key, handle));
+  ASSERT_EQ(OB_SUCCESS, t3m->tablet_map_.compare_and_swap_address_and_object(key, addr, handle, handle));
+}
+
+TEST_F(TestLazyTabletLoad, test_wash_replayed_tablet)
+{
+  ObTenantMetaMemMgr *t3m = MTL(ObTenantMetaMemMgr*);
+  ObMetaDiskAddr disk_addr;
+  disk_addr.first_id_ = 1;
+  disk_addr.second_id_ = 2;
+  disk_addr.offset_ = 0;
+  disk_addr.size_ = 4096;
+  disk_addr.type_ = ObMetaDiskAddr::DiskType::BLOCK;
+  const ObTabletMapKey key(ObLSID(1001), ObTabletID(200001));
+  put_tablet(key, disk_addr);
+
+  bool is_in_memory = false;
+  bool is_washed = false;
+  ASSERT_EQ(OB_SUCCESS, t3m->check_tablet_in_memory(key, is_in_memory));
+  ASSERT_TRUE(is_in_memory);
+
+  // the tablet held by others is not washed
+  ObTabletHandle handle;
+  ASSERT_EQ(OB_SUCCESS, t3m->get_tablet(WashTabletPriority::WTP_HIGH, key, handle));
+  ASSERT_EQ(OB_SUCCESS, t3m->wash_replayed_tablet(key, is_washed));
+  ASSERT_FALSE(is_washed);
+  handle.reset();
+
+  // the tablet in tx is not washed
+  ASSERT_EQ(OB_SUCCESS, t3m->insert_pinned_tablet(key));
+  ASSERT_EQ(OB_SUCCESS, t3m->wash_replayed_tablet(key, is_washed));
+  ASSERT_FALSE(is_washed);
+  ASSERT_EQ(OB_SUCCESS, t3m->erase_pinned_tablet(key));
+
+  ASSERT_EQ(OB_SUCCESS, t3m->wash_replayed_tablet(key, is_washed));
+  ASSERT_TRUE(is_washed);
+  ASSERT_EQ(OB_SUCCESS, t3m->check_tablet_in_memory(key, is_in_memory));
+  ASSERT_FALSE(is_in_memory);
+  // the washed tablet stays washed until it is accessed
+  ASSERT_EQ(OB_SUCCESS, t3m->wash_replayed_tablet(key, is_washed));
+  ASSERT_FALSE(is_washed);
+  ASSERT_EQ(0, load_tablet_cnt);
+
+  // the washed tablet is loaded by its disk address on first access
+  ObMetaDiskAddr addr;
+  ASSERT_EQ(OB_SUCCESS, t3m->get_tablet_addr(key, addr));
+  ASSERT_EQ(disk_addr, addr);
+  ASSERT_EQ(OB_SUCCESS, t3m->get_tablet(WashTabletPriority::WTP_HIGH, key, handle));
+  ASSERT_TRUE(handle.is_valid());
+  ASSERT_EQ(key.tablet_id_, handle.get_obj()->get_tablet_meta().tablet_id_);
+  ASSERT_EQ(1, load_tablet_cnt);
+  ASSERT_EQ(OB_SUCCESS, t3m->check_tablet_in_memory(key, is_in_memory));
+  ASSERT_TRUE(is_in_memory);
+  handle.reset();
+
+  // the loaded tablet could be washed again
+  ASSERT_EQ(OB_SUCCESS, t3m->wash_replayed_tablet(key, is_washed));
+  ASSERT_TRUE(is_washed);
+  ASSERT_EQ(OB_SUCCESS, t3m->get_tablet(WashTabletPriority::WTP_HIGH, key, handle));
+  ASSERT_EQ(2, load_tablet_cnt);
+  handle.reset();
+
+  ASSERT_EQ(OB_SUCCESS, t3m->tablet_map_.erase(key, t3m->get_tenant_allocator()));
+}
+
+TEST_F(TestLazyTabletLoad, test_keep_tablet_in_memory)
+{
+  ObTenantMetaMemMgr *t3m = MTL(ObTenantMetaMemMgr*);
+  ObMetaDiskAddr disk_addr;
+  disk_addr.first_id_ = 1;
+  disk_addr.second_id_ = 2;
+  disk_addr.offset_ = 0;
+  disk_addr.size_ = 4096;
+  disk_addr.type_ = ObMetaDiskAddr::DiskType::BLOCK;
+  ObMetaDiskAddr mem_addr;
+  ASSERT_EQ(OB_SUCCESS, mem_addr.set_mem_addr(0, sizeof(ObTablet)));
+
+  // the inner tablet is accessed on restart anyway
+  const ObTabletMapKey inner_key(ObLSID(1001), ObTabletID(ObTabletID::LS_TX_CTX_TABLET_ID));
+  // the tablet without disk address couldn't be loaded again
+  const ObTabletMapKey mem_key(ObLSID(1001), ObTabletID(200002));
+  put_tablet(inner_key, disk_addr);
+  put_tablet(mem_key, mem_addr);
+
+  bool is_in_memory = false;
+  bool is_washed = true;
+  ASSERT_EQ(OB_SUCCESS, t3m->wash_replayed_tablet(inner_key, is_washed));
+  ASSERT_FALSE(is_washed);
+  ASSERT_EQ(OB_SUCCESS, t3m->check_tablet_in_memory(inner_key, is_in_memory));
+  ASSERT_TRUE(is_in_memory);
+
+  is_washed = true;
+  ASSERT_EQ(OB_SUCCESS, t3m->wash_replayed_tablet(mem_key, is_washed));
+  ASSERT_FALSE(is_washed);
+  ASSERT_EQ(OB_SUCCESS, t3m->check_tablet_in_memory(mem_key, is_in_memory));
+  ASSERT_TRUE(is_in_memory);
+
+  const ObTabletMapKey not_exist_key(ObLSID(1001), ObTabletID(200003));
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, t3m->check_tablet_in_memory(not_exist_key, is_in_memory));
+  ASSERT_FALSE(is_in_memory);
+  ASSERT_EQ(0, load_tablet_cnt);
+
+  ASSERT_EQ(OB_SUCCESS, t3m->tablet_map_.erase(inner_key, t3m->get_tenant_allocator()));
+  ASSERT_EQ(OB_SUCCESS, t3m->tablet_map_.erase(mem_key, t3m->get_tenant_allocator()));
+}
+
+TEST_F(TestLazyTabletLoad, test_skip_idle_cold_tablet)
+{
+  ObTenantMetaMemMgr *t3m = MTL(ObTenantMetaMemMgr*);
+  ObMetaDiskAddr disk_addr;
+  disk_addr.first_id_ = 1;
+  disk_addr.second_id_ = 2;
+  disk_addr.offset_ = 0;
+  disk_addr.size_ = 4096;
+  disk_addr.type_ = ObMetaDiskAddr::DiskType::BLOCK;
+  const ObLSID ls_id(1001);
+  const ObTabletMapKey idle_key(ls_id, ObTabletID(200004));
+  const ObTabletMapKey ddl_key(ls_id, ObTabletID(200005));
+  put_tablet(idle_key, disk_addr);
+  put_tablet(ddl_key, disk_addr);
+
+  // the ddl kv is kept by the pointer, so it is checked without the tablet
+  ObTenantMetaMemMgr::ObTabletPointerHandle ptr_handle(t3m->tablet_map_);
+  ObDDLKvMgrHandle ddl_kv_mgr_handle;
+  ASSERT_EQ(OB_SUCCESS, t3m->tablet_map_.get(ddl_key, ptr_handle));
+  ObTabletPointer *ddl_tablet_ptr = static_cast<ObTabletPointer *>(ptr_handle.get_resource_ptr());
+  ASSERT_EQ(OB_SUCCESS, ddl_tablet_ptr->create_ddl_kv_mgr(ls_id, ddl_key.tablet_id_, ddl_kv_mgr_handle));
+
+  bool is_washed = false;
+  bool has_memory_data = true;
+  ASSERT_EQ(OB_SUCCESS, t3m->wash_replayed_tablet(idle_key, is_washed));
+  ASSERT_TRUE(is_washed);
+  ASSERT_EQ(OB_SUCCESS, t3m->wash_replayed_tablet(ddl_key, is_washed));
+  ASSERT_TRUE(is_washed);
+  ASSERT_EQ(OB_SUCCESS, t3m->check_tablet_has_memory_data(idle_key, has_memory_data));
+  ASSERT_FALSE(has_memory_data);
+  ASSERT_EQ(OB_SUCCESS, t3m->check_tablet_has_memory_data(ddl_key, has_memory_data));
+  ASSERT_TRUE(has_memory_data);
+  ddl_kv_mgr_handle.reset();
+  ddl_tablet_ptr->remove_ddl_kv_mgr();
+  ASSERT_EQ(OB_SUCCESS, t3m->check_tablet_has_memory_data(ddl_key, has_memory_data));
+  ASSERT_FALSE(has_memory_data);
+  ptr_handle.reset();
+
+  // the idle cold tablets are skipped by the iterator instead of being loaded
+  fake_ls_.ls_meta_.ls_id_ = ls_id;
+  ObLSTabletIterator iter(ObTabletCommon::NO_CHECK_GET_TABLET_TIMEOUT_US);
+  iter.ls_tablet_service_ = fake_ls_.get_tablet_svr();
+  iter.keep_cold_tablet_washed_ = true;
+  iter.set_skip_idle_cold_tablet();
+  ASSERT_EQ(OB_SUCCESS, iter.tablet_ids_.push_back(idle_key.tablet_id_));
+  ASSERT_EQ(OB_SUCCESS, iter.tablet_ids_.push_back(ddl_key.tablet_id_));
+  ObTabletHandle handle;
+  ASSERT_EQ(OB_ITER_END, iter.get_next_tablet(handle));
+  ASSERT_FALSE(handle.is_valid());
+  ASSERT_EQ(0, load_tablet_cnt);
+  iter.reset();
+
+  ASSERT_EQ(OB_SUCCESS, t3m->tablet_map_.erase(idle_key, t3m->get_tenant_allocator()));
+  ASSERT_EQ(OB_SUCCESS, t3m->tablet_map_.erase(ddl_key, t3m->get_tenant_allocator()));
+}
+
+} // end namespace storage
+} // end namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  system("rm -f test_lazy_tablet_load.log*");
+  OB_LOGGER.set_file_name("test_lazy_tablet_load.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
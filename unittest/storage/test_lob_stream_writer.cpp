@@ -0,0 +1,265 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#define protected public
+#define private public
+
+#include "storage/lob/ob_lob_manager.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace storage;
+
+namespace unittest
+{
+
+static const int64_t PIECE_SIZE = ObLobMetaUtil::LOB_OPER_PIECE_DATA_SIZE;
+static const char MB_CHAR[] = "\xE4\xB8\xAD"; // a 3 bytes char of utf8mb4
+
+// record the appended pieces instead of writing the lob meta tablet
+class MockLobStreamWriter : public ObLobStreamWriter
+{
+public:
+  virtual int do_append(const char *data, const int64_t len) override
+  {
+    ptrs_.push_back(data);
+    pieces_.push_back(std::string(data, len));
+    append_size_ += len;
+    return OB_SUCCESS;
+  }
+  int64_t count() const { return static_cast<int64_t>(pieces_.size()); }
+  std::string get_appended() const
+  {
+    std::string str;
+    for (int64_t i = 0; i < static_cast<int64_t>(pieces_.size()); ++i) {
+      str.append(pieces_[i]);
+    }
+    return str;
+  }
+  std::vector<const char *> ptrs_;
+  std::vector<std::string> pieces_;
+};
+
+class TestLobStreamWriter : public ::testing::Test
+{
+public:
+  TestLobStreamWriter() : allocator_(ObModIds::TEST) {}
+  virtual void SetUp()
+  {
+    param_.allocator_ = &allocator_;
+  }
+  virtual void TearDown()
+  {
+    allocator_.reset();
+  }
+protected:
+  ObArenaAllocator allocator_;
+  ObLobAccessParam param_;
+};
+
+TEST_F(TestLobStreamWriter, multibyte_char_across_appends)
+{
+  // the buffered piece ends with the first byte of the multi-byte char
+  std::string data(PIECE_SIZE - 1, 'a');
+  data.append(MB_CHAR);
+  data.append(10, 'b');
+  param_.coll_type_ = CS_TYPE_UTF8MB4_BIN;
+  MockLobStreamWriter writer;
+  ASSERT_EQ(OB_SUCCESS, writer.open(param_));
+  ASSERT_EQ(OB_SUCCESS, writer.append(ObString(PIECE_SIZE, data.data())));
+  ASSERT_EQ(1, writer.count());
+  ASSERT_EQ(PIECE_SIZE - 1, static_cast<int64_t>(writer.pieces_[0].length()));
+  ASSERT_EQ(1, writer.buf_pos_);
+
+  ASSERT_EQ(OB_SUCCESS, writer.append(ObString(data.length() - PIECE_SIZE, data.data() + PIECE_SIZE)));
+  ASSERT_EQ(1, writer.count());
+  ASSERT_EQ(OB_SUCCESS, writer.close());
+  ASSERT_EQ(2, writer.count());
+  ASSERT_EQ(0, writer.pieces_[1].compare(0, 3, MB_CHAR));
+  ASSERT_EQ(data, writer.get_appended());
+  ASSERT_EQ(static_cast<int64_t>(data.length()), writer.get_append_size());
+}
+
+TEST_F(TestLobStreamWriter, zero_copy_large_chunk)
+{
+  const int64_t len = 2 * PIECE_SIZE + 10;
+  std::string data(len, 'x');
+  MockLobStreamWriter writer;
+  ASSERT_EQ(OB_SUCCESS, writer.open(param_));
+  ASSERT_EQ(OB_SUCCESS, writer.append(ObString(len, data.data())));
+  // the full pieces point to the chunk, only the tail is copied
+  ASSERT_EQ(1, writer.count());
+  ASSERT_EQ(data.data(), writer.ptrs_[0]);
+  ASSERT_EQ(2 * PIECE_SIZE, static_cast<int64_t>(writer.pieces_[0].length()));
+  ASSERT_EQ(10, writer.buf_pos_);
+  ASSERT_EQ(OB_SUCCESS, writer.close());
+  ASSERT_EQ(2, writer.count());
+  ASSERT_EQ(writer.buf_, writer.ptrs_[1]);
+  ASSERT_EQ(data, writer.get_appended());
+  writer.reset();
+
+  // the zero copy piece stops before the char crossing the piece boundary
+  std::string mb_data(PIECE_SIZE - 1, 'a');
+  mb_data.append(MB_CHAR);
+  param_.coll_type_ = CS_TYPE_UTF8MB4_BIN;
+  MockLobStreamWriter mb_writer;
+  ASSERT_EQ(OB_SUCCESS, mb_writer.open(param_));
+  ASSERT_EQ(OB_SUCCESS, mb_writer.append(ObString(mb_data.length(), mb_data.data())));
+  ASSERT_EQ(1, mb_writer.count());
+  ASSERT_EQ(mb_data.data(), mb_writer.ptrs_[0]);
+  ASSERT_EQ(PIECE_SIZE - 1, static_cast<int64_t>(mb_writer.pieces_[0].length()));
+  ASSERT_EQ(3, mb_writer.buf_pos_);
+  ASSERT_EQ(OB_SUCCESS, mb_writer.close());
+  ASSERT_EQ(mb_data, mb_writer.get_appended());
+}
+
+TEST_F(TestLobStreamWriter, close_flush_tail)
+{
+  std::string data(100, 'y');
+  MockLobStreamWriter writer;
+  ASSERT_EQ(OB_NOT_INIT, writer.close());
+  ASSERT_EQ(OB_SUCCESS, writer.open(param_));
+  ASSERT_EQ(OB_INIT_TWICE, writer.open(param_));
+  ASSERT_EQ(OB_SUCCESS, writer.append(ObString(50, data.data())));
+  ASSERT_EQ(OB_SUCCESS, writer.append(ObString(50, data.data() + 50)));
+  ASSERT_EQ(0, writer.count());
+  ASSERT_EQ(0, writer.get_append_size());
+  ASSERT_EQ(OB_SUCCESS, writer.close());
+  ASSERT_EQ(1, writer.count());
+  ASSERT_EQ(data, writer.pieces_[0]);
+  ASSERT_EQ(100, writer.get_append_size());
+  // nothing is left to flush
+  ASSERT_EQ(OB_SUCCESS, writer.close());
+  ASSERT_EQ(1, writer.count());
+}
+
+TEST_F(TestLobStreamWriter, get_next_piece_in_row)
+{
+  ObString data = ObString::make_string("hello lob");
+  ObString piece;
+  ObLobQueryIter iter;
+  ASSERT_EQ(OB_SUCCESS, iter.open(data));
+  ASSERT_EQ(OB_SUCCESS, iter.get_next_piece(piece));
+  ASSERT_EQ(data.ptr(), piece.ptr());
+  ASSERT_EQ(data.length(), piece.length());
+  ASSERT_EQ(OB_ITER_END, iter.get_next_piece(piece));
+  iter.reset();
+
+  // the copy path fills the remaining space of the output buffer from the lob data
+  char buf[4];
+  ObString out(sizeof(buf), 0, buf);
+  ASSERT_EQ(OB_SUCCESS, iter.open(data));
+  ASSERT_EQ(OB_SUCCESS, iter.get_next_row(out));
+  ASSERT_EQ(ObString::make_string("hell"), out);
+  out.set_length(0);
+  ASSERT_EQ(OB_SUCCESS, iter.get_next_row(out));
+  ASSERT_EQ(ObString::make_string("o lo"), out);
+  iter.reset();
+}
+
+TEST_F(TestLobStreamWriter, get_piece_data_out_row)
+{
+  // "ab中cd" in the lob data of a meta row
+  std::string lob_data("ab");
+  lob_data.append(MB_CHAR);
+  lob_data.append("cd");
+  ObLobManager lob_mngr(OB_SYS_TENANT_ID);
+  ObLobQueryResult result;
+  result.meta_result_.info_.piece_id_ = ObLobMetaUtil::LOB_META_INLINE_PIECE_ID;
+  result.meta_result_.info_.lob_data_.assign_ptr(lob_data.data(), lob_data.length());
+  result.meta_result_.info_.byte_len_ = lob_data.length();
+  ObString piece;
+
+  // the range is in chars for the char collation
+  param_.coll_type_ = CS_TYPE_UTF8MB4_BIN;
+  result.meta_result_.st_ = 2;
+  result.meta_result_.len_ = 2;
+  ASSERT_EQ(OB_SUCCESS, lob_mngr.get_piece_data(param_, result, piece));
+  ASSERT_EQ(lob_data.data() + 2, piece.ptr());
+  ASSERT_EQ(std::string(MB_CHAR) + "c", std::string(piece.ptr(), piece.length()));
+
+  // the range is in bytes for binary
+  param_.coll_type_ = CS_TYPE_BINARY;
+  result.meta_result_.st_ = 1;
+  result.meta_result_.len_ = 2;
+  ASSERT_EQ(OB_SUCCESS, lob_mngr.get_piece_data(param_, result, piece));
+  ASSERT_EQ(lob_data.data() + 1, piece.ptr());
+  ASSERT_EQ(2, piece.length());
+
+  result.meta_result_.info_.piece_id_ = 0;
+  ASSERT_EQ(OB_ERR_UNEXPECTED, lob_mngr.get_piece_data(param_, result, piece));
+}
+
+TEST_F(TestLobStreamWriter, in_row_query_range)
+{
+  // an in row lob "ab中cde" without lob data header
+  std::string data("ab");
+  data.append(MB_CHAR);
+  data.append("cde");
+  const int64_t handle_size = sizeof(ObLobCommon) + data.length();
+  char *handle_buf = static_cast<char *>(allocator_.alloc(handle_size));
+  ASSERT_TRUE(NULL != handle_buf);
+  ObLobCommon *lob_common = new (handle_buf) ObLobCommon();
+  MEMCPY(lob_common->buffer_, data.data(), data.length());
+
+  ObLobManager lob_mngr(OB_SYS_TENANT_ID);
+  lob_mngr.is_inited_ = true;
+  param_.coll_type_ = CS_TYPE_UTF8MB4_BIN;
+  param_.lob_common_ = lob_common;
+  param_.byte_size_ = data.length();
+  param_.handle_size_ = handle_size;
+
+  struct Range {
+    uint64_t offset_;
+    uint64_t len_;
+    const char *expect_;
+  } ranges[] = {
+    {2, 3, "\xE4\xB8\xAD" "cd"},
+    {0, 100, "ab\xE4\xB8\xAD" "cde"},
+    {5, 100, "e"},
+    {100, 1, ""},
+  };
+  for (int64_t i = 0; i < static_cast<int64_t>(sizeof(ranges) / sizeof(ranges[0])); ++i) {
+    ObLobQueryIter *iter = NULL;
+    ObString piece;
+    param_.offset_ = ranges[i].offset_;
+    param_.len_ = ranges[i].len_;
+    ASSERT_EQ(OB_SUCCESS, lob_mngr.query(param_, iter));
+    ASSERT_TRUE(NULL != iter);
+    if (0 == strlen(ranges[i].expect_)) {
+      ASSERT_EQ(OB_ITER_END, iter->get_next_piece(piece));
+    } else {
+      ASSERT_EQ(OB_SUCCESS, iter->get_next_piece(piece));
+      ASSERT_EQ(std::string(ranges[i].expect_), std::string(piece.ptr(), piece.length()));
+      ASSERT_EQ(OB_ITER_END, iter->get_next_piece(piece));
+    }
+    iter->reset();
+    common::sop_return(ObLobQueryIter, iter);
+  }
+  lob_mngr.is_inited_ = false;
+}
+
+} // end unittest
+} // end oceanbase
+
+int main(int argc, char **argv)
+{
+  system("rm -f test_lob_stream_writer.log*");
+  OB_LOGGER.set_file_name("test_lob_stream_writer.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,210 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include "storage/blocksstable/ob_multi_version_sstable_test.h"
+#include "storage/blocksstable/ob_macro_block_bare_iterator.h"
+#include "storage/compaction/ob_partition_merger.h"
+#include "storage/compaction/ob_tablet_merge_task.h"
+#include "storage/compaction/ob_tenant_tablet_scheduler.h"
+
+namespace oceanbase
+{
+using namespace compaction;
+namespace storage
+{
+
+class TestMajorMergeMicroReuse : public ObMultiVersionSSTableTest
+{
+public:
+  TestMajorMergeMicroReuse()
+    : ObMultiVersionSSTableTest("test_major_merge_micro_reuse", MAJOR_MERGE)
+  {}
+  virtual ~TestMajorMergeMicroReuse() = default;
+
+  void prepare_merge_context(
+      const ObVersionRange &version_range,
+      ObTabletMergeCtx &ctx);
+  void get_micro_headers(
+      const MacroBlockId &macro_id,
+      ObIArray<ObMicroBlockHeader> &headers);
+
+  static const int64_t SNAPSHOT_VERSION = 30;
+};
+
+void TestMajorMergeMicroReuse::prepare_merge_context(
+    const ObVersionRange &version_range,
+    ObTabletMergeCtx &ctx)
+{
+  ObLSService *ls_svr = MTL(ObLSService*);
+  ASSERT_EQ(OB_SUCCESS, ls_svr->get_ls(ObLSID(ls_id_), ctx.ls_handle_, ObLSGetMod::STORAGE_MOD));
+  ASSERT_EQ(OB_SUCCESS, ctx.ls_handle_.get_ls()->get_tablet(ObTabletID(tablet_id_), ctx.tablet_handle_));
+
+  ctx.param_.merge_type_ = MAJOR_MERGE;
+  ctx.param_.merge_version_ = version_range.snapshot_version_;
+  ctx.param_.ls_id_ = ObLSID(ls_id_);
+  ctx.param_.tablet_id_ = ObTabletID(tablet_id_);
+  ctx.param_.report_ = &rs_reporter_;
+  ctx.sstable_version_range_ = version_range;
+  ctx.log_ts_range_.start_log_ts_ = 0;
+  ctx.log_ts_range_.end_log_ts_ = version_range.snapshot_version_;
+  ctx.create_snapshot_version_ = 0;
+  ctx.read_base_version_ = version_range.base_version_;
+  ctx.schema_ctx_.base_schema_version_ = SCHEMA_VERSION;
+  ctx.schema_ctx_.schema_version_ = SCHEMA_VERSION;
+  ctx.schema_ctx_.table_schema_ = &table_schema_;
+  ctx.schema_ctx_.merge_schema_ = &table_schema_;
+  // an incremental merge at micro block level, without progressive rewrite
+  ctx.is_full_merge_ = false;
+  ctx.merge_level_ = MICRO_BLOCK_MERGE_LEVEL;
+  ctx.progressive_merge_num_ = 0;
+
+  ASSERT_EQ(OB_SUCCESS, ctx.init_merge_info());
+  ASSERT_EQ(1, ctx.get_concurrent_cnt());
+  ASSERT_EQ(OB_SUCCESS, index_desc_.init(index_schema_, ObLSID(ls_id_), ObTabletID(tablet_id_),
+      MAJOR_MERGE, version_range.snapshot_version_));
+  ASSERT_EQ(OB_SUCCESS, ctx.merge_info_.prepare_index_builder(index_desc_));
+}
+
+void TestMajorMergeMicroReuse::get_micro_headers(
+    const MacroBlockId &macro_id,
+    ObIArray<ObMicroBlockHeader> &headers)
+{
+  ObMacroBlockReadInfo read_info;
+  ObMacroBlockHandle macro_handle;
+  read_info.macro_block_id_ = macro_id;
+  read_info.offset_ = 0;
+  read_info.size_ = OB_SERVER_BLOCK_MGR.get_macro_block_size();
+  read_info.io_desc_.set_mode(ObIOMode::READ);
+  read_info.io_desc_.set_category(ObIOCategory::SYS_IO);
+  read_info.io_desc_.set_wait_event(ObWaitEventIds::DB_FILE_DATA_READ);
+  ASSERT_EQ(OB_SUCCESS, ObBlockManager::read_block(read_info, macro_handle));
+
+  // the micro blocks are iterated as they are stored, without decompression
+  ObMicroBlockBareIterator micro_iter;
+  ObMicroBlockData micro_data;
+  ASSERT_EQ(OB_SUCCESS, micro_iter.open(macro_handle.get_buffer(), macro_handle.get_data_size(),
+      false /*need_check_data_integrity*/, false /*need_deserialize*/));
+  int ret = OB_SUCCESS;
+  while (OB_SUCC(micro_iter.get_next_micro_block_data(micro_data))) {
+    ObMicroBlockHeader header;
+    int64_t pos = 0;
+    ASSERT_EQ(OB_SUCCESS, header.deserialize(micro_data.get_buf(), micro_data.get_buf_size(), pos));
+    header.column_checksums_ = nullptr;
+    ASSERT_EQ(OB_SUCCESS, headers.push_back(header));
+  }
+  ASSERT_EQ(OB_ITER_END, ret);
+}
+
+TEST_F(TestMajorMergeMicroReuse, test_copy_micro_blocks_of_small_macro_block)
+{
+  const int64_t rowkey_cnt = 4;
+  ObLogTsRange log_ts_range;
+
+  // the incremental row is after all the rows of the base sstable
+  const char *minor_data[1];
+  minor_data[0] =
+      "bigint   var   bigint   bigint   bigint bigint  flag    multi_version_row_flag\n"
+      "10       var1  -20      0        10     10      EXIST   CLF\n";
+  ObTableHandleV2 minor_handle;
+  merge_type_ = MINOR_MERGE;
+  log_ts_range.start_log_ts_ = 10;
+  log_ts_range.end_log_ts_ = 20;
+  prepare_data(minor_handle, minor_data, 1, rowkey_cnt, log_ts_range, 20);
+
+  // a small macro block with three micro blocks
+  const char *major_data[3];
+  major_data[0] =
+      "bigint   var   bigint   bigint   bigint bigint  flag    multi_version_row_flag\n"
+      "0        var1  -10      0        0      0       EXIST   CLF\n"
+      "1        var1  -10      0        1      1       EXIST   CLF\n"
+      "2        var1  -10      0        2      2       EXIST   CLF\n";
+  major_data[1] =
+      "bigint   var   bigint   bigint   bigint bigint  flag    multi_version_row_flag\n"
+      "3        var1  -10      0        3      3       EXIST   CLF\n"
+      "4        var1  -10      0        4      4       EXIST   CLF\n"
+      "5        var1  -10      0        5      5       EXIST   CLF\n";
+  major_data[2] =
+      "bigint   var   bigint   bigint   bigint bigint  flag    multi_version_row_flag\n"
+      "6        var1  -10      0        6      6       EXIST   CLF\n"
+      "7        var1  -10      0        7      7       EXIST   CLF\n";
+  ObTableHandleV2 major_handle;
+  merge_type_ = MAJOR_MERGE;
+  log_ts_range.start_log_ts_ = 0;
+  log_ts_range.end_log_ts_ = 10;
+  prepare_data(major_handle, major_data, 3, rowkey_cnt, log_ts_range, 10);
+
+  ObSSTable *major_sstable = static_cast<ObSSTable *>(major_handle.get_table());
+  const ObIArray<MacroBlockId> &base_macro_ids =
+      major_sstable->get_meta().get_macro_info().get_data_block_ids();
+  ASSERT_EQ(1, base_macro_ids.count());
+  ObSEArray<ObMicroBlockHeader, 4> base_headers;
+  get_micro_headers(base_macro_ids.at(0), base_headers);
+  ASSERT_EQ(3, base_headers.count());
+  int64_t base_micro_size = 0;
+  for (int64_t i = 0; i < base_headers.count(); ++i) {
+    base_micro_size += base_headers.at(i).data_zlength_;
+  }
+
+  ObTabletMergeDagParam param;
+  ObTabletMergeCtx merge_context(param, allocator_);
+  ASSERT_EQ(OB_SUCCESS, merge_context.tables_handle_.add_table(major_handle.get_table()));
+  ASSERT_EQ(OB_SUCCESS, merge_context.tables_handle_.add_table(minor_handle.get_table()));
+  ObVersionRange version_range;
+  version_range.base_version_ = 10;
+  version_range.multi_version_start_ = 10;
+  version_range.snapshot_version_ = SNAPSHOT_VERSION;
+  prepare_merge_context(version_range, merge_context);
+
+  MTL(ObTenantTabletScheduler*)->major_merge_status_ = true;
+  ObPartitionMajorMerger merger;
+  ASSERT_EQ(OB_SUCCESS, merger.merge_partition(merge_context, 0));
+
+  // the base macro block is below the rewrite threshold, so it is merged into
+  // a new macro block by copying its micro blocks instead of being reused
+  const ObSSTableMergeInfo &merge_info = merger.merge_info_;
+  ASSERT_EQ(0, merge_info.multiplexed_macro_block_count_);
+  ASSERT_EQ(0, merge_info.multiplexed_macro_block_size_);
+  ASSERT_EQ(3, merge_info.multiplexed_micro_count_in_new_macro_);
+  ASSERT_EQ(base_micro_size, merge_info.multiplexed_micro_size_in_new_macro_);
+  ASSERT_EQ(1, merge_info.new_micro_count_in_new_macro_);
+  ASSERT_GT(merge_info.new_flush_occupy_size_, base_micro_size);
+  ASSERT_EQ(base_micro_size * 100 / merge_info.new_flush_occupy_size_, merge_info.get_reused_size_pct());
+  ASSERT_GT(merge_info.get_reused_size_pct(), 0);
+  ASSERT_EQ(merge_info.get_reused_size_pct(),
+      merge_context.merge_info_.get_sstable_merge_info().get_reused_size_pct());
+
+  // the copied micro blocks keep their rows and checksums
+  ObIArray<MacroBlockId> &new_macro_ids =
+      merger.macro_writer_.get_macro_block_write_ctx().get_macro_block_list();
+  ASSERT_EQ(1, new_macro_ids.count());
+  ObSEArray<ObMicroBlockHeader, 4> new_headers;
+  get_micro_headers(new_macro_ids.at(0), new_headers);
+  ASSERT_EQ(4, new_headers.count());
+  for (int64_t i = 0; i < base_headers.count(); ++i) {
+    ASSERT_EQ(base_headers.at(i).row_count_, new_headers.at(i).row_count_);
+    ASSERT_EQ(base_headers.at(i).data_zlength_, new_headers.at(i).data_zlength_);
+    ASSERT_EQ(base_headers.at(i).data_checksum_, new_headers.at(i).data_checksum_);
+  }
+  ASSERT_EQ(1, new_headers.at(3).row_count_);
+}
+
+} // end namespace storage
+} // end namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  system("rm -f test_major_merge_micro_reuse.log*");
+  OB_LOGGER.set_file_name("test_major_merge_micro_reuse.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
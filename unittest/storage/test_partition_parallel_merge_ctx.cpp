@@ -0,0 +1,317 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+
+#define USING_LOG_PREFIX STORAGE
+
+#define protected public
+#define private public
+
+#include "share/rc/ob_tenant_base.h"
+#include "share/scheduler/ob_dag_scheduler.h"
+#include "storage/compaction/ob_partition_parallel_merge_ctx.h"
+#include "storage/compaction/ob_tablet_merge_ctx.h"
+#include "storage/memtable/ob_memtable.h"
+#include "storage/memtable/mvcc/ob_query_engine.h"
+#include "storage/ob_storage_schema.h"
+#include "memtable/utils_rowkey_builder.h"
+#include "memtable/utils_mod_allocator.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace share;
+using namespace storage;
+using namespace memtable;
+using namespace compaction;
+using namespace blocksstable;
+
+namespace unittest
+{
+
+static const int64_t TEST_TABLET_ID = 200001;
+
+// The memtable keeps its rows in a query engine of its own, so that the ranges
+// are split by the real btree without the memstore allocator of the tenant.
+class MockSplitMemtable : public ObMemtable
+{
+public:
+  explicit MockSplitMemtable(const int64_t occupied_size)
+    : ObMemtable(),
+      allocator_(),
+      qe_(allocator_),
+      occupied_size_(occupied_size)
+  {
+    key_.table_type_ = ObITable::DATA_MEMTABLE;
+    key_.tablet_id_ = TEST_TABLET_ID;
+  }
+  virtual ~MockSplitMemtable() { qe_.destroy(); }
+  int prepare_rows(const int64_t row_cnt);
+  virtual int64_t get_occupied_size() const override { return occupied_size_; }
+  virtual int estimate_phy_size(
+      const ObStoreRowkey *start_key,
+      const ObStoreRowkey *end_key,
+      int64_t &total_bytes,
+      int64_t &total_rows) override;
+  virtual int get_split_ranges(
+      const ObStoreRowkey *start_key,
+      const ObStoreRowkey *end_key,
+      const int64_t part_cnt,
+      ObIArray<ObStoreRange> &range_array) override;
+private:
+  ObModAllocator allocator_;
+  ObQueryEngine qe_;
+  int64_t occupied_size_;
+};
+
+int MockSplitMemtable::prepare_rows(const int64_t row_cnt)
+{
+  int ret = OB_SUCCESS;
+  ObMvccRow *rows = nullptr;
+  ObMvccTransNode *nodes = nullptr;
+  if (OB_FAIL(qe_.init(OB_SERVER_TENANT_ID))) {
+    LOG_WARN("failed to init query engine", K(ret));
+  } else if (OB_ISNULL(rows = static_cast<ObMvccRow *>(allocator_.alloc(sizeof(ObMvccRow) * row_cnt)))
+      || OB_ISNULL(nodes = static_cast<ObMvccTransNode *>(allocator_.alloc(sizeof(ObMvccTransNode) * row_cnt)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("failed to alloc rows", K(ret), K(row_cnt));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < row_cnt; ++i) {
+    ObMemtableKey *mtk = nullptr;
+    INIT_MTK(allocator_, mtk, I(i));
+    new (&nodes[i]) ObMvccTransNode();
+    new (&rows[i]) ObMvccRow();
+    rows[i].list_head_ = &nodes[i];
+    if (OB_FAIL(qe_.set(mtk, &rows[i]))) {
+      LOG_WARN("failed to set row", K(ret), K(i));
+    }
+  }
+  return ret;
+}
+
+int MockSplitMemtable::estimate_phy_size(
+    const ObStoreRowkey *start_key,
+    const ObStoreRowkey *end_key,
+    int64_t &total_bytes,
+    int64_t &total_rows)
+{
+  int ret = OB_SUCCESS;
+  int64_t level = 0;
+  int64_t branch_count = 0;
+  ObMemtableKey start_mtk;
+  ObMemtableKey end_mtk;
+  total_bytes = 0;
+  total_rows = 0;
+  UNUSEDx(start_key, end_key);
+  if (OB_FAIL(start_mtk.encode(&ObStoreRowkey::MIN_STORE_ROWKEY))
+      || OB_FAIL(end_mtk.encode(&ObStoreRowkey::MAX_STORE_ROWKEY))) {
+    LOG_WARN("failed to encode key", K(ret));
+  } else if (OB_FAIL(qe_.estimate_size(&start_mtk, &end_mtk, level, branch_count, total_bytes, total_rows))) {
+    LOG_WARN("failed to estimate size", K(ret));
+  }
+  return ret;
+}
+
+int MockSplitMemtable::get_split_ranges(
+    const ObStoreRowkey *start_key,
+    const ObStoreRowkey *end_key,
+    const int64_t part_cnt,
+    ObIArray<ObStoreRange> &range_array)
+{
+  int ret = OB_SUCCESS;
+  ObMemtableKey start_mtk;
+  ObMemtableKey end_mtk;
+  UNUSEDx(start_key, end_key);
+  if (OB_FAIL(start_mtk.encode(&ObStoreRowkey::MIN_STORE_ROWKEY))
+      || OB_FAIL(end_mtk.encode(&ObStoreRowkey::MAX_STORE_ROWKEY))) {
+    LOG_WARN("failed to encode key", K(ret));
+  } else if (OB_FAIL(qe_.split_range(&start_mtk, &end_mtk, part_cnt, range_array))) {
+    LOG_WARN("failed to split range", K(ret), K(part_cnt));
+  }
+  return ret;
+}
+
+class TestParallelMergeCtx : public ::testing::Test
+{
+public:
+  TestParallelMergeCtx();
+  virtual ~TestParallelMergeCtx() = default;
+
+  virtual void SetUp() override;
+  virtual void TearDown() override;
+
+  // add a memtable of the occupied size with row_cnt rows to the merge
+  void add_memtable(const int64_t occupied_size, const int64_t row_cnt);
+  void init_mini_merge(ObParallelMergeCtx &parallel_ctx);
+  // the ranges must cover the whole range without overlap or gap
+  void check_ranges(const ObParallelMergeCtx &parallel_ctx);
+  int64_t get_max_concurrent_cnt();
+
+protected:
+  static constexpr uint64_t TEST_TENANT_ID = 500;
+  static constexpr int64_t TABLET_SIZE = 2L << 20; // 2MB
+  ObTenantBase tenant_base_;
+  ObTenantDagScheduler *scheduler_;
+  ObArenaAllocator allocator_;
+  ObTabletMergeDagParam param_;
+  ObStorageSchema storage_schema_;
+  ObTabletMergeCtx *merge_ctx_;
+};
+
+TestParallelMergeCtx::TestParallelMergeCtx()
+  : tenant_base_(TEST_TENANT_ID),
+    scheduler_(nullptr),
+    allocator_(),
+    param_(),
+    storage_schema_(),
+    merge_ctx_(nullptr)
+{
+}
+
+void TestParallelMergeCtx::SetUp()
+{
+  scheduler_ = OB_NEW(ObTenantDagScheduler, ObModIds::TEST);
+  tenant_base_.set(scheduler_);
+  ObTenantEnv::set_tenant(&tenant_base_);
+  ASSERT_EQ(OB_SUCCESS, tenant_base_.init());
+  ASSERT_EQ(OB_SUCCESS, scheduler_->init(TEST_TENANT_ID));
+
+  param_.merge_type_ = MINI_MERGE;
+  storage_schema_.tablet_size_ = TABLET_SIZE;
+  merge_ctx_ = OB_NEWx(ObTabletMergeCtx, &allocator_, param_, allocator_);
+  ASSERT_NE(nullptr, merge_ctx_);
+  merge_ctx_->schema_ctx_.storage_schema_ = &storage_schema_;
+  merge_ctx_->schema_ctx_.merge_schema_ = &storage_schema_;
+}
+
+void TestParallelMergeCtx::TearDown()
+{
+  merge_ctx_->~ObTabletMergeCtx();
+  merge_ctx_ = nullptr;
+  allocator_.reset();
+  scheduler_->destroy();
+  scheduler_ = nullptr;
+  tenant_base_.destroy();
+  ObTenantEnv::set_tenant(nullptr);
+}
+
+void TestParallelMergeCtx::add_memtable(const int64_t occupied_size, const int64_t row_cnt)
+{
+  MockSplitMemtable *memtable = OB_NEWx(MockSplitMemtable, &allocator_, occupied_size);
+  ASSERT_NE(nullptr, memtable);
+  ASSERT_EQ(OB_SUCCESS, memtable->prepare_rows(row_cnt));
+  ASSERT_EQ(OB_SUCCESS, merge_ctx_->tables_handle_.add_table(memtable, &allocator_));
+}
+
+void TestParallelMergeCtx::init_mini_merge(ObParallelMergeCtx &parallel_ctx)
+{
+  ASSERT_EQ(OB_SUCCESS, parallel_ctx.init_parallel_mini_merge(*merge_ctx_));
+  parallel_ctx.is_inited_ = true;
+  ASSERT_TRUE(parallel_ctx.is_valid());
+}
+
+void TestParallelMergeCtx::check_ranges(const ObParallelMergeCtx &parallel_ctx)
+{
+  const ObIArray<ObDatumRange> &ranges = parallel_ctx.range_array_;
+  ASSERT_EQ(parallel_ctx.concurrent_cnt_, ranges.count());
+  ASSERT_TRUE(ranges.at(0).get_start_key().is_min_rowkey());
+  ASSERT_TRUE(ranges.at(ranges.count() - 1).get_end_key().is_max_rowkey());
+  for (int64_t i = 1; i < ranges.count(); ++i) {
+    const ObDatumRange &prev = ranges.at(i - 1);
+    const ObDatumRange &cur = ranges.at(i);
+    // the border key belongs to the previous range only
+    ASSERT_FALSE(prev.get_end_key().is_max_rowkey());
+    ASSERT_FALSE(cur.get_start_key().is_min_rowkey());
+    ASSERT_TRUE(prev.get_end_key() == cur.get_start_key());
+    ASSERT_TRUE(prev.is_right_closed());
+    ASSERT_TRUE(cur.is_left_open());
+    // the border keys increase, so that no range is empty
+    ASSERT_EQ(1, cur.get_start_key().get_datum_cnt());
+    if (i > 1) {
+      ASSERT_LT(prev.get_start_key().datums_[0].get_int(), cur.get_start_key().datums_[0].get_int());
+    }
+  }
+}
+
+int64_t TestParallelMergeCtx::get_max_concurrent_cnt()
+{
+  int32_t up_limit = 0;
+  const int64_t target_task_cnt = ObParallelMergeCtx::PARALLEL_MERGE_TARGET_TASK_CNT;
+  const int64_t max_merge_thread = ObParallelMergeCtx::MAX_MERGE_THREAD;
+  EXPECT_EQ(OB_SUCCESS, scheduler_->get_up_limit(ObDagPrio::DAG_PRIO_COMPACTION_HIGH, up_limit));
+  return MIN(MAX(static_cast<int64_t>(up_limit), target_task_cnt), max_merge_thread);
+}
+
+TEST_F(TestParallelMergeCtx, test_small_memtable)
+{
+  // a memtable smaller than the tablet size is dumped serially
+  add_memtable(TABLET_SIZE / 2, 1000);
+  ObParallelMergeCtx parallel_ctx;
+  init_mini_merge(parallel_ctx);
+  ASSERT_EQ(1, parallel_ctx.get_concurrent_cnt());
+  ASSERT_EQ(ObParallelMergeCtx::SERIALIZE_MERGE, parallel_ctx.parallel_type_);
+  ASSERT_TRUE(parallel_ctx.range_array_.at(0).is_whole_range());
+}
+
+TEST_F(TestParallelMergeCtx, test_memtables_of_different_size)
+{
+  // the memory of all the memtables decides the concurrency, and the ranges
+  // are split on the largest one
+  add_memtable(TABLET_SIZE, 100);
+  add_memtable(7 * TABLET_SIZE, 20000);
+  add_memtable(TABLET_SIZE / 2, 100);
+  ObParallelMergeCtx parallel_ctx;
+  init_mini_merge(parallel_ctx);
+  ASSERT_EQ(ObParallelMergeCtx::PARALLEL_MINI, parallel_ctx.parallel_type_);
+  ASSERT_EQ(9, parallel_ctx.get_concurrent_cnt());
+  check_ranges(parallel_ctx);
+}
+
+TEST_F(TestParallelMergeCtx, test_concurrency_limit)
+{
+  // a huge memtable is split by the thread limit of mini merge
+  add_memtable(1000 * TABLET_SIZE, 50000);
+  ObParallelMergeCtx parallel_ctx;
+  init_mini_merge(parallel_ctx);
+  ASSERT_EQ(ObParallelMergeCtx::PARALLEL_MINI, parallel_ctx.parallel_type_);
+  ASSERT_EQ(get_max_concurrent_cnt(), parallel_ctx.get_concurrent_cnt());
+  check_ranges(parallel_ctx);
+}
+
+TEST_F(TestParallelMergeCtx, test_few_sampled_keys)
+{
+  // the rows are too few to be split as wanted, less ranges are used
+  add_memtable(16 * TABLET_SIZE, 10);
+  ObParallelMergeCtx parallel_ctx;
+  init_mini_merge(parallel_ctx);
+  ASSERT_LT(parallel_ctx.get_concurrent_cnt(), 16);
+  if (parallel_ctx.get_concurrent_cnt() > 1) {
+    ASSERT_EQ(ObParallelMergeCtx::PARALLEL_MINI, parallel_ctx.parallel_type_);
+    check_ranges(parallel_ctx);
+  } else {
+    ASSERT_EQ(ObParallelMergeCtx::SERIALIZE_MERGE, parallel_ctx.parallel_type_);
+    ASSERT_TRUE(parallel_ctx.range_array_.at(0).is_whole_range());
+  }
+}
+
+} // end namespace unittest
+} // end namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  system("rm -f test_partition_parallel_merge_ctx.log*");
+  OB_LOGGER.set_file_name("test_partition_parallel_merge_ctx.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
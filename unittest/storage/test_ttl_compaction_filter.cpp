@@ -0,0 +1,229 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include "storage/compaction/ob_i_compaction_filter.h"
+#include "storage/blocksstable/ob_datum_row.h"
+#include "share/schema/ob_table_schema.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace blocksstable;
+using namespace compaction;
+using namespace share::schema;
+
+namespace unittest
+{
+
+static const int64_t SNAPSHOT_VERSION = 1000L * 1000L * 1000L * 1000L; // 1000s in nsec
+
+static void add_column(
+    ObTableSchema &table_schema,
+    const uint64_t column_id,
+    const char *column_name,
+    const ObObjType type,
+    const int64_t rowkey_position)
+{
+  ObColumnSchemaV2 column;
+  column.set_column_id(column_id);
+  column.set_column_name(column_name);
+  column.set_data_type(type);
+  column.set_rowkey_position(rowkey_position);
+  ASSERT_EQ(OB_SUCCESS, table_schema.add_column(column));
+}
+
+class MockNewerVersionChecker : public ObIRowNewerVersionChecker
+{
+public:
+  MockNewerVersionChecker() : ret_(OB_SUCCESS), has_newer_(false), check_cnt_(0) {}
+  virtual int check(const ObDatumRow &row, bool &has_newer) override
+  {
+    UNUSED(row);
+    ++check_cnt_;
+    has_newer = has_newer_;
+    return ret_;
+  }
+  int ret_;
+  bool has_newer_;
+  int64_t check_cnt_;
+};
+
+TEST(TestTTLDescriptor, parse)
+{
+  ObArenaAllocator allocator;
+  ObTTLDescriptor ttl_desc;
+  ASSERT_EQ(OB_SUCCESS, ttl_desc.parse_from_comment(
+      "{\"HColumnDescriptor\": {\"TimeToLive\": 3600, \"MaxVersions\": 2}}", allocator));
+  ASSERT_TRUE(ttl_desc.is_valid());
+  ASSERT_TRUE(ttl_desc.is_htable_);
+  ASSERT_EQ(3600, ttl_desc.time_to_live_);
+  ASSERT_EQ(2, ttl_desc.max_versions_);
+
+  ASSERT_EQ(OB_SUCCESS, ttl_desc.parse_from_comment(
+      "{\"TTLDescriptor\": {\"Column\": \"gmt_create\", \"TimeToLive\": 60}}", allocator));
+  ASSERT_TRUE(ttl_desc.is_valid());
+  ASSERT_FALSE(ttl_desc.is_htable_);
+  ASSERT_EQ(60, ttl_desc.time_to_live_);
+  ASSERT_EQ(0, ttl_desc.column_name_.compare("gmt_create"));
+
+  // the column is required by the tables other than htable
+  ASSERT_EQ(OB_SUCCESS, ttl_desc.parse_from_comment("{\"TTLDescriptor\": {\"TimeToLive\": 60}}", allocator));
+  ASSERT_FALSE(ttl_desc.is_valid());
+  // plain comment
+  ASSERT_EQ(OB_SUCCESS, ttl_desc.parse_from_comment("time series of the sensors", allocator));
+  ASSERT_FALSE(ttl_desc.is_valid());
+}
+
+TEST(TestTTLCompactionFilter, htable)
+{
+  ObArenaAllocator allocator;
+  ObTableSchema table_schema;
+  ObTTLDescriptor ttl_desc;
+  ObTTLCompactionFilter filter;
+  MockNewerVersionChecker checker;
+  ObDatumRow row;
+  ObICompactionFilter::ObFilterRet filter_ret = ObICompactionFilter::FILTER_RET_MAX;
+  add_column(table_schema, OB_APP_MIN_COLUMN_ID, "K", ObVarcharType, 1);
+  add_column(table_schema, OB_APP_MIN_COLUMN_ID + 1, "Q", ObVarcharType, 2);
+  add_column(table_schema, OB_APP_MIN_COLUMN_ID + 2, "T", ObIntType, 3);
+  add_column(table_schema, OB_APP_MIN_COLUMN_ID + 3, "V", ObVarcharType, 0);
+  ASSERT_EQ(OB_SUCCESS, ttl_desc.parse_from_comment(
+      "{\"HColumnDescriptor\": {\"TimeToLive\": 100, \"MaxVersions\": 2}}", allocator));
+  ASSERT_EQ(OB_SUCCESS, filter.init(table_schema, ttl_desc, SNAPSHOT_VERSION));
+  // the task states are not inited yet
+  ASSERT_EQ(OB_INVALID_ARGUMENT, filter.prepare_task(0, &checker));
+  ASSERT_EQ(OB_SUCCESS, filter.init_task_states(2));
+  // each task checks the newer versions by its own merger
+  ASSERT_EQ(OB_INVALID_ARGUMENT, filter.prepare_task(0, nullptr));
+  ASSERT_EQ(OB_SUCCESS, row.init(allocator, 6));
+  row.row_flag_.set_flag(ObDmlFlag::DF_INSERT);
+
+  // versions of one cell in the order of the newest first, the cells older than 900s are expired
+  const int64_t timestamps_ms[] = {990 * 1000L, 980 * 1000L, 970 * 1000L};
+  const bool removed[] = {false, false, true};
+  ASSERT_EQ(OB_SUCCESS, filter.prepare_task(0, &checker));
+  for (int64_t i = 0; i < ARRAYSIZEOF(timestamps_ms); ++i) {
+    row.storage_datums_[0].set_string(ObString("row1"));
+    row.storage_datums_[1].set_string(ObString("cf:q1"));
+    row.storage_datums_[2].set_int(-timestamps_ms[i]);
+    ASSERT_EQ(OB_SUCCESS, filter.filter(row, 0, filter_ret));
+    ASSERT_EQ(removed[i], ObICompactionFilter::FILTER_RET_REMOVE == filter_ret);
+  }
+  // the versions are counted for each qualifier
+  row.storage_datums_[1].set_string(ObString("cf:q2"));
+  row.storage_datums_[2].set_int(-995 * 1000L);
+  ASSERT_EQ(OB_SUCCESS, filter.filter(row, 0, filter_ret));
+  ASSERT_EQ(ObICompactionFilter::FILTER_RET_NOT_CHANGE, filter_ret);
+  // expired
+  row.storage_datums_[2].set_int(-899 * 1000L);
+  ASSERT_EQ(OB_SUCCESS, filter.filter(row, 0, filter_ret));
+  ASSERT_EQ(ObICompactionFilter::FILTER_RET_REMOVE, filter_ret);
+
+  // the state of the other task is independent
+  ASSERT_EQ(OB_SUCCESS, filter.prepare_task(1, &checker));
+  row.storage_datums_[1].set_string(ObString("cf:q1"));
+  row.storage_datums_[2].set_int(-960 * 1000L);
+  ASSERT_EQ(OB_SUCCESS, filter.filter(row, 1, filter_ret));
+  ASSERT_EQ(ObICompactionFilter::FILTER_RET_NOT_CHANGE, filter_ret);
+  ASSERT_EQ(OB_INVALID_ARGUMENT, filter.filter(row, 2, filter_ret));
+}
+
+TEST(TestTTLCompactionFilter, timestamp_column)
+{
+  ObArenaAllocator allocator;
+  ObTableSchema table_schema;
+  ObTTLDescriptor ttl_desc;
+  ObTTLCompactionFilter filter;
+  MockNewerVersionChecker checker;
+  ObDatumRow row;
+  ObICompactionFilter::ObFilterRet filter_ret = ObICompactionFilter::FILTER_RET_MAX;
+  add_column(table_schema, OB_APP_MIN_COLUMN_ID, "id", ObIntType, 1);
+  add_column(table_schema, OB_APP_MIN_COLUMN_ID + 1, "gmt_create", ObTimestampType, 0);
+  add_column(table_schema, OB_APP_MIN_COLUMN_ID + 2, "value", ObIntType, 0);
+
+  ASSERT_EQ(OB_SUCCESS, ttl_desc.parse_from_comment(
+      "{\"TTLDescriptor\": {\"Column\": \"value\", \"TimeToLive\": 60}}", allocator));
+  ASSERT_EQ(OB_NOT_SUPPORTED, filter.init(table_schema, ttl_desc, SNAPSHOT_VERSION));
+
+  ASSERT_EQ(OB_SUCCESS, ttl_desc.parse_from_comment(
+      "{\"TTLDescriptor\": {\"Column\": \"gmt_create\", \"TimeToLive\": 60}}", allocator));
+  ASSERT_EQ(OB_SUCCESS, filter.init(table_schema, ttl_desc, SNAPSHOT_VERSION));
+  ASSERT_EQ(OB_SUCCESS, filter.init_task_states(1));
+  ASSERT_EQ(OB_SUCCESS, filter.prepare_task(0, &checker));
+  // rowkey, trans version, sql sequence, gmt_create, value
+  ASSERT_EQ(OB_SUCCESS, row.init(allocator, 5));
+  row.row_flag_.set_flag(ObDmlFlag::DF_INSERT);
+  row.storage_datums_[0].set_int(1);
+  row.storage_datums_[4].set_int(1);
+
+  row.storage_datums_[3].set_timestamp(939L * 1000L * 1000L);
+  ASSERT_EQ(OB_SUCCESS, filter.filter(row, filter_ret));
+  ASSERT_EQ(ObICompactionFilter::FILTER_RET_REMOVE, filter_ret);
+  row.storage_datums_[3].set_timestamp(941L * 1000L * 1000L);
+  ASSERT_EQ(OB_SUCCESS, filter.filter(row, filter_ret));
+  ASSERT_EQ(ObICompactionFilter::FILTER_RET_NOT_CHANGE, filter_ret);
+  row.storage_datums_[3].set_null();
+  ASSERT_EQ(OB_SUCCESS, filter.filter(row, filter_ret));
+  ASSERT_EQ(ObICompactionFilter::FILTER_RET_NOT_CHANGE, filter_ret);
+  // only the expired rows are probed
+  ASSERT_EQ(1, checker.check_cnt_);
+}
+
+TEST(TestTTLCompactionFilter, newer_version)
+{
+  ObArenaAllocator allocator;
+  ObTableSchema table_schema;
+  ObTTLDescriptor ttl_desc;
+  ObTTLCompactionFilter filter;
+  MockNewerVersionChecker checker;
+  ObDatumRow row;
+  ObICompactionFilter::ObFilterRet filter_ret = ObICompactionFilter::FILTER_RET_MAX;
+  add_column(table_schema, OB_APP_MIN_COLUMN_ID, "id", ObIntType, 1);
+  add_column(table_schema, OB_APP_MIN_COLUMN_ID + 1, "gmt_create", ObTimestampType, 0);
+  add_column(table_schema, OB_APP_MIN_COLUMN_ID + 2, "value", ObIntType, 0);
+  ASSERT_EQ(OB_SUCCESS, ttl_desc.parse_from_comment(
+      "{\"TTLDescriptor\": {\"Column\": \"gmt_create\", \"TimeToLive\": 60}}", allocator));
+  ASSERT_EQ(OB_SUCCESS, filter.init(table_schema, ttl_desc, SNAPSHOT_VERSION));
+  ASSERT_EQ(OB_SUCCESS, filter.init_task_states(1));
+  ASSERT_EQ(OB_SUCCESS, filter.prepare_task(0, &checker));
+  ASSERT_EQ(OB_SUCCESS, row.init(allocator, 5));
+  row.row_flag_.set_flag(ObDmlFlag::DF_INSERT);
+  row.storage_datums_[0].set_int(1);
+  row.storage_datums_[3].set_timestamp(939L * 1000L * 1000L);
+  row.storage_datums_[4].set_int(1);
+
+  // the row written after the last major merge is kept
+  checker.has_newer_ = true;
+  ASSERT_EQ(OB_SUCCESS, filter.filter(row, filter_ret));
+  ASSERT_EQ(ObICompactionFilter::FILTER_RET_NOT_CHANGE, filter_ret);
+  // keep the row when the probe fails
+  checker.has_newer_ = false;
+  checker.ret_ = OB_TIMEOUT;
+  ASSERT_EQ(OB_SUCCESS, filter.filter(row, filter_ret));
+  ASSERT_EQ(ObICompactionFilter::FILTER_RET_NOT_CHANGE, filter_ret);
+  checker.ret_ = OB_SUCCESS;
+  ASSERT_EQ(OB_SUCCESS, filter.filter(row, filter_ret));
+  ASSERT_EQ(ObICompactionFilter::FILTER_RET_REMOVE, filter_ret);
+}
+
+} // namespace unittest
+} // namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  system("rm -f test_ttl_compaction_filter.log*");
+  OB_LOGGER.set_file_name("test_ttl_compaction_filter.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -237,6 +237,13 @@ public:
     if (get_gts_error_) { return get_gts_error_; }
     return OB_SUCCESS;
   }
+  int get_read_snapshot(const uint64_t tenant_id,
+                        const MonotonicTs stc,
+                        int64_t &snapshot,
+                        MonotonicTs &receive_gts_ts)
+  {
+    return get_gts(tenant_id, stc, NULL, snapshot, receive_gts_ts);
+  }
   int get_ts_sync(const uint64_t tenant_id, const int64_t timeout_ts,
                   int64_t &ts, bool &is_external_consistent) { return OB_SUCCESS; }
   int wait_gts_elapse(const uint64_t tenant_id, const int64_t ts, ObTsCbTask *task,
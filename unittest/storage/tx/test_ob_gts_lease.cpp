@@ -0,0 +1,291 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include "share/ob_errno.h"
+#include "lib/oblog/ob_log.h"
+#include "lib/random/ob_random.h"
+#include "storage/tx/ob_gts_local_cache.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace transaction;
+namespace unittest
+{
+
+static const int64_t LEASE_DURATION_US = 100 * 1000;
+static const int64_t MAX_CLOCK_SKEW_NS = 1000 * 1000;
+static const int64_t LEADER_EPOCH = 1;
+
+// The gts leader generates gts by its clock, which starts from base_gts at
+// base_mts of local monotonic clock, and runs with drift_ppm faster than the
+// local clock.
+class MockGtsLeader
+{
+public:
+  MockGtsLeader(const int64_t base_gts, const int64_t base_mts, const int64_t drift_ppm)
+    : base_gts_(base_gts), base_mts_(base_mts), drift_ppm_(drift_ppm), last_gts_(0) {}
+  int64_t get_gts(const int64_t mts)
+  {
+    const int64_t elapsed_ns = (mts - base_mts_) * 1000;
+    const int64_t clock_ns = base_gts_ + elapsed_ns + elapsed_ns / 1000000 * drift_ppm_;
+    last_gts_ = std::max(last_gts_ + 1, clock_ns);
+    return last_gts_;
+  }
+  // the max gts issued before mts without generating new one
+  int64_t peek_gts(const int64_t mts) const
+  {
+    const int64_t elapsed_ns = (mts - base_mts_) * 1000;
+    return std::max(last_gts_, base_gts_ + elapsed_ns + elapsed_ns / 1000000 * drift_ppm_);
+  }
+private:
+  int64_t base_gts_;
+  int64_t base_mts_;
+  int64_t drift_ppm_;
+  int64_t last_gts_;
+};
+
+TEST(TestObGtsLease, invalid_and_expired)
+{
+  ObGTSLease lease;
+  int64_t ts = 0;
+  const MonotonicTs srr(1000 * 1000);
+  EXPECT_EQ(OB_EAGAIN, lease.get_ts(srr, ts));
+  EXPECT_EQ(OB_INVALID_ARGUMENT, lease.renew(MonotonicTs(), 100, LEADER_EPOCH, LEASE_DURATION_US, 0));
+  EXPECT_EQ(OB_INVALID_ARGUMENT, lease.renew(srr, 0, LEADER_EPOCH, LEASE_DURATION_US, 0));
+  EXPECT_EQ(OB_INVALID_ARGUMENT, lease.renew(srr, 100, LEADER_EPOCH, -1, 0));
+
+  // lease with zero duration never issues timestamp
+  EXPECT_EQ(OB_SUCCESS, lease.renew(srr, 100, LEADER_EPOCH, 0, 0));
+  EXPECT_EQ(OB_EAGAIN, lease.get_ts(srr, ts));
+
+  EXPECT_EQ(OB_SUCCESS, lease.renew(srr + MonotonicTs(1), 100, LEADER_EPOCH, LEASE_DURATION_US, 0));
+  EXPECT_TRUE(lease.is_valid(srr + MonotonicTs(1)));
+  EXPECT_EQ(OB_SUCCESS, lease.get_ts(srr + MonotonicTs(LEASE_DURATION_US), ts));
+  // expired
+  EXPECT_FALSE(lease.is_valid(srr + MonotonicTs(LEASE_DURATION_US + 1)));
+  EXPECT_EQ(OB_EAGAIN, lease.get_ts(srr + MonotonicTs(LEASE_DURATION_US + 1), ts));
+  // before the request is sent
+  EXPECT_EQ(OB_EAGAIN, lease.get_ts(srr, ts));
+
+  lease.reset();
+  EXPECT_EQ(OB_EAGAIN, lease.get_ts(srr + MonotonicTs(1), ts));
+}
+
+TEST(TestObGtsLease, out_of_order_renew)
+{
+  ObGTSLease lease;
+  int64_t ts = 0;
+  const MonotonicTs srr(1000 * 1000);
+  EXPECT_EQ(OB_SUCCESS, lease.renew(srr, 1000 * 1000 * 1000, LEADER_EPOCH, LEASE_DURATION_US, 0));
+  // the response of an older request does not roll back the lease
+  EXPECT_EQ(OB_SUCCESS, lease.renew(srr - MonotonicTs(10), 1000, LEADER_EPOCH, LEASE_DURATION_US, 0));
+  EXPECT_EQ(OB_SUCCESS, lease.get_ts(srr, ts));
+  EXPECT_LE(1000 * 1000 * 1000, ts);
+}
+
+// Safety: the timestamp issued by the lease at any moment is greater than any
+// gts issued by the leader before that moment, under the clock drift and skew
+// bound.
+TEST(TestObGtsLease, cover_leader_gts)
+{
+  const int64_t drifts[] = {0, ObGTSLease::MAX_CLOCK_DRIFT_PPM / 2, ObGTSLease::MAX_CLOCK_DRIFT_PPM};
+  const int64_t drift_cnt = static_cast<int64_t>(sizeof(drifts) / sizeof(drifts[0]));
+  for (int64_t d = 0; d < drift_cnt; d++) {
+    const int64_t base_mts = 1000 * 1000;
+    MockGtsLeader leader(1000 * 1000 * 1000, base_mts, drifts[d]);
+    ObGTSLease lease;
+    int64_t mts = base_mts;
+    int64_t last_ts = 0;
+    for (int64_t round = 0; round < 1000; round++) {
+      // the gts request is sent at srr and handled by the leader after a
+      // random network delay
+      const int64_t srr = mts;
+      const int64_t gts = leader.get_gts(srr + ObRandom::rand(0, 2000));
+      mts = srr + ObRandom::rand(0, 4000);
+      ASSERT_EQ(OB_SUCCESS, lease.renew(MonotonicTs(srr), gts, LEADER_EPOCH, LEASE_DURATION_US, MAX_CLOCK_SKEW_NS));
+      for (int64_t i = 0; i < 10; i++) {
+        // the other transactions get gts from the leader concurrently
+        if (0 == ObRandom::rand(0, 1)) {
+          (void)leader.get_gts(mts);
+        }
+        int64_t ts = 0;
+        if (mts - srr < LEASE_DURATION_US) {
+          ASSERT_EQ(OB_SUCCESS, lease.get_ts(MonotonicTs(mts), ts));
+          ASSERT_LT(leader.peek_gts(mts), ts);
+          ASSERT_LT(last_ts, ts);
+          last_ts = ts;
+        } else {
+          ASSERT_EQ(OB_EAGAIN, lease.get_ts(MonotonicTs(mts), ts));
+        }
+        mts += ObRandom::rand(1, LEASE_DURATION_US / 5);
+      }
+    }
+  }
+}
+
+// The new gts leader takes over at takeover_mts and resumes from the limited id
+// pre-allocated by the old one, which is far ahead of the clock. It issues no
+// gts until wait_us has passed since taking over.
+class MockNewGtsLeader
+{
+public:
+  MockNewGtsLeader(const int64_t limited_id, const int64_t takeover_mts, const int64_t wait_us)
+    : last_gts_(limited_id), serve_mts_(takeover_mts + wait_us) {}
+  int get_gts(const int64_t mts, int64_t &gts)
+  {
+    int ret = OB_SUCCESS;
+    if (mts < serve_mts_) {
+      ret = OB_EAGAIN;
+    } else {
+      gts = ++last_gts_;
+    }
+    return ret;
+  }
+  bool has_served(const int64_t mts) const { return mts >= serve_mts_; }
+  int64_t get_last_gts() const { return last_gts_; }
+private:
+  int64_t last_gts_;
+  int64_t serve_mts_;
+};
+
+// the gts leader fails over to a new one, which jumps ahead to the limited id
+TEST(TestObGtsLease, failover_new_leader_jumps_ahead)
+{
+  const int64_t base_mts = 1000 * 1000;
+  const int64_t base_gts = 1000 * 1000 * 1000;
+  // 4s of pre-allocated range in ns
+  const int64_t limited_id = base_gts + 4L * 1000 * 1000 * 1000;
+  const int64_t old_epoch = LEADER_EPOCH;
+  const int64_t new_epoch = LEADER_EPOCH + 1;
+  MockGtsLeader old_leader(base_gts, base_mts, 0);
+  ObGTSLease lease;
+  const int64_t srr = base_mts + 10;
+  const int64_t gts = old_leader.get_gts(srr + 5);
+  ASSERT_EQ(OB_SUCCESS, lease.renew(MonotonicTs(srr), gts, old_epoch,
+                                    LEASE_DURATION_US, MAX_CLOCK_SKEW_NS));
+
+  // the old leader is deposed right after responding, the new leader waits as
+  // ObTimestampService::switch_to_leader does
+  const int64_t takeover_mts = srr + 20;
+  const int64_t wait_us = LEASE_DURATION_US
+                          + LEASE_DURATION_US / 1000000 * ObGTSLease::MAX_CLOCK_DRIFT_PPM
+                          + MAX_CLOCK_SKEW_NS / 1000;
+  MockNewGtsLeader new_leader(limited_id, takeover_mts, wait_us);
+
+  // the jump is far beyond the bound of the lease, so the lease of the old
+  // epoch must have expired before the new leader issues any gts
+  int64_t max_lease_ts = 0;
+  for (int64_t mts = srr; mts < srr + 2 * LEASE_DURATION_US; mts += 997) {
+    int64_t ts = 0;
+    int64_t new_gts = 0;
+    if (OB_SUCCESS == lease.get_ts(MonotonicTs(mts), ts)) {
+      ASSERT_FALSE(new_leader.has_served(mts));
+      ASSERT_EQ(OB_EAGAIN, new_leader.get_gts(mts, new_gts));
+      ASSERT_LT(ts, limited_id);
+      max_lease_ts = ts;
+    } else if (new_leader.has_served(mts)) {
+      ASSERT_EQ(OB_SUCCESS, new_leader.get_gts(mts, new_gts));
+      ASSERT_LT(max_lease_ts, new_gts);
+    }
+  }
+  ASSERT_LT(0, max_lease_ts);
+
+  // renewed by the new leader, the lease covers the jumped gts
+  const int64_t srr2 = takeover_mts + wait_us + 10;
+  int64_t gts2 = 0;
+  ASSERT_EQ(OB_SUCCESS, new_leader.get_gts(srr2 + 5, gts2));
+  ASSERT_EQ(OB_SUCCESS, lease.renew(MonotonicTs(srr2), gts2, new_epoch,
+                                    LEASE_DURATION_US, MAX_CLOCK_SKEW_NS));
+  for (int64_t mts = srr2; mts < srr2 + LEASE_DURATION_US; mts += 997) {
+    int64_t ts = 0;
+    int64_t new_gts = 0;
+    ASSERT_EQ(OB_SUCCESS, new_leader.get_gts(mts, new_gts));
+    ASSERT_EQ(OB_SUCCESS, lease.get_ts(MonotonicTs(mts), ts));
+    ASSERT_LT(new_gts, ts);
+  }
+
+  // a late response of the deposed leader never renews the lease, even if it
+  // is sent later
+  int64_t ts = 0;
+  ASSERT_EQ(OB_SUCCESS, lease.renew(MonotonicTs(srr2 + 100), old_leader.get_gts(srr2 + 100),
+                                    old_epoch, LEASE_DURATION_US, MAX_CLOCK_SKEW_NS));
+  ASSERT_EQ(OB_SUCCESS, lease.get_ts(MonotonicTs(srr2 + 200), ts));
+  ASSERT_LT(new_leader.get_last_gts(), ts);
+
+  // NOT_MASTER invalidates the lease, but keeps the epoch
+  lease.invalidate();
+  ASSERT_EQ(OB_EAGAIN, lease.get_ts(MonotonicTs(srr2 + 300), ts));
+  ASSERT_EQ(OB_SUCCESS, lease.renew(MonotonicTs(srr2 + 400), old_leader.get_gts(srr2 + 400),
+                                    old_epoch, LEASE_DURATION_US, MAX_CLOCK_SKEW_NS));
+  ASSERT_EQ(OB_EAGAIN, lease.get_ts(MonotonicTs(srr2 + 500), ts));
+
+  // the gts without leader epoch can not renew the lease
+  ASSERT_EQ(OB_INVALID_ARGUMENT, lease.renew(MonotonicTs(srr2 + 600), gts2 + 1, 0,
+                                             LEASE_DURATION_US, MAX_CLOCK_SKEW_NS));
+}
+
+TEST(TestObGtsLease, monotonic)
+{
+  ObGTSLease lease;
+  const int64_t thread_cnt = 8;
+  const int64_t ts_cnt = 10000;
+  const MonotonicTs srr = MonotonicTs::current_time();
+  ASSERT_EQ(OB_SUCCESS, lease.renew(srr, 1000, LEADER_EPOCH, 10 * 1000 * 1000, 0));
+  std::vector<std::vector<int64_t>> issued(thread_cnt);
+  std::vector<std::thread> threads;
+  for (int64_t i = 0; i < thread_cnt; i++) {
+    threads.push_back(std::thread([&, i]() {
+      for (int64_t j = 0; j < ts_cnt; j++) {
+        int64_t ts = 0;
+        // all the threads issue at the same moment
+        EXPECT_EQ(OB_SUCCESS, lease.get_ts(srr, ts));
+        issued[i].push_back(ts);
+      }
+    }));
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  std::vector<int64_t> all;
+  for (int64_t i = 0; i < thread_cnt; i++) {
+    for (int64_t j = 1; j < ts_cnt; j++) {
+      // increasing in each thread
+      ASSERT_LT(issued[i][j - 1], issued[i][j]);
+    }
+    all.insert(all.end(), issued[i].begin(), issued[i].end());
+  }
+  // no duplicated timestamp
+  std::sort(all.begin(), all.end());
+  ASSERT_TRUE(std::adjacent_find(all.begin(), all.end()) == all.end());
+}
+
+}//end of unittest
+}//end of oceanbase
+
+using namespace oceanbase;
+using namespace oceanbase::common;
+
+int main(int argc, char **argv)
+{
+  int ret = 1;
+  ObLogger &logger = ObLogger::get_logger();
+  logger.set_file_name("test_ob_gts_lease.log", true);
+  logger.set_log_level(OB_LOG_LEVEL_INFO);
+  testing::InitGoogleTest(&argc, argv);
+  ret = RUN_ALL_TESTS();
+  return ret;
+}
@@ -0,0 +1,153 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include "lib/random/ob_random.h"
+#include "storage/tx_table/ob_tx_data_cache.h"
+#include "storage/tx_table/ob_tx_table_define.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace transaction;
+using namespace storage;
+
+namespace unittest
+{
+
+void make_tx_data(const int64_t tx_id, const int32_t state, ObTxData &tx_data)
+{
+  tx_data.reset();
+  tx_data.tx_id_ = ObTransID(tx_id);
+  tx_data.state_ = state;
+  tx_data.commit_version_ = tx_id * 10;
+  tx_data.start_log_ts_ = tx_id * 10 - 5;
+  tx_data.end_log_ts_ = tx_id * 10 + 5;
+}
+
+TEST(TestTxDataLookupCache, get_and_put)
+{
+  ObTxDataLookupCache cache;
+  ObMemAttr attr(OB_SERVER_TENANT_ID, "TxDataCacheUT");
+  ASSERT_EQ(OB_SUCCESS, cache.init(attr));
+  ObTxCommitData commit_data;
+  bool is_not_exist = false;
+  ObTxData tx_data;
+
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, cache.get(ObTransID(1), 0, 1, commit_data, is_not_exist));
+
+  // running transactions are not cached
+  make_tx_data(1, ObTxData::RUNNING, tx_data);
+  cache.put(tx_data);
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, cache.get(ObTransID(1), 0, 1, commit_data, is_not_exist));
+
+  make_tx_data(1, ObTxData::COMMIT, tx_data);
+  cache.put(tx_data);
+  ASSERT_EQ(OB_SUCCESS, cache.get(ObTransID(1), 0, 1, commit_data, is_not_exist));
+  ASSERT_FALSE(is_not_exist);
+  ASSERT_EQ(ObTxData::COMMIT, commit_data.state_);
+  ASSERT_EQ(10, commit_data.commit_version_);
+  // the decided state is not bound to memtables
+  ASSERT_EQ(OB_SUCCESS, cache.get(ObTransID(1), 5, 8, commit_data, is_not_exist));
+
+  // the tx in the same slot is overwritten
+  const int64_t other_tx_id = 1 + ObTxDataLookupCache::SLOT_CNT;
+  if ((ObTransID(other_tx_id).hash() & (ObTxDataLookupCache::SLOT_CNT - 1))
+      == (ObTransID(1).hash() & (ObTxDataLookupCache::SLOT_CNT - 1))) {
+    make_tx_data(other_tx_id, ObTxData::ABORT, tx_data);
+    cache.put(tx_data);
+    ASSERT_EQ(OB_ENTRY_NOT_EXIST, cache.get(ObTransID(1), 0, 1, commit_data, is_not_exist));
+  }
+
+  cache.clear();
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, cache.get(ObTransID(1), 0, 1, commit_data, is_not_exist));
+}
+
+TEST(TestTxDataLookupCache, not_exist)
+{
+  ObTxDataLookupCache cache;
+  ObMemAttr attr(OB_SERVER_TENANT_ID, "TxDataCacheUT");
+  ASSERT_EQ(OB_SUCCESS, cache.init(attr));
+  ObTxCommitData commit_data;
+  bool is_not_exist = false;
+
+  cache.put_not_exist(ObTransID(2), 3, 5);
+  ASSERT_EQ(OB_SUCCESS, cache.get(ObTransID(2), 3, 5, commit_data, is_not_exist));
+  ASSERT_TRUE(is_not_exist);
+  // memtables are flushed or a new memtable is created
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, cache.get(ObTransID(2), 4, 5, commit_data, is_not_exist));
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, cache.get(ObTransID(2), 3, 6, commit_data, is_not_exist));
+}
+
+TEST(TestTxDataLookupCache, concurrent)
+{
+  ObTxDataLookupCache cache;
+  ObMemAttr attr(OB_SERVER_TENANT_ID, "TxDataCacheUT");
+  ASSERT_EQ(OB_SUCCESS, cache.init(attr));
+  const int64_t thread_cnt = 8;
+  const int64_t tx_cnt = 100000;
+  std::vector<std::thread> threads;
+  for (int64_t i = 0; i < thread_cnt; i++) {
+    threads.push_back(std::thread([&]() {
+      ObTxData tx_data;
+      ObTxCommitData commit_data;
+      bool is_not_exist = false;
+      for (int64_t j = 0; j < tx_cnt; j++) {
+        const int64_t tx_id = ObRandom::rand(1, tx_cnt);
+        if (OB_SUCCESS == cache.get(ObTransID(tx_id), 0, 0, commit_data, is_not_exist)) {
+          // never read a torn entry
+          EXPECT_EQ(tx_id * 10, commit_data.commit_version_);
+          EXPECT_EQ(tx_id * 10 + 5, commit_data.end_log_ts_);
+        } else {
+          make_tx_data(tx_id, ObTxData::COMMIT, tx_data);
+          cache.put(tx_data);
+        }
+      }
+    }));
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+}
+
+TEST(TestCommitVersionsArray, lower_bound)
+{
+  ObCommitVersionsArray commit_versions;
+  ASSERT_EQ(0, commit_versions.lower_bound(100));
+  int64_t log_ts = 0;
+  std::vector<int64_t> keys;
+  for (int64_t i = 0; i < 1000; i++) {
+    // duplicated start_log_ts is allowed
+    log_ts += ObRandom::rand(0, 3);
+    keys.push_back(log_ts);
+    ASSERT_EQ(OB_SUCCESS, commit_versions.array_.push_back(ObCommitVersionsArray::Node(log_ts, log_ts + 1)));
+    for (int64_t key = -1; key <= log_ts + 1; key++) {
+      const int64_t expected = std::lower_bound(keys.begin(), keys.end(), key) - keys.begin();
+      ASSERT_EQ(expected, commit_versions.lower_bound(key)) << "count=" << keys.size() << " key=" << key;
+    }
+  }
+}
+
+}  // namespace unittest
+}  // namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  system("rm -rf test_tx_data_cache.log*");
+  OB_LOGGER.set_file_name("test_tx_data_cache.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}